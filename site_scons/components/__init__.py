@@ -349,6 +349,12 @@ def define_components(reqs):
     else:
         spdk_arch = 'haswell'
 
+    # io_uring bdev module is used for the io_uring backed file and kdev classes, liburing isn't
+    # available on CentOS 7.
+    spdk_uring = ['--with-uring']
+    if dist[0] == 'CentOS Linux' and dist[1] == '7':
+        spdk_uring = []
+
     reqs.define('spdk',
                 retriever=GitRepoRetriever('https://github.com/spdk/spdk.git', True),
                 commands=[['./configure',
@@ -364,7 +370,7 @@ def define_components(reqs):
                            '--without-iscsi-initiator',
                            '--without-isal',
                            '--without-vtune',
-                           '--with-shared'],
+                           '--with-shared'] + spdk_uring,
                           ['make', 'CONFIG_ARCH={}'.format(spdk_arch)],
                           ['make', 'install'],
                           ['cp', '-r', '-P', 'dpdk/build/lib/', '$SPDK_PREFIX'],
@@ -16,6 +16,11 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 	D_ASSERT(chunk->bdc_pg_idx == 0);
 	D_ASSERT(chunk->bdc_ref == 0);
 	D_ASSERT(d_list_empty(&chunk->bdc_link));
+	D_ASSERT(chunk->bdc_bulk_grp == NULL);
+
+	/* Bulk handle array is kept when the chunk is reclaimed from bulk group */
+	if (chunk->bdc_bulks != NULL)
+		D_FREE(chunk->bdc_bulks);
 
 	if (bio_spdk_inited)
 		spdk_dma_free(chunk->bdc_ptr);
@@ -26,7 +31,7 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 }
 
 static struct bio_dma_chunk *
-dma_alloc_chunk(unsigned int cnt)
+dma_alloc_chunk(unsigned int cnt, int numa_node)
 {
 	struct bio_dma_chunk *chunk;
 	ssize_t bytes = (ssize_t)cnt << BIO_DMA_PAGE_SHIFT;
@@ -41,7 +46,7 @@ dma_alloc_chunk(unsigned int cnt)
 
 	if (bio_spdk_inited) {
 		chunk->bdc_ptr = spdk_dma_malloc_socket(bytes, BIO_DMA_PAGE_SZ, NULL,
-							bio_numa_node);
+							numa_node);
 	} else {
 		rc = posix_memalign(&chunk->bdc_ptr, BIO_DMA_PAGE_SZ, bytes);
 		if (rc)
@@ -86,7 +91,7 @@ dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 	D_ASSERT((buf->bdb_tot_cnt + cnt) <= bio_chk_cnt_max);
 
 	for (i = 0; i < cnt; i++) {
-		chunk = dma_alloc_chunk(bio_chk_sz);
+		chunk = dma_alloc_chunk(bio_chk_sz, buf->bdb_numa_node);
 		if (chunk == NULL) {
 			rc = -DER_NOMEM;
 			break;
@@ -110,6 +115,8 @@ dma_buffer_destroy(struct bio_dma_buffer *buf)
 
 	bulk_cache_destroy(buf);
 	dma_buffer_shrink(buf, buf->bdb_tot_cnt);
+	if (buf->bdb_gap_chk != NULL)
+		dma_free_chunk(buf->bdb_gap_chk);
 
 	D_ASSERT(buf->bdb_tot_cnt == 0);
 	ABT_mutex_free(&buf->bdb_mutex);
@@ -119,6 +126,19 @@ dma_buffer_destroy(struct bio_dma_buffer *buf)
 	D_FREE(buf);
 }
 
+static inline char *
+dma_class2str(int dma_class)
+{
+	switch (dma_class) {
+	case BIO_DMA_CLASS_SMALL:
+		return "small";
+	case BIO_DMA_CLASS_LARGE:
+		return "large";
+	default:
+		return "unknown";
+	}
+}
+
 static inline char *
 chk_type2str(int chk_type)
 {
@@ -160,6 +180,22 @@ dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create total_bulk_grps telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&stats->bds_bulk_regs, D_TM_COUNTER, "Bulk handles registered",
+			     "hdl", "dmabuff/bulk_regs/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create bulk_regs telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_bulk_reg_lat, D_TM_STATS_GAUGE,
+			     "Bulk chunk registration latency", D_TM_MICROSECOND,
+			     "dmabuff/bulk_reg_lat/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create bulk_reg_lat telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_bulk_evicts, D_TM_COUNTER, "Bulk chunks evicted",
+			     "chunk", "dmabuff/bulk_evicts/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create bulk_evicts telemetry: "DF_RC"\n", DP_RC(rc));
+
 	rc = d_tm_add_metric(&stats->bds_active_iods, D_TM_GAUGE, "Active requests", "req",
 			     "dmabuff/active_reqs/tgt_%d", tgt_id);
 	if (rc)
@@ -180,10 +216,60 @@ dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create grab_retries telemetry: "DF_RC"\n", DP_RC(rc));
 
+	for (i = BIO_DMA_CLASS_SMALL; i < BIO_DMA_CLASS_MAX; i++) {
+		snprintf(desc, sizeof(desc), "Used chunks (%s I/O)", dma_class2str(i));
+		rc = d_tm_add_metric(&stats->bds_class_chks[i], D_TM_GAUGE, desc, "chunk",
+				     "dmabuff/%s/used_chunks/tgt_%d", dma_class2str(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create %s used_chunks telemetry: "DF_RC"\n",
+			       dma_class2str(i), DP_RC(rc));
+
+		snprintf(desc, sizeof(desc), "Chunk utilization (%s I/O)", dma_class2str(i));
+		rc = d_tm_add_metric(&stats->bds_class_util[i], D_TM_STATS_GAUGE, desc, "%",
+				     "dmabuff/%s/chunk_util/tgt_%d", dma_class2str(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create %s chunk_util telemetry: "DF_RC"\n",
+			       dma_class2str(i), DP_RC(rc));
+
+		snprintf(desc, sizeof(desc), "Buffer wait time (%s I/O)", dma_class2str(i));
+		rc = d_tm_add_metric(&stats->bds_class_wait[i], D_TM_STATS_GAUGE, desc,
+				     D_TM_MICROSECOND, "dmabuff/%s/wait_time/tgt_%d",
+				     dma_class2str(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create %s wait_time telemetry: "DF_RC"\n",
+			       dma_class2str(i), DP_RC(rc));
+	}
+
+	rc = d_tm_add_metric(&stats->bds_iod_size, D_TM_STATS_GAUGE, "DMA request size",
+			     D_TM_KIBIBYTE, "dmabuff/req_size/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create req_size telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_nvme_cmds, D_TM_COUNTER, "NVMe commands issued", "cmd",
+			     "dmabuff/nvme_cmds/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create nvme_cmds telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_nvme_extents, D_TM_COUNTER, "NVMe extents transferred",
+			     "extent", "dmabuff/nvme_extents/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create nvme_extents telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_wc_writes, D_TM_COUNTER,
+			     "NVMe writes staged for combining", "extent",
+			     "dmabuff/wc_writes/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create wc_writes telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_wc_batch, D_TM_STATS_GAUGE,
+			     "Staged writes per combined NVMe write", "extent",
+			     "dmabuff/wc_batch/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create wc_batch telemetry: "DF_RC"\n", DP_RC(rc));
 }
 
 struct bio_dma_buffer *
-dma_buffer_create(unsigned int init_cnt, int tgt_id)
+dma_buffer_create(unsigned int init_cnt, int tgt_id, int numa_node)
 {
 	struct bio_dma_buffer *buf;
 	int rc;
@@ -196,6 +282,8 @@ dma_buffer_create(unsigned int init_cnt, int tgt_id)
 	D_INIT_LIST_HEAD(&buf->bdb_used_list);
 	buf->bdb_tot_cnt = 0;
 	buf->bdb_active_iods = 0;
+	buf->bdb_numa_node = numa_node;
+	buf->bdb_adapt_ts = daos_gettime_coarse();
 
 	rc = ABT_mutex_create(&buf->bdb_mutex);
 	if (rc != ABT_SUCCESS) {
@@ -235,6 +323,14 @@ dma_buffer_create(unsigned int init_cnt, int tgt_id)
 		return NULL;
 	}
 
+	if (bio_nvme_gap_pgs != 0) {
+		buf->bdb_gap_chk = dma_alloc_chunk(bio_nvme_gap_pgs, numa_node);
+		if (buf->bdb_gap_chk == NULL) {
+			dma_buffer_destroy(buf);
+			return NULL;
+		}
+	}
+
 	return buf;
 }
 
@@ -269,6 +365,9 @@ bio_iod_alloc(struct bio_io_context *ctxt, unsigned int sgl_cnt,
 	biod->bd_ctxt = ctxt;
 	biod->bd_type = type;
 	biod->bd_sgl_cnt = sgl_cnt;
+	biod->bd_io_class = BIO_IO_CLASS_FG;
+	D_INIT_LIST_HEAD(&biod->bd_sched_link);
+	D_INIT_LIST_HEAD(&biod->bd_rcache_link);
 
 	biod->bd_dma_done = ABT_EVENTUAL_NULL;
 	return biod;
@@ -354,6 +453,12 @@ iod_release_buffer(struct bio_desc *biod)
 		if (dma_chunk_is_huge(chunk)) {
 			dma_free_chunk(chunk);
 		} else if (chunk->bdc_ref == 0) {
+			struct bio_dma_class *bdcl = &bdb->bdb_class[chunk->bdc_class];
+
+			/* Pages used by the chunk before it's recycled */
+			if (bdb->bdb_stats.bds_class_util[chunk->bdc_class])
+				d_tm_set_gauge(bdb->bdb_stats.bds_class_util[chunk->bdc_class],
+					       chunk->bdc_pg_idx * 100 / bio_chk_sz);
 			chunk->bdc_pg_idx = 0;
 			D_ASSERT(bdb->bdb_used_cnt[chunk->bdc_type] > 0);
 			bdb->bdb_used_cnt[chunk->bdc_type] -= 1;
@@ -361,8 +466,14 @@ iod_release_buffer(struct bio_desc *biod)
 				d_tm_set_gauge(bdb->bdb_stats.bds_chks_used[chunk->bdc_type],
 					       bdb->bdb_used_cnt[chunk->bdc_type]);
 
-			if (chunk == bdb->bdb_cur_chk[chunk->bdc_type])
-				bdb->bdb_cur_chk[chunk->bdc_type] = NULL;
+			D_ASSERT(bdcl->bdcl_used_cnt > 0);
+			bdcl->bdcl_used_cnt--;
+			if (bdb->bdb_stats.bds_class_chks[chunk->bdc_class])
+				d_tm_set_gauge(bdb->bdb_stats.bds_class_chks[chunk->bdc_class],
+					       bdcl->bdcl_used_cnt);
+
+			if (chunk == bdb->bdb_cur_chk[chunk->bdc_type][chunk->bdc_class])
+				bdb->bdb_cur_chk[chunk->bdc_type][chunk->bdc_class] = NULL;
 			d_list_move_tail(&chunk->bdc_link, &bdb->bdb_idle_list);
 		}
 		rsrvd_dma->brd_dma_chks[i] = NULL;
@@ -661,6 +772,7 @@ iod_add_region(struct bio_desc *biod, struct bio_dma_chunk *chk,
 	rsrvd_dma->brd_regions[cnt].brr_off = off;
 	rsrvd_dma->brd_regions[cnt].brr_end = end;
 	rsrvd_dma->brd_regions[cnt].brr_media = media;
+	rsrvd_dma->brd_regions[cnt].brr_cached = 0;
 	rsrvd_dma->brd_rg_cnt++;
 	return 0;
 }
@@ -713,6 +825,10 @@ iod_expand_region(struct bio_iov *biov, struct bio_rsrvd_region *last_rg,
 	    bio_iov2media(biov) != last_rg->brr_media)
 		return false;
 
+	/* Region copied from read cache won't be read from NVMe */
+	if (last_rg->brr_cached)
+		return false;
+
 	/* Not consecutive with prev rg */
 	if (cur_pg != prev_pg_end)
 		return false;
@@ -772,6 +888,53 @@ iod_pad_region(struct bio_iov *biov, struct bio_rsrvd_region *last_rg, unsigned
 	return true;
 }
 
+static inline void
+dma_class_get_chunk(struct bio_dma_buffer *bdb, unsigned int dma_class)
+{
+	struct bio_dma_class *bdcl = &bdb->bdb_class[dma_class];
+
+	bdcl->bdcl_used_cnt++;
+	if (bdcl->bdcl_used_cnt > bdcl->bdcl_peak_cnt)
+		bdcl->bdcl_peak_cnt = bdcl->bdcl_used_cnt;
+	if (bdb->bdb_stats.bds_class_chks[dma_class])
+		d_tm_set_gauge(bdb->bdb_stats.bds_class_chks[dma_class], bdcl->bdcl_used_cnt);
+}
+
+/* Classify the IOD by the total pages to be reserved from DMA buffer */
+static void
+iod_set_dma_class(struct bio_desc *biod, struct bio_dma_buffer *bdb)
+{
+	uint64_t	off, end;
+	unsigned int	pg_cnt, pg_off, tot_pgs = 0;
+	int		i, j;
+
+	for (i = 0; i < biod->bd_sgl_cnt; i++) {
+		struct bio_sglist *bsgl = &biod->bd_sgls[i];
+
+		for (j = 0; j < bsgl->bs_nr_out; j++) {
+			struct bio_iov *biov = &bsgl->bs_iovs[j];
+
+			if (bio_iov2raw_len(biov) == 0 || bio_addr_is_hole(&biov->bi_addr))
+				continue;
+			if (direct_scm_access(biod, biov))
+				continue;
+
+			dma_biov2pg(biov, &off, &end, &pg_cnt, &pg_off);
+			tot_pgs += pg_cnt;
+		}
+	}
+
+	biod->bd_dma_class = (tot_pgs > bio_dma_small_pgs) ? BIO_DMA_CLASS_LARGE :
+							     BIO_DMA_CLASS_SMALL;
+	if (bdb == NULL || tot_pgs == 0)
+		return;
+
+	bdb->bdb_class[biod->bd_dma_class].bdcl_iods++;
+	if (bdb->bdb_stats.bds_iod_size)
+		d_tm_set_gauge(bdb->bdb_stats.bds_iod_size,
+			       ((uint64_t)tot_pgs << BIO_DMA_PAGE_SHIFT) >> 10);
+}
+
 /* Convert offset of @biov into memory pointer */
 int
 dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
@@ -781,6 +944,7 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	struct bio_dma_chunk *chk = NULL, *cur_chk;
 	uint64_t off, end;
 	unsigned int pg_cnt, pg_off, chk_pg_idx, chk_off = 0;
+	bool cached;
 	int rc;
 
 	D_ASSERT(arg == NULL);
@@ -804,6 +968,9 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	bdb = iod_dma_buf(biod);
 	dma_biov2pg(biov, &off, &end, &pg_cnt, &pg_off);
 
+	/* Small NVMe extent being fetched could be served by the read cache */
+	cached = bio_iov2media(biov) == DAOS_MEDIA_NVME && bio_rcache_lookup(biod, biov);
+
 	/*
 	 * For huge IOV, we'll bypass our per-xstream DMA buffer cache and
 	 * allocate chunk from the SPDK reserved huge pages directly, this
@@ -813,11 +980,12 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	 * be high contention over the SPDK huge page cache.
 	 */
 	if (pg_cnt > bio_chk_sz) {
-		chk = dma_alloc_chunk(pg_cnt);
+		chk = dma_alloc_chunk(pg_cnt, bdb->bdb_numa_node);
 		if (chk == NULL)
 			return -DER_NOMEM;
 
 		chk->bdc_type = biod->bd_chk_type;
+		chk->bdc_class = biod->bd_dma_class;
 		rc = iod_add_chunk(biod, chk);
 		if (rc) {
 			dma_free_chunk(chk);
@@ -843,8 +1011,11 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 		chk = last_rg->brr_chk;
 		D_ASSERT(biod->bd_chk_type == chk->bdc_type);
 
-		/* Expand the last NVMe region when it's contiguous with current NVMe region. */
-		if (iod_expand_region(biov, last_rg, off, end, pg_cnt, pg_off))
+		/*
+		 * Expand the last NVMe region when it's contiguous with current NVMe region,
+		 * extent hit the read cache needs its own region.
+		 */
+		if (!cached && iod_expand_region(biov, last_rg, off, end, pg_cnt, pg_off))
 			return 0;
 
 		/*
@@ -874,8 +1045,12 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	 * Try to reserve the DMA buffer from the 'current chunk' of the
 	 * per-xstream DMA buffer. It could be different with the last chunk
 	 * in io descriptor, because dma_map_one() may yield in the future.
+	 *
+	 * Each size class has its own 'current chunk', small I/Os are packed
+	 * together and won't leave unusable tail pages in the chunks of large
+	 * I/Os.
 	 */
-	cur_chk = bdb->bdb_cur_chk[biod->bd_chk_type];
+	cur_chk = bdb->bdb_cur_chk[biod->bd_chk_type][biod->bd_dma_class];
 	if (cur_chk != NULL && cur_chk != chk) {
 		chk = cur_chk;
 		chk_pg_idx = chk->bdc_pg_idx;
@@ -904,11 +1079,13 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 
 	D_ASSERT(chk != NULL);
 	chk->bdc_type = biod->bd_chk_type;
-	bdb->bdb_cur_chk[chk->bdc_type] = chk;
+	chk->bdc_class = biod->bd_dma_class;
+	bdb->bdb_cur_chk[chk->bdc_type][chk->bdc_class] = chk;
 	bdb->bdb_used_cnt[chk->bdc_type] += 1;
 	if (bdb->bdb_stats.bds_chks_used[chk->bdc_type])
 		d_tm_set_gauge(bdb->bdb_stats.bds_chks_used[chk->bdc_type],
 			       bdb->bdb_used_cnt[chk->bdc_type]);
+	dma_class_get_chunk(bdb, chk->bdc_class);
 	chk_pg_idx = chk->bdc_pg_idx;
 
 	D_ASSERT(chk_pg_idx == 0);
@@ -931,14 +1108,18 @@ add_chunk:
 		return rc;
 	}
 add_region:
-	return iod_add_region(biod, chk, chk_pg_idx, chk_off, off, end,
-			      bio_iov2media(biov));
+	rc = iod_add_region(biod, chk, chk_pg_idx, chk_off, off, end,
+			    bio_iov2media(biov));
+	if (rc == 0 && cached)
+		bio_rcache_copy(biod, iod_last_region(biod));
+	return rc;
 }
 
 static void
 rw_completion(void *cb_arg, int err)
 {
 	struct bio_xs_context	*xs_ctxt;
+	struct bio_dev_health	*bdh;
 	struct bio_desc		*biod = cb_arg;
 	struct media_error_msg	*mem = NULL;
 
@@ -950,6 +1131,10 @@ rw_completion(void *cb_arg, int err)
 	xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
 	D_ASSERT(xs_ctxt->bxc_blob_rw > 0);
 	xs_ctxt->bxc_blob_rw--;
+	if (xs_ctxt->bxc_blobstore != NULL) {
+		bdh = &xs_ctxt->bxc_blobstore->bb_dev_health;
+		atomic_fetch_sub_relaxed(&bdh->bdh_io_cmds[biod->bd_type], 1);
+	}
 
 	/* Induce NVMe Read/Write Error*/
 	if (biod->bd_type == BIO_IOD_TYPE_UPDATE)
@@ -1009,6 +1194,57 @@ bio_memcpy(struct bio_desc *biod, uint16_t media, void *media_addr,
 	}
 }
 
+/* Completion of the NVMe command sampled for latency */
+static void
+rw_completion_sampled(void *cb_arg, int err)
+{
+	struct bio_desc		*biod = cb_arg;
+	struct bio_xs_context	*xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	struct bio_dev_health	*bdh;
+	uint64_t		 lat;
+
+	D_ASSERT(biod->bd_lat_start != 0);
+	if (xs_ctxt->bxc_blobstore != NULL) {
+		bdh = &xs_ctxt->bxc_blobstore->bb_dev_health;
+		lat = (spdk_get_ticks() - biod->bd_lat_start) * 1000000 / spdk_get_ticks_hz();
+
+		if (xs_ctxt->bxc_io_lat[biod->bd_type])
+			d_tm_set_gauge(xs_ctxt->bxc_io_lat[biod->bd_type], lat);
+		if (xs_ctxt->bxc_io_inflight[biod->bd_type])
+			d_tm_set_gauge(xs_ctxt->bxc_io_inflight[biod->bd_type],
+				       atomic_load_relaxed(&bdh->bdh_io_cmds[biod->bd_type]));
+	}
+	biod->bd_lat_start = 0;
+
+	rw_completion(cb_arg, err);
+}
+
+/*
+ * Account a NVMe command about to be submitted, return the completion callback.
+ * One of every 'bio_io_lat_sample' commands is timestamped for the per-device
+ * latency histogram, at most one sampled command in-flight per IOD.
+ */
+static inline spdk_blob_op_complete
+nvme_rw_prep(struct bio_desc *biod)
+{
+	struct bio_xs_context	*xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	struct bio_blobstore	*bbs = xs_ctxt->bxc_blobstore;
+
+	biod->bd_inflights++;
+	xs_ctxt->bxc_blob_rw++;
+	if (bbs == NULL)
+		return rw_completion;
+
+	atomic_fetch_add_relaxed(&bbs->bb_dev_health.bdh_io_cmds[biod->bd_type], 1);
+
+	if (bio_io_lat_sample == 0 || biod->bd_lat_start != 0 ||
+	    (++xs_ctxt->bxc_rw_cnt % bio_io_lat_sample) != 0)
+		return rw_completion;
+
+	biod->bd_lat_start = spdk_get_ticks();
+	return rw_completion_sampled;
+}
+
 static void
 scm_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 {
@@ -1034,6 +1270,7 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 	struct spdk_io_channel	*channel;
 	struct spdk_blob	*blob;
 	struct bio_xs_context	*xs_ctxt;
+	spdk_blob_op_complete	 cb_fn;
 	uint64_t		 pg_idx, pg_cnt, rw_cnt;
 	void			*payload;
 
@@ -1061,15 +1298,19 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 	D_ASSERT(pg_cnt > pg_idx);
 	pg_cnt -= pg_idx;
 
+	if (xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_extents)
+		d_tm_inc_counter(xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_extents, 1);
+
 	while (pg_cnt > 0) {
 		/* NVMe poll needs be scheduled */
 		if (bio_need_nvme_poll(xs_ctxt))
 			bio_yield();
 
-		biod->bd_inflights++;
-		xs_ctxt->bxc_blob_rw++;
+		cb_fn = nvme_rw_prep(biod);
 
 		rw_cnt = (pg_cnt > bio_chk_sz) ? bio_chk_sz : pg_cnt;
+		if (xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_cmds)
+			d_tm_inc_counter(xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_cmds, 1);
 
 		D_DEBUG(DB_IO, "%s blob:%p payload:%p, pg_idx:"DF_U64", pg_cnt:"DF_U64"/"DF_U64"\n",
 			biod->bd_type == BIO_IOD_TYPE_UPDATE ? "Write" : "Read",
@@ -1080,12 +1321,12 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 			spdk_blob_io_write(blob, channel, payload,
 					   page2io_unit(biod->bd_ctxt, pg_idx, BIO_DMA_PAGE_SZ),
 					   page2io_unit(biod->bd_ctxt, rw_cnt, BIO_DMA_PAGE_SZ),
-					   rw_completion, biod);
+					   cb_fn, biod);
 		else
 			spdk_blob_io_read(blob, channel, payload,
 					  page2io_unit(biod->bd_ctxt, pg_idx, BIO_DMA_PAGE_SZ),
 					  page2io_unit(biod->bd_ctxt, rw_cnt, BIO_DMA_PAGE_SZ),
-					  rw_completion, biod);
+					  cb_fn, biod);
 
 		pg_cnt -= rw_cnt;
 		pg_idx += rw_cnt;
@@ -1093,12 +1334,345 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 	}
 }
 
+/* Max IOVs in a coalesced NVMe command */
+#define BIO_NVME_CMD_IOV_MAX	32
+
+/* NVMe command coalesced from multiple physically adjacent regions */
+struct bio_nvme_cmd {
+	struct iovec	bnc_iovs[BIO_NVME_CMD_IOV_MAX];
+	/* Start page and page count on the blob */
+	uint64_t	bnc_pg_idx;
+	uint64_t	bnc_pg_cnt;
+	unsigned int	bnc_iov_cnt;
+};
+
 static void
-dma_rw(struct bio_desc *biod)
+nvme_cmd_submit(struct bio_desc *biod, struct bio_nvme_cmd *cmd)
 {
-	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_xs_context	*xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	struct spdk_blob	*blob = biod->bd_ctxt->bic_blob;
+	struct spdk_io_channel	*channel = xs_ctxt->bxc_io_channel;
+	spdk_blob_op_complete	 cb_fn;
+	uint64_t		 off, len;
+
+	D_ASSERT(cmd->bnc_iov_cnt > 0 && cmd->bnc_pg_cnt > 0);
+	/* NVMe poll needs be scheduled */
+	if (bio_need_nvme_poll(xs_ctxt))
+		bio_yield();
+
+	cb_fn = nvme_rw_prep(biod);
+	if (xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_cmds)
+		d_tm_inc_counter(xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_cmds, 1);
+
+	off = page2io_unit(biod->bd_ctxt, cmd->bnc_pg_idx, BIO_DMA_PAGE_SZ);
+	len = page2io_unit(biod->bd_ctxt, cmd->bnc_pg_cnt, BIO_DMA_PAGE_SZ);
+
+	D_DEBUG(DB_IO, "%s blob:%p iovs:%u, pg_idx:"DF_U64", pg_cnt:"DF_U64"\n",
+		biod->bd_type == BIO_IOD_TYPE_UPDATE ? "Write" : "Read",
+		blob, cmd->bnc_iov_cnt, cmd->bnc_pg_idx, cmd->bnc_pg_cnt);
+
+	if (cmd->bnc_iov_cnt == 1) {
+		if (biod->bd_type == BIO_IOD_TYPE_UPDATE)
+			spdk_blob_io_write(blob, channel, cmd->bnc_iovs[0].iov_base, off, len,
+					   cb_fn, biod);
+		else
+			spdk_blob_io_read(blob, channel, cmd->bnc_iovs[0].iov_base, off, len,
+					  cb_fn, biod);
+	} else {
+		if (biod->bd_type == BIO_IOD_TYPE_UPDATE)
+			spdk_blob_io_writev(blob, channel, cmd->bnc_iovs, cmd->bnc_iov_cnt,
+					    off, len, cb_fn, biod);
+		else
+			spdk_blob_io_readv(blob, channel, cmd->bnc_iovs, cmd->bnc_iov_cnt,
+					   off, len, cb_fn, biod);
+	}
+}
+
+static inline void
+nvme_cmd_add_iov(struct bio_nvme_cmd *cmd, void *buf, uint64_t pg_cnt)
+{
+	struct iovec	*last;
+
+	cmd->bnc_pg_cnt += pg_cnt;
+	if (cmd->bnc_iov_cnt != 0) {
+		last = &cmd->bnc_iovs[cmd->bnc_iov_cnt - 1];
+		/* Merge with the last IOV when the DMA buffers are contiguous */
+		if (last->iov_base + last->iov_len == buf) {
+			last->iov_len += pg_cnt << BIO_DMA_PAGE_SHIFT;
+			return;
+		}
+	}
+
+	D_ASSERT(cmd->bnc_iov_cnt < BIO_NVME_CMD_IOV_MAX);
+	cmd->bnc_iovs[cmd->bnc_iov_cnt].iov_base = buf;
+	cmd->bnc_iovs[cmd->bnc_iov_cnt].iov_len = pg_cnt << BIO_DMA_PAGE_SHIFT;
+	cmd->bnc_iov_cnt++;
+}
+
+static int
+rg_off_cmp(const void *a, const void *b)
+{
+	const struct bio_rsrvd_region	*rg_a = *(const struct bio_rsrvd_region **)a;
+	const struct bio_rsrvd_region	*rg_b = *(const struct bio_rsrvd_region **)b;
+
+	if (rg_a->brr_off < rg_b->brr_off)
+		return -1;
+	return (rg_a->brr_off > rg_b->brr_off) ? 1 : 0;
+}
+
+/*
+ * Coalesce the NVMe regions from all the SG lists of the IOD into as few blob
+ * read/write commands as possible: regions physically adjacent on the blob are
+ * merged into single vectored command, for read, small holes between regions
+ * (no more than bio_nvme_gap_pgs) are read through into a scratch buffer.
+ *
+ * Returns the command array which must be freed by caller after all the
+ * commands are completed.
+ */
+static struct bio_nvme_cmd *
+nvme_rw_coalesce(struct bio_desc *biod, struct bio_rsrvd_region **rgs, unsigned int rg_cnt)
+{
+	struct bio_dma_buffer	*bdb = iod_dma_buf(biod);
+	struct bio_nvme_cmd	*cmds, *cmd = NULL;
 	struct bio_rsrvd_region	*rg;
+	uint64_t		 pg_idx, pg_cnt, cmd_end, gap, max_gap;
+	unsigned int		 cmd_cnt = 0, iov_cnt;
+	void			*payload;
+	int			 i;
+
+	/* Bypass NVMe I/O, used by daos_perf for performance evaluation */
+	if (daos_io_bypass & IOBP_NVME)
+		return NULL;
+
+	if (!is_blob_valid(biod->bd_ctxt)) {
+		D_ERROR("Blobstore is invalid. blob:%p, closing:%d\n",
+			biod->bd_ctxt->bic_blob, biod->bd_ctxt->bic_closing);
+		biod->bd_result = -DER_NO_HDL;
+		return NULL;
+	}
+
+	D_ALLOC_ARRAY(cmds, rg_cnt);
+	if (cmds == NULL) {
+		/* Fallback to one command per region */
+		for (i = 0; i < rg_cnt; i++)
+			nvme_rw(biod, rgs[i]);
+		return NULL;
+	}
+
+	/* Never write through holes */
+	max_gap = 0;
+	if (biod->bd_type == BIO_IOD_TYPE_FETCH && bdb->bdb_gap_chk != NULL)
+		max_gap = bio_nvme_gap_pgs;
+
+	qsort(rgs, rg_cnt, sizeof(*rgs), rg_off_cmp);
+
+	for (i = 0; i < rg_cnt; i++) {
+		rg = rgs[i];
+		D_ASSERT(rg->brr_chk_off == 0);
+		payload = rg->brr_chk->bdc_ptr + (rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT);
+		pg_idx = rg->brr_off >> BIO_DMA_PAGE_SHIFT;
+		pg_cnt = ((rg->brr_end + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT) - pg_idx;
+		D_ASSERT(pg_cnt > 0);
+
+		/* Huge region, it'll be split into multiple commands anyway */
+		if (pg_cnt >= bio_chk_sz) {
+			nvme_rw(biod, rg);
+			continue;
+		}
+
+		if (bdb->bdb_stats.bds_nvme_extents)
+			d_tm_inc_counter(bdb->bdb_stats.bds_nvme_extents, 1);
+
+		if (cmd != NULL) {
+			cmd_end = cmd->bnc_pg_idx + cmd->bnc_pg_cnt;
+			gap = (pg_idx >= cmd_end) ? pg_idx - cmd_end : UINT64_MAX;
+			iov_cnt = cmd->bnc_iov_cnt + ((gap != 0) ? 2 : 1);
+
+			if (gap > max_gap || iov_cnt > BIO_NVME_CMD_IOV_MAX ||
+			    (cmd->bnc_pg_cnt + gap + pg_cnt) > bio_chk_sz) {
+				nvme_cmd_submit(biod, cmd);
+				cmd = NULL;
+			} else if (gap != 0) {
+				nvme_cmd_add_iov(cmd, bdb->bdb_gap_chk->bdc_ptr, gap);
+			}
+		}
+
+		if (cmd == NULL) {
+			D_ASSERT(cmd_cnt < rg_cnt);
+			cmd = &cmds[cmd_cnt++];
+			cmd->bnc_pg_idx = pg_idx;
+		}
+		nvme_cmd_add_iov(cmd, payload, pg_cnt);
+	}
+
+	if (cmd != NULL)
+		nvme_cmd_submit(biod, cmd);
+
+	/* The IOVs must be kept intact until all the commands are completed */
+	return cmds;
+}
+
+/* Small NVMe write staged in the write combining batch */
+struct bio_wc_ent {
+	struct bio_desc		*bwe_biod;
+	spdk_blob_op_complete	 bwe_cb_fn;
+};
+
+/*
+ * Per-xstream write combining batch, small NVMe writes (from different IODs)
+ * landing on sequential blob pages are appended to the batch and submitted
+ * as one vectored write on next NVMe poll.
+ */
+struct bio_wc_batch {
+	struct bio_nvme_cmd	 bwb_cmd;
+	struct bio_io_context	*bwb_ctxt;
+	struct bio_wc_ent	 bwb_ents[BIO_NVME_CMD_IOV_MAX];
+	unsigned int		 bwb_ent_cnt;
+};
+
+static void
+wc_completion(void *cb_arg, int err)
+{
+	struct bio_wc_batch	*batch = cb_arg;
+	struct bio_wc_ent	*ent;
+	int			 i;
+
+	/* Induce NVMe write error, it fails all the writes in the batch */
+	err = DAOS_FAIL_CHECK(DAOS_NVME_WRITE_ERR) ? -EIO : err;
+
+	for (i = 0; i < batch->bwb_ent_cnt; i++) {
+		ent = &batch->bwb_ents[i];
+		ent->bwe_cb_fn(ent->bwe_biod, err);
+	}
+	D_FREE(batch);
+}
+
+void
+bio_wc_flush(struct bio_xs_context *xs_ctxt)
+{
+	struct bio_wc_batch	*batch = xs_ctxt->bxc_wc_batch;
+	struct bio_nvme_cmd	*cmd;
+	struct bio_io_context	*ctxt;
+	int			 i;
+
+	if (batch == NULL)
+		return;
+
+	xs_ctxt->bxc_wc_batch = NULL;
+	cmd = &batch->bwb_cmd;
+	ctxt = batch->bwb_ctxt;
+	D_ASSERT(batch->bwb_ent_cnt > 0 && cmd->bnc_iov_cnt > 0);
+
+	if (xs_ctxt->bxc_dma_buf->bdb_stats.bds_wc_batch)
+		d_tm_set_gauge(xs_ctxt->bxc_dma_buf->bdb_stats.bds_wc_batch, batch->bwb_ent_cnt);
+
+	if (!is_blob_valid(ctxt)) {
+		D_ERROR("Blobstore is invalid. blob:%p, closing:%d\n",
+			ctxt->bic_blob, ctxt->bic_closing);
+		for (i = 0; i < batch->bwb_ent_cnt; i++) {
+			if (batch->bwb_ents[i].bwe_biod->bd_result == 0)
+				batch->bwb_ents[i].bwe_biod->bd_result = -DER_NO_HDL;
+		}
+		wc_completion(batch, 0);
+		return;
+	}
+
+	xs_ctxt->bxc_wc_cmds++;
+	if (xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_cmds)
+		d_tm_inc_counter(xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_cmds, 1);
+
+	D_DEBUG(DB_IO, "Combined write blob:%p writes:%u iovs:%u, pg_idx:"DF_U64", pg_cnt:"
+		DF_U64"\n", ctxt->bic_blob, batch->bwb_ent_cnt, cmd->bnc_iov_cnt,
+		cmd->bnc_pg_idx, cmd->bnc_pg_cnt);
+
+	spdk_blob_io_writev(ctxt->bic_blob, xs_ctxt->bxc_io_channel, cmd->bnc_iovs,
+			    cmd->bnc_iov_cnt, page2io_unit(ctxt, cmd->bnc_pg_idx, BIO_DMA_PAGE_SZ),
+			    page2io_unit(ctxt, cmd->bnc_pg_cnt, BIO_DMA_PAGE_SZ), wc_completion,
+			    batch);
+}
+
+void
+bio_wc_query(struct bio_xs_context *xs, uint64_t *writes, uint64_t *cmds)
+{
+	*writes = xs->bxc_wc_writes;
+	*cmds = xs->bxc_wc_cmds;
+}
+
+unsigned int
+bio_wc_set(unsigned int pgs)
+{
+	unsigned int	old_pgs = bio_wc_pgs;
+
+	bio_wc_pgs = min(pgs, bio_chk_sz);
+	if (bio_wc_io_pgs == 0 || bio_wc_io_pgs > bio_wc_pgs)
+		bio_wc_io_pgs = min(BIO_WC_IO_PGS, bio_wc_pgs);
+	return old_pgs;
+}
+
+/*
+ * Stage a small NVMe write region in the write combining batch, the batch is
+ * flushed first when the region isn't sequential to it. Returns false if the
+ * region should be written by itself.
+ */
+static bool
+nvme_wc_stage(struct bio_desc *biod, struct bio_rsrvd_region *rg)
+{
+	struct bio_xs_context	*xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	struct bio_wc_batch	*batch = xs_ctxt->bxc_wc_batch;
+	struct bio_wc_ent	*ent;
+	uint64_t		 pg_idx, pg_cnt;
+
+	if (bio_wc_pgs == 0 || biod->bd_type != BIO_IOD_TYPE_UPDATE ||
+	    (daos_io_bypass & IOBP_NVME) || !is_blob_valid(biod->bd_ctxt))
+		return false;
+
+	D_ASSERT(rg->brr_chk_off == 0);
+	pg_idx = rg->brr_off >> BIO_DMA_PAGE_SHIFT;
+	pg_cnt = ((rg->brr_end + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT) - pg_idx;
+	if (pg_cnt > bio_wc_io_pgs)
+		return false;
+
+	if (batch != NULL && (batch->bwb_ctxt != biod->bd_ctxt ||
+			      batch->bwb_ent_cnt == BIO_NVME_CMD_IOV_MAX ||
+			      batch->bwb_cmd.bnc_pg_idx + batch->bwb_cmd.bnc_pg_cnt != pg_idx ||
+			      batch->bwb_cmd.bnc_pg_cnt + pg_cnt > bio_wc_pgs)) {
+		bio_wc_flush(xs_ctxt);
+		batch = NULL;
+	}
+
+	if (batch == NULL) {
+		D_ALLOC_PTR(batch);
+		if (batch == NULL)
+			return false;
+		batch->bwb_ctxt = biod->bd_ctxt;
+		batch->bwb_cmd.bnc_pg_idx = pg_idx;
+		xs_ctxt->bxc_wc_batch = batch;
+	}
+
+	ent = &batch->bwb_ents[batch->bwb_ent_cnt];
+	ent->bwe_biod = biod;
+	ent->bwe_cb_fn = nvme_rw_prep(biod);
+	batch->bwb_ent_cnt++;
+	nvme_cmd_add_iov(&batch->bwb_cmd,
+			 rg->brr_chk->bdc_ptr + (rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT), pg_cnt);
+	xs_ctxt->bxc_wc_writes++;
+
+	if (xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_extents)
+		d_tm_inc_counter(xs_ctxt->bxc_dma_buf->bdb_stats.bds_nvme_extents, 1);
+	if (xs_ctxt->bxc_dma_buf->bdb_stats.bds_wc_writes)
+		d_tm_inc_counter(xs_ctxt->bxc_dma_buf->bdb_stats.bds_wc_writes, 1);
+
+	return true;
+}
+
+/* Issue the DMA transfer, dma_rw_wait() must be called to wait for completion */
+static void
+dma_rw_submit(struct bio_desc *biod)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_rsrvd_region	*rg, **nvme_rgs = NULL;
 	struct bio_xs_context	*xs_ctxt;
+	unsigned int		 nvme_cnt = 0;
 	int			 i;
 
 	D_ASSERT(biod->bd_ctxt->bic_xs_ctxt);
@@ -1112,6 +1686,23 @@ dma_rw(struct bio_desc *biod)
 	D_ASSERT(biod->bd_type < BIO_IOD_TYPE_GETBUF);
 	D_DEBUG(DB_IO, "DMA start, type:%d\n", biod->bd_type);
 
+	/* Wait for dispatch by the I/O scheduler if any NVMe I/O is involved */
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
+		rg = &rsrvd_dma->brd_regions[i];
+		if (rg->brr_media != DAOS_MEDIA_SCM && !rg->brr_cached) {
+			bio_sched_admit(biod);
+			break;
+		}
+	}
+
+	/* Invalidate the overwritten cached pages before NVMe write */
+	bio_rcache_inval_iod(biod);
+	bio_rcache_fill_start(biod);
+
+	/* Collect the NVMe regions for coalescing when there are more than one */
+	if (rsrvd_dma->brd_rg_cnt > 1)
+		D_ALLOC_ARRAY(nvme_rgs, rsrvd_dma->brd_rg_cnt);
+
 	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
 		rg = &rsrvd_dma->brd_regions[i];
 
@@ -1120,23 +1711,121 @@ dma_rw(struct bio_desc *biod)
 
 		if (rg->brr_media == DAOS_MEDIA_SCM)
 			scm_rw(biod, rg);
+		else if (rg->brr_cached || nvme_wc_stage(biod, rg))
+			continue;
+		else if (nvme_rgs != NULL)
+			nvme_rgs[nvme_cnt++] = rg;
 		else
 			nvme_rw(biod, rg);
 	}
 
+	if (nvme_cnt == 1)
+		nvme_rw(biod, nvme_rgs[0]);
+	else if (nvme_cnt > 1)
+		biod->bd_dma_cmds = nvme_rw_coalesce(biod, nvme_rgs, nvme_cnt);
+	biod->bd_dma_rgs = nvme_rgs;
+
+	if (xs_ctxt->bxc_self_polling)
+		/* No concurrent IODs to be combined with */
+		bio_wc_flush(xs_ctxt);
+	else
+		biod->bd_dma_issued = 1;
+}
+
+static void
+dma_rw_wait(struct bio_desc *biod)
+{
+	struct bio_xs_context	*xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+
 	if (xs_ctxt->bxc_self_polling) {
 		D_DEBUG(DB_IO, "Self poll completion\n");
 		xs_poll_completion(xs_ctxt, &biod->bd_inflights, 0);
-	} else {
-		biod->bd_dma_issued = 1;
-		if (biod->bd_inflights != 0)
-			ABT_eventual_wait(biod->bd_dma_done, NULL);
+	} else if (biod->bd_inflights != 0) {
+		ABT_eventual_wait(biod->bd_dma_done, NULL);
 	}
 
+	bio_rcache_fill(biod);
+	D_FREE(biod->bd_dma_cmds);
+	D_FREE(biod->bd_dma_rgs);
+	bio_sched_done(biod);
 	biod->bd_ctxt->bic_inflight_dmas--;
 	D_DEBUG(DB_IO, "DMA done, type:%d\n", biod->bd_type);
 }
 
+static void
+dma_rw(struct bio_desc *biod)
+{
+	dma_rw_submit(biod);
+	dma_rw_wait(biod);
+}
+
+/*
+ * Adapt the DMA buffer size to the demand observed in last interval: the peak
+ * used chunks of each size class plus 25% headroom for the classes being used.
+ * Idle chunks beyond the demand are freed (but never below the initial size),
+ * and the buffer is grown ahead of demand when the peak is approaching the
+ * current size, so that chunk allocation won't happen on the I/O path. Bulk
+ * groups are resized by their own demand first, see bulk_cache_adapt().
+ *
+ * It's called by the per-xstream NVMe poll, so the resizing and the bulk
+ * registration are kept off the I/O completion path.
+ */
+void
+dma_buffer_adapt(struct bio_dma_buffer *bdb)
+{
+	struct bio_bulk_cache	*bbc = &bdb->bdb_bulk_cache;
+	struct bio_dma_class	*bdcl;
+	struct bio_dma_chunk	*chk;
+	unsigned int		 want = 0, bulk_chks = 0, idle_cnt;
+	uint64_t		 now;
+	int			 i;
+
+	if (bio_dma_adapt_intvl == 0)
+		return;
+
+	now = daos_gettime_coarse();
+	if ((bdb->bdb_adapt_ts + bio_dma_adapt_intvl) > now)
+		return;
+	bdb->bdb_adapt_ts = now;
+
+	for (i = 0; i < BIO_DMA_CLASS_MAX; i++) {
+		bdcl = &bdb->bdb_class[i];
+
+		if (bdcl->bdcl_iods != 0)
+			want += bdcl->bdcl_peak_cnt + (bdcl->bdcl_peak_cnt + 3) / 4;
+		/* Restart the demand tracking for next interval */
+		bdcl->bdcl_peak_cnt = bdcl->bdcl_used_cnt;
+		bdcl->bdcl_iods = 0;
+	}
+
+	/* Chunks held by bulk cache are managed by bulk groups */
+	bulk_cache_adapt(bdb);
+	for (i = 0; i < bbc->bbc_grp_cnt; i++)
+		bulk_chks += bbc->bbc_grps[i].bbg_chk_cnt;
+	want += bulk_chks;
+
+	want = max(want, bio_chk_cnt_init);
+	want = min(want, bio_chk_cnt_max);
+
+	if (bdb->bdb_tot_cnt > want) {
+		idle_cnt = 0;
+		d_list_for_each_entry(chk, &bdb->bdb_idle_list, bdc_link)
+			idle_cnt++;
+		idle_cnt = min(idle_cnt, bdb->bdb_tot_cnt - want);
+		if (idle_cnt == 0)
+			return;
+
+		D_DEBUG(DB_IO, "Shrink DMA buffer by %u chunks, tot:%u, want:%u\n",
+			idle_cnt, bdb->bdb_tot_cnt, want);
+		dma_buffer_shrink(bdb, idle_cnt);
+	} else if (bdb->bdb_tot_cnt < want) {
+		D_DEBUG(DB_IO, "Grow DMA buffer by %u chunks, tot:%u, want:%u\n",
+			want - bdb->bdb_tot_cnt, bdb->bdb_tot_cnt, want);
+		/* Failure is tolerable, chunk will be allocated on demand */
+		dma_buffer_grow(bdb, want - bdb->bdb_tot_cnt);
+	}
+}
+
 static void
 dma_drop_iod(struct bio_dma_buffer *bdb)
 {
@@ -1243,6 +1932,11 @@ dump_dma_info(struct bio_dma_buffer *bdb)
 	       bio_chk_sz, bdb->bdb_tot_cnt, bio_chk_cnt_max, bdb->bdb_active_iods,
 	       bdb->bdb_queued_iods, bdb->bdb_used_cnt[BIO_CHK_TYPE_IO],
 	       bdb->bdb_used_cnt[BIO_CHK_TYPE_LOCAL], bdb->bdb_used_cnt[BIO_CHK_TYPE_REBUILD]);
+	D_EMIT("numa:%d, small_chk:%u/%u, large_chk:%u/%u\n", bdb->bdb_numa_node,
+	       bdb->bdb_class[BIO_DMA_CLASS_SMALL].bdcl_used_cnt,
+	       bdb->bdb_class[BIO_DMA_CLASS_SMALL].bdcl_peak_cnt,
+	       bdb->bdb_class[BIO_DMA_CLASS_LARGE].bdcl_used_cnt,
+	       bdb->bdb_class[BIO_DMA_CLASS_LARGE].bdcl_peak_cnt);
 
 	/* cached bulk info */
 	for (i = 0; i < bbc->bbc_grp_cnt; i++) {
@@ -1254,8 +1948,9 @@ dump_dma_info(struct bio_dma_buffer *bdb)
 		bulk_grps++;
 		bulk_chunks += bbg->bbg_chk_cnt;
 
-		D_EMIT("bulk_grp %d: bulk_size:%u, chunks:%u\n",
-		       i, bbg->bbg_bulk_pgs, bbg->bbg_chk_cnt);
+		D_EMIT("bulk_grp %d: bulk_size:%u, chunks:%u, inuse:%u, peak:%u, heat:"DF_U64"\n",
+		       i, bbg->bbg_bulk_pgs, bbg->bbg_chk_cnt, bbg->bbg_inuse, bbg->bbg_peak,
+		       bbg->bbg_heat + bbg->bbg_reqs);
 	}
 	D_EMIT("bulk_grps:%d, bulk_chunks:%d\n", bulk_grps, bulk_chunks);
 }
@@ -1264,6 +1959,7 @@ static int
 iod_map_iovs(struct bio_desc *biod, void *arg)
 {
 	struct bio_dma_buffer	*bdb;
+	uint64_t		 wait_start = 0;
 	int			 rc, retry_cnt = 0;
 
 	/* NVMe context isn't allocated */
@@ -1272,6 +1968,15 @@ iod_map_iovs(struct bio_desc *biod, void *arg)
 	else
 		bdb = iod_dma_buf(biod);
 
+	/* Bulk mapping reserves from bulk groups, size class doesn't matter */
+	if (arg == NULL)
+		iod_set_dma_class(biod, bdb);
+
+	/* Don't queue behind other waiters, caller will release buffers and retry */
+	if (biod->bd_no_wait && bdb != NULL &&
+	    (bdb->bdb_queued_iods != 0 || DAOS_FAIL_CHECK(DAOS_NVME_COPY_NOBUF)))
+		return -DER_AGAIN;
+
 	iod_fifo_in(biod, bdb);
 retry:
 	rc = iterate_biov(biod, arg ? bulk_map_one : dma_map_one, arg);
@@ -1291,6 +1996,9 @@ retry:
 		dump_dma_info(bdb);
 
 		biod->bd_retry = 0;
+		if (biod->bd_no_wait)
+			goto out;
+
 		if (!iod_should_retry(biod, bdb)) {
 			D_ERROR("Per-xstream DMA buffer isn't large enough "
 				"to satisfy large IOD %p\n", biod);
@@ -1298,6 +2006,8 @@ retry:
 		}
 
 		retry_cnt++;
+		if (wait_start == 0)
+			wait_start = daos_getutime();
 		D_DEBUG(DB_IO, "IOD %p waits for active IODs. %d\n", biod, retry_cnt);
 
 		iod_fifo_wait(biod, bdb);
@@ -1310,14 +2020,18 @@ retry:
 	biod->bd_buffer_prep = 1;
 	if (retry_cnt && bdb->bdb_stats.bds_grab_retries)
 		d_tm_set_gauge(bdb->bdb_stats.bds_grab_retries, retry_cnt);
+	if (retry_cnt && bdb->bdb_stats.bds_class_wait[biod->bd_dma_class])
+		d_tm_set_gauge(bdb->bdb_stats.bds_class_wait[biod->bd_dma_class],
+			       daos_getutime() - wait_start);
 out:
 	iod_fifo_out(biod, bdb);
 	return rc;
 }
 
-int
-bio_iod_prep(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
-	     unsigned int bulk_perm)
+/* Map DMA buffer for the IOD, the data isn't loaded from media yet */
+static int
+iod_prep_internal(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
+		  unsigned int bulk_perm)
 {
 	struct bio_bulk_args	 bulk_arg;
 	struct bio_dma_buffer	*bdb;
@@ -1330,6 +2044,8 @@ bio_iod_prep(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 	biod->bd_chk_type = type;
 	/* For rebuild pull, the DMA buffer will be used as RDMA client */
 	biod->bd_rdma = (bulk_ctxt != NULL) || (type == BIO_CHK_TYPE_REBUILD);
+	if (type == BIO_CHK_TYPE_REBUILD)
+		biod->bd_io_class = BIO_IO_CLASS_REBUILD;
 
 	if (bulk_ctxt != NULL && !(daos_io_bypass & IOBP_SRV_BULK_CACHE)) {
 		bulk_arg.ba_bulk_ctxt = bulk_ctxt;
@@ -1351,14 +2067,29 @@ bio_iod_prep(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 	if (bdb->bdb_stats.bds_active_iods)
 		d_tm_set_gauge(bdb->bdb_stats.bds_active_iods, bdb->bdb_active_iods);
 
-	if (biod->bd_type < BIO_IOD_TYPE_GETBUF) {
+	/* Eventual could be created by prior prep being reverted */
+	if (biod->bd_type < BIO_IOD_TYPE_GETBUF && biod->bd_dma_done == ABT_EVENTUAL_NULL) {
 		rc = ABT_eventual_create(0, &biod->bd_dma_done);
 		if (rc != ABT_SUCCESS) {
-			rc = -DER_NOMEM;
-			goto failed;
+			iod_release_buffer(biod);
+			dma_drop_iod(bdb);
+			return -DER_NOMEM;
 		}
 	}
 
+	return 0;
+}
+
+int
+bio_iod_prep(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
+	     unsigned int bulk_perm)
+{
+	int	rc;
+
+	rc = iod_prep_internal(biod, type, bulk_ctxt, bulk_perm);
+	if (rc || biod->bd_rsrvd.brd_rg_cnt == 0)
+		return rc;
+
 	/* Load data from media to buffer on read */
 	if (biod->bd_type == BIO_IOD_TYPE_FETCH)
 		dma_rw(biod);
@@ -1367,21 +2098,26 @@ bio_iod_prep(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 
 	if (biod->bd_result) {
 		rc = biod->bd_result;
-		goto failed;
+		iod_release_buffer(biod);
+		dma_drop_iod(iod_dma_buf(biod));
 	}
 
-	return 0;
-failed:
-	iod_release_buffer(biod);
-	dma_drop_iod(bdb);
 	return rc;
 }
 
+/* Release the DMA buffer once the DMA transfer is done */
+static int
+iod_post_done(struct bio_desc *biod)
+{
+	iod_release_buffer(biod);
+	dma_drop_iod(iod_dma_buf(biod));
+
+	return biod->bd_result;
+}
+
 int
 bio_iod_post(struct bio_desc *biod, int err)
 {
-	struct bio_dma_buffer *bdb;
-
 	if (!biod->bd_buffer_prep)
 		return -DER_INVAL;
 
@@ -1397,11 +2133,7 @@ bio_iod_post(struct bio_desc *biod, int err)
 	else
 		biod->bd_result = err;
 
-	iod_release_buffer(biod);
-	bdb = iod_dma_buf(biod);
-	dma_drop_iod(bdb);
-
-	return biod->bd_result;
+	return iod_post_done(biod);
 }
 
 int
@@ -1477,7 +2209,7 @@ iod_dup_sgl(struct bio_desc *biod, struct bio_sglist *bsgl_in)
 
 static int
 bio_rwv(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_in,
-	d_sg_list_t *sgl, bool update)
+	d_sg_list_t *sgl, bool update, unsigned int io_class)
 {
 	struct bio_sglist	*bsgl;
 	struct bio_desc		*biod;
@@ -1488,6 +2220,7 @@ bio_rwv(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_in,
 			update ? BIO_IOD_TYPE_UPDATE : BIO_IOD_TYPE_FETCH);
 	if (biod == NULL)
 		return -DER_NOMEM;
+	bio_iod_set_class(biod, io_class);
 
 	bsgl = iod_dup_sgl(biod, bsgl_in);
 	if (bsgl == NULL) {
@@ -1522,7 +2255,7 @@ bio_readv(struct bio_io_context *ioctxt, struct bio_sglist *bsgl,
 {
 	int	rc;
 
-	rc = bio_rwv(ioctxt, bsgl, sgl, false);
+	rc = bio_rwv(ioctxt, bsgl, sgl, false, BIO_IO_CLASS_FG);
 	if (rc)
 		D_ERROR("Readv to blob:%p failed for xs:%p, rc:%d\n",
 			ioctxt->bic_blob, ioctxt->bic_xs_ctxt, rc);
@@ -1539,7 +2272,7 @@ bio_writev(struct bio_io_context *ioctxt, struct bio_sglist *bsgl,
 {
 	int	rc;
 
-	rc = bio_rwv(ioctxt, bsgl, sgl, true);
+	rc = bio_rwv(ioctxt, bsgl, sgl, true, BIO_IO_CLASS_FG);
 	if (rc)
 		D_ERROR("Writev to blob:%p failed for xs:%p, rc:%d\n",
 			ioctxt->bic_blob, ioctxt->bic_xs_ctxt, rc);
@@ -1552,7 +2285,7 @@ bio_writev(struct bio_io_context *ioctxt, struct bio_sglist *bsgl,
 
 static int
 bio_rw(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
-	bool update)
+	bool update, unsigned int io_class)
 {
 	struct bio_sglist	bsgl;
 	struct bio_iov		biov;
@@ -1567,7 +2300,7 @@ bio_rw(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
 	sgl.sg_nr = 1;
 	sgl.sg_nr_out = 0;
 
-	rc = bio_rwv(ioctxt, &bsgl, &sgl, update);
+	rc = bio_rwv(ioctxt, &bsgl, &sgl, update, io_class);
 	if (rc)
 		D_ERROR("%s to blob:%p failed for xs:%p, rc:%d\n",
 			update ? "Write" : "Read", ioctxt->bic_blob,
@@ -1583,13 +2316,21 @@ bio_rw(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
 int
 bio_read(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov)
 {
-	return bio_rw(ioctxt, addr, iov, false);
+	return bio_rw(ioctxt, addr, iov, false, BIO_IO_CLASS_FG);
+}
+
+int
+bio_read_class(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
+	       unsigned int io_class)
+{
+	D_ASSERT(io_class < BIO_IO_CLASS_MAX);
+	return bio_rw(ioctxt, addr, iov, false, io_class);
 }
 
 int
 bio_write(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov)
 {
-	return bio_rw(ioctxt, addr, iov, true);
+	return bio_rw(ioctxt, addr, iov, true, BIO_IO_CLASS_FG);
 }
 
 struct bio_desc *
@@ -1691,6 +2432,10 @@ alloc_copy_desc(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_src,
 	if (copy_desc->bcd_iod_dst == NULL)
 		goto free;
 
+	/* Copy is used by background services like aggregation */
+	bio_iod_set_class(copy_desc->bcd_iod_src, BIO_IO_CLASS_BG);
+	bio_iod_set_class(copy_desc->bcd_iod_dst, BIO_IO_CLASS_BG);
+
 	bsgl_read = iod_dup_sgl(copy_desc->bcd_iod_src, bsgl_src);
 	if (bsgl_read == NULL)
 		goto free;
@@ -1788,6 +2533,326 @@ bio_copy_get_sgl(struct bio_copy_desc *copy_desc, bool src)
 	return bio_iod_sgl(biod, 0);
 }
 
+/* Position in BIO SGL */
+struct bio_copy_pos {
+	unsigned int		 cp_iov_idx;
+	uint64_t		 cp_iov_off;
+};
+
+/* Segment of the pipelined copy */
+struct bio_copy_seg {
+	struct bio_copy_desc	*cs_desc;
+	/* Source is copied to target, target is being written */
+	bool			 cs_writing;
+};
+
+/*
+ * Large copy is split into segments, and a few segments are in flight at the
+ * same time, so that the read of next segments is overlapped with the write
+ * of prior segments.
+ */
+struct bio_copy_pipe {
+	struct bio_io_context	*cp_ioctxt;
+	struct bio_sglist	*cp_bsgl_src;
+	struct bio_sglist	*cp_bsgl_dst;
+	struct bio_copy_pos	 cp_pos_src;
+	struct bio_copy_pos	 cp_pos_dst;
+	/* FIFO of in-flight segments */
+	struct bio_copy_seg	*cp_segs;
+	unsigned int		 cp_seg_head;
+	unsigned int		 cp_seg_cnt;
+};
+
+static bool
+copy_sgl_len(struct bio_sglist *bsgl, uint64_t *len)
+{
+	struct bio_iov	*biov;
+	int		 i;
+
+	*len = 0;
+	for (i = 0; i < bsgl->bs_nr_out; i++) {
+		biov = &bsgl->bs_iovs[i];
+		/* Extra prefix & suffix for csum can't be split */
+		if (biov->bi_prefix_len != 0 || biov->bi_suffix_len != 0)
+			return false;
+		*len += bio_iov2len(biov);
+	}
+	return true;
+}
+
+static bool
+copy_can_pipeline(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_src,
+		  struct bio_sglist *bsgl_dst, unsigned int copy_size)
+{
+	uint64_t	src_len, dst_len;
+
+	if (bio_copy_depth < 2 || ioctxt->bic_xs_ctxt == NULL)
+		return false;
+
+	if (!copy_sgl_len(bsgl_src, &src_len) || !copy_sgl_len(bsgl_dst, &dst_len))
+		return false;
+
+	/* Let the non-pipelined copy report the size mismatch */
+	if (src_len != dst_len || (copy_size != 0 && copy_size != src_len))
+		return false;
+
+	return src_len > ((uint64_t)bio_copy_seg_pgs << BIO_DMA_PAGE_SHIFT);
+}
+
+/*
+ * Length of the next segment, the segment is split on page boundary on NVMe
+ * target, otherwise, the tail page written by one segment would be partially
+ * overwritten by the next segment.
+ */
+static uint64_t
+copy_seg_len(struct bio_sglist *bsgl_dst, struct bio_copy_pos *pos)
+{
+	struct bio_iov	*biov;
+	uint64_t	 seg_sz = (uint64_t)bio_copy_seg_pgs << BIO_DMA_PAGE_SHIFT;
+	uint64_t	 len = 0, off = pos->cp_iov_off, start, end;
+	int		 i;
+
+	for (i = pos->cp_iov_idx; i < bsgl_dst->bs_nr_out; i++, off = 0) {
+		biov = &bsgl_dst->bs_iovs[i];
+		if (len + bio_iov2len(biov) - off <= seg_sz) {
+			len += bio_iov2len(biov) - off;
+			continue;
+		}
+
+		start = bio_iov2off(biov) + off;
+		end = start + seg_sz - len;
+		if (bio_iov2media(biov) == DAOS_MEDIA_NVME)
+			end &= ~(BIO_DMA_PAGE_SZ - 1);
+		if (end > start)
+			len += end - start;
+		break;
+	}
+	D_ASSERT(len > 0);
+
+	return len;
+}
+
+/* Generate BIO SGL for @len bytes starting from @pos, and move @pos forward */
+static int
+copy_sgl_slice(struct bio_sglist *bsgl, struct bio_copy_pos *pos, uint64_t len,
+	       struct bio_sglist *bsgl_slice)
+{
+	struct bio_copy_pos	 cur = *pos;
+	struct bio_iov		*biov;
+	bio_addr_t		 addr;
+	uint64_t		 left = len, nob;
+	unsigned int		 nr = 0;
+	int			 rc;
+
+	while (left > 0) {
+		D_ASSERT(cur.cp_iov_idx < bsgl->bs_nr_out);
+		biov = &bsgl->bs_iovs[cur.cp_iov_idx];
+		nob = min(left, bio_iov2len(biov) - cur.cp_iov_off);
+		left -= nob;
+		nr++;
+		cur.cp_iov_idx++;
+		cur.cp_iov_off = 0;
+	}
+
+	rc = bio_sgl_init(bsgl_slice, nr);
+	if (rc)
+		return rc;
+
+	for (left = len; left > 0; bsgl_slice->bs_nr_out++) {
+		biov = &bsgl->bs_iovs[pos->cp_iov_idx];
+		nob = min(left, bio_iov2len(biov) - pos->cp_iov_off);
+
+		addr = biov->bi_addr;
+		addr.ba_off += pos->cp_iov_off;
+		bio_iov_set(&bsgl_slice->bs_iovs[bsgl_slice->bs_nr_out], addr, nob);
+
+		left -= nob;
+		pos->cp_iov_off += nob;
+		if (pos->cp_iov_off == bio_iov2len(biov)) {
+			pos->cp_iov_idx++;
+			pos->cp_iov_off = 0;
+		}
+	}
+	D_ASSERT(bsgl_slice->bs_nr_out == nr);
+
+	return 0;
+}
+
+static inline void
+copy_seg_push(struct bio_copy_pipe *pipe, struct bio_copy_desc *copy_desc, bool writing)
+{
+	struct bio_copy_seg	*seg;
+
+	D_ASSERT(pipe->cp_seg_cnt < bio_copy_depth);
+	seg = &pipe->cp_segs[(pipe->cp_seg_head + pipe->cp_seg_cnt) % bio_copy_depth];
+	seg->cs_desc = copy_desc;
+	seg->cs_writing = writing;
+	pipe->cp_seg_cnt++;
+}
+
+/*
+ * Move the oldest in-flight segment to next stage: copy it and start write
+ * once the read is done, or release it once the write is done.
+ */
+static int
+copy_seg_advance(struct bio_copy_pipe *pipe, int err)
+{
+	struct bio_copy_seg	*seg = &pipe->cp_segs[pipe->cp_seg_head];
+	struct bio_copy_desc	*copy_desc = seg->cs_desc;
+	struct bio_desc		*src = copy_desc->bcd_iod_src;
+	struct bio_desc		*dst = copy_desc->bcd_iod_dst;
+	bool			 writing = seg->cs_writing;
+	int			 rc = 0;
+
+	D_ASSERT(pipe->cp_seg_cnt > 0);
+	pipe->cp_seg_head = (pipe->cp_seg_head + 1) % bio_copy_depth;
+	pipe->cp_seg_cnt--;
+
+	if (writing) {
+		dma_rw_wait(dst);
+		rc = iod_post_done(dst);
+		free_copy_desc(copy_desc);
+		return rc;
+	}
+
+	if (src->bd_rsrvd.brd_rg_cnt != 0) {
+		dma_rw_wait(src);
+		rc = src->bd_result;
+	}
+
+	if (rc == 0 && err == 0)
+		rc = bio_copy_run(copy_desc, 0, NULL);
+
+	/* Failed, or target is accessed directly */
+	if (rc != 0 || err != 0 || dst->bd_rsrvd.brd_rg_cnt == 0)
+		return bio_copy_post(copy_desc, err ? err : rc);
+
+	/* Source buffer isn't needed anymore */
+	rc = bio_iod_post(src, 0);
+	D_ASSERT(rc == 0);
+
+	dma_rw_submit(dst);
+	copy_seg_push(pipe, copy_desc, true);
+	return 0;
+}
+
+static int
+copy_seg_map(struct bio_copy_pipe *pipe, struct bio_copy_desc *copy_desc)
+{
+	struct bio_desc	*src = copy_desc->bcd_iod_src;
+	struct bio_desc	*dst = copy_desc->bcd_iod_dst;
+	int		 rc, rc2;
+
+retry:
+	/* Don't wait for DMA buffer while holding buffers of in-flight segments */
+	src->bd_no_wait = dst->bd_no_wait = (pipe->cp_seg_cnt != 0);
+
+	rc = iod_prep_internal(src, BIO_CHK_TYPE_LOCAL, NULL, 0);
+	if (rc == 0) {
+		dst->bd_copy_dst = 1;
+		rc = iod_prep_internal(dst, BIO_CHK_TYPE_LOCAL, NULL, 0);
+		if (rc) {
+			rc2 = bio_iod_post(src, 0);
+			D_ASSERT(rc2 == 0);
+		}
+	}
+
+	if (rc == -DER_AGAIN && pipe->cp_seg_cnt != 0) {
+		rc = copy_seg_advance(pipe, 0);
+		if (rc == 0)
+			goto retry;
+	}
+
+	return rc;
+}
+
+/* Prepare next segment and start reading it */
+static int
+copy_seg_start(struct bio_copy_pipe *pipe)
+{
+	struct bio_copy_desc	*copy_desc;
+	struct bio_sglist	 bsgl_src, bsgl_dst;
+	uint64_t		 len;
+	int			 rc;
+
+	len = copy_seg_len(pipe->cp_bsgl_dst, &pipe->cp_pos_dst);
+
+	rc = copy_sgl_slice(pipe->cp_bsgl_src, &pipe->cp_pos_src, len, &bsgl_src);
+	if (rc)
+		return rc;
+
+	rc = copy_sgl_slice(pipe->cp_bsgl_dst, &pipe->cp_pos_dst, len, &bsgl_dst);
+	if (rc) {
+		bio_sgl_fini(&bsgl_src);
+		return rc;
+	}
+
+	copy_desc = alloc_copy_desc(pipe->cp_ioctxt, &bsgl_src, &bsgl_dst);
+	bio_sgl_fini(&bsgl_src);
+	bio_sgl_fini(&bsgl_dst);
+	if (copy_desc == NULL)
+		return -DER_NOMEM;
+
+	rc = copy_seg_map(pipe, copy_desc);
+	if (rc) {
+		free_copy_desc(copy_desc);
+		return rc;
+	}
+
+	/*
+	 * Complete prior segments when the I/O scheduler is busy, otherwise, the
+	 * dispatch could wait on the segments held by ourself.
+	 */
+	while (pipe->cp_seg_cnt != 0 && bio_sched_busy(copy_desc->bcd_iod_src)) {
+		rc = copy_seg_advance(pipe, 0);
+		if (rc) {
+			bio_copy_post(copy_desc, rc);
+			return rc;
+		}
+	}
+
+	if (copy_desc->bcd_iod_src->bd_rsrvd.brd_rg_cnt != 0)
+		dma_rw_submit(copy_desc->bcd_iod_src);
+	copy_seg_push(pipe, copy_desc, false);
+
+	return 0;
+}
+
+static int
+bio_copy_pipelined(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_src,
+		   struct bio_sglist *bsgl_dst)
+{
+	struct bio_copy_pipe	pipe = { 0 };
+	int			rc = 0, rc2;
+
+	D_ALLOC_ARRAY(pipe.cp_segs, bio_copy_depth);
+	if (pipe.cp_segs == NULL)
+		return -DER_NOMEM;
+
+	pipe.cp_ioctxt = ioctxt;
+	pipe.cp_bsgl_src = bsgl_src;
+	pipe.cp_bsgl_dst = bsgl_dst;
+
+	while (pipe.cp_pos_dst.cp_iov_idx < bsgl_dst->bs_nr_out) {
+		if (pipe.cp_seg_cnt == bio_copy_depth)
+			rc = copy_seg_advance(&pipe, 0);
+		else
+			rc = copy_seg_start(&pipe);
+		if (rc)
+			break;
+	}
+
+	/* Wait for all in-flight segments, skip writes on failure */
+	while (pipe.cp_seg_cnt != 0) {
+		rc2 = copy_seg_advance(&pipe, rc);
+		if (rc == 0)
+			rc = rc2;
+	}
+
+	D_FREE(pipe.cp_segs);
+	return rc;
+}
+
 int
 bio_copy(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_src,
 	 struct bio_sglist *bsgl_dst, unsigned int copy_size,
@@ -1796,6 +2861,9 @@ bio_copy(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_src,
 	struct bio_copy_desc	*copy_desc;
 	int			 rc;
 
+	if (csum_desc == NULL && copy_can_pipeline(ioctxt, bsgl_src, bsgl_dst, copy_size))
+		return bio_copy_pipelined(ioctxt, bsgl_src, bsgl_dst);
+
 	copy_desc = bio_copy_prep(ioctxt, bsgl_src, bsgl_dst);
 	if (copy_desc == NULL)
 		return -DER_NOMEM;
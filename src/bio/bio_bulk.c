@@ -138,6 +138,16 @@ bulk_grp_evict_one(struct bio_dma_buffer *bdb, struct bio_dma_chunk *chk,
 	bulk_chunk_depopulate(chk, fini);
 	bbg->bbg_chk_cnt--;
 	d_list_move_tail(&chk->bdc_link, &bdb->bdb_idle_list);
+
+	if (!fini && bdb->bdb_stats.bds_bulk_evicts)
+		d_tm_inc_counter(bdb->bdb_stats.bds_bulk_evicts, 1);
+}
+
+/* Demand of the group, decayed history plus requests in current interval */
+static inline uint64_t
+bulk_grp_heat(struct bio_bulk_group *bbg)
+{
+	return bbg->bbg_heat + bbg->bbg_reqs;
 }
 
 static inline void
@@ -147,8 +157,12 @@ bulk_grp_reset(struct bio_bulk_group *bbg, unsigned int pg_cnt)
 	D_ASSERT(d_list_empty(&bbg->bbg_dma_chks));
 	D_ASSERT(d_list_empty(&bbg->bbg_idle_bulks));
 	D_ASSERT(bbg->bbg_chk_cnt == 0);
+	D_ASSERT(bbg->bbg_inuse == 0);
 
 	bbg->bbg_bulk_pgs = pg_cnt;
+	bbg->bbg_peak = 0;
+	bbg->bbg_reqs = 0;
+	bbg->bbg_heat = 0;
 }
 
 static void
@@ -169,7 +183,7 @@ static struct bio_bulk_group *
 bulk_grp_add(struct bio_dma_buffer *bdb, unsigned int pgs)
 {
 	struct bio_bulk_cache	*bbc = &bdb->bdb_bulk_cache;
-	struct bio_bulk_group	*bbg;
+	struct bio_bulk_group	*bbg, *victim = NULL;
 	int			 grp_idx, rc;
 
 	/* If there is empty bulk group slot, add new bulk group */
@@ -186,19 +200,26 @@ bulk_grp_add(struct bio_dma_buffer *bdb, unsigned int pgs)
 	}
 
 	D_ASSERT(bbc->bbc_grp_cnt == bbc->bbc_grp_max);
-	/* Try to evict an idle unused group */
+	/*
+	 * Try to evict an idle group, prefer the coldest one so that the bulk
+	 * sizes in steady demand keep their registered handles.
+	 */
 	D_ASSERT(!d_list_empty(&bbc->bbc_grp_lru));
 	d_list_for_each_entry(bbg, &bbc->bbc_grp_lru, bbg_lru_link) {
-		if (bulk_grp_is_idle(bbg)) {
-			/* Replace victim with new bulk group */
-			d_list_del_init(&bbg->bbg_lru_link);
-			bulk_grp_evict(bdb, bbg, false);
-			goto done;
-		}
+		if (!bulk_grp_is_idle(bbg))
+			continue;
+		if (victim == NULL || bulk_grp_heat(bbg) < bulk_grp_heat(victim))
+			victim = bbg;
 	}
 
 	/* Group array is full, and all groups are inuse */
-	return NULL;
+	if (victim == NULL)
+		return NULL;
+
+	/* Replace victim with new bulk group */
+	bbg = victim;
+	d_list_del_init(&bbg->bbg_lru_link);
+	bulk_grp_evict(bdb, bbg, false);
 done:
 	bulk_grp_reset(bbg, pgs);
 	rc = daos_array_sort(bbc->bbc_sorted, bbc->bbc_grp_cnt, true,
@@ -252,23 +273,31 @@ bulk_reclaim_chunk(struct bio_dma_buffer *bdb, struct bio_bulk_group *ex_grp)
 {
 	struct bio_bulk_cache	*bbc = &bdb->bdb_bulk_cache;
 	struct bio_bulk_group	*bbg;
-	struct bio_dma_chunk	*chk;
+	struct bio_dma_chunk	*chk, *victim = NULL;
 
+	/* Reclaim the idle chunk from the coldest group */
 	d_list_for_each_entry(bbg, &bbc->bbc_grp_lru, bbg_lru_link) {
 		if (ex_grp != NULL && ex_grp == bbg)
 			continue;
+		if (victim != NULL &&
+		    bulk_grp_heat(bbg) >= bulk_grp_heat(victim->bdc_bulk_grp))
+			continue;
 
 		d_list_for_each_entry(chk, &bbg->bbg_dma_chks, bdc_link) {
 			if (bulk_chunk_is_idle(chk)) {
-				D_DEBUG(DB_IO, "Reclaim a bulk chunk (%u)\n",
-					bbg->bbg_bulk_pgs);
-				bulk_grp_evict_one(bdb, chk, false);
-				return 0;
+				victim = chk;
+				break;
 			}
 		}
 	}
+
 	/* All bulk chunks are inuse */
-	return -DER_AGAIN;
+	if (victim == NULL)
+		return -DER_AGAIN;
+
+	D_DEBUG(DB_IO, "Reclaim a bulk chunk (%u)\n", victim->bdc_bulk_grp->bbg_bulk_pgs);
+	bulk_grp_evict_one(bdb, victim, false);
+	return 0;
 }
 
 static int
@@ -362,9 +391,11 @@ error:
 
 static int
 bulk_grp_grow(struct bio_dma_buffer *bdb, struct bio_bulk_group *bbg,
-	      struct bio_bulk_args *arg)
+	      struct bio_bulk_args *arg, bool reclaim)
 {
+	struct bio_dma_stats	*stats = &bdb->bdb_stats;
 	struct bio_dma_chunk	*chk;
+	uint64_t		 reg_start;
 	int			 rc;
 
 	/* Try grab an idle chunk first */
@@ -378,6 +409,9 @@ bulk_grp_grow(struct bio_dma_buffer *bdb, struct bio_bulk_group *bbg,
 			goto populate;
 	}
 
+	if (!reclaim)
+		return -DER_AGAIN;
+
 	/* Try to evict an unused chunk from other bulk group */
 	rc = bulk_reclaim_chunk(bdb, bbg);
 	if (rc)
@@ -388,10 +422,16 @@ populate:
 
 	chk = d_list_entry(bdb->bdb_idle_list.next,
 			   struct bio_dma_chunk, bdc_link);
+	reg_start = daos_getutime();
 	rc = bulk_chunk_populate(chk, bbg, arg);
 	if (rc)
 		return rc;
 
+	if (stats->bds_bulk_regs)
+		d_tm_inc_counter(stats->bds_bulk_regs, chk->bdc_bulk_cnt);
+	if (stats->bds_bulk_reg_lat)
+		d_tm_set_gauge(stats->bds_bulk_reg_lat, daos_getutime() - reg_start);
+
 	d_list_move_tail(&chk->bdc_link, &bbg->bbg_dma_chks);
 	bbg->bbg_chk_cnt++;
 
@@ -419,6 +459,8 @@ bulk_hdl_unhold(struct bio_bulk_hdl *hdl)
 
 		bbg = chk->bdc_bulk_grp;
 		D_ASSERT(bbg != NULL);
+		D_ASSERT(bbg->bbg_inuse > 0);
+		bbg->bbg_inuse--;
 		d_list_add_tail(&hdl->bbh_link, &bbg->bbg_idle_bulks);
 	}
 }
@@ -436,6 +478,7 @@ bulk_hdl_hold(struct bio_bulk_hdl *hdl, unsigned int pg_off, unsigned int remote
 	      struct bio_iov *biov)
 {
 	struct bio_dma_chunk	*chk = hdl->bbh_chunk;
+	struct bio_bulk_group	*bbg;
 
 	D_ASSERT(!bulk_hdl_is_inuse(hdl));
 
@@ -449,6 +492,11 @@ bulk_hdl_hold(struct bio_bulk_hdl *hdl, unsigned int pg_off, unsigned int remote
 	D_ASSERT(chk != NULL);
 	D_ASSERT(chk->bdc_bulk_idle > 0);
 	chk->bdc_bulk_idle--;
+
+	bbg = chk->bdc_bulk_grp;
+	D_ASSERT(bbg != NULL);
+	bbg->bbg_inuse++;
+	bbg->bbg_peak = max(bbg->bbg_peak, bbg->bbg_inuse);
 }
 
 static inline unsigned int
@@ -513,11 +561,15 @@ bulk_get_hdl(struct bio_desc *biod, struct bio_iov *biov, unsigned int pg_cnt,
 		biod->bd_retry = 1;
 		return NULL;
 	}
+	bbg->bbg_reqs++;
+	/* Remembered for populating hot groups ahead of demand */
+	bdb->bdb_bulk_cache.bbc_bulk_ctxt = arg->ba_bulk_ctxt;
+	bdb->bdb_bulk_cache.bbc_bulk_perm = arg->ba_bulk_perm;
 
 	if (!d_list_empty(&bbg->bbg_idle_bulks))
 		goto done;
 
-	rc = bulk_grp_grow(bdb, bbg, arg);
+	rc = bulk_grp_grow(bdb, bbg, arg, true);
 	if (rc) {
 		if (rc == -DER_AGAIN)
 			biod->bd_retry = 1;
@@ -666,6 +718,10 @@ bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 		return rc;
 	}
 
+	/* Small NVMe extent being fetched could be served by the read cache */
+	if (bio_iov2media(biov) == DAOS_MEDIA_NVME && bio_rcache_lookup(biod, biov))
+		bio_rcache_copy(biod, &biod->bd_rsrvd.brd_regions[biod->bd_rsrvd.brd_rg_cnt - 1]);
+
 	/* Update the used bytes for shared handle */
 	if (hdl->bbh_shareable) {
 		D_ASSERT(hdl->bbh_bulk_off == 0);
@@ -770,12 +826,71 @@ bulk_cache_create(struct bio_dma_buffer *bdb)
 		D_INIT_LIST_HEAD(&bbg->bbg_lru_link);
 		D_INIT_LIST_HEAD(&bbg->bbg_dma_chks);
 		D_INIT_LIST_HEAD(&bbg->bbg_idle_bulks);
-		bbg->bbg_bulk_pgs = 0;
-		bbg->bbg_chk_cnt = 0;
+		bulk_grp_reset(bbg, 0);
 	}
 	return 0;
 }
 
+/*
+ * Resize the bulk groups by the per bulk size demand observed in last adapt
+ * interval, so that memory registration is moved off the I/O path:
+ *  - Group being used is populated ahead of demand when the peak held bulk
+ *    handles (plus 25% headroom) exceeds the registered handles. It only takes
+ *    idle chunks or grows the DMA buffer, chunks of other groups are never
+ *    reclaimed here.
+ *  - Group not being requested for several intervals releases its idle chunks,
+ *    so that they can be used by the hot groups without reclaiming on demand.
+ */
+void
+bulk_cache_adapt(struct bio_dma_buffer *bdb)
+{
+	struct bio_bulk_cache	*bbc = &bdb->bdb_bulk_cache;
+	struct bio_bulk_group	*bbg;
+	struct bio_dma_chunk	*chk, *tmp;
+	struct bio_bulk_args	 arg;
+	unsigned int		 per_chk, want;
+	int			 i, rc;
+
+	arg.ba_bulk_ctxt = bbc->bbc_bulk_ctxt;
+	arg.ba_bulk_perm = bbc->bbc_bulk_perm;
+	arg.ba_sgl_idx = 0;
+
+	for (i = 0; i < bbc->bbc_grp_cnt; i++) {
+		bbg = &bbc->bbc_grps[i];
+
+		bbg->bbg_heat = bbg->bbg_heat / 2 + bbg->bbg_reqs;
+		if (bbg->bbg_heat == 0) {
+			d_list_for_each_entry_safe(chk, tmp, &bbg->bbg_dma_chks, bdc_link) {
+				if (bulk_chunk_is_idle(chk))
+					bulk_grp_evict_one(bdb, chk, false);
+			}
+			goto next;
+		}
+
+		if (bbg->bbg_reqs == 0 || arg.ba_bulk_ctxt == NULL)
+			goto next;
+
+		per_chk = bio_chk_sz / bbg->bbg_bulk_pgs;
+		want = bbg->bbg_peak + (bbg->bbg_peak + 3) / 4;
+		want = (want + per_chk - 1) / per_chk;
+
+		while (bbg->bbg_chk_cnt < want) {
+			rc = bulk_grp_grow(bdb, bbg, &arg, false);
+			if (rc) {
+				D_DEBUG(DB_IO, "Failed to grow bulk grp (%u pages). "DF_RC"\n",
+					bbg->bbg_bulk_pgs, DP_RC(rc));
+				break;
+			}
+			D_DEBUG(DB_IO, "Grow bulk grp (%u pages) to %u chunks ahead\n",
+				bbg->bbg_bulk_pgs, bbg->bbg_chk_cnt);
+		}
+next:
+		/* Restart the demand tracking for next interval */
+		bbg->bbg_peak = bbg->bbg_inuse;
+		bbg->bbg_reqs = 0;
+	}
+}
+
 void *
 bio_iod_bulk(struct bio_desc *biod, int sgl_idx, int iov_idx,
 	     unsigned int *bulk_off)
@@ -806,3 +806,71 @@ bio_read_accel_props(const char *nvme_conf) {
 	return get_accel_props(nvme_conf);
 }
 
+
+/* Read the NUMA node of a PCI device from sysfs, -1 when unknown */
+static int
+pci_addr_numa_node(struct spdk_pci_addr *addr)
+{
+	char	 bdf[32];
+	char	*path;
+	FILE	*fp;
+	int	 node = -1;
+
+	if (spdk_pci_addr_fmt(bdf, sizeof(bdf), addr) != 0)
+		return -1;
+
+	D_ASPRINTF(path, "/sys/bus/pci/devices/%s/numa_node", bdf);
+	if (path == NULL)
+		return -1;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		D_DEBUG(DB_MGMT, "Unable to open %s: %d\n", path, errno);
+		goto out;
+	}
+	if (fscanf(fp, "%d", &node) != 1)
+		node = -1;
+	fclose(fp);
+out:
+	D_DEBUG(DB_MGMT, "PCI device %s is on NUMA node %d\n", bdf, node);
+	D_FREE(path);
+	return node;
+}
+
+int
+bio_nvme_numa_node(const char *nvme_conf, int numa_nr)
+{
+	struct spdk_env_opts	 opts = { 0 };
+	int			*dev_nr;
+	int			 node = -1;
+	int			 i, rc;
+
+	if (nvme_conf == NULL || numa_nr <= 0)
+		return -1;
+
+	rc = bio_add_allowed_alloc(nvme_conf, &opts);
+	if (rc != 0) {
+		D_ERROR("Failed to read NVMe devices from %s: "DF_RC"\n", nvme_conf, DP_RC(rc));
+		goto out;
+	}
+
+	D_ALLOC_ARRAY(dev_nr, numa_nr);
+	if (dev_nr == NULL)
+		goto out;
+
+	for (i = 0; i < opts.num_pci_addr; i++) {
+		rc = pci_addr_numa_node(&opts.pci_allowed[i]);
+		if (rc >= 0 && rc < numa_nr)
+			dev_nr[rc]++;
+	}
+
+	/* The NUMA node most of the SSDs are attached to, the lowest one on tie */
+	for (i = 0; i < numa_nr; i++) {
+		if (dev_nr[i] > 0 && (node == -1 || dev_nr[i] > dev_nr[node]))
+			node = i;
+	}
+	D_FREE(dev_nr);
+out:
+	D_FREE(opts.pci_allowed);
+	return node;
+}
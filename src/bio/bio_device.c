@@ -886,3 +886,49 @@ free_traddr:
 
 	return rc;
 }
+
+struct socket_opts {
+	struct spdk_pci_addr	pci_addr;
+	int			socket_id;
+};
+
+static void
+get_socket_id(void *ctx, struct spdk_pci_device *pci_device)
+{
+	struct socket_opts *opts = ctx;
+
+	if (spdk_pci_addr_compare(&opts->pci_addr, &pci_device->addr) == 0)
+		opts->socket_id = spdk_pci_device_get_socket_id(pci_device);
+}
+
+/*
+ * Get the NUMA node the NVMe SSD is attached to, -1 will be returned when the
+ * locality can't be determined (non-NVMe bdev, unknown PCI device, etc.)
+ */
+int
+bio_dev_socket_id(char *dev_name)
+{
+	struct bio_dev_info	b_info = { 0 };
+	struct socket_opts	opts = { 0 };
+	int			rc;
+
+	rc = fill_in_traddr(&b_info, dev_name);
+	if (rc || b_info.bdi_traddr == NULL) {
+		D_DEBUG(DB_MGMT, "Unable to get traddr for device:%s\n", dev_name);
+		return -1;
+	}
+
+	opts.socket_id = -1;
+	if (spdk_pci_addr_parse(&opts.pci_addr, b_info.bdi_traddr)) {
+		D_ERROR("Unable to parse PCI address: %s\n", b_info.bdi_traddr);
+		goto free_traddr;
+	}
+
+	spdk_pci_for_each_device(&opts, get_socket_id);
+	D_DEBUG(DB_MGMT, "Device %s (%s) is on NUMA node %d\n", dev_name,
+		b_info.bdi_traddr, opts.socket_id);
+
+free_traddr:
+	D_FREE(b_info.bdi_traddr);
+	return opts.socket_id;
+}
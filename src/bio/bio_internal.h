@@ -9,6 +9,7 @@
 
 #include <daos_srv/daos_engine.h>
 #include <daos_srv/bio.h>
+#include <gurt/atomic.h>
 #include <gurt/telemetry_common.h>
 #include <gurt/telemetry_producer.h>
 #include <spdk/env.h>
@@ -18,6 +19,14 @@
 #define BIO_DMA_PAGE_SHIFT	12	/* 4K */
 #define BIO_DMA_PAGE_SZ		(1UL << BIO_DMA_PAGE_SHIFT)
 #define BIO_XS_CNT_MAX		48	/* Max VOS xstreams per blobstore */
+#define BIO_DMA_SMALL_PGS	16	/* Default small I/O threshold, 64K */
+#define BIO_NVME_GAP_PGS	4	/* Default max hole read through, 16K */
+#define BIO_IO_QD_DEF		64	/* Default inflight IODs per device channel */
+#define BIO_IO_LAT_SAMPLE	16	/* Default latency sampling rate, 1/16 */
+#define BIO_RCACHE_MAX_PGS	4	/* Default max extent cached in DRAM, 16K */
+#define BIO_WC_IO_PGS		16	/* Default max write being combined, 64K */
+#define BIO_COPY_DEPTH		4	/* Default in-flight segments of pipelined copy */
+#define BIO_COPY_SEG_PGS	256	/* Default pipelined copy segment size, 1M */
 /*
  * Period to query raw device health stats, auto detect faulty and transition
  * device state. 60 seconds by default. Once FAULTY state has occurred, reduce
@@ -66,6 +75,14 @@ struct bio_bulk_group {
 	unsigned int		 bbg_bulk_pgs;
 	/* How many chunks used for this group */
 	unsigned int		 bbg_chk_cnt;
+	/* Bulk handles being held by I/O descriptors */
+	unsigned int		 bbg_inuse;
+	/* Peak held bulk handles in current adapt interval */
+	unsigned int		 bbg_peak;
+	/* Requests served in current adapt interval */
+	uint64_t		 bbg_reqs;
+	/* Request count decayed over adapt intervals */
+	uint64_t		 bbg_heat;
 };
 
 /* DMA buffer is managed in chunks */
@@ -80,6 +97,8 @@ struct bio_dma_chunk {
 	unsigned int	 bdc_ref;
 	/* Chunk type */
 	unsigned int	 bdc_type;
+	/* Size class of the I/O descriptors sharing this chunk */
+	unsigned int	 bdc_class;
 	/* == Bulk handle caching related fields == */
 	struct bio_bulk_group	*bdc_bulk_grp;
 	struct bio_bulk_hdl	*bdc_bulks;
@@ -96,16 +115,51 @@ struct bio_bulk_cache {
 	unsigned int		  bbc_grp_cnt;
 	/* All groups in LRU */
 	d_list_t		  bbc_grp_lru;
+	/* Bulk context & permission for populating groups ahead of demand */
+	void			 *bbc_bulk_ctxt;
+	unsigned int		  bbc_bulk_perm;
+};
+
+/*
+ * I/O descriptors are classified by total DMA payload size, each size class
+ * reserves from its own current chunk, so that small I/Os won't fragment the
+ * chunks used by large I/Os and vice versa.
+ */
+enum {
+	BIO_DMA_CLASS_SMALL	= 0,
+	BIO_DMA_CLASS_LARGE,
+	BIO_DMA_CLASS_MAX,
+};
+
+/* Per size class DMA buffer usage, used to adapt the buffer size */
+struct bio_dma_class {
+	/* Chunks being used by this class */
+	unsigned int		 bdcl_used_cnt;
+	/* Peak used chunks in current adapt interval */
+	unsigned int		 bdcl_peak_cnt;
+	/* IODs mapped in current adapt interval */
+	unsigned int		 bdcl_iods;
 };
 
 struct bio_dma_stats {
 	struct d_tm_node_t	*bds_chks_tot;
 	struct d_tm_node_t	*bds_chks_used[BIO_CHK_TYPE_MAX];
+	struct d_tm_node_t	*bds_class_chks[BIO_DMA_CLASS_MAX];
+	struct d_tm_node_t	*bds_class_util[BIO_DMA_CLASS_MAX];
+	struct d_tm_node_t	*bds_class_wait[BIO_DMA_CLASS_MAX];
+	struct d_tm_node_t	*bds_iod_size;
 	struct d_tm_node_t	*bds_bulk_grps;
+	struct d_tm_node_t	*bds_bulk_regs;
+	struct d_tm_node_t	*bds_bulk_reg_lat;
+	struct d_tm_node_t	*bds_bulk_evicts;
 	struct d_tm_node_t	*bds_active_iods;
 	struct d_tm_node_t	*bds_queued_iods;
 	struct d_tm_node_t	*bds_grab_errs;
 	struct d_tm_node_t	*bds_grab_retries;
+	struct d_tm_node_t	*bds_nvme_cmds;
+	struct d_tm_node_t	*bds_nvme_extents;
+	struct d_tm_node_t	*bds_wc_writes;
+	struct d_tm_node_t	*bds_wc_batch;
 };
 
 /*
@@ -115,8 +169,9 @@ struct bio_dma_stats {
 struct bio_dma_buffer {
 	d_list_t		 bdb_idle_list;
 	d_list_t		 bdb_used_list;
-	struct bio_dma_chunk	*bdb_cur_chk[BIO_CHK_TYPE_MAX];
+	struct bio_dma_chunk	*bdb_cur_chk[BIO_CHK_TYPE_MAX][BIO_DMA_CLASS_MAX];
 	unsigned int		 bdb_used_cnt[BIO_CHK_TYPE_MAX];
+	struct bio_dma_class	 bdb_class[BIO_DMA_CLASS_MAX];
 	unsigned int		 bdb_tot_cnt;
 	unsigned int		 bdb_active_iods;
 	unsigned int		 bdb_queued_iods;
@@ -126,6 +181,11 @@ struct bio_dma_buffer {
 	struct bio_bulk_cache	 bdb_bulk_cache;
 	struct bio_dma_stats	 bdb_stats;
 	uint64_t		 bdb_dump_ts;
+	uint64_t		 bdb_adapt_ts;
+	/* NUMA node where the DMA chunks are allocated from */
+	int			 bdb_numa_node;
+	/* DMA buffer for the holes being read through by coalesced NVMe reads */
+	struct bio_dma_chunk	*bdb_gap_chk;
 };
 
 #define BIO_PROTO_NVME_STATS_LIST					\
@@ -274,6 +334,8 @@ struct bio_dev_health {
 	uint64_t		bdh_stat_age;
 	unsigned int		bdh_inflights;
 	uint16_t		bdh_vendor_id; /* PCI vendor ID */
+	/* In-flight NVMe commands from all xstreams, per I/O type */
+	ATOMIC unsigned int	bdh_io_cmds[BIO_IOD_TYPE_GETBUF];
 
 	/**
 	 * NVMe statistics exported via telemetry framework
@@ -357,6 +419,56 @@ struct bio_blobstore {
 				 bb_unloading:1;
 };
 
+struct bio_io_sched_stats {
+	struct d_tm_node_t	*biss_queued;
+	struct d_tm_node_t	*biss_inflight;
+	struct d_tm_node_t	*biss_wait;
+};
+
+/*
+ * Per-xstream NVMe I/O scheduler. IODs issuing NVMe I/O are admitted by
+ * priority class, when the device channel is saturated (or the in-flight
+ * limit of the class is reached), they are queued per class and dispatched
+ * in weighted round robin on IOD completion.
+ */
+struct bio_io_sched {
+	/* Waiting IODs of each class */
+	d_list_t			bis_queue[BIO_IO_CLASS_MAX];
+	unsigned int			bis_queued[BIO_IO_CLASS_MAX];
+	unsigned int			bis_inflight[BIO_IO_CLASS_MAX];
+	/* Dispatch credits left in current round of each class */
+	unsigned int			bis_credits[BIO_IO_CLASS_MAX];
+	unsigned int			bis_inflight_tot;
+	struct bio_io_sched_stats	bis_stats[BIO_IO_CLASS_MAX];
+};
+
+struct bio_rcache_stats {
+	struct d_tm_node_t	*brs_hits;
+	struct d_tm_node_t	*brs_misses;
+	struct d_tm_node_t	*brs_hit_ratio;
+	struct d_tm_node_t	*brs_pages;
+	struct d_tm_node_t	*brs_invals;
+};
+
+/*
+ * Per-xstream DRAM read cache for small NVMe extents, it caches 4k pages keyed
+ * by I/O context and page offset on the blob, the cached pages are invalidated
+ * on overwrite and on VEA free.
+ */
+struct bio_rcache {
+	struct daos_lru_cache	*brc_lru;
+	/* In-flight fetch IODs to fill the cache, checked on each invalidation */
+	d_list_t		 brc_fills;
+	/* Lookups and hits in current window, for the hit ratio gauge */
+	unsigned int		 brc_win_lookups;
+	unsigned int		 brc_win_hits;
+	/* Total hits, misses and invalidated pages, for unit test */
+	uint64_t		 brc_hits;
+	uint64_t		 brc_misses;
+	uint64_t		 brc_invals;
+	struct bio_rcache_stats	 brc_stats;
+};
+
 /* Per-xstream NVMe context */
 struct bio_xs_context {
 	int			 bxc_tgt_id;
@@ -366,6 +478,22 @@ struct bio_xs_context {
 	struct spdk_io_channel	*bxc_io_channel;
 	struct bio_dma_buffer	*bxc_dma_buf;
 	d_list_t		 bxc_io_ctxts;
+	struct bio_io_sched	 bxc_io_sched;
+	/* DRAM read cache, NULL when it's disabled */
+	struct bio_rcache	*bxc_rcache;
+	/* Small NVMe writes staged for write combining */
+	struct bio_wc_batch	*bxc_wc_batch;
+	/* Staged small NVMe writes & NVMe commands issued for them */
+	uint64_t		 bxc_wc_writes;
+	uint64_t		 bxc_wc_cmds;
+	/* Submitted NVMe commands, for latency sampling */
+	unsigned int		 bxc_rw_cnt;
+	/*
+	 * Sampled NVMe command latency & device in-flight commands, per I/O type.
+	 * Per xstream since the telemetry stats are not updated atomically.
+	 */
+	struct d_tm_node_t	*bxc_io_lat[BIO_IOD_TYPE_GETBUF];
+	struct d_tm_node_t	*bxc_io_inflight[BIO_IOD_TYPE_GETBUF];
 	unsigned int		 bxc_ready:1,		/* xstream setup finished */
 				 bxc_self_polling;	/* for standalone VOS */
 };
@@ -398,6 +526,8 @@ struct bio_rsrvd_region {
 	uint64_t		 brr_end;
 	/* Media type this DMA region mapped to */
 	uint8_t			 brr_media;
+	/* Data is copied from the read cache, no NVMe read is needed */
+	uint8_t			 brr_cached;
 };
 
 /* Reserved DMA buffer for certain io descriptor */
@@ -428,13 +558,28 @@ struct bio_desc {
 	int			 bd_result;
 	unsigned int		 bd_chk_type;
 	unsigned int		 bd_type;
+	unsigned int		 bd_dma_class;
+	/* I/O class, see enum bio_io_class */
+	unsigned int		 bd_io_class;
+	/* Link to bis_queue when waiting for NVMe I/O dispatch */
+	d_list_t		 bd_sched_link;
+	/* Submit time (in ticks) of the in-flight NVMe command being sampled */
+	uint64_t		 bd_lat_start;
+	/* Coalesced commands & regions of the DMA transfer being issued */
+	struct bio_nvme_cmd	*bd_dma_cmds;
+	struct bio_rsrvd_region	**bd_dma_rgs;
+	/* Link to brc_fills while the NVMe reads to fill read cache are in-flight */
+	d_list_t		 bd_rcache_link;
 	/* Flags */
 	unsigned int		 bd_buffer_prep:1,
 				 bd_dma_issued:1,
 				 bd_retry:1,
 				 bd_rdma:1,
 				 bd_copy_dst:1,
-				 bd_in_fifo:1;
+				 bd_in_fifo:1,
+				 bd_sched_admitted:1,
+				 bd_no_wait:1,
+				 bd_rcache_stale:1;
 	/* Cached bulk handles being used by this IOD */
 	struct bio_bulk_hdl    **bd_bulk_hdls;
 	unsigned int		 bd_bulk_max;
@@ -466,6 +611,7 @@ enum {
 	BDEV_CLASS_NVME = 0,
 	BDEV_CLASS_MALLOC,
 	BDEV_CLASS_AIO,
+	BDEV_CLASS_URING,
 	BDEV_CLASS_UNKNOWN
 };
 
@@ -478,6 +624,8 @@ get_bdev_type(struct spdk_bdev *bdev)
 		return BDEV_CLASS_MALLOC;
 	else if (strcmp(spdk_bdev_get_product_name(bdev), "AIO disk") == 0)
 		return BDEV_CLASS_AIO;
+	else if (strcmp(spdk_bdev_get_product_name(bdev), "URING bdev") == 0)
+		return BDEV_CLASS_URING;
 	else
 		return BDEV_CLASS_UNKNOWN;
 }
@@ -507,7 +655,18 @@ extern bool		bio_scm_rdma;
 extern bool		bio_spdk_inited;
 extern unsigned int	bio_chk_sz;
 extern unsigned int	bio_chk_cnt_max;
+extern unsigned int	bio_chk_cnt_init;
 extern unsigned int	bio_numa_node;
+extern unsigned int	bio_dma_small_pgs;
+extern unsigned int	bio_dma_adapt_intvl;
+extern unsigned int	bio_nvme_gap_pgs;
+extern unsigned int	bio_io_qd;
+extern unsigned int	bio_io_bg_inflight;
+extern unsigned int	bio_io_lat_sample;
+extern unsigned int	bio_wc_pgs;
+extern unsigned int	bio_wc_io_pgs;
+extern unsigned int	bio_copy_depth;
+extern unsigned int	bio_copy_seg_pgs;
 int xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights,
 		       uint64_t timeout);
 void bio_bdev_event_cb(enum spdk_bdev_event_type type, struct spdk_bdev *bdev,
@@ -532,7 +691,7 @@ bool bypass_health_collect(void);
 
 /* bio_buffer.c */
 void dma_buffer_destroy(struct bio_dma_buffer *buf);
-struct bio_dma_buffer *dma_buffer_create(unsigned int init_cnt, int tgt_id);
+struct bio_dma_buffer *dma_buffer_create(unsigned int init_cnt, int tgt_id, int numa_node);
 void bio_memcpy(struct bio_desc *biod, uint16_t media, void *media_addr,
 		void *addr, ssize_t n);
 int dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg);
@@ -540,6 +699,8 @@ int iod_add_region(struct bio_desc *biod, struct bio_dma_chunk *chk,
 		   unsigned int chk_pg_idx, unsigned int chk_off, uint64_t off,
 		   uint64_t end, uint8_t media);
 int dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt);
+void dma_buffer_adapt(struct bio_dma_buffer *bdb);
+void bio_wc_flush(struct bio_xs_context *xs_ctxt);
 
 static inline struct bio_dma_buffer *
 iod_dma_buf(struct bio_desc *biod)
@@ -576,6 +737,7 @@ int bulk_cache_create(struct bio_dma_buffer *bdb);
 void bulk_cache_destroy(struct bio_dma_buffer *bdb);
 int bulk_reclaim_chunk(struct bio_dma_buffer *bdb,
 		       struct bio_bulk_group *ex_grp);
+void bulk_cache_adapt(struct bio_dma_buffer *bdb);
 /* bio_monitor.c */
 int bio_init_health_monitoring(struct bio_blobstore *bb, char *bdev_name);
 void bio_fini_health_monitoring(struct bio_blobstore *bb);
@@ -583,6 +745,7 @@ void bio_bs_monitor(struct bio_xs_context *ctxt, uint64_t now);
 void bio_media_error(void *msg_arg);
 void bio_export_health_stats(struct bio_blobstore *bb, char *bdev_name);
 void bio_export_vendor_health_stats(struct bio_blobstore *bb, char *bdev_name);
+void bio_export_io_stats(struct bio_xs_context *ctxt);
 void bio_set_vendor_id(struct bio_blobstore *bb, char *bdev_name);
 
 /* bio_context.c */
@@ -596,6 +759,25 @@ int bio_bs_state_set(struct bio_blobstore *bbs, enum bio_bs_state new_state);
 /* bio_device.c */
 void bio_led_event_monitor(struct bio_xs_context *ctxt, uint64_t now);
 int fill_in_traddr(struct bio_dev_info *b_info, char *dev_name);
+int bio_dev_socket_id(char *dev_name);
+
+/* bio_sched.c */
+void bio_sched_init(struct bio_io_sched *sched, int tgt_id);
+void bio_sched_admit(struct bio_desc *biod);
+void bio_sched_done(struct bio_desc *biod);
+bool bio_sched_busy(struct bio_desc *biod);
+
+/* bio_rcache.c */
+extern unsigned int	bio_rcache_mb;
+extern unsigned int	bio_rcache_max_pgs;
+int bio_rcache_create(struct bio_xs_context *xs_ctxt);
+void bio_rcache_destroy(struct bio_xs_context *xs_ctxt);
+bool bio_rcache_lookup(struct bio_desc *biod, struct bio_iov *biov);
+void bio_rcache_copy(struct bio_desc *biod, struct bio_rsrvd_region *rg);
+void bio_rcache_fill_start(struct bio_desc *biod);
+void bio_rcache_fill(struct bio_desc *biod);
+void bio_rcache_inval_iod(struct bio_desc *biod);
+void bio_rcache_evict_ctxt(struct bio_io_context *ioctxt);
 
 /* bio_config.c */
 int bio_add_allowed_alloc(const char *nvme_conf, struct spdk_env_opts *opts);
@@ -971,6 +971,54 @@ bio_export_vendor_health_stats(struct bio_blobstore *bb, char *bdev_name)
 	D_FREE(binfo);
 }
 
+#define BIO_LAT_BUCKETS		16	/* 8us ~ 256ms */
+#define BIO_LAT_BUCKET_WIDTH	8	/* us */
+
+/*
+ * Register DAOS metrics to export the sampled NVMe I/O latency histograms and
+ * in-flight commands of the device, one set per xstream doing I/O to it.
+ */
+void
+bio_export_io_stats(struct bio_xs_context *ctxt)
+{
+	char			*bdev_name = ctxt->bxc_blobstore->bb_dev->bb_name;
+	struct bio_dev_info	 binfo = { 0 };
+	char			 path[D_TM_MAX_NAME_LEN];
+	char			*io_type;
+	int			 i, rc;
+
+	rc = fill_in_traddr(&binfo, bdev_name);
+	if (rc || binfo.bdi_traddr == NULL) {
+		D_WARN("Failed to extract %s addr: "DF_RC"\n", bdev_name, DP_RC(rc));
+		return;
+	}
+
+	for (i = 0; i < BIO_IOD_TYPE_GETBUF; i++) {
+		io_type = (i == BIO_IOD_TYPE_UPDATE) ? "write" : "read";
+
+		snprintf(path, sizeof(path), "/nvme/%s/io/%s/latency/tgt_%d", binfo.bdi_traddr,
+			 io_type, ctxt->bxc_tgt_id);
+		rc = d_tm_add_metric(&ctxt->bxc_io_lat[i], D_TM_STATS_GAUGE,
+				     "Sampled NVMe command latency", "us", path);
+		if (rc == 0)
+			rc = d_tm_init_histogram(ctxt->bxc_io_lat[i], path, BIO_LAT_BUCKETS,
+						 BIO_LAT_BUCKET_WIDTH, 2);
+		if (rc)
+			D_WARN("Failed to create %s latency sensor for %s: "DF_RC"\n",
+			       io_type, bdev_name, DP_RC(rc));
+
+		rc = d_tm_add_metric(&ctxt->bxc_io_inflight[i], D_TM_STATS_GAUGE,
+				     "Sampled in-flight NVMe commands", "cmd",
+				     "/nvme/%s/io/%s/inflight/tgt_%d", binfo.bdi_traddr, io_type,
+				     ctxt->bxc_tgt_id);
+		if (rc)
+			D_WARN("Failed to create %s inflight sensor for %s: "DF_RC"\n",
+			       io_type, bdev_name, DP_RC(rc));
+	}
+
+	D_FREE(binfo.bdi_traddr);
+}
+
 
 static void
 get_vendor_id(void *ctx, struct spdk_pci_device *pci_device)
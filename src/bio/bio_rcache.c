@@ -0,0 +1,501 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+#define D_LOGFAC	DD_FAC(bio)
+
+#include <daos/common.h>
+#include <daos/lru.h>
+#include "bio_internal.h"
+
+/* Per-target read cache size in MB, 0 means the read cache is disabled */
+unsigned int bio_rcache_mb;
+/* Max NVMe extent size in pages to be cached */
+unsigned int bio_rcache_max_pgs = BIO_RCACHE_MAX_PGS;
+
+/* Window of lookups for the hit ratio gauge */
+#define RCACHE_RATIO_WIN	1024
+
+struct rcache_key {
+	struct bio_io_context	*rk_ctxt;
+	/* Page index on the blob */
+	uint64_t		 rk_pg_idx;
+};
+
+/* One cached DMA page of a blob */
+struct rcache_entry {
+	struct daos_llink	re_llink;
+	struct rcache_key	re_key;
+	char			re_data[BIO_DMA_PAGE_SZ];
+};
+
+static inline struct rcache_entry *
+llink2entry(struct daos_llink *llink)
+{
+	return container_of(llink, struct rcache_entry, re_llink);
+}
+
+static int
+rcache_lop_alloc(void *key, unsigned int ksize, void *args, struct daos_llink **llink_p)
+{
+	struct rcache_entry	*entry;
+
+	D_ASSERT(ksize == sizeof(struct rcache_key));
+	D_ASSERT(args != NULL);
+
+	D_ALLOC_PTR(entry);
+	if (entry == NULL)
+		return -DER_NOMEM;
+
+	entry->re_key = *(struct rcache_key *)key;
+	memcpy(entry->re_data, args, BIO_DMA_PAGE_SZ);
+
+	*llink_p = &entry->re_llink;
+	return 0;
+}
+
+static bool
+rcache_lop_cmp_key(const void *key, unsigned int ksize, struct daos_llink *llink)
+{
+	D_ASSERT(ksize == sizeof(struct rcache_key));
+	return !memcmp(key, &llink2entry(llink)->re_key, sizeof(struct rcache_key));
+}
+
+static uint32_t
+rcache_lop_rec_hash(struct daos_llink *llink)
+{
+	struct rcache_entry	*entry = llink2entry(llink);
+
+	return d_hash_string_u32((const char *)&entry->re_key, sizeof(entry->re_key));
+}
+
+static void
+rcache_lop_free(struct daos_llink *llink)
+{
+	struct rcache_entry	*entry = llink2entry(llink);
+
+	D_FREE(entry);
+}
+
+static struct daos_llink_ops rcache_lru_ops = {
+	.lop_alloc_ref	= rcache_lop_alloc,
+	.lop_cmp_keys	= rcache_lop_cmp_key,
+	.lop_rec_hash	= rcache_lop_rec_hash,
+	.lop_free_ref	= rcache_lop_free,
+};
+
+static inline struct bio_rcache *
+iod_rcache(struct bio_desc *biod)
+{
+	D_ASSERT(biod->bd_ctxt->bic_xs_ctxt);
+	return biod->bd_ctxt->bic_xs_ctxt->bxc_rcache;
+}
+
+static inline void
+rg2pg(struct bio_rsrvd_region *rg, uint64_t *pg_idx, uint64_t *pg_cnt)
+{
+	*pg_idx = rg->brr_off >> BIO_DMA_PAGE_SHIFT;
+	*pg_cnt = ((rg->brr_end + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT) - *pg_idx;
+}
+
+static inline void
+rcache_set_pages(struct bio_rcache *brc)
+{
+	if (brc->brc_stats.brs_pages)
+		d_tm_set_gauge(brc->brc_stats.brs_pages, brc->brc_lru->dlc_count);
+}
+
+static inline bool
+rcache_find(struct bio_rcache *brc, struct rcache_key *key, struct daos_llink **llink)
+{
+	return daos_lru_ref_hold(brc->brc_lru, key, sizeof(*key), NULL, llink) == 0;
+}
+
+static inline bool
+rcache_eligible(struct bio_desc *biod, uint64_t pg_cnt)
+{
+	return iod_rcache(biod) != NULL && biod->bd_type == BIO_IOD_TYPE_FETCH &&
+	       pg_cnt <= bio_rcache_max_pgs && !(daos_io_bypass & IOBP_NVME);
+}
+
+static void
+rcache_account(struct bio_rcache *brc, bool hit)
+{
+	struct bio_rcache_stats	*stats = &brc->brc_stats;
+
+	if (hit && stats->brs_hits)
+		d_tm_inc_counter(stats->brs_hits, 1);
+	else if (!hit && stats->brs_misses)
+		d_tm_inc_counter(stats->brs_misses, 1);
+
+	brc->brc_win_lookups++;
+	if (hit) {
+		brc->brc_win_hits++;
+		brc->brc_hits++;
+	} else {
+		brc->brc_misses++;
+	}
+
+	if (brc->brc_win_lookups == RCACHE_RATIO_WIN) {
+		if (stats->brs_hit_ratio)
+			d_tm_set_gauge(stats->brs_hit_ratio,
+				       brc->brc_win_hits * 100 / RCACHE_RATIO_WIN);
+		brc->brc_win_lookups = 0;
+		brc->brc_win_hits = 0;
+	}
+}
+
+/*
+ * Check if all the pages of a small NVMe extent being fetched are cached,
+ * called by dma_map_one() before reserving DMA buffer for the extent.
+ */
+bool
+bio_rcache_lookup(struct bio_desc *biod, struct bio_iov *biov)
+{
+	struct bio_rcache	*brc = iod_rcache(biod);
+	struct daos_llink	*llink;
+	struct rcache_key	 key;
+	uint64_t		 off, end, pg_end;
+	unsigned int		 pg_cnt, pg_off;
+	bool			 hit = true;
+
+	D_ASSERT(bio_iov2media(biov) == DAOS_MEDIA_NVME);
+	dma_biov2pg(biov, &off, &end, &pg_cnt, &pg_off);
+	if (!rcache_eligible(biod, pg_cnt))
+		return false;
+
+	key.rk_ctxt = biod->bd_ctxt;
+	pg_end = (end + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT;
+	for (key.rk_pg_idx = off >> BIO_DMA_PAGE_SHIFT; key.rk_pg_idx < pg_end;
+	     key.rk_pg_idx++) {
+		if (!rcache_find(brc, &key, &llink)) {
+			hit = false;
+			break;
+		}
+		daos_lru_ref_release(brc->brc_lru, llink);
+	}
+
+	rcache_account(brc, hit);
+	return hit;
+}
+
+/*
+ * Copy the cached pages into the DMA region reserved for an extent which hit
+ * the cache, the region won't be read from NVMe once it's marked as cached.
+ * The pages could have been evicted if dma_map_one() yielded after lookup,
+ * then the region will just be read from NVMe.
+ */
+void
+bio_rcache_copy(struct bio_desc *biod, struct bio_rsrvd_region *rg)
+{
+	struct bio_rcache	*brc = iod_rcache(biod);
+	struct daos_llink	*llink;
+	struct rcache_key	 key;
+	uint64_t		 pg_idx, pg_cnt, i;
+	void			*payload;
+
+	D_ASSERT(brc != NULL && rg->brr_media == DAOS_MEDIA_NVME);
+	payload = rg->brr_chk->bdc_ptr + (rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT);
+	rg2pg(rg, &pg_idx, &pg_cnt);
+
+	key.rk_ctxt = biod->bd_ctxt;
+	for (i = 0; i < pg_cnt; i++) {
+		key.rk_pg_idx = pg_idx + i;
+		if (!rcache_find(brc, &key, &llink))
+			return;
+
+		memcpy(payload + (i << BIO_DMA_PAGE_SHIFT), llink2entry(llink)->re_data,
+		       BIO_DMA_PAGE_SZ);
+		daos_lru_ref_release(brc->brc_lru, llink);
+	}
+
+	rg->brr_cached = 1;
+}
+
+/*
+ * Track a fetch IOD whose NVMe reads are being issued, so that an invalidation
+ * racing with the reads can drop the cache fill of the overlapped IOD only.
+ */
+void
+bio_rcache_fill_start(struct bio_desc *biod)
+{
+	struct bio_rcache	*brc = iod_rcache(biod);
+
+	if (brc == NULL || biod->bd_type != BIO_IOD_TYPE_FETCH)
+		return;
+
+	D_ASSERT(d_list_empty(&biod->bd_rcache_link));
+	biod->bd_rcache_stale = 0;
+	d_list_add_tail(&biod->bd_rcache_link, &brc->brc_fills);
+}
+
+/* Populate the cache with the small NVMe regions just read by a fetch IOD */
+void
+bio_rcache_fill(struct bio_desc *biod)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_rsrvd_region	*rg;
+	struct bio_rcache	*brc = iod_rcache(biod);
+	struct daos_llink	*llink;
+	struct rcache_key	 key;
+	uint64_t		 pg_idx, pg_cnt;
+	void			*payload;
+	int			 i, rc;
+
+	if (d_list_empty(&biod->bd_rcache_link))
+		return;
+	d_list_del_init(&biod->bd_rcache_link);
+
+	/* Some extents were invalidated while the NVMe reads were in-flight */
+	if (biod->bd_result != 0 || biod->bd_rcache_stale)
+		return;
+
+	key.rk_ctxt = biod->bd_ctxt;
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
+		rg = &rsrvd_dma->brd_regions[i];
+		if (rg->brr_media != DAOS_MEDIA_NVME || rg->brr_cached)
+			continue;
+
+		rg2pg(rg, &pg_idx, &pg_cnt);
+		if (!rcache_eligible(biod, pg_cnt))
+			continue;
+
+		payload = rg->brr_chk->bdc_ptr + (rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT);
+		for (; pg_cnt > 0; pg_cnt--, pg_idx++, payload += BIO_DMA_PAGE_SZ) {
+			key.rk_pg_idx = pg_idx;
+			rc = daos_lru_ref_hold(brc->brc_lru, &key, sizeof(key), payload, &llink);
+			if (rc) {
+				D_DEBUG(DB_IO, "Failed to cache page "DF_U64". "DF_RC"\n",
+					pg_idx, DP_RC(rc));
+				break;
+			}
+			daos_lru_ref_release(brc->brc_lru, llink);
+		}
+	}
+
+	rcache_set_pages(brc);
+}
+
+struct rcache_evict_arg {
+	struct bio_io_context	*rea_ctxt;
+	uint64_t		 rea_pg_idx;
+	uint64_t		 rea_pg_end;
+};
+
+static bool
+rcache_evict_cond(struct daos_llink *llink, void *arg)
+{
+	struct rcache_evict_arg	*rea = arg;
+	struct rcache_key	*key = &llink2entry(llink)->re_key;
+
+	return key->rk_ctxt == rea->rea_ctxt && key->rk_pg_idx >= rea->rea_pg_idx &&
+	       key->rk_pg_idx < rea->rea_pg_end;
+}
+
+/* Drop the cache fill of in-flight fetch IODs reading the invalidated range */
+static void
+rcache_evict_fills(struct bio_rcache *brc, struct bio_io_context *ctxt, uint64_t pg_idx,
+		   uint64_t pg_end)
+{
+	struct bio_desc		*biod;
+	struct bio_rsrvd_region	*rg;
+	uint64_t		 rg_idx, rg_cnt;
+	int			 i;
+
+	d_list_for_each_entry(biod, &brc->brc_fills, bd_rcache_link) {
+		if (biod->bd_ctxt != ctxt || biod->bd_rcache_stale)
+			continue;
+
+		for (i = 0; i < biod->bd_rsrvd.brd_rg_cnt; i++) {
+			rg = &biod->bd_rsrvd.brd_regions[i];
+			if (rg->brr_media != DAOS_MEDIA_NVME || rg->brr_cached)
+				continue;
+
+			rg2pg(rg, &rg_idx, &rg_cnt);
+			if (rg_idx < pg_end && rg_idx + rg_cnt > pg_idx) {
+				biod->bd_rcache_stale = 1;
+				break;
+			}
+		}
+	}
+}
+
+static void
+rcache_evict(struct bio_rcache *brc, struct bio_io_context *ctxt, uint64_t pg_idx,
+	     uint64_t pg_end)
+{
+	struct rcache_evict_arg	 rea;
+	struct daos_llink	*llink;
+	struct rcache_key	 key;
+	uint32_t		 count;
+
+	rcache_evict_fills(brc, ctxt, pg_idx, pg_end);
+	count = brc->brc_lru->dlc_count;
+	if (count == 0)
+		return;
+
+	/* Large range, scan the whole cache instead of page by page lookup */
+	if (pg_end - pg_idx > count) {
+		rea.rea_ctxt = ctxt;
+		rea.rea_pg_idx = pg_idx;
+		rea.rea_pg_end = pg_end;
+		daos_lru_cache_evict(brc->brc_lru, rcache_evict_cond, &rea);
+	} else {
+		key.rk_ctxt = ctxt;
+		for (key.rk_pg_idx = pg_idx; key.rk_pg_idx < pg_end; key.rk_pg_idx++) {
+			if (!rcache_find(brc, &key, &llink))
+				continue;
+			daos_lru_ref_evict(brc->brc_lru, llink);
+			daos_lru_ref_release(brc->brc_lru, llink);
+		}
+	}
+
+	count -= brc->brc_lru->dlc_count;
+	if (count == 0)
+		return;
+
+	brc->brc_invals += count;
+	if (brc->brc_stats.brs_invals)
+		d_tm_inc_counter(brc->brc_stats.brs_invals, count);
+	rcache_set_pages(brc);
+}
+
+/* Invalidate the cached pages being overwritten by an update IOD */
+void
+bio_rcache_inval_iod(struct bio_desc *biod)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_rsrvd_region	*rg;
+	struct bio_rcache	*brc = iod_rcache(biod);
+	uint64_t		 pg_idx, pg_cnt;
+	int			 i;
+
+	if (brc == NULL || biod->bd_type != BIO_IOD_TYPE_UPDATE)
+		return;
+
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
+		rg = &rsrvd_dma->brd_regions[i];
+		if (rg->brr_media != DAOS_MEDIA_NVME)
+			continue;
+
+		rg2pg(rg, &pg_idx, &pg_cnt);
+		rcache_evict(brc, biod->bd_ctxt, pg_idx, pg_idx + pg_cnt);
+	}
+}
+
+void
+bio_rcache_invalidate(struct bio_io_context *ioctxt, uint64_t off, uint64_t len)
+{
+	struct bio_rcache	*brc;
+
+	if (ioctxt == NULL || ioctxt->bic_xs_ctxt == NULL || len == 0)
+		return;
+
+	brc = ioctxt->bic_xs_ctxt->bxc_rcache;
+	if (brc == NULL)
+		return;
+
+	rcache_evict(brc, ioctxt, off >> BIO_DMA_PAGE_SHIFT,
+		     (off + len + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT);
+}
+
+bool
+bio_rcache_query(struct bio_xs_context *xs, uint64_t *hits, uint64_t *misses, uint64_t *invals)
+{
+	struct bio_rcache	*brc = xs->bxc_rcache;
+
+	*hits = brc != NULL ? brc->brc_hits : 0;
+	*misses = brc != NULL ? brc->brc_misses : 0;
+	*invals = brc != NULL ? brc->brc_invals : 0;
+	return brc != NULL;
+}
+
+/* Drop all the cached pages of an I/O context on close */
+void
+bio_rcache_evict_ctxt(struct bio_io_context *ioctxt)
+{
+	bio_rcache_invalidate(ioctxt, 0, UINT64_MAX - BIO_DMA_PAGE_SZ);
+}
+
+static void
+rcache_metrics_init(struct bio_rcache *brc, int tgt_id)
+{
+	struct bio_rcache_stats	*stats = &brc->brc_stats;
+	int			 rc;
+
+	rc = d_tm_add_metric(&stats->brs_hits, D_TM_COUNTER, "NVMe read cache hits", "extent",
+			     "rcache/hits/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create hits telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->brs_misses, D_TM_COUNTER, "NVMe read cache misses",
+			     "extent", "rcache/misses/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create misses telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->brs_hit_ratio, D_TM_GAUGE,
+			     "NVMe read cache hit ratio of recent lookups", "%",
+			     "rcache/hit_ratio/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create hit_ratio telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->brs_pages, D_TM_GAUGE, "Cached pages", "page",
+			     "rcache/pages/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create pages telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->brs_invals, D_TM_COUNTER,
+			     "Cached pages invalidated by free or overwrite", "page",
+			     "rcache/invalidations/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create invalidations telemetry: "DF_RC"\n", DP_RC(rc));
+}
+
+int
+bio_rcache_create(struct bio_xs_context *xs_ctxt)
+{
+	struct bio_rcache	*brc;
+	uint64_t		 pages;
+	int			 bits, rc;
+
+	if (bio_rcache_mb == 0)
+		return 0;
+
+	/* The LRU capacity is power of 2, round the budget down */
+	pages = ((uint64_t)bio_rcache_mb << 20) >> BIO_DMA_PAGE_SHIFT;
+	bits = 63 - __builtin_clzll(pages);
+
+	D_ALLOC_PTR(brc);
+	if (brc == NULL)
+		return -DER_NOMEM;
+	D_INIT_LIST_HEAD(&brc->brc_fills);
+
+	rc = daos_lru_cache_create(bits, D_HASH_FT_NOLOCK, &rcache_lru_ops, &brc->brc_lru);
+	if (rc) {
+		D_ERROR("Failed to create read cache: "DF_RC"\n", DP_RC(rc));
+		D_FREE(brc);
+		return rc;
+	}
+
+	rcache_metrics_init(brc, xs_ctxt->bxc_tgt_id);
+	xs_ctxt->bxc_rcache = brc;
+
+	D_INFO("Created "DF_U64"MB NVMe read cache, tgt_id:%d\n",
+	       (pages << BIO_DMA_PAGE_SHIFT) >> 20, xs_ctxt->bxc_tgt_id);
+	return 0;
+}
+
+void
+bio_rcache_destroy(struct bio_xs_context *xs_ctxt)
+{
+	struct bio_rcache	*brc = xs_ctxt->bxc_rcache;
+
+	if (brc == NULL)
+		return;
+
+	D_ASSERT(d_list_empty(&brc->brc_fills));
+	daos_lru_cache_destroy(brc->brc_lru);
+	D_FREE(brc);
+	xs_ctxt->bxc_rcache = NULL;
+}
@@ -0,0 +1,245 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+#define D_LOGFAC	DD_FAC(bio)
+
+#include <daos/common.h>
+#include "bio_internal.h"
+
+/* Max in-flight IODs per device channel */
+unsigned int bio_io_qd = BIO_IO_QD_DEF;
+/* Max in-flight IODs of each non-foreground class per device channel */
+unsigned int bio_io_bg_inflight = BIO_IO_QD_DEF / 4;
+
+/* Dispatch weight of each I/O class, adjustable at runtime */
+static unsigned int bio_io_weights[BIO_IO_CLASS_MAX] = {
+	[BIO_IO_CLASS_FG]	= 8,
+	[BIO_IO_CLASS_REBUILD]	= 2,
+	[BIO_IO_CLASS_BG]	= 1,
+};
+
+static inline char *
+io_class2str(int io_class)
+{
+	switch (io_class) {
+	case BIO_IO_CLASS_FG:
+		return "fg";
+	case BIO_IO_CLASS_REBUILD:
+		return "rebuild";
+	case BIO_IO_CLASS_BG:
+		return "bg";
+	default:
+		return "unknown";
+	}
+}
+
+int
+bio_io_weight_set(unsigned int io_class, unsigned int weight)
+{
+	if (io_class >= BIO_IO_CLASS_MAX || weight == 0) {
+		D_ERROR("Invalid I/O class %u or weight %u\n", io_class, weight);
+		return -DER_INVAL;
+	}
+
+	D_INFO("Set I/O class %s weight %u -> %u\n", io_class2str(io_class),
+	       bio_io_weights[io_class], weight);
+	bio_io_weights[io_class] = weight;
+	return 0;
+}
+
+void
+bio_iod_set_class(struct bio_desc *biod, unsigned int io_class)
+{
+	D_ASSERT(io_class < BIO_IO_CLASS_MAX);
+	D_ASSERT(!biod->bd_buffer_prep);
+	biod->bd_io_class = io_class;
+}
+
+static inline unsigned int
+class_inflight_max(unsigned int io_class)
+{
+	return io_class == BIO_IO_CLASS_FG ? bio_io_qd : bio_io_bg_inflight;
+}
+
+static inline bool
+class_can_dispatch(struct bio_io_sched *sched, unsigned int io_class)
+{
+	return sched->bis_inflight_tot < bio_io_qd &&
+	       sched->bis_inflight[io_class] < class_inflight_max(io_class);
+}
+
+static void
+sched_update_stats(struct bio_io_sched *sched, unsigned int io_class)
+{
+	struct bio_io_sched_stats *stats = &sched->bis_stats[io_class];
+
+	if (stats->biss_queued)
+		d_tm_set_gauge(stats->biss_queued, sched->bis_queued[io_class]);
+	if (stats->biss_inflight)
+		d_tm_set_gauge(stats->biss_inflight, sched->bis_inflight[io_class]);
+}
+
+static inline void
+sched_inflight_add(struct bio_io_sched *sched, struct bio_desc *biod)
+{
+	D_ASSERT(!biod->bd_sched_admitted);
+	biod->bd_sched_admitted = 1;
+	sched->bis_inflight[biod->bd_io_class]++;
+	sched->bis_inflight_tot++;
+	sched_update_stats(sched, biod->bd_io_class);
+}
+
+/*
+ * Pick the class to be dispatched next in weighted round robin: each class
+ * consumes one credit per dispatched IOD, credits are refilled by weights
+ * once all the dispatchable classes run out of credits.
+ */
+static int
+sched_pick_class(struct bio_io_sched *sched)
+{
+	int	i, round;
+
+	for (round = 0; round < 2; round++) {
+		for (i = 0; i < BIO_IO_CLASS_MAX; i++) {
+			if (sched->bis_queued[i] == 0 || !class_can_dispatch(sched, i))
+				continue;
+			if (sched->bis_credits[i] > 0) {
+				sched->bis_credits[i]--;
+				return i;
+			}
+		}
+
+		for (i = 0; i < BIO_IO_CLASS_MAX; i++)
+			sched->bis_credits[i] = bio_io_weights[i];
+	}
+
+	return -1;
+}
+
+static void
+sched_dispatch(struct bio_io_sched *sched)
+{
+	struct bio_desc	*biod;
+	int		 io_class;
+
+	while ((io_class = sched_pick_class(sched)) >= 0) {
+		biod = d_list_pop_entry(&sched->bis_queue[io_class], struct bio_desc,
+					bd_sched_link);
+		D_ASSERT(biod != NULL);
+		D_ASSERT(sched->bis_queued[io_class] > 0);
+		sched->bis_queued[io_class]--;
+
+		sched_inflight_add(sched, biod);
+		ABT_eventual_set(biod->bd_dma_done, NULL, 0);
+	}
+}
+
+/*
+ * Admit an IOD to issue NVMe I/O, the caller ULT will be blocked until the
+ * IOD is dispatched when the device channel is saturated.
+ */
+void
+bio_sched_admit(struct bio_desc *biod)
+{
+	struct bio_xs_context	*xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	struct bio_io_sched	*sched = &xs_ctxt->bxc_io_sched;
+	unsigned int		 io_class = biod->bd_io_class;
+	uint64_t		 wait_start;
+
+	D_ASSERT(io_class < BIO_IO_CLASS_MAX);
+	/* No concurrent IODs in self polling mode */
+	if (xs_ctxt->bxc_self_polling)
+		return;
+
+	if (sched->bis_queued[io_class] == 0 && class_can_dispatch(sched, io_class)) {
+		sched_inflight_add(sched, biod);
+		return;
+	}
+
+	D_ASSERT(biod->bd_dma_done != ABT_EVENTUAL_NULL);
+	wait_start = daos_getutime();
+
+	d_list_add_tail(&biod->bd_sched_link, &sched->bis_queue[io_class]);
+	sched->bis_queued[io_class]++;
+	sched_update_stats(sched, io_class);
+
+	ABT_eventual_wait(biod->bd_dma_done, NULL);
+	ABT_eventual_reset(biod->bd_dma_done);
+	D_ASSERT(biod->bd_sched_admitted);
+
+	if (sched->bis_stats[io_class].biss_wait)
+		d_tm_set_gauge(sched->bis_stats[io_class].biss_wait,
+			       daos_getutime() - wait_start);
+}
+
+/*
+ * Check if admitting the IOD will block the caller, it's used by the caller
+ * issuing multiple IODs to complete some of them before issuing more.
+ */
+bool
+bio_sched_busy(struct bio_desc *biod)
+{
+	struct bio_xs_context	*xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	struct bio_io_sched	*sched;
+	unsigned int		 io_class = biod->bd_io_class;
+
+	if (xs_ctxt == NULL || xs_ctxt->bxc_self_polling)
+		return false;
+
+	sched = &xs_ctxt->bxc_io_sched;
+	return sched->bis_queued[io_class] != 0 || !class_can_dispatch(sched, io_class);
+}
+
+/* Called when all the NVMe I/O of an admitted IOD are completed */
+void
+bio_sched_done(struct bio_desc *biod)
+{
+	struct bio_io_sched	*sched = &biod->bd_ctxt->bic_xs_ctxt->bxc_io_sched;
+	unsigned int		 io_class = biod->bd_io_class;
+
+	if (!biod->bd_sched_admitted)
+		return;
+
+	biod->bd_sched_admitted = 0;
+	D_ASSERT(sched->bis_inflight[io_class] > 0);
+	D_ASSERT(sched->bis_inflight_tot > 0);
+	sched->bis_inflight[io_class]--;
+	sched->bis_inflight_tot--;
+	sched_update_stats(sched, io_class);
+
+	sched_dispatch(sched);
+}
+
+void
+bio_sched_init(struct bio_io_sched *sched, int tgt_id)
+{
+	struct bio_io_sched_stats	*stats;
+	int				 i, rc;
+
+	memset(sched, 0, sizeof(*sched));
+	for (i = 0; i < BIO_IO_CLASS_MAX; i++) {
+		D_INIT_LIST_HEAD(&sched->bis_queue[i]);
+		sched->bis_credits[i] = bio_io_weights[i];
+
+		stats = &sched->bis_stats[i];
+		rc = d_tm_add_metric(&stats->biss_queued, D_TM_GAUGE, "Queued NVMe IODs",
+				     "iod", "io_sched/%s/queued/tgt_%d", io_class2str(i),
+				     tgt_id);
+		if (rc)
+			D_WARN("Failed to create queued telemetry: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&stats->biss_inflight, D_TM_GAUGE, "Inflight NVMe IODs",
+				     "iod", "io_sched/%s/inflight/tgt_%d", io_class2str(i),
+				     tgt_id);
+		if (rc)
+			D_WARN("Failed to create inflight telemetry: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&stats->biss_wait, D_TM_STATS_GAUGE,
+				     "NVMe IOD dispatch wait time", "us",
+				     "io_sched/%s/wait_time/tgt_%d", io_class2str(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create wait_time telemetry: "DF_RC"\n", DP_RC(rc));
+	}
+}
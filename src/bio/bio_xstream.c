@@ -45,7 +45,23 @@ unsigned int bio_chk_cnt_max;
 /* NUMA node affinity */
 unsigned int bio_numa_node;
 /* Per-xstream initial DMA buffer size (in chunk count) */
-static unsigned int bio_chk_cnt_init;
+unsigned int bio_chk_cnt_init;
+/* I/O descriptors reserving more pages than this are in large size class */
+unsigned int bio_dma_small_pgs = BIO_DMA_SMALL_PGS;
+/* Interval (in seconds) of adapting the DMA buffer size, 0 to disable */
+unsigned int bio_dma_adapt_intvl = 10;
+/* Max hole (in pages) being read through when coalescing NVMe reads */
+unsigned int bio_nvme_gap_pgs = BIO_NVME_GAP_PGS;
+/* Sample latency for one of every N NVMe commands, 0 to disable */
+unsigned int bio_io_lat_sample = BIO_IO_LAT_SAMPLE;
+/* Max pages of a combined NVMe write, 0 to disable write combining */
+unsigned int bio_wc_pgs;
+/* NVMe writes no larger than this (in pages) are staged for combining */
+unsigned int bio_wc_io_pgs = BIO_WC_IO_PGS;
+/* In-flight segments of pipelined copy, 1 to disable pipelining */
+unsigned int bio_copy_depth = BIO_COPY_DEPTH;
+/* Segment size (in pages) of pipelined copy */
+unsigned int bio_copy_seg_pgs = BIO_COPY_SEG_PGS;
 /* Diret RDMA over SCM */
 bool bio_scm_rdma;
 /* Whether SPDK inited */
@@ -202,6 +218,55 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	d_getenv_int("DAOS_SPDK_SUBSYS_TIMEOUT", &bio_spdk_subsys_timeout);
 	D_INFO("SPDK subsystem fini timeout is %u ms\n", bio_spdk_subsys_timeout);
 
+	d_getenv_int("DAOS_DMA_SMALL_PGS", &bio_dma_small_pgs);
+	if (bio_dma_small_pgs == 0 || bio_dma_small_pgs > bio_chk_sz)
+		bio_dma_small_pgs = BIO_DMA_SMALL_PGS;
+	d_getenv_int("DAOS_DMA_ADAPT_INTVL", &bio_dma_adapt_intvl);
+	D_INFO("DMA small I/O threshold is %u pages, adapt interval is %u secs\n",
+	       bio_dma_small_pgs, bio_dma_adapt_intvl);
+
+	d_getenv_int("DAOS_NVME_COALESCE_GAP", &bio_nvme_gap_pgs);
+	if (bio_nvme_gap_pgs > bio_chk_sz)
+		bio_nvme_gap_pgs = BIO_NVME_GAP_PGS;
+	D_INFO("NVMe read coalescing gap is %u pages\n", bio_nvme_gap_pgs);
+
+	d_getenv_int("DAOS_NVME_IO_QD", &bio_io_qd);
+	if (bio_io_qd == 0)
+		bio_io_qd = BIO_IO_QD_DEF;
+	bio_io_bg_inflight = bio_io_qd / 4;
+	d_getenv_int("DAOS_NVME_BG_INFLIGHT", &bio_io_bg_inflight);
+	if (bio_io_bg_inflight == 0 || bio_io_bg_inflight > bio_io_qd)
+		bio_io_bg_inflight = max(bio_io_qd / 4, 1);
+	D_INFO("NVMe I/O queue depth is %u, background inflight limit is %u\n",
+	       bio_io_qd, bio_io_bg_inflight);
+
+	d_getenv_int("DAOS_NVME_LAT_SAMPLE", &bio_io_lat_sample);
+	D_INFO("NVMe latency sampling is %s (1/%u)\n",
+	       bio_io_lat_sample ? "enabled" : "disabled", bio_io_lat_sample);
+
+	d_getenv_int("DAOS_NVME_RCACHE_MB", &bio_rcache_mb);
+	d_getenv_int("DAOS_NVME_RCACHE_MAX_PGS", &bio_rcache_max_pgs);
+	if (bio_rcache_max_pgs == 0 || bio_rcache_max_pgs > bio_chk_sz)
+		bio_rcache_max_pgs = BIO_RCACHE_MAX_PGS;
+	D_INFO("NVMe read cache is %uMB per target, max cached extent is %u pages\n",
+	       bio_rcache_mb, bio_rcache_max_pgs);
+
+	d_getenv_int("DAOS_NVME_WC_PGS", &bio_wc_pgs);
+	if (bio_wc_pgs > bio_chk_sz)
+		bio_wc_pgs = bio_chk_sz;
+	d_getenv_int("DAOS_NVME_WC_IO_PGS", &bio_wc_io_pgs);
+	if (bio_wc_io_pgs == 0 || bio_wc_io_pgs > bio_wc_pgs)
+		bio_wc_io_pgs = min(BIO_WC_IO_PGS, bio_wc_pgs);
+	D_INFO("NVMe write combining is %s, max write %u pages, max combined write %u pages\n",
+	       bio_wc_pgs ? "enabled" : "disabled", bio_wc_io_pgs, bio_wc_pgs);
+
+	d_getenv_int("DAOS_NVME_COPY_DEPTH", &bio_copy_depth);
+	d_getenv_int("DAOS_NVME_COPY_SEG_PGS", &bio_copy_seg_pgs);
+	if (bio_copy_seg_pgs == 0 || bio_copy_seg_pgs > bio_chk_sz)
+		bio_copy_seg_pgs = min(BIO_COPY_SEG_PGS, bio_chk_sz);
+	D_INFO("NVMe copy pipeline depth is %u, segment size is %u pages\n",
+	       bio_copy_depth, bio_copy_seg_pgs);
+
 	/* Hugepages disabled */
 	if (mem_size == 0) {
 		D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks\n",
@@ -250,6 +315,12 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	if (env && strcasecmp(env, "AIO") == 0) {
 		D_WARN("AIO device(s) will be used!\n");
 		nvme_glb.bd_bdev_class = BDEV_CLASS_AIO;
+	} else if (env && strcasecmp(env, "URING") == 0) {
+		D_WARN("io_uring device(s) will be used!\n");
+		nvme_glb.bd_bdev_class = BDEV_CLASS_URING;
+	} else if (env && strcasecmp(env, "MALLOC") == 0) {
+		D_WARN("Malloc device(s) will be used!\n");
+		nvme_glb.bd_bdev_class = BDEV_CLASS_MALLOC;
 	}
 
 	env = getenv("VMD_LED_PERIOD");
@@ -1203,6 +1274,8 @@ bio_xsctxt_free(struct bio_xs_context *ctxt)
 		return;
 
 	ctxt->bxc_ready = 0;
+	/* Staged writes are always flushed before their IODs complete */
+	D_ASSERT(ctxt->bxc_wc_batch == NULL);
 	if (ctxt->bxc_io_channel != NULL) {
 		spdk_bs_free_io_channel(ctxt->bxc_io_channel);
 		ctxt->bxc_io_channel = NULL;
@@ -1280,6 +1353,7 @@ bio_xsctxt_free(struct bio_xs_context *ctxt)
 		ctxt->bxc_dma_buf = NULL;
 	}
 
+	bio_rcache_destroy(ctxt);
 	D_FREE(ctxt);
 }
 
@@ -1288,6 +1362,7 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id, bool self_polling)
 {
 	struct bio_xs_context	*ctxt;
 	char			 th_name[32];
+	int			 numa_node, socket_id;
 	int			 rc;
 
 	D_ALLOC_PTR(ctxt);
@@ -1297,10 +1372,11 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id, bool self_polling)
 	D_INIT_LIST_HEAD(&ctxt->bxc_io_ctxts);
 	ctxt->bxc_tgt_id = tgt_id;
 	ctxt->bxc_self_polling = self_polling;
+	bio_sched_init(&ctxt->bxc_io_sched, tgt_id);
 
 	/* Skip NVMe context setup if the daos_nvme.conf isn't present */
 	if (!bio_nvme_configured()) {
-		ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id);
+		ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id, bio_numa_node);
 		if (ctxt->bxc_dma_buf == NULL) {
 			D_FREE(ctxt);
 			*pctxt = NULL;
@@ -1375,13 +1451,29 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id, bool self_polling)
 	rc = init_blobstore_ctxt(ctxt, tgt_id);
 	if (rc)
 		goto out;
+	if (ctxt->bxc_blobstore != NULL)
+		bio_export_io_stats(ctxt);
+
+	/* Allocate DMA buffer on the NUMA node where the SSD is attached */
+	numa_node = bio_numa_node;
+	if (ctxt->bxc_blobstore != NULL) {
+		socket_id = bio_dev_socket_id(ctxt->bxc_blobstore->bb_dev->bb_name);
+		if (socket_id >= 0)
+			numa_node = socket_id;
+	}
+	D_INFO("Allocate DMA buffer on NUMA node %d, tgt_id:%d\n", numa_node, tgt_id);
 
-	ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id);
+	ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id, numa_node);
 	if (ctxt->bxc_dma_buf == NULL) {
 		D_ERROR("failed to initialize dma buffer\n");
 		rc = -DER_NOMEM;
 		goto out;
 	}
+
+	rc = bio_rcache_create(ctxt);
+	if (rc)
+		D_WARN("Read cache is disabled, tgt_id:%d. "DF_RC"\n", tgt_id, DP_RC(rc));
+	rc = 0;
 out:
 	ABT_mutex_unlock(nvme_glb.bd_mutex);
 	if (rc != 0)
@@ -1583,11 +1675,17 @@ bio_nvme_poll(struct bio_xs_context *ctxt)
 	uint64_t now = d_timeus_secdiff(0);
 	int rc;
 
+	/* Resize the DMA buffer and bulk groups by demand of last interval */
+	if (ctxt != NULL && ctxt->bxc_dma_buf != NULL)
+		dma_buffer_adapt(ctxt->bxc_dma_buf);
+
 	/* NVMe context setup was skipped */
 	if (!bio_nvme_configured())
 		return 0;
 
 	D_ASSERT(ctxt != NULL && ctxt->bxc_thread != NULL);
+	/* Submit the small writes staged since last poll */
+	bio_wc_flush(ctxt);
 	rc = spdk_thread_poll(ctxt->bxc_thread, 0, 0);
 
 	/*
@@ -0,0 +1,275 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/*
+ * Unit tests for the demand driven resizing of the bulk cache, the bulk
+ * registration and the DMA buffer growing are mocked.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <daos/common.h>
+#include <daos/tests_lib.h>
+#include "../bio_internal.h"
+
+#define UT_CHK_PGS	16
+#define UT_CHK_MAX	32
+
+unsigned int	bio_chk_sz = UT_CHK_PGS;
+unsigned int	bio_chk_cnt_max = UT_CHK_MAX;
+bool		bio_scm_rdma;
+
+static int	ut_bulk_creates;
+static int	ut_bulk_frees;
+static int	ut_bulk_ctxt;
+
+/* Mocks of bio_buffer.c & bio_rcache.c */
+int
+dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
+{
+	struct bio_dma_chunk	*chk;
+	int			 i;
+
+	assert_true(buf->bdb_tot_cnt + cnt <= bio_chk_cnt_max);
+	for (i = 0; i < cnt; i++) {
+		D_ALLOC_PTR(chk);
+		assert_non_null(chk);
+		D_ALLOC(chk->bdc_ptr, UT_CHK_PGS << BIO_DMA_PAGE_SHIFT);
+		assert_non_null(chk->bdc_ptr);
+		D_INIT_LIST_HEAD(&chk->bdc_link);
+
+		d_list_add_tail(&chk->bdc_link, &buf->bdb_idle_list);
+		buf->bdb_tot_cnt++;
+	}
+	return 0;
+}
+
+int
+dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
+{
+	fail();
+	return 0;
+}
+
+int
+iod_add_region(struct bio_desc *biod, struct bio_dma_chunk *chk, unsigned int chk_pg_idx,
+	       unsigned int chk_off, uint64_t off, uint64_t end, uint8_t media)
+{
+	fail();
+	return 0;
+}
+
+bool
+bio_rcache_lookup(struct bio_desc *biod, struct bio_iov *biov)
+{
+	fail();
+	return false;
+}
+
+void
+bio_rcache_copy(struct bio_desc *biod, struct bio_rsrvd_region *rg)
+{
+	fail();
+}
+
+static int
+ut_bulk_create(void *ctxt, d_sg_list_t *sgl, unsigned int perm, void **bulk_hdl)
+{
+	assert_ptr_equal(ctxt, &ut_bulk_ctxt);
+	assert_int_equal(sgl->sg_nr, 1);
+
+	ut_bulk_creates++;
+	*bulk_hdl = sgl->sg_iovs[0].iov_buf;
+	return 0;
+}
+
+static int
+ut_bulk_free(void *bulk_hdl)
+{
+	assert_non_null(bulk_hdl);
+	ut_bulk_frees++;
+	return 0;
+}
+
+static int
+ut_setup(void **state)
+{
+	struct bio_dma_buffer	*bdb;
+	int			 rc;
+
+	D_ALLOC_PTR(bdb);
+	assert_non_null(bdb);
+	D_INIT_LIST_HEAD(&bdb->bdb_idle_list);
+	D_INIT_LIST_HEAD(&bdb->bdb_used_list);
+
+	rc = bulk_cache_create(bdb);
+	assert_rc_equal(rc, 0);
+	bdb->bdb_bulk_cache.bbc_bulk_ctxt = &ut_bulk_ctxt;
+
+	ut_bulk_creates = ut_bulk_frees = 0;
+	*state = bdb;
+	return 0;
+}
+
+static int
+ut_teardown(void **state)
+{
+	struct bio_dma_buffer	*bdb = *state;
+	struct bio_dma_chunk	*chk, *tmp;
+
+	bulk_cache_destroy(bdb);
+	assert_int_equal(ut_bulk_creates, ut_bulk_frees);
+
+	d_list_for_each_entry_safe(chk, tmp, &bdb->bdb_idle_list, bdc_link) {
+		d_list_del(&chk->bdc_link);
+		D_FREE(chk->bdc_bulks);
+		D_FREE(chk->bdc_ptr);
+		D_FREE(chk);
+	}
+	D_FREE(bdb);
+	return 0;
+}
+
+/* Add a bulk group with observed demand, as the bulk mapping would do */
+static struct bio_bulk_group *
+ut_grp_add(struct bio_dma_buffer *bdb, unsigned int pgs, unsigned int reqs, unsigned int peak)
+{
+	struct bio_bulk_cache	*bbc = &bdb->bdb_bulk_cache;
+	struct bio_bulk_group	*bbg;
+
+	assert_true(bbc->bbc_grp_cnt < bbc->bbc_grp_max);
+	bbg = &bbc->bbc_grps[bbc->bbc_grp_cnt];
+	bbc->bbc_sorted[bbc->bbc_grp_cnt] = bbg;
+	bbc->bbc_grp_cnt++;
+
+	bbg->bbg_bulk_pgs = pgs;
+	bbg->bbg_reqs = reqs;
+	bbg->bbg_peak = peak;
+	d_list_add_tail(&bbg->bbg_lru_link, &bbc->bbc_grp_lru);
+
+	return bbg;
+}
+
+/* Group is populated ahead of the observed peak, then released once it turns cold */
+static void
+ut_adapt_resize(void **state)
+{
+	struct bio_dma_buffer	*bdb = *state;
+	struct bio_bulk_group	*bbg;
+	int			 i;
+
+	/* 10 bulks of 4 pages plus 25% headroom, 4 bulks per chunk */
+	bbg = ut_grp_add(bdb, 4, 10, 10);
+	bulk_cache_adapt(bdb);
+	assert_int_equal(bbg->bbg_chk_cnt, 4);
+	assert_int_equal(bdb->bdb_tot_cnt, 4);
+	assert_int_equal(ut_bulk_creates, 16);
+	assert_int_equal(bbg->bbg_reqs, 0);
+	assert_int_equal(bbg->bbg_peak, 0);
+
+	/* Demand within the registered bulks doesn't grow the group */
+	bbg->bbg_reqs = 20;
+	bbg->bbg_peak = 12;
+	bulk_cache_adapt(bdb);
+	assert_int_equal(bbg->bbg_chk_cnt, 4);
+	assert_int_equal(ut_bulk_creates, 16);
+
+	/* Higher peak grows the group */
+	bbg->bbg_reqs = 20;
+	bbg->bbg_peak = 20;
+	bulk_cache_adapt(bdb);
+	assert_int_equal(bbg->bbg_chk_cnt, 7);
+	assert_int_equal(bdb->bdb_tot_cnt, 7);
+	assert_int_equal(ut_bulk_creates, 28);
+
+	/* No bulk registration without bulk context */
+	bdb->bdb_bulk_cache.bbc_bulk_ctxt = NULL;
+	bbg->bbg_reqs = 40;
+	bbg->bbg_peak = 40;
+	bulk_cache_adapt(bdb);
+	assert_int_equal(bbg->bbg_chk_cnt, 7);
+	bdb->bdb_bulk_cache.bbc_bulk_ctxt = &ut_bulk_ctxt;
+
+	/* Heat decays by half each idle interval, idle chunks are released at zero */
+	for (i = 0; bbg->bbg_chk_cnt != 0; i++) {
+		assert_true(i < 16);
+		assert_int_equal(ut_bulk_frees, 0);
+		bulk_cache_adapt(bdb);
+	}
+	assert_true(i > 1);
+	assert_int_equal(bbg->bbg_heat, 0);
+	assert_int_equal(ut_bulk_frees, ut_bulk_creates);
+	assert_int_equal(bdb->bdb_tot_cnt, 7);
+}
+
+/* Idle chunk is reclaimed from the coldest group */
+static void
+ut_reclaim_coldest(void **state)
+{
+	struct bio_dma_buffer	*bdb = *state;
+	struct bio_bulk_group	*hot, *cold, *warm;
+	int			 rc;
+
+	hot = ut_grp_add(bdb, 2, 100, 1);
+	cold = ut_grp_add(bdb, 8, 2, 1);
+	warm = ut_grp_add(bdb, 4, 50, 1);
+	bulk_cache_adapt(bdb);
+	assert_int_equal(hot->bbg_chk_cnt, 1);
+	assert_int_equal(cold->bbg_chk_cnt, 1);
+	assert_int_equal(warm->bbg_chk_cnt, 1);
+
+	rc = bulk_reclaim_chunk(bdb, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(cold->bbg_chk_cnt, 0);
+	assert_int_equal(hot->bbg_chk_cnt, 1);
+	assert_int_equal(warm->bbg_chk_cnt, 1);
+	assert_int_equal(ut_bulk_frees, 2);
+
+	/* The requesting group is never the victim */
+	rc = bulk_reclaim_chunk(bdb, warm);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(hot->bbg_chk_cnt, 0);
+	assert_int_equal(warm->bbg_chk_cnt, 1);
+
+	rc = bulk_reclaim_chunk(bdb, warm);
+	assert_rc_equal(rc, -DER_AGAIN);
+	assert_int_equal(warm->bbg_chk_cnt, 1);
+}
+
+static int
+ut_group_setup(void **state)
+{
+	int	rc;
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc)
+		return rc;
+
+	bio_register_bulk_ops(ut_bulk_create, ut_bulk_free);
+	return 0;
+}
+
+static int
+ut_group_teardown(void **state)
+{
+	daos_debug_fini();
+	return 0;
+}
+
+static const struct CMUnitTest bulk_uts[] = {
+	{ "BULK01: Resize bulk group by demand", ut_adapt_resize, ut_setup, ut_teardown},
+	{ "BULK02: Reclaim chunk from the coldest group", ut_reclaim_coldest, ut_setup,
+	  ut_teardown},
+};
+
+int
+main(int argc, char **argv)
+{
+	return cmocka_run_group_tests_name("Bulk cache unit tests", bulk_uts, ut_group_setup,
+					   ut_group_teardown);
+}
@@ -123,6 +123,10 @@ const struct daos_task_api dc_funcs[] = {
 	{dc_kv_put, sizeof(daos_kv_put_t)},
 	{dc_kv_remove, sizeof(daos_kv_remove_t)},
 	{dc_kv_list, sizeof(daos_kv_list_t)},
+
+	/** Object batch */
+	{dc_obj_fetch_batch_task, sizeof(daos_obj_batch_t)},
+	{dc_obj_update_batch_task, sizeof(daos_obj_batch_t)},
 };
 
 /**
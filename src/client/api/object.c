@@ -169,6 +169,46 @@ daos_obj_update(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_obj_fetch_batch(daos_obj_batch_op_t *ops, unsigned int nr,
+		     daos_event_t *ev)
+{
+	daos_obj_batch_t	*args;
+	tse_task_t		*task;
+	int			 rc;
+
+	DAOS_API_ARG_ASSERT(*args, OBJ_FETCH_BATCH);
+	rc = dc_task_create(dc_obj_fetch_batch_task, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->ops	= ops;
+	args->nr	= nr;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_obj_update_batch(daos_obj_batch_op_t *ops, unsigned int nr,
+		      daos_event_t *ev)
+{
+	daos_obj_batch_t	*args;
+	tse_task_t		*task;
+	int			 rc;
+
+	DAOS_API_ARG_ASSERT(*args, OBJ_UPDATE_BATCH);
+	rc = dc_task_create(dc_obj_update_batch_task, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->ops	= ops;
+	args->nr	= nr;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_obj_list_dkey(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 		   daos_key_desc_t *kds, d_sg_list_t *sgl,
@@ -369,6 +369,12 @@ daos_prop_valid(daos_prop_t *prop, bool pool, bool input)
 		case DAOS_PROP_PO_SCRUB_THRESH:
 			/* accepting any number for threshold for now */
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+		case DAOS_PROP_PO_QOS_BW:
+		case DAOS_PROP_PO_QOS_CONT_IOPS:
+		case DAOS_PROP_PO_QOS_CONT_BW:
+			/* zero means unlimited, any other value is a limit */
+			break;
 		/* container-only properties */
 		case DAOS_PROP_CO_LAYOUT_TYPE:
 			val = prop->dpp_entries[i].dpe_val;
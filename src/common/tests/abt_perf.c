@@ -26,6 +26,25 @@ static int		opt_concur = 1;
 static int		opt_secs;
 static int		opt_stack;
 static int		opt_cr_type;
+static bool		opt_recycle;
+
+/*
+ * ULT stack recycled by the test itself (-r), it mimics the per-xstream deep
+ * ULT stack cache of the engine, so the ULT creation rate with and without
+ * stack recycling can be compared, e.g. for the 64KB DSS_DEEP_STACK_SZ:
+ *	abt_perf -t c -n 64 -s 10 -S 64
+ *	abt_perf -t c -n 64 -s 10 -S 64 -r
+ */
+struct abt_stack {
+	struct abt_stack	*as_next;
+	void			(*as_func)(void *);
+};
+
+#define ABT_STACK_HDR_SZ	64
+
+static struct abt_stack	*abt_stacks;
+static ABT_thread_attr	abt_stack_attr = ABT_THREAD_ATTR_NULL;
+static size_t		abt_stack_sz;
 
 static inline uint64_t
 abt_current_ms(void)
@@ -36,6 +55,61 @@ abt_current_ms(void)
 	return now.tv_sec * 1000 + now.tv_nsec / 1000000;
 }
 
+static void
+abt_stack_ult(void *arg)
+{
+	struct abt_stack	*as = arg;
+
+	as->as_func(NULL);
+	/* Single xstream, no other ULT can reuse the stack before this ULT exits */
+	as->as_next = abt_stacks;
+	abt_stacks = as;
+}
+
+static int
+abt_ult_create(void (*func)(void *), ABT_thread_attr attr)
+{
+	struct abt_stack	*as;
+	int			 rc;
+
+	if (!opt_recycle)
+		return ABT_thread_create(abt_pool, func, NULL, attr, NULL);
+
+	as = abt_stacks;
+	if (as != NULL) {
+		abt_stacks = as->as_next;
+	} else {
+		as = malloc(ABT_STACK_HDR_SZ + abt_stack_sz);
+		if (as == NULL)
+			return ABT_ERR_MEM;
+	}
+	as->as_func = func;
+
+	rc = ABT_thread_attr_set_stack(abt_stack_attr, (char *)as + ABT_STACK_HDR_SZ,
+				       abt_stack_sz);
+	if (rc == ABT_SUCCESS)
+		rc = ABT_thread_create(abt_pool, abt_stack_ult, as, abt_stack_attr, NULL);
+	if (rc != ABT_SUCCESS) {
+		as->as_next = abt_stacks;
+		abt_stacks = as;
+	}
+	return rc;
+}
+
+static void
+abt_stacks_free(void)
+{
+	struct abt_stack	*as;
+
+	while (abt_stacks != NULL) {
+		as = abt_stacks;
+		abt_stacks = as->as_next;
+		free(as);
+	}
+	if (abt_stack_attr != ABT_THREAD_ATTR_NULL)
+		ABT_thread_attr_free(&abt_stack_attr);
+}
+
 static void
 abt_thread_1(void *arg)
 {
@@ -46,7 +120,7 @@ abt_thread_1(void *arg)
 		abt_cntr++;
 		ABT_mutex_unlock(abt_lock);
 
-		ABT_thread_create(abt_pool, abt_thread_1, NULL, abt_attr, NULL);
+		abt_ult_create(abt_thread_1, abt_attr);
 
 		ABT_mutex_lock(abt_lock);
 	} /* else: do nothing and exit */
@@ -103,8 +177,7 @@ abt_ult_create_rate(void)
 		abt_cntr++;
 		ABT_mutex_unlock(abt_lock);
 
-		rc = ABT_thread_create(abt_pool, abt_thread_1, NULL,
-				       abt_attr, NULL);
+		rc = abt_ult_create(abt_thread_1, abt_attr);
 		if (rc != ABT_SUCCESS) {
 			printf("ABT thread create failed: %d\n", rc);
 			return;
@@ -286,6 +359,8 @@ static struct option abt_ops[] = {
 	{ "sec",	required_argument,	NULL,	's'	},
 	/** stack size (kilo-bytes) */
 	{ "stack",	required_argument,	NULL,	'S'	},
+	/** recycle ULT stacks for test 'c' */
+	{ "recycle",	no_argument,		NULL,	'r'	},
 };
 
 int
@@ -294,7 +369,7 @@ main(int argc, char **argv)
 	char	test_id = 0;
 	int	rc;
 
-	while ((rc = getopt_long(argc, argv, "t:n:s:S:",
+	while ((rc = getopt_long(argc, argv, "t:n:s:S:r",
 				 abt_ops, NULL)) != -1) {
 		switch (rc) {
 		default:
@@ -313,6 +388,9 @@ main(int argc, char **argv)
 			opt_stack = atoi(optarg);
 			opt_stack <<= 10; /* kilo-byte */
 			break;
+		case 'r':
+			opt_recycle = true;
+			break;
 		}
 	}
 
@@ -371,6 +449,22 @@ main(int argc, char **argv)
 		printf("ULT stack size = %d\n", opt_stack);
 	}
 
+	if (opt_recycle) {
+		abt_stack_sz = opt_stack;
+		if (abt_stack_sz == 0) {
+			rc = ABT_info_query_config(ABT_INFO_QUERY_KIND_DEFAULT_THREAD_STACKSIZE,
+						   &abt_stack_sz);
+			D_ASSERT(rc == ABT_SUCCESS);
+		}
+
+		rc = ABT_thread_attr_create(&abt_stack_attr);
+		if (rc != ABT_SUCCESS) {
+			printf("ABT thread attr create failed: %d\n", rc);
+			return -1;
+		}
+		printf("Recycle ULT stacks of size %zu\n", abt_stack_sz);
+	}
+
 	switch (test_id) {
 	default:
 		break;
@@ -418,6 +512,7 @@ main(int argc, char **argv)
 	ABT_mutex_unlock(abt_lock);
 out:
 	abt_reset();
+	abt_stacks_free();
 	if (abt_attr != ABT_THREAD_ATTR_NULL)
 		ABT_thread_attr_free(&abt_attr);
 
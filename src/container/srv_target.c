@@ -1817,6 +1817,7 @@ ds_cont_tgt_query_handler(crt_rpc_t *rpc)
 	coll_ops.co_reduce		= ds_cont_query_coll_reduce;
 	coll_ops.co_reduce_arg_alloc	= ds_cont_query_stream_alloc;
 	coll_ops.co_reduce_arg_free	= ds_cont_query_stream_free;
+	coll_ops.co_reduce_tree		= true;
 
 	/** packing arguments for aggregator args */
 	pack_args.xcq_rpc_in		= in;
@@ -288,6 +288,88 @@ func PoolProperties() PoolPropertyMap {
 				jsonNumeric: true,
 			},
 		},
+		"qos_iops": {
+			Property: PoolProperty{
+				Number:      daos.PoolPropertyQosIops,
+				Description: "Foreground I/O operations per second limit",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					iops, err := strconv.ParseUint(s, 10, 64)
+					if err != nil {
+						return nil, errors.Errorf("invalid IOPS limit %q", s)
+					}
+					return &PoolPropertyValue{iops}, nil
+				},
+				valueStringer: qosLimitStringer(func(n uint64) string {
+					return fmt.Sprintf("%d", n)
+				}),
+				jsonNumeric: true,
+			},
+		},
+		"qos_cont_iops": {
+			Property: PoolProperty{
+				Number:      daos.PoolPropertyQosContIops,
+				Description: "Per container foreground I/O operations per second limit",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					iops, err := strconv.ParseUint(s, 10, 64)
+					if err != nil {
+						return nil, errors.Errorf("invalid IOPS limit %q", s)
+					}
+					return &PoolPropertyValue{iops}, nil
+				},
+				valueStringer: qosLimitStringer(func(n uint64) string {
+					return fmt.Sprintf("%d", n)
+				}),
+				jsonNumeric: true,
+			},
+		},
+		"qos_bw": {
+			Property: PoolProperty{
+				Number:      daos.PoolPropertyQosBw,
+				Description: "Foreground I/O bandwidth limit",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					b, err := humanize.ParseBytes(strings.TrimSuffix(s, "/s"))
+					if err != nil {
+						return nil, errors.Errorf("invalid bandwidth limit %q", s)
+					}
+					return &PoolPropertyValue{b}, nil
+				},
+				valueStringer: qosLimitStringer(func(n uint64) string {
+					return humanize.IBytes(n) + "/s"
+				}),
+				jsonNumeric: true,
+			},
+		},
+		"qos_cont_bw": {
+			Property: PoolProperty{
+				Number:      daos.PoolPropertyQosContBw,
+				Description: "Per container foreground I/O bandwidth limit",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					b, err := humanize.ParseBytes(strings.TrimSuffix(s, "/s"))
+					if err != nil {
+						return nil, errors.Errorf("invalid bandwidth limit %q", s)
+					}
+					return &PoolPropertyValue{b}, nil
+				},
+				valueStringer: qosLimitStringer(func(n uint64) string {
+					return humanize.IBytes(n) + "/s"
+				}),
+				jsonNumeric: true,
+			},
+		},
+	}
+}
+
+// qosLimitStringer formats a QoS limit, zero means there is no limit.
+func qosLimitStringer(format func(uint64) string) func(*PoolPropertyValue) string {
+	return func(v *PoolPropertyValue) string {
+		n, err := v.GetNumber()
+		if err != nil {
+			return "not set"
+		}
+		if n == 0 {
+			return "unlimited"
+		}
+		return format(n)
 	}
 }
 
@@ -129,6 +129,34 @@ func TestControl_PoolProperties(t *testing.T) {
 			value:  "wat",
 			expErr: errors.New("invalid"),
 		},
+		"qos_iops-valid": {
+			name:    "qos_iops",
+			value:   "10000",
+			expStr:  "qos_iops:10000",
+			expJson: []byte(`{"name":"qos_iops","description":"Foreground I/O operations per second limit","value":10000}`),
+		},
+		"qos_iops-unlimited": {
+			name:    "qos_iops",
+			value:   "0",
+			expStr:  "qos_iops:unlimited",
+			expJson: []byte(`{"name":"qos_iops","description":"Foreground I/O operations per second limit","value":0}`),
+		},
+		"qos_iops-invalid": {
+			name:   "qos_iops",
+			value:  "wat",
+			expErr: errors.New("invalid"),
+		},
+		"qos_cont_bw-valid": {
+			name:    "qos_cont_bw",
+			value:   "1GiB/s",
+			expStr:  "qos_cont_bw:1.0 GiB/s",
+			expJson: []byte(`{"name":"qos_cont_bw","description":"Per container foreground I/O bandwidth limit","value":1073741824}`),
+		},
+		"qos_cont_bw-invalid": {
+			name:   "qos_cont_bw",
+			value:  "wat",
+			expErr: errors.New("invalid"),
+		},
 		"rf-valid": {
 			name:    "rf",
 			value:   "1",
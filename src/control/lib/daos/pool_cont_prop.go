@@ -107,6 +107,14 @@ const (
 	PoolPropertyScrubFreq = C.DAOS_PROP_PO_SCRUB_FREQ
 	// PoolPropertyScrubThresh Checksum scrubbing threshold
 	PoolPropertyScrubThresh = C.DAOS_PROP_PO_SCRUB_THRESH
+	// PoolPropertyQosIops is the foreground I/O operations per second limit of the pool
+	PoolPropertyQosIops = C.DAOS_PROP_PO_QOS_IOPS
+	// PoolPropertyQosBw is the foreground I/O bandwidth limit of the pool
+	PoolPropertyQosBw = C.DAOS_PROP_PO_QOS_BW
+	// PoolPropertyQosContIops is the foreground I/O IOPS limit of each container
+	PoolPropertyQosContIops = C.DAOS_PROP_PO_QOS_CONT_IOPS
+	// PoolPropertyQosContBw is the foreground I/O bandwidth limit of each container
+	PoolPropertyQosContBw = C.DAOS_PROP_PO_QOS_CONT_BW
 )
 
 const (
@@ -283,7 +283,8 @@ func TestServerConfig_Constructed(t *testing.T) {
 				storage.NewTierConfig().
 					WithStorageClass("file").
 					WithBdevDeviceList("/tmp/daos-bdev1", "/tmp/daos-bdev2").
-					WithBdevFileSize(16),
+					WithBdevFileSize(16).
+					WithBdevUring(true),
 			).
 			WithFabricInterface("ib1").
 			WithFabricInterfacePort(20000).
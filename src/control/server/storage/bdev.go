@@ -43,6 +43,7 @@ const (
 	ConfBdevNvmeSetOptions       = "bdev_nvme_set_options"
 	ConfBdevNvmeSetHotplug       = "bdev_nvme_set_hotplug"
 	ConfBdevAioCreate            = "bdev_aio_create"
+	ConfBdevUringCreate          = "bdev_uring_create"
 	ConfBdevNvmeAttachController = C.NVME_CONF_ATTACH_CONTROLLER
 	ConfVmdEnable                = C.NVME_CONF_ENABLE_VMD
 	ConfSetHotplugBusidRange     = C.NVME_CONF_SET_HOTPLUG_RANGE
@@ -407,6 +408,7 @@ type (
 		DeviceList     *BdevDeviceList
 		DeviceFileSize uint64 // size in bytes for NVMe device emulation
 		Tier           int
+		Uring          bool // use io_uring instead of Linux AIO for NVMe device emulation
 	}
 
 	// BdevFormatRequest defines the parameters for a Format operation.
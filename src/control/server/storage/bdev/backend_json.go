@@ -85,6 +85,15 @@ type AioCreateParams struct {
 
 func (acp AioCreateParams) isSpdkSubsystemConfigParams() {}
 
+// UringCreateParams specifies details for a storage.ConfBdevUringCreate method.
+type UringCreateParams struct {
+	BlockSize  uint64 `json:"block_size"`
+	DeviceName string `json:"name"`
+	Filename   string `json:"filename"`
+}
+
+func (ucp UringCreateParams) isSpdkSubsystemConfigParams() {}
+
 // HotplugBusidRangeParams specifies details for a storage.ConfSetHotplugBusidRange method.
 type HotplugBusidRangeParams struct {
 	Begin uint8 `json:"begin"`
@@ -203,6 +212,27 @@ func getAioKdevCreateMethod(name, path string) *SpdkSubsystemConfig {
 	}
 }
 
+func getUringFileCreateMethod(name, path string) *SpdkSubsystemConfig {
+	return &SpdkSubsystemConfig{
+		Method: storage.ConfBdevUringCreate,
+		Params: UringCreateParams{
+			DeviceName: fmt.Sprintf("URING_%s", name),
+			Filename:   path,
+			BlockSize:  aioBlockSize,
+		},
+	}
+}
+
+func getUringKdevCreateMethod(name, path string) *SpdkSubsystemConfig {
+	return &SpdkSubsystemConfig{
+		Method: storage.ConfBdevUringCreate,
+		Params: UringCreateParams{
+			DeviceName: fmt.Sprintf("URING_%s", name),
+			Filename:   path,
+		},
+	}
+}
+
 func getSpdkConfigMethods(req *storage.BdevWriteConfigRequest) (sscs []*SpdkSubsystemConfig) {
 	for _, tier := range req.TierProps {
 		var f configMethodGetter
@@ -212,8 +242,14 @@ func getSpdkConfigMethods(req *storage.BdevWriteConfigRequest) (sscs []*SpdkSubs
 			f = getNvmeAttachMethod
 		case storage.ClassFile:
 			f = getAioFileCreateMethod
+			if tier.Uring {
+				f = getUringFileCreateMethod
+			}
 		case storage.ClassKdev:
 			f = getAioKdevCreateMethod
+			if tier.Uring {
+				f = getUringKdevCreateMethod
+			}
 		}
 
 		for index, dev := range tier.DeviceList.Devices() {
@@ -64,6 +64,7 @@ func TestBackend_newSpdkConfig(t *testing.T) {
 		enableVmd          bool
 		enableHotplug      bool
 		busidRange         string
+		uring              bool
 		vosEnv             string
 		accelEngine        string
 		accelOptMask       storage.AccelOptionBits
@@ -167,6 +168,61 @@ func TestBackend_newSpdkConfig(t *testing.T) {
 				}...),
 			vosEnv: "AIO",
 		},
+		"io_uring file class; multiple files": {
+			class:      storage.ClassFile,
+			fileSizeGB: 1,
+			uring:      true,
+			devList:    []string{"/path/to/myfile", "/path/to/myotherfile"},
+			expBdevCfgs: append(defaultSpdkConfig().Subsystems[0].Configs,
+				[]*SpdkSubsystemConfig{
+					{
+						Method: storage.ConfBdevUringCreate,
+						Params: UringCreateParams{
+							BlockSize:  humanize.KiByte * 4,
+							DeviceName: fmt.Sprintf("URING_%s_0_%d", host, tierID),
+							Filename:   "/path/to/myfile",
+						},
+					},
+					{
+						Method: storage.ConfBdevUringCreate,
+						Params: UringCreateParams{
+							BlockSize:  humanize.KiByte * 4,
+							DeviceName: fmt.Sprintf("URING_%s_1_%d", host, tierID),
+							Filename:   "/path/to/myotherfile",
+						},
+					},
+				}...),
+			vosEnv: "URING",
+		},
+		"io_uring kdev class; multiple devices": {
+			class:   storage.ClassKdev,
+			uring:   true,
+			devList: []string{"/dev/sdb", "/dev/sdc"},
+			expBdevCfgs: append(defaultSpdkConfig().Subsystems[0].Configs,
+				[]*SpdkSubsystemConfig{
+					{
+						Method: storage.ConfBdevUringCreate,
+						Params: UringCreateParams{
+							DeviceName: fmt.Sprintf("URING_%s_0_%d", host, tierID),
+							Filename:   "/dev/sdb",
+						},
+					},
+					{
+						Method: storage.ConfBdevUringCreate,
+						Params: UringCreateParams{
+							DeviceName: fmt.Sprintf("URING_%s_1_%d", host, tierID),
+							Filename:   "/dev/sdc",
+						},
+					},
+				}...),
+			vosEnv: "URING",
+		},
+		"io_uring nvme class": {
+			class:          storage.ClassNvme,
+			uring:          true,
+			devList:        []string{test.MockPCIAddr(1), test.MockPCIAddr(2)},
+			expValidateErr: errors.New("bdev_uring is not supported"),
+		},
 		"multiple controllers; acceleration set to spdk; move and crc opts specified": {
 			class:        storage.ClassNvme,
 			devList:      []string{test.MockPCIAddr(1), test.MockPCIAddr(2)},
@@ -197,6 +253,7 @@ func TestBackend_newSpdkConfig(t *testing.T) {
 					DeviceList: storage.MustNewBdevDeviceList(tc.devList...),
 					FileSize:   tc.fileSizeGB,
 					BusidRange: storage.MustNewBdevBusRange(tc.busidRange),
+					Uring:      tc.uring,
 				},
 			}
 			if tc.class != "" {
@@ -171,6 +171,12 @@ func (tc *TierConfig) WithBdevFileSize(size int) *TierConfig {
 	return tc
 }
 
+// WithBdevUring sets whether io_uring is used instead of Linux AIO (file or kdev class).
+func (tc *TierConfig) WithBdevUring(uring bool) *TierConfig {
+	tc.Bdev.Uring = uring
+	return tc
+}
+
 // WithBdevBusidRange sets the bus-ID range to be used to filter hot plug events.
 func (tc *TierConfig) WithBdevBusidRange(rangeStr string) *TierConfig {
 	tc.Bdev.BusidRange = MustNewBdevBusRange(rangeStr)
@@ -515,6 +521,7 @@ type BdevConfig struct {
 	DeviceCount int             `yaml:"bdev_number,omitempty"`
 	FileSize    int             `yaml:"bdev_size,omitempty"`
 	BusidRange  *BdevBusRange   `yaml:"bdev_busid_range,omitempty"`
+	Uring       bool            `yaml:"bdev_uring,omitempty"`
 }
 
 func (bc *BdevConfig) checkNonZeroDevFileSize(class Class) error {
@@ -562,6 +569,11 @@ func (bc *BdevConfig) Validate(class Class) error {
 		return errors.Errorf("bdev_class value %q not supported (valid: nvme/kdev/file)", class)
 	}
 
+	if bc.Uring && class != ClassFile && class != ClassKdev {
+		return errors.Errorf("bdev_uring is not supported by bdev_class %s (valid: kdev/file)",
+			class)
+	}
+
 	return nil
 }
 
@@ -748,7 +760,17 @@ func (c *Config) Validate() error {
 
 	// set vos environment variable based on class of first bdev config
 	if fbc.Class == ClassFile || fbc.Class == ClassKdev {
+		// all emulated devices are driven by the same SPDK bdev module
+		for _, bc := range bdevCfgs {
+			if bc.Bdev.Uring != fbc.Bdev.Uring {
+				return errors.New("bdev_uring must be set consistently across bdev tiers")
+			}
+		}
+
 		c.VosEnv = "AIO"
+		if fbc.Bdev.Uring {
+			c.VosEnv = "URING"
+		}
 		return nil
 	}
 
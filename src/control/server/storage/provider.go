@@ -272,6 +272,7 @@ func BdevTierPropertiesFromConfig(cfg *TierConfig) BdevTierProperties {
 		// cfg size in nr GiBytes
 		DeviceFileSize: uint64(humanize.GiByte * cfg.Bdev.FileSize),
 		Tier:           cfg.Tier,
+		Uring:          cfg.Bdev.Uring,
 	}
 }
 
@@ -22,6 +22,7 @@
 #include <daos/btree_class.h>
 #include <daos/common.h>
 #include <daos/placement.h>
+#include <daos_srv/bio.h>
 #include "srv_internal.h"
 #include "drpc_internal.h"
 #include <gurt/telemetry_common.h>
@@ -289,6 +290,59 @@ retry:
 	return tgt_nr;
 }
 
+/*
+ * Pick the NUMA node the NVMe SSDs are attached to when no NUMA node was
+ * specified, as long as it has enough cores for all the xstreams.
+ */
+static void
+dss_topo_auto_numa(int depth, int numa_node_nr, bool tgt_oversub)
+{
+	hwloc_obj_t	obj;
+	hwloc_obj_t	corenode;
+	unsigned int	os_nr = 0;
+	int		node;
+	int		ncores = 0;
+	int		needed;
+	int		k;
+
+	/* sysfs reports OS indexes, which can be sparse and differ from hwloc logical ones */
+	for (k = 0; k < numa_node_nr; k++) {
+		obj = hwloc_get_obj_by_depth(dss_topo, depth, k);
+		if (obj != NULL && obj->os_index + 1 > os_nr)
+			os_nr = obj->os_index + 1;
+	}
+
+	node = bio_nvme_numa_node(dss_nvme_conf, os_nr);
+	if (node < 0) {
+		D_PRINT("NUMA auto placement: NVMe locality unknown\n");
+		return;
+	}
+
+	obj = hwloc_get_numanode_obj_by_os_index(dss_topo, node);
+	if (obj == NULL) {
+		D_PRINT("NUMA auto placement: NVMe NUMA node %d not in the topology\n", node);
+		return;
+	}
+
+	for (k = 0; k < dss_core_nr; k++) {
+		corenode = hwloc_get_obj_by_depth(dss_topo, dss_core_depth, k);
+		if (corenode != NULL && hwloc_bitmap_isincluded(corenode->cpuset, obj->cpuset))
+			ncores++;
+	}
+
+	needed = dss_core_offset + DAOS_TGT0_OFFSET + dss_tgt_offload_xs_nr +
+		 (nr_threads > 0 ? nr_threads : 1);
+	if (ncores < needed && !tgt_oversub) {
+		D_PRINT("NUMA auto placement: NUMA node %d with NVMe has %d cores, "
+			"%d needed\n", obj->logical_index, ncores, needed);
+		return;
+	}
+
+	D_PRINT("NUMA auto placement: binding to NUMA node %d (OS index %d, %d cores) "
+		"with NVMe\n", obj->logical_index, node, ncores);
+	dss_numa_node = obj->logical_index;
+}
+
 static int
 dss_topo_init()
 {
@@ -299,6 +353,7 @@ dss_topo_init()
 	int		k;
 	hwloc_obj_t	corenode;
 	bool            tgt_oversub = false;
+	bool		numa_auto = false;
 
 	hwloc_topology_init(&dss_topo);
 	hwloc_topology_load(dss_topo);
@@ -308,6 +363,10 @@ dss_topo_init()
 	depth = hwloc_get_type_depth(dss_topo, HWLOC_OBJ_NUMANODE);
 	numa_node_nr = hwloc_get_nbobjs_by_depth(dss_topo, depth);
 	d_getenv_bool("DAOS_TARGET_OVERSUBSCRIBE", &tgt_oversub);
+	d_getenv_bool("DAOS_NUMA_AUTO", &numa_auto);
+
+	if (dss_numa_node == -1 && numa_auto && numa_node_nr > 1)
+		dss_topo_auto_numa(depth, numa_node_nr, tgt_oversub);
 
 	/* if no NUMA node was specified, or NUMA data unavailable */
 	/* fall back to the legacy core allocation algorithm */
@@ -339,6 +398,7 @@ dss_topo_init()
 			dss_numa_node);
 		return -DER_INVAL;
 	}
+	d_tm_set_gauge(dss_engine_metrics.numa_node, dss_numa_node);
 
 	/* create an empty bitmap, then set each bit as we */
 	/* find a core that matches */
@@ -123,11 +123,41 @@ struct sched_req_info {
 	uint32_t		sri_req_limit;
 };
 
+/* Token bucket for the QoS of foreground I/O */
+struct sched_qos_bucket {
+	/* Tokens replenished per second, 0 means unlimited */
+	uint64_t		sqb_rate;
+	/* Available tokens in 1/1000 unit, it's negative when overdrawn by large request */
+	int64_t			sqb_tokens;
+	/* When tokens are replenished, in msecs */
+	uint64_t		sqb_ts;
+};
+
+struct sched_cont_info {
+	/* Link to 'sched_pool_info->spi_cont_list' */
+	d_list_t		sci_link;
+	uuid_t			sci_cont_id;
+	struct sched_qos_bucket	sci_qos_iops;
+	struct sched_qos_bucket	sci_qos_bw;
+	/* Queued requests referring to this container info */
+	uint32_t		sci_req_cnt;
+	/* When the container info is used, in msecs */
+	uint64_t		sci_access_ts;
+};
+
 struct sched_pool_info {
 	/* Link to 'sched_info->si_pool_hash' */
 	d_list_t		spi_hash_link;
 	uuid_t			spi_pool_id;
 	struct sched_req_info	spi_req_array[SCHED_REQ_MAX];
+	/* QoS limits and token buckets for foreground I/O */
+	struct sched_qos_limits	spi_qos;
+	struct sched_qos_bucket	spi_qos_iops;
+	struct sched_qos_bucket	spi_qos_bw;
+	/* Per container QoS info, only used when per container limit is set */
+	d_list_t		spi_cont_list;
+	/* When the idle container infos are purged, in msecs */
+	uint64_t		spi_cont_purge_ts;
 	/* When space pressure info acquired, in msecs */
 	uint64_t		spi_space_ts;
 	/* When pool is running into space pressure, in msecs */
@@ -152,38 +182,57 @@ struct sched_request {
 	void			*sr_arg;
 	ABT_thread		 sr_ult;
 	struct sched_pool_info	*sr_pool_info;
+	/* Per container QoS info for foreground I/O request */
+	struct sched_cont_info	*sr_cont_info;
 	/* Wakeup time for the sleeping request, in milli seconds */
 	uint64_t		 sr_wakeup_time;
 	/* When the request is enqueued, in msecs */
 	uint64_t		 sr_enqueue_ts;
+	/* When the request is expected to be kicked off, for EDF policy, in msecs */
+	uint64_t		 sr_deadline;
+	/* SCHED_CLASS_* */
+	unsigned int		 sr_class;
 	unsigned int		 sr_abort:1,
 				 /* sr_ult is sched_request-owned */
-				 sr_owned:1;
+				 sr_owned:1,
+				 /* Foreground I/O request subject to QoS limits */
+				 sr_qos:1,
+				 /* Request has been held by QoS limits */
+				 sr_qos_held:1;
 };
 
 bool		sched_prio_disabled;
 unsigned int	sched_relax_intvl = SCHED_RELAX_INTVL_DEFAULT;
 unsigned int	sched_relax_mode;
+/* Max spinning time (us) after the last arrival in adaptive relax mode */
+unsigned int	sched_spin_window = SCHED_SPIN_WINDOW_DEFAULT;
+/* Admission control on foreground I/O, zero value means disabled */
+unsigned int	sched_admit_depth;	/* Max queued and running ULTs of the xstream */
+unsigned int	sched_admit_delay;	/* Max queueing delay (ms) of I/O requests */
 unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
+bool		sched_work_steal = true;
 
-enum {
-	/* All requests for various pools are processed in FIFO */
-	SCHED_POLICY_FIFO	= 0,
-	/*
-	 * All requests are processed in RR based on certain ID (Client ID,
-	 * Pool ID, Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_RR,
-	/*
-	 * Request priority is based on certain ID (Client ID, Pool ID,
-	 * Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_PRIO,
-	SCHED_POLICY_MAX
+unsigned int	sched_policy = SCHED_POLICY_FIFO;
+
+/* Fetch no larger than this is latency sensitive small read */
+#define SCHED_SMALL_READ_SZ	(64UL << 10)
+
+/* Queueing deadlines in msecs for foreground I/O classes, used by EDF policy */
+static unsigned int edf_deadlines[SCHED_CLASS_IO_MAX] = {
+	1,	/* SCHED_CLASS_READ_SMALL */
+	5,	/* SCHED_CLASS_READ */
+	10,	/* SCHED_CLASS_UPDATE */
 };
 
-static int	sched_policy;
+static char *sched_class_names[SCHED_CLASS_MAX] = {
+	"read_small",	/* SCHED_CLASS_READ_SMALL */
+	"read",		/* SCHED_CLASS_READ */
+	"update",	/* SCHED_CLASS_UPDATE */
+	"migrate",	/* SCHED_CLASS_MIGRATE */
+	"gc",		/* SCHED_CLASS_GC */
+	"scrub",	/* SCHED_CLASS_SCRUB */
+};
 
 /*
  * Time threshold for giving IO up throttling. If space pressure stays in the
@@ -326,6 +375,7 @@ static void
 spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 {
 	struct sched_pool_info	*spi = sched_rlink2spi(rlink);
+	struct sched_cont_info	*sci, *tmp;
 	unsigned int		 type;
 
 	/*
@@ -346,6 +396,12 @@ spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 		D_ASSERT(d_list_empty(pool2req_list(spi, type)));
 	}
 
+	d_list_for_each_entry_safe(sci, tmp, &spi->spi_cont_list, sci_link) {
+		D_ASSERTF(sci->sci_req_cnt == 0, "req_cnt:%u\n", sci->sci_req_cnt);
+		d_list_del_init(&sci->sci_link);
+		D_FREE(sci);
+	}
+
 	D_FREE(spi);
 }
 
@@ -442,15 +498,383 @@ add_purge_list(struct dss_xstream *dx, struct sched_pool_info *spi)
 	d_list_add_tail(&pi->pi_link, &info->si_purge_list);
 }
 
+/*
+ * Per-xstream ULT stack cache.
+ *
+ * Argobots recycles the default size stacks through its per-xstream stack
+ * pool, but allocates and frees the stack on each ULT creation and exit for
+ * the ULTs with non-default stack size. DSS_DEEP_STACK_SZ is the only
+ * non-default stack size used by the engine, the deep stacks of ULTs created
+ * on current xstream are taken from a per-xstream cache instead, and put back
+ * when the ULT function returns. The returned stack is still in
+ * use until the ULT switches out, but that's fine since no other ULT on this
+ * xstream can run (and create a ULT on the stack) before it does. The cached
+ * stacks exceeding sched_stack_cache_max are freed on next schedule cycle.
+ *
+ * The stacks provided to Argobots aren't guarded by ABT_STACK_OVERFLOW_CHECK,
+ * so the cache is disabled when the overflow check is configured.
+ */
+struct sched_stack {
+	struct sched_stack	 *ss_next;
+	struct sched_info	 *ss_info;
+	void			(*ss_func)(void *);
+	void			 *ss_arg;
+};
+
+/* Keep the stack pointer aligned */
+#define SCHED_STACK_HDR_SZ	D_ALIGNUP(sizeof(struct sched_stack), 64)
+
+unsigned int	sched_stack_cache_max = 32;
+
+static void
+stack_ult_wrapper(void *arg)
+{
+	struct sched_stack	*ss = arg;
+	struct sched_stack_pool	*ssp = &ss->ss_info->si_stacks;
+
+	ss->ss_func(ss->ss_arg);
+
+	ss->ss_next = ssp->ssp_free;
+	ssp->ssp_free = ss;
+	ssp->ssp_free_cnt++;
+}
+
+int
+sched_stack_create_thread(struct dss_xstream *dx, void (*func)(void *), void *arg,
+			  ABT_thread_attr t_attr)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_stack_pool	*ssp = &info->si_stacks;
+	struct sched_stack	*ss;
+	size_t			 stack_size;
+	int			 rc;
+
+	if (info->si_stack_attr == ABT_THREAD_ATTR_NULL)
+		return -DER_NOTSUPPORTED;
+
+	rc = ABT_thread_attr_get_stacksize(t_attr, &stack_size);
+	if (rc != ABT_SUCCESS || stack_size != DSS_DEEP_STACK_SZ)
+		return -DER_NOTSUPPORTED;
+
+	if (ssp->ssp_free != NULL) {
+		ss = ssp->ssp_free;
+		ssp->ssp_free = ss->ss_next;
+		D_ASSERT(ssp->ssp_free_cnt > 0);
+		ssp->ssp_free_cnt--;
+	} else {
+		D_ALLOC(ss, SCHED_STACK_HDR_SZ + stack_size);
+		if (ss == NULL)
+			return -DER_NOMEM;
+	}
+
+	ss->ss_next = NULL;
+	ss->ss_info = info;
+	ss->ss_func = func;
+	ss->ss_arg = arg;
+
+	rc = ABT_thread_attr_set_stack(info->si_stack_attr, (char *)ss + SCHED_STACK_HDR_SZ,
+				       stack_size);
+	D_ASSERT(rc == ABT_SUCCESS);
+
+	rc = ABT_thread_create(dx->dx_pools[DSS_POOL_GENERIC], stack_ult_wrapper, ss,
+			       info->si_stack_attr, NULL);
+	if (rc != ABT_SUCCESS) {
+		ss->ss_next = ssp->ssp_free;
+		ssp->ssp_free = ss;
+		ssp->ssp_free_cnt++;
+	}
+
+	return dss_abterr2der(rc);
+}
+
+/* Free the cached stacks exceeding the cache limit, or all of them */
+static void
+stack_cache_trim(struct sched_info *info, bool all)
+{
+	struct sched_stack_pool	*ssp = &info->si_stacks;
+	struct sched_stack	*ss;
+
+	while (ssp->ssp_free != NULL && (all || ssp->ssp_free_cnt > sched_stack_cache_max)) {
+		ss = ssp->ssp_free;
+		ssp->ssp_free = ss->ss_next;
+		ssp->ssp_free_cnt--;
+		D_FREE(ss);
+	}
+}
+
+static void
+stack_cache_fini(struct sched_info *info)
+{
+	stack_cache_trim(info, true);
+	if (info->si_stack_attr != ABT_THREAD_ATTR_NULL)
+		ABT_thread_attr_free(&info->si_stack_attr);
+}
+
+static void
+stack_cache_init(struct sched_info *info)
+{
+	int	rc;
+
+	memset(&info->si_stacks, 0, sizeof(info->si_stacks));
+	info->si_stack_attr = ABT_THREAD_ATTR_NULL;
+	if (sched_stack_cache_max == 0)
+		return;
+
+	/* Stack cache is disabled on failure */
+	rc = ABT_thread_attr_create(&info->si_stack_attr);
+	if (rc != ABT_SUCCESS) {
+		D_WARN("Failed to create ULT attr for stack cache: %d\n", rc);
+		info->si_stack_attr = ABT_THREAD_ATTR_NULL;
+	}
+}
+
+/*
+ * Work stealing among the helper xstreams shared by all targets.
+ *
+ * ULTs offloaded to a shared helper (DSS_XS_IOFW/DSS_XS_OFFLOAD) are queued as
+ * descriptors on the steal queue of the helper chosen by sched_ult2xs(). The
+ * owner helper moves at most SCHED_STEAL_BATCH of them into its ABT pool on
+ * each schedule cycle, from the queue head and only when it doesn't have
+ * enough runnable ULTs, so that the backlog stays stealable. An idle helper
+ * steals half of the longest queue from its tail.
+ *
+ * ULTs are always created on the helper executing them, a ULT never migrates
+ * once it has started, which keeps per-xstream TLS and sched_info consistent.
+ */
+struct sched_steal_item {
+	d_list_t	  ssi_link;
+	void		(*ssi_func)(void *);
+	void		 *ssi_arg;
+	size_t		  ssi_stack_size;
+	/* ULT sends RPCs (IO forwarding), requires helper with cart context */
+	bool		  ssi_comm;
+};
+
+#define SCHED_STEAL_BATCH	16
+
+int
+sched_steal_enqueue(struct dss_xstream *dx, void (*func)(void *), void *arg,
+		    size_t stack_size, bool comm)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_steal_item	*item;
+
+	D_ASSERT(sched_steal_xs(dx));
+	if (sched_xstream_stopping())
+		return -DER_SHUTDOWN;
+
+	D_ALLOC_PTR(item);
+	if (item == NULL)
+		return -DER_NOMEM;
+
+	item->ssi_func = func;
+	item->ssi_arg = arg;
+	item->ssi_stack_size = stack_size;
+	item->ssi_comm = comm;
+
+	sched_note_arrival(info);
+
+	D_SPIN_LOCK(&info->si_steal_lock);
+	d_list_add_tail(&item->ssi_link, &info->si_steal_list);
+	info->si_steal_cnt++;
+	D_SPIN_UNLOCK(&info->si_steal_lock);
+
+	return 0;
+}
+
+static int
+steal_item_create(struct dss_xstream *dx, struct sched_steal_item *item)
+{
+	ABT_thread_attr	attr = ABT_THREAD_ATTR_NULL;
+	int		rc;
+
+	if (item->ssi_stack_size > 0) {
+		rc = ABT_thread_attr_create(&attr);
+		if (rc != ABT_SUCCESS)
+			return dss_abterr2der(rc);
+
+		rc = ABT_thread_attr_set_stacksize(attr, item->ssi_stack_size);
+		D_ASSERT(rc == ABT_SUCCESS);
+	}
+
+	/* Not sched_create_thread(), the ULT was accepted before stopping */
+	rc = ABT_thread_create(dx->dx_pools[DSS_POOL_GENERIC], item->ssi_func,
+			       item->ssi_arg, attr, NULL);
+	if (attr != ABT_THREAD_ATTR_NULL)
+		ABT_thread_attr_free(&attr);
+
+	return dss_abterr2der(rc);
+}
+
+/* Create ULTs for the items on @list, failed items are put back to @dx queue */
+static int
+steal_list_create(struct dss_xstream *dx, d_list_t *list)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_steal_item	*item, *tmp;
+	int			 created = 0, failed = 0;
+	int			 rc;
+
+	d_list_for_each_entry_safe(item, tmp, list, ssi_link) {
+		rc = steal_item_create(dx, item);
+		if (rc) {
+			D_ERROR("XS(%d) failed to create offloaded ULT: "DF_RC"\n",
+				dx->dx_xs_id, DP_RC(rc));
+			failed++;
+			continue;
+		}
+		d_list_del(&item->ssi_link);
+		D_FREE(item);
+		created++;
+	}
+
+	if (failed) {
+		D_SPIN_LOCK(&info->si_steal_lock);
+		d_list_splice_init(list, &info->si_steal_list);
+		info->si_steal_cnt += failed;
+		D_SPIN_UNLOCK(&info->si_steal_lock);
+	}
+
+	return created;
+}
+
+/* Move at most @max queued items of @dx into its ABT pool */
+static int
+steal_drain(struct dss_xstream *dx, uint32_t max)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_steal_item	*item;
+	d_list_t		 list;
+
+	if (!sched_steal_xs(dx) || info->si_steal_cnt == 0)
+		return 0;
+
+	D_INIT_LIST_HEAD(&list);
+	D_SPIN_LOCK(&info->si_steal_lock);
+	while (max > 0 && !d_list_empty(&info->si_steal_list)) {
+		item = d_list_entry(info->si_steal_list.next, struct sched_steal_item, ssi_link);
+		d_list_move_tail(&item->ssi_link, &list);
+		D_ASSERT(info->si_steal_cnt > 0);
+		info->si_steal_cnt--;
+		max--;
+	}
+	D_SPIN_UNLOCK(&info->si_steal_lock);
+
+	return steal_list_create(dx, &list);
+}
+
+/* Steal half of the longest steal queue of other helpers from its tail */
+static int
+steal_from_others(struct dss_xstream *dx)
+{
+	struct sched_info	*info, *victim = NULL;
+	struct dss_xstream	*dx_victim;
+	struct sched_steal_item	*item;
+	d_list_t		 list, *link;
+	uint32_t		 cnt, max = 0;
+	int			 i, stolen;
+
+	for (i = dss_sys_xs_nr; i < dss_xstream_cnt(); i++) {
+		dx_victim = dss_get_xstream(i);
+		if (dx_victim == NULL || dx_victim == dx || !sched_steal_xs(dx_victim))
+			continue;
+
+		info = &dx_victim->dx_sched_info;
+		/* Racy read, it's only a hint */
+		cnt = info->si_steal_cnt;
+		if (cnt > max && !info->si_stop) {
+			max = cnt;
+			victim = info;
+		}
+	}
+
+	if (victim == NULL)
+		return 0;
+
+	cnt = min((max + 1) / 2, SCHED_STEAL_BATCH);
+	D_INIT_LIST_HEAD(&list);
+
+	D_SPIN_LOCK(&victim->si_steal_lock);
+	link = victim->si_steal_list.prev;
+	while (cnt > 0 && link != &victim->si_steal_list) {
+		item = d_list_entry(link, struct sched_steal_item, ssi_link);
+		link = link->prev;
+		if (item->ssi_comm && !dx->dx_comm)
+			continue;
+		d_list_move(&item->ssi_link, &list);
+		D_ASSERT(victim->si_steal_cnt > 0);
+		victim->si_steal_cnt--;
+		cnt--;
+	}
+	D_SPIN_UNLOCK(&victim->si_steal_lock);
+
+	stolen = steal_list_create(dx, &list);
+	if (stolen > 0)
+		d_tm_inc_counter(dx->dx_sched_info.si_stats.ss_ws_stolen, stolen);
+
+	return stolen;
+}
+
+/*
+ * Feed the helper ABT pool from the steal queues on starting a schedule cycle,
+ * @ready is the number of runnable ULTs in the ABT pool.
+ */
+static int
+steal_process(struct dss_xstream *dx, size_t ready)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	int			 created = 0;
+
+	if (!sched_steal_xs(dx))
+		return 0;
+
+	if (ready < SCHED_STEAL_BATCH)
+		created = steal_drain(dx, SCHED_STEAL_BATCH - ready);
+
+	if (ready == 0 && created == 0 && !info->si_stop)
+		created = steal_from_others(dx);
+
+	d_tm_set_gauge(info->si_stats.ss_ws_queue, info->si_steal_cnt);
+	return created;
+}
+
+static void
+steal_list_fini(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_steal_item	*item, *tmp;
+
+	if (!sched_steal_xs(dx))
+		goto out;
+
+	if (info->si_steal_cnt != 0)
+		D_ERROR("XS(%d) %u offloaded ULTs are dropped\n", dx->dx_xs_id,
+			info->si_steal_cnt);
+
+	d_list_for_each_entry_safe(item, tmp, &info->si_steal_list, ssi_link) {
+		d_list_del(&item->ssi_link);
+		D_FREE(item);
+	}
+	info->si_steal_cnt = 0;
+out:
+	D_SPIN_DESTROY(&info->si_steal_lock);
+}
+
+static void prof_fini(struct dss_xstream *dx);
+static void prof_check_reset(struct dss_xstream *dx);
+
 static void
 sched_info_fini(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_request	*req, *tmp;
+	int			 i;
 
 	D_ASSERT(info->si_req_cnt == 0);
 	D_ASSERT(d_list_empty(&info->si_sleep_list));
 	D_ASSERT(d_list_empty(&info->si_fifo_list));
+	for (i = 0; i < SCHED_CLASS_IO_MAX; i++)
+		D_ASSERT(d_list_empty(&info->si_edf_list[i]));
 
 	prune_purge_list(dx);
 
@@ -464,6 +888,10 @@ sched_info_fini(struct dss_xstream *dx)
 		d_list_del_init(&req->sr_link);
 		D_FREE(req);
 	}
+
+	steal_list_fini(dx);
+	stack_cache_fini(info);
+	prof_fini(dx);
 }
 
 static int
@@ -486,6 +914,7 @@ prealloc_requests(struct sched_info *info, int cnt)
 }
 
 #define SCHED_PREALLOC_INIT_CNT		8192
+#define SCHED_DELAY_BUCKETS		16	/* 1ms ~ 32s */
 #define SCHED_PREALLOC_BATCH_CNT	1024
 
 static void
@@ -493,7 +922,7 @@ sched_metrics_init(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_stats	*stats = &info->si_stats;
-	int			 rc;
+	int			 i, rc;
 
 	stats->ss_busy_ts = info->si_cur_ts;
 	stats->ss_watchdog_ts = 0;
@@ -509,6 +938,18 @@ sched_metrics_init(struct dss_xstream *dx)
 	if (rc)
 		D_WARN("Failed to create relax_time telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&stats->ss_relax_saved, D_TM_COUNTER,
+			     "Measured CPU time saved by relaxing", "us",
+			     "sched/relax_saved/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create relax_saved telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_wakeup_lat, D_TM_STATS_GAUGE,
+			     "Delay of the event arrived on relaxing", "us",
+			     "sched/wakeup_latency/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create wakeup_latency telemetry: "DF_RC"\n", DP_RC(rc));
+
 	rc = d_tm_add_metric(&stats->ss_wq_len, D_TM_GAUGE, "Wait queue length", "req",
 			     "sched/wait_queue/xs_%u", dx->dx_xs_id);
 	if (rc)
@@ -528,25 +969,84 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "ULT", "sched/cycle_size/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create cycle_size telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_qos_throttled, D_TM_COUNTER,
+			     "Requests throttled by QoS limits", "req",
+			     "sched/qos_throttled/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create qos_throttled telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_qos_delay, D_TM_STATS_GAUGE,
+			     "Time of requests being throttled by QoS limits", "ms",
+			     "sched/qos_delay/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create qos_delay telemetry: "DF_RC"\n", DP_RC(rc));
+
+	/* Requests are only queued on VOS xstream */
+	for (i = 0; dx->dx_main_xs && i < SCHED_CLASS_MAX; i++) {
+		char	path[D_TM_MAX_NAME_LEN];
+
+		snprintf(path, sizeof(path), "sched/queue_delay/%s/xs_%u", sched_class_names[i],
+			 dx->dx_xs_id);
+		rc = d_tm_add_metric(&stats->ss_queue_delay[i], D_TM_STATS_GAUGE,
+				     "Request queueing delay", "ms", path);
+		if (rc == 0)
+			rc = d_tm_init_histogram(stats->ss_queue_delay[i], path,
+						 SCHED_DELAY_BUCKETS, 1, 2);
+		if (rc)
+			D_WARN("Failed to create %s queue_delay telemetry: "DF_RC"\n",
+			       sched_class_names[i], DP_RC(rc));
+	}
+
+	if (!sched_steal_xs(dx))
+		return;
+
+	rc = d_tm_add_metric(&stats->ss_ws_queue, D_TM_STATS_GAUGE,
+			     "Offloaded ULTs queued on the helper", "ULT",
+			     "sched/steal_queue/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create steal_queue telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_ws_stolen, D_TM_COUNTER,
+			     "Offloaded ULTs stolen from other helpers", "ULT",
+			     "sched/steal_count/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create steal_count telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_rejected, D_TM_COUNTER,
+			     "I/O requests rejected on overload", "req",
+			     "sched/rejected/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create rejected telemetry: "DF_RC"\n", DP_RC(rc));
 }
 
 static int
 sched_info_init(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
-	int			 rc;
+	int			 i, rc;
 
 	info->si_cur_ts = daos_getmtime_coarse();
 	info->si_cur_seq = 0;
 	D_INIT_LIST_HEAD(&info->si_idle_list);
 	D_INIT_LIST_HEAD(&info->si_sleep_list);
 	D_INIT_LIST_HEAD(&info->si_fifo_list);
+	for (i = 0; i < SCHED_CLASS_IO_MAX; i++)
+		D_INIT_LIST_HEAD(&info->si_edf_list[i]);
 	D_INIT_LIST_HEAD(&info->si_purge_list);
+	D_INIT_LIST_HEAD(&info->si_steal_list);
+	info->si_steal_cnt = 0;
 	info->si_req_cnt = 0;
+	info->si_qos_held_cnt = 0;
 	info->si_sleep_cnt = 0;
 	info->si_wait_cnt = 0;
 	info->si_stop = 0;
 	sched_metrics_init(dx);
+	stack_cache_init(info);
+
+	rc = D_SPIN_INIT(&info->si_steal_lock, PTHREAD_PROCESS_PRIVATE);
+	if (rc)
+		return rc;
 
 	rc = d_hash_table_create(D_HASH_FT_NOLOCK, 4,
 				 NULL, &sched_pool_hash_ops,
@@ -587,6 +1087,7 @@ cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 		return NULL;
 	}
 	D_INIT_LIST_HEAD(&spi->spi_hash_link);
+	D_INIT_LIST_HEAD(&spi->spi_cont_list);
 	uuid_copy(spi->spi_pool_id, pool_uuid);
 
 	for (type = SCHED_REQ_UPDATE; type < SCHED_REQ_MAX; type++) {
@@ -640,7 +1141,10 @@ req_get(struct dss_xstream *dx, struct sched_req_attr *attr,
 	req->sr_ult	= ult;
 	req->sr_abort	= 0;
 	req->sr_owned	= (owned ? 1 : 0);
+	req->sr_qos	= 0;
+	req->sr_qos_held = 0;
 	req->sr_pool_info = spi;
+	req->sr_cont_info = NULL;
 
 	return req;
 }
@@ -772,6 +1276,171 @@ out:
 	return spi->spi_space_pressure;
 }
 
+/*
+ * QoS of foreground I/O: Each pool (and each container when per container limit
+ * is set) has token buckets for IOPS and bandwidth, the queued update & fetch
+ * requests are held until there are tokens available. Tokens worth 100 msecs
+ * could be accumulated for burst, and a large request is allowed to overdraw
+ * the bucket, so that the following requests will be held until the debt is
+ * paid off.
+ *
+ * To avoid RPC timeout, a throttled request won't be held for more than 20
+ * seconds.
+ */
+#define SCHED_QOS_BURST_MSECS	100	/* msecs */
+#define SCHED_QOS_DELAY_MAX	20000	/* msecs */
+#define SCHED_QOS_CONT_AGE_MAX	60000	/* msecs */
+
+static inline int64_t
+qos_bucket_cap(struct sched_qos_bucket *bkt)
+{
+	/* At least one whole token */
+	return max((int64_t)(bkt->sqb_rate * SCHED_QOS_BURST_MSECS), (int64_t)1000);
+}
+
+static inline void
+qos_bucket_set(struct sched_qos_bucket *bkt, uint64_t rate, uint64_t now)
+{
+	if (bkt->sqb_rate == rate)
+		return;
+
+	bkt->sqb_rate = rate;
+	bkt->sqb_tokens = rate ? qos_bucket_cap(bkt) : 0;
+	bkt->sqb_ts = now;
+}
+
+static inline bool
+qos_bucket_empty(struct sched_qos_bucket *bkt, uint64_t now)
+{
+	uint64_t	elapsed;
+
+	if (bkt->sqb_rate == 0)
+		return false;
+
+	if (now > bkt->sqb_ts) {
+		/* 'sqb_rate' tokens per second is 'sqb_rate' 1/1000 tokens per msec */
+		elapsed = min(now - bkt->sqb_ts, 1000UL);
+		bkt->sqb_tokens = min(bkt->sqb_tokens + (int64_t)(bkt->sqb_rate * elapsed),
+				      qos_bucket_cap(bkt));
+		bkt->sqb_ts = now;
+	}
+
+	return bkt->sqb_tokens <= 0;
+}
+
+static inline void
+qos_bucket_charge(struct sched_qos_bucket *bkt, uint64_t cost)
+{
+	if (bkt->sqb_rate != 0)
+		bkt->sqb_tokens -= (int64_t)(cost * 1000);
+}
+
+static inline bool
+qos_cont_enabled(struct sched_pool_info *spi)
+{
+	return spi->spi_qos.sql_cont_iops != 0 || spi->spi_qos.sql_cont_bw != 0;
+}
+
+static inline bool
+qos_enabled(struct sched_pool_info *spi)
+{
+	return spi->spi_qos.sql_iops != 0 || spi->spi_qos.sql_bw != 0 || qos_cont_enabled(spi);
+}
+
+static struct sched_cont_info *
+cur_cont_info(struct sched_info *info, struct sched_pool_info *spi, uuid_t cont_id)
+{
+	struct sched_cont_info	*sci;
+
+	if (!qos_cont_enabled(spi) || uuid_is_null(cont_id))
+		return NULL;
+
+	d_list_for_each_entry(sci, &spi->spi_cont_list, sci_link) {
+		if (uuid_compare(sci->sci_cont_id, cont_id) == 0) {
+			/* Keep the recently used one at head */
+			d_list_move(&sci->sci_link, &spi->spi_cont_list);
+			goto out;
+		}
+	}
+
+	D_ALLOC_PTR(sci);
+	if (sci == NULL) {
+		D_ERROR("Failed to allocate container info\n");
+		return NULL;
+	}
+	uuid_copy(sci->sci_cont_id, cont_id);
+	qos_bucket_set(&sci->sci_qos_iops, spi->spi_qos.sql_cont_iops, info->si_cur_ts);
+	qos_bucket_set(&sci->sci_qos_bw, spi->spi_qos.sql_cont_bw, info->si_cur_ts);
+	d_list_add(&sci->sci_link, &spi->spi_cont_list);
+out:
+	sci->sci_access_ts = info->si_cur_ts;
+	return sci;
+}
+
+static void
+purge_cont_info(struct sched_info *info, struct sched_pool_info *spi)
+{
+	struct sched_cont_info	*sci, *tmp;
+
+	if (d_list_empty(&spi->spi_cont_list) ||
+	    (spi->spi_cont_purge_ts + SCHED_QOS_CONT_AGE_MAX) > info->si_cur_ts)
+		return;
+
+	spi->spi_cont_purge_ts = info->si_cur_ts;
+	d_list_for_each_entry_safe(sci, tmp, &spi->spi_cont_list, sci_link) {
+		if (sci->sci_req_cnt != 0 ||
+		    (sci->sci_access_ts + SCHED_QOS_CONT_AGE_MAX) > info->si_cur_ts)
+			continue;
+
+		d_list_del_init(&sci->sci_link);
+		D_FREE(sci);
+	}
+}
+
+static bool
+qos_throttled(struct sched_info *info, struct sched_request *req)
+{
+	struct sched_pool_info	*spi = req->sr_pool_info;
+	struct sched_cont_info	*sci = req->sr_cont_info;
+	uint64_t		 now = info->si_cur_ts;
+
+	if (qos_bucket_empty(&spi->spi_qos_iops, now) || qos_bucket_empty(&spi->spi_qos_bw, now))
+		return true;
+
+	if (sci != NULL &&
+	    (qos_bucket_empty(&sci->sci_qos_iops, now) || qos_bucket_empty(&sci->sci_qos_bw, now)))
+		return true;
+
+	return false;
+}
+
+static void
+qos_charge(struct sched_info *info, struct sched_request *req)
+{
+	struct sched_stats	*stats = &info->si_stats;
+	struct sched_pool_info	*spi = req->sr_pool_info;
+	struct sched_cont_info	*sci = req->sr_cont_info;
+
+	qos_bucket_charge(&spi->spi_qos_iops, 1);
+	qos_bucket_charge(&spi->spi_qos_bw, req->sr_attr.sra_size);
+
+	if (sci != NULL) {
+		qos_bucket_charge(&sci->sci_qos_iops, 1);
+		qos_bucket_charge(&sci->sci_qos_bw, req->sr_attr.sra_size);
+
+		D_ASSERT(sci->sci_req_cnt > 0);
+		sci->sci_req_cnt--;
+		req->sr_cont_info = NULL;
+	}
+
+	if (req->sr_qos_held) {
+		D_ASSERT(info->si_qos_held_cnt > 0);
+		info->si_qos_held_cnt--;
+		d_tm_inc_counter(stats->ss_qos_throttled, 1);
+		d_tm_set_gauge(stats->ss_qos_delay, info->si_cur_ts - req->sr_enqueue_ts);
+	}
+}
+
 static int
 process_req(struct dss_xstream *dx, struct sched_request *req)
 {
@@ -790,6 +1459,18 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	if (info->si_stop)
 		goto kickoff;
 
+	if (req->sr_qos && qos_throttled(info, req)) {
+		D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+		if ((info->si_cur_ts - req->sr_enqueue_ts) <= SCHED_QOS_DELAY_MAX) {
+			if (!req->sr_qos_held) {
+				req->sr_qos_held = 1;
+				info->si_qos_held_cnt++;
+			}
+			return 1;
+		}
+		D_DEBUG(DB_TRACE, "Request delayed by QoS limits for too long\n");
+	}
+
 	if (sri->sri_req_kicked < sri->sri_req_limit)
 		goto kickoff;
 
@@ -813,6 +1494,10 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	/* Remaining requests are not expired */
 	return 1;
 kickoff:
+	if (req->sr_qos)
+		qos_charge(info, req);
+	d_tm_set_gauge(info->si_stats.ss_queue_delay[req->sr_class],
+		       info->si_cur_ts - req->sr_enqueue_ts);
 	sri->sri_req_kicked++;
 	req_kickoff(dx, req);
 	return 0;
@@ -1036,6 +1721,14 @@ throttle_sys(struct stats_window *sw, uint32_t *kick, struct pressure_ratio *pr)
 		apportion_wts(avail_wts, kick, SCHED_REQ_SCRUB);
 }
 
+static inline void
+process_sys_reqs(struct dss_xstream *dx, struct sched_pool_info *spi)
+{
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_GC), true);
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_SCRUB), true);
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_MIGRATE), true);
+}
+
 static int
 process_pool_cb(d_list_t *rlink, void *arg)
 {
@@ -1050,6 +1743,7 @@ process_pool_cb(d_list_t *rlink, void *arg)
 
 	/* Update stats window no matter if any pending ULT or not */
 	sw_window_update(&spi->spi_stats_window);
+	purge_cont_info(info, spi);
 	if (spi->spi_req_cnt == 0)
 		return 0;
 
@@ -1067,9 +1761,21 @@ process_pool_cb(d_list_t *rlink, void *arg)
 	for (i = SCHED_REQ_UPDATE; i < SCHED_REQ_MAX; i++)
 		set_req_limit(dx, spi, i, kick[i]);
 
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_GC), true);
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_SCRUB), true);
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_MIGRATE), true);
+	/* EDF policy kicks off system requests after the IO requests */
+	if (sched_policy != SCHED_POLICY_EDF)
+		process_sys_reqs(dx, spi);
+
+	return 0;
+}
+
+static int
+process_pool_sys_cb(d_list_t *rlink, void *arg)
+{
+	struct dss_xstream	*dx = (struct dss_xstream *)arg;
+	struct sched_pool_info	*spi = sched_rlink2spi(rlink);
+
+	if (spi->spi_req_cnt != 0)
+		process_sys_reqs(dx, spi);
 
 	return 0;
 }
@@ -1091,6 +1797,59 @@ policy_fifo_process(struct dss_xstream *dx)
 	process_req_list(dx, &info->si_fifo_list, false);
 }
 
+static void
+policy_edf_enqueue(struct dss_xstream *dx, struct sched_request *req,
+		   void *prio_data)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+
+	D_ASSERT(req->sr_class < SCHED_CLASS_IO_MAX);
+	/* Same deadline for a class, so each class list is in deadline order */
+	d_list_add_tail(&req->sr_link, &info->si_edf_list[req->sr_class]);
+}
+
+/*
+ * Process the IO requests in earliest deadline first. Deadline of a request
+ * is its enqueue time plus the queueing deadline of its class, since a
+ * request isn't overtaken by later requests once its deadline is due, the
+ * large reads and updates won't be starved by small reads.
+ */
+static void
+policy_edf_process(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_request	*req, *tmp;
+	d_list_t		*cursor[SCHED_CLASS_IO_MAX];
+	int			 i, pick;
+
+	for (i = 0; i < SCHED_CLASS_IO_MAX; i++)
+		cursor[i] = info->si_edf_list[i].next;
+
+	while (1) {
+		req = NULL;
+		pick = -1;
+		for (i = 0; i < SCHED_CLASS_IO_MAX; i++) {
+			if (cursor[i] == &info->si_edf_list[i])
+				continue;
+
+			tmp = d_list_entry(cursor[i], struct sched_request, sr_link);
+			if (req == NULL || tmp->sr_deadline < req->sr_deadline) {
+				req = tmp;
+				pick = i;
+			}
+		}
+
+		if (req == NULL)
+			break;
+
+		/* The request is removed from list on kicking off */
+		cursor[pick] = cursor[pick]->next;
+		process_req(dx, req);
+	}
+
+	d_hash_table_traverse(info->si_pool_hash, process_pool_sys_cb, dx);
+}
+
 struct sched_policy_ops {
 	void (*enqueue_io)(struct dss_xstream *dx, struct sched_request *req,
 			   void *prio_data);
@@ -1109,6 +1868,10 @@ static struct sched_policy_ops	policy_ops[SCHED_POLICY_MAX] = {
 	{	/* SCHED_POLICY_ID_PRIO */
 		.enqueue_io = NULL,
 		.process_io = NULL,
+	},
+	{	/* SCHED_POLICY_EDF */
+		.enqueue_io = policy_edf_enqueue,
+		.process_io = policy_edf_process,
 	}
 };
 
@@ -1143,6 +1906,125 @@ should_enqueue_req(struct dss_xstream *dx, struct sched_req_attr *attr)
 	return dx->dx_main_xs;
 }
 
+/* Enqueue time of the oldest I/O request on the list which isn't held by QoS limits */
+static uint64_t
+oldest_unheld_ts(d_list_t *list, uint64_t ts)
+{
+	struct sched_request	*req;
+
+	d_list_for_each_entry(req, list, sr_link) {
+		if (!req->sr_qos_held)
+			return min(ts, req->sr_enqueue_ts);
+	}
+
+	return ts;
+}
+
+/*
+ * Enqueue time of the oldest queued I/O request. The requests held by QoS limits
+ * are delayed on purpose, they don't tell the xstream is overloaded, so they are
+ * skipped. Otherwise a throttled pool would make all the I/O of the other pools
+ * rejected.
+ */
+static uint64_t
+oldest_io_ts(struct sched_info *info)
+{
+	struct sched_request	*req;
+	uint64_t		 ts = info->si_cur_ts;
+	int			 i;
+
+	if (sched_policy == SCHED_POLICY_EDF) {
+		/* Requests of same class have the same deadline offset */
+		for (i = 0; i < SCHED_CLASS_IO_MAX; i++) {
+			if (d_list_empty(&info->si_edf_list[i]))
+				continue;
+			if (info->si_qos_held_cnt != 0) {
+				ts = oldest_unheld_ts(&info->si_edf_list[i], ts);
+				continue;
+			}
+			req = d_list_entry(info->si_edf_list[i].next, struct sched_request,
+					   sr_link);
+			ts = min(ts, req->sr_enqueue_ts);
+		}
+	} else if (info->si_qos_held_cnt != 0) {
+		ts = oldest_unheld_ts(&info->si_fifo_list, ts);
+	} else if (!d_list_empty(&info->si_fifo_list)) {
+		req = d_list_entry(info->si_fifo_list.next, struct sched_request, sr_link);
+		ts = min(ts, req->sr_enqueue_ts);
+	}
+
+	return ts;
+}
+
+#define SCHED_BACKOFF_MIN	5	/* msecs */
+#define SCHED_BACKOFF_MAX	1000	/* msecs */
+
+/*
+ * Admission control on foreground I/O from client. When the queued and running
+ * ULTs exceed sched_admit_depth, or the oldest queued I/O request has waited for
+ * more than sched_admit_delay, the new request is rejected with a suggested backoff
+ * (how long the current backlog has been waiting), instead of being queued until
+ * the client times out. The requests held by QoS limits are not counted.
+ */
+static bool
+should_reject_req(struct dss_xstream *dx, struct sched_req_attr *attr)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	uint64_t		 oldest, wait;
+	size_t			 depth;
+	int			 rc;
+
+	if (!(attr->sra_flags & SCHED_REQ_FL_CLIENT) || !dx->dx_main_xs || info->si_stop)
+		return false;
+
+	if (sched_admit_depth == 0 && sched_admit_delay == 0)
+		return false;
+
+	oldest = oldest_io_ts(info);
+	D_ASSERT(info->si_cur_ts >= oldest);
+	wait = info->si_cur_ts - oldest;
+	if (sched_admit_delay != 0 && wait > sched_admit_delay)
+		goto reject;
+
+	if (sched_admit_depth != 0) {
+		rc = ABT_pool_get_total_size(dx->dx_pools[DSS_POOL_GENERIC], &depth);
+		if (rc != ABT_SUCCESS) {
+			D_ERROR("Get ABT pool(%d) total size error: %d\n", DSS_POOL_GENERIC, rc);
+			return false;
+		}
+		D_ASSERT(info->si_req_cnt >= info->si_qos_held_cnt);
+		if (depth + info->si_req_cnt - info->si_qos_held_cnt > sched_admit_depth)
+			goto reject;
+	}
+
+	return false;
+reject:
+	attr->sra_backoff = min(max(wait, SCHED_BACKOFF_MIN), SCHED_BACKOFF_MAX);
+	d_tm_inc_counter(info->si_stats.ss_rejected, 1);
+	return true;
+}
+
+static inline unsigned int
+req_class(struct sched_req_attr *attr)
+{
+	switch (attr->sra_type) {
+	case SCHED_REQ_FETCH:
+		return attr->sra_size <= SCHED_SMALL_READ_SZ ?
+		       SCHED_CLASS_READ_SMALL : SCHED_CLASS_READ;
+	case SCHED_REQ_UPDATE:
+		return SCHED_CLASS_UPDATE;
+	case SCHED_REQ_GC:
+		return SCHED_CLASS_GC;
+	case SCHED_REQ_SCRUB:
+		return SCHED_CLASS_SCRUB;
+	case SCHED_REQ_MIGRATE:
+		return SCHED_CLASS_MIGRATE;
+	default:
+		D_ASSERTF(0, "Invalid req type %u\n", attr->sra_type);
+		return SCHED_CLASS_GC;
+	}
+}
+
 static void
 req_enqueue(struct dss_xstream *dx, struct sched_request *req)
 {
@@ -1155,14 +2037,16 @@ req_enqueue(struct dss_xstream *dx, struct sched_request *req)
 	sri = &spi->spi_req_array[attr->sra_type];
 
 	D_ASSERT(d_list_empty(&req->sr_link));
+	req->sr_enqueue_ts = info->si_cur_ts;
+	req->sr_class = req_class(attr);
 	if (attr->sra_type == SCHED_REQ_UPDATE ||
 	    attr->sra_type == SCHED_REQ_FETCH) {
+		req->sr_deadline = req->sr_enqueue_ts + edf_deadlines[req->sr_class];
 		D_ASSERT(policy_ops[sched_policy].enqueue_io != NULL);
 		policy_ops[sched_policy].enqueue_io(dx, req, NULL);
 	} else {
 		d_list_add_tail(&req->sr_link, &sri->sri_req_list);
 	}
-	req->sr_enqueue_ts = info->si_cur_ts;
 
 	sri->sri_req_cnt++;
 	spi->spi_req_cnt++;
@@ -1175,31 +2059,71 @@ sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 {
 	struct sched_request	*req;
 
+	/* All RPCs run the same dispatcher, the profiler looks at the opcode instead */
+	if (attr->sra_flags & SCHED_REQ_FL_RPC)
+		dx->dx_sched_info.si_rpc_func = func;
+
+	if (should_reject_req(dx, attr))
+		return -DER_OVERLOAD_RETRY;
+
 	if (!should_enqueue_req(dx, attr))
 		return req_kickoff_internal(dx, attr, func, arg);
 
-	/*
-	 * TODO: A RPC flow control mechanism could be introduced to avoid RPC timeout when the
-	 * server is congested:
-	 *
-	 * Estimate how long it would take to process the incoming request based on the server
-	 * resource availability (request queue length, space pressure, DMA buffer usage, etc)
-	 * and the average per request processing time, then compare the estimated time with the
-	 * RPC timeout to see if the request should be early replied with hint data for retry.
-	 *
-	 * That requires wire format and client changes.
-	 */
 	D_ASSERT(attr->sra_type < SCHED_REQ_MAX);
 	req = req_get(dx, attr, func, arg, ABT_THREAD_NULL, false);
 	if (req == NULL) {
 		D_ERROR("Get req failed.\n");
 		return -DER_NOMEM;
 	}
+
+	/* QoS limits are applied on foreground I/O RPCs */
+	if ((attr->sra_type == SCHED_REQ_UPDATE || attr->sra_type == SCHED_REQ_FETCH) &&
+	    qos_enabled(req->sr_pool_info)) {
+		req->sr_qos = 1;
+		req->sr_cont_info = cur_cont_info(&dx->dx_sched_info, req->sr_pool_info,
+						  attr->sra_cont_id);
+		if (req->sr_cont_info != NULL)
+			req->sr_cont_info->sci_req_cnt++;
+	}
 	req_enqueue(dx, req);
 
 	return 0;
 }
 
+int
+sched_pool_qos_set(uuid_t pool_id, struct sched_qos_limits *limits)
+{
+	struct dss_xstream	*dx = dss_current_xstream();
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi;
+	struct sched_cont_info	*sci;
+
+	/* Foreground I/O is only scheduled on VOS xstream */
+	if (!dx->dx_main_xs)
+		return 0;
+
+	spi = cur_pool_info(info, pool_id);
+	if (spi == NULL)
+		return -DER_NOMEM;
+
+	if (memcmp(&spi->spi_qos, limits, sizeof(*limits)) != 0)
+		D_DEBUG(DB_MGMT, DF_UUID": QoS limits iops:"DF_U64", bw:"DF_U64", "
+			"cont_iops:"DF_U64", cont_bw:"DF_U64"\n", DP_UUID(pool_id),
+			limits->sql_iops, limits->sql_bw, limits->sql_cont_iops,
+			limits->sql_cont_bw);
+
+	spi->spi_qos = *limits;
+	qos_bucket_set(&spi->spi_qos_iops, limits->sql_iops, info->si_cur_ts);
+	qos_bucket_set(&spi->spi_qos_bw, limits->sql_bw, info->si_cur_ts);
+
+	d_list_for_each_entry(sci, &spi->spi_cont_list, sci_link) {
+		qos_bucket_set(&sci->sci_qos_iops, limits->sql_cont_iops, info->si_cur_ts);
+		qos_bucket_set(&sci->sci_qos_bw, limits->sql_cont_bw, info->si_cur_ts);
+	}
+
+	return 0;
+}
+
 void
 sched_req_yield(struct sched_request *req)
 {
@@ -1432,6 +2356,8 @@ sched_stop(struct dss_xstream *dx)
 	info->si_stop = 1;
 	wakeup_all(dx);
 	process_all(dx);
+	/* Other helpers may have stopped stealing, flush all queued ULTs */
+	steal_drain(dx, UINT32_MAX);
 }
 
 void
@@ -1713,6 +2639,70 @@ sched_pop_one(struct sched_data *data, ABT_pool pool, int pool_idx)
 
 #define SCHED_IDLE_THRESH	8000UL	/* msecs */
 
+/*
+ * Account the last relaxing and learn the inter-arrival time of external events
+ * (incoming RPCs, ULTs offloaded or created by other xstreams), it's called on the
+ * start of each schedule cycle.
+ */
+static void
+relax_account(struct dss_xstream *dx, uint64_t now)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	uint64_t		 arrival = info->si_arrival_ns;
+	uint64_t		 gap;
+
+	if (info->si_relax_start != 0) {
+		if (now > info->si_relax_start)
+			d_tm_inc_counter(info->si_stats.ss_relax_saved,
+					 (now - info->si_relax_start) / NSEC_PER_USEC);
+		/* Event arrived on relaxing, it's delayed until the xstream woke up */
+		if (arrival > info->si_relax_start && now > arrival)
+			d_tm_set_gauge(info->si_stats.ss_wakeup_lat,
+				       (now - arrival) / NSEC_PER_USEC);
+		info->si_relax_start = 0;
+	}
+
+	if (sched_relax_mode != SCHED_RELAX_MODE_ADAPTIVE || arrival == info->si_arrival_last)
+		return;
+
+	/* Moving average of inter-arrival time, weight of new sample is 1/8 */
+	if (info->si_arrival_last != 0 && arrival > info->si_arrival_last) {
+		gap = arrival - info->si_arrival_last;
+		if (info->si_arrival_gap == 0)
+			info->si_arrival_gap = gap;
+		else
+			info->si_arrival_gap = (info->si_arrival_gap * 7 + gap) / 8;
+	}
+	info->si_arrival_last = arrival;
+}
+
+/*
+ * In adaptive mode, keep spinning for a short window after the last arrival if
+ * the next arrival is likely to come soon (within twice of the average inter-arrival
+ * time, capped by sched_spin_window), or when there are inflight NVMe I/Os. Otherwise,
+ * relax immediately instead of waiting for SCHED_IDLE_THRESH.
+ */
+static bool
+adaptive_need_spin(struct dss_xstream *dx, uint64_t now)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct dss_module_info	*dmi;
+	uint64_t		 window;
+
+	if (dx->dx_main_xs) {
+		dmi = dss_get_module_info();
+		D_ASSERT(dmi != NULL);
+		if (bio_need_nvme_poll(dmi->dmi_nvme_ctxt))
+			return true;
+	}
+
+	if (info->si_arrival_last == 0 || info->si_arrival_gap == 0)
+		return false;
+
+	window = min(info->si_arrival_gap * 2, (uint64_t)sched_spin_window * NSEC_PER_USEC);
+	return now < info->si_arrival_last + window;
+}
+
 /*
  * Try to relax CPU for a short period when the xstream is idle. The relaxing
  * period can't be too long, otherwise, potential external events like:
@@ -1728,10 +2718,12 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	unsigned int		 sleep_time = sched_relax_intvl;
+	uint64_t		 now = daos_get_ntime();
 	size_t			 blocked;
 	int			 ret;
 
 	dx->dx_timeout = 0;
+	relax_account(dx, now);
 
 	if (info->si_stop)
 		return;
@@ -1750,6 +2742,10 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	if (info->si_req_cnt != 0)
 		return;
 
+	/* There are queued offloaded ULTs to be created */
+	if (info->si_steal_cnt != 0)
+		return;
+
 	ret = ABT_pool_get_total_size(pools[DSS_POOL_GENERIC], &blocked);
 	if (ret != ABT_SUCCESS) {
 		D_ERROR("Get ABT pool(%d) total size error: %d\n",
@@ -1779,8 +2775,12 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	 * no external events for a short period of SCHED_IDLE_THRESH.
 	 */
 	D_ASSERT(info->si_cur_ts >= info->si_stats.ss_busy_ts);
-	if (info->si_cur_ts - info->si_stats.ss_busy_ts < SCHED_IDLE_THRESH)
+	if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE) {
+		if (adaptive_need_spin(dx, now))
+			return;
+	} else if (info->si_cur_ts - info->si_stats.ss_busy_ts < SCHED_IDLE_THRESH) {
 		return;
+	}
 
 	/* Adjust sleep time according to the first sleeping ULT */
 	if (info->si_sleep_cnt > 0) {
@@ -1796,6 +2796,7 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 			sleep_time = req->sr_wakeup_time - info->si_cur_ts;
 	}
 	D_ASSERT(sleep_time > 0 && sleep_time <= SCHED_RELAX_INTVL_MAX);
+	info->si_relax_start = now;
 
 	/*
 	 * Wait on external network request if the xstream has Cart context,
@@ -1843,6 +2844,9 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 
 	wakeup_all(dx);
 	process_all(dx);
+	stack_cache_trim(info, false);
+	/* Drop profiled metrics on reset, even if profiler is disabled */
+	prof_check_reset(dx);
 
 	/* Get number of ULTS in generic ABT pool */
 	D_ASSERT(cycle->sc_ults_cnt[DSS_POOL_GENERIC] == 0);
@@ -1852,6 +2856,8 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 			DSS_POOL_GENERIC, ret);
 		cnt = 0;
 	}
+	/* Feed shared helper with offloaded ULTs, newly created ULTs are runnable */
+	cnt += steal_process(dx, cnt);
 	cycle->sc_ults_cnt[DSS_POOL_GENERIC] = cnt;
 	cycle->sc_ults_tot += cycle->sc_ults_cnt[DSS_POOL_GENERIC];
 
@@ -1899,15 +2905,272 @@ sched_exec_time(uint64_t *msecs, const char *ult_name)
 	return 0;
 }
 
+/*
+ * Per ULT function execution time profiler.
+ *
+ * Built on the watchdog hooks, when it's enabled, the execution time of each
+ * run of a ULT (from being scheduled to yielding, blocking or exiting) is
+ * accumulated into a histogram per ULT function and per xstream, the runs of
+ * a ULT resumed from yielding or blocking are counted as yields. The ULTs of
+ * RPCs all start from the same dispatcher, so they are profiled per opcode and
+ * named after the module handler of the opcode. Metrics are created lazily
+ * under the ephemeral telemetry directory sched/prof/xs_N, and are dropped on
+ * reset.
+ */
+struct sched_prof_func {
+	d_list_t		 spf_link;
+	void			*spf_func;
+	uint32_t		 spf_opc;	/* RPC opcode, 0 for non-RPC ULT */
+	struct d_tm_node_t	*spf_exec_time;
+	struct d_tm_node_t	*spf_yields;
+};
+
+#define SCHED_PROF_HASH_SZ	64
+#define SCHED_PROF_FUNC_MAX	128	/* Max profiled ULT functions per xstream */
+#define SCHED_PROF_LAT_BUCKETS	16	/* 1us ~ 32ms */
+
+/* Generous estimate of telemetry bytes for a profiled ULT function */
+#define SCHED_PROF_NODE_BYTES	\
+	(sizeof(struct d_tm_node_t) + sizeof(struct d_tm_metric_t) + 64)
+#define SCHED_PROF_FUNC_BYTES						\
+	(3 * SCHED_PROF_NODE_BYTES + sizeof(struct d_tm_stats_t) +	\
+	 sizeof(struct d_tm_histogram_t) +				\
+	 SCHED_PROF_LAT_BUCKETS * (sizeof(struct d_tm_bucket_t) + SCHED_PROF_NODE_BYTES))
+
+struct sched_prof {
+	d_list_t		 sp_hash[SCHED_PROF_HASH_SZ];
+	uint32_t		 sp_func_cnt;
+	uint32_t		 sp_gen;
+	char			 sp_path[D_TM_MAX_NAME_LEN];
+};
+
+bool		sched_prof_enabled;
+/* Bumped on each reset */
+static uint32_t	sched_prof_gen;
+
+int
+sched_prof_set(uint64_t value)
+{
+	switch (value) {
+	case SCHED_PROF_DISABLE:
+		sched_prof_enabled = false;
+		break;
+	case SCHED_PROF_ENABLE:
+		sched_prof_enabled = true;
+		break;
+	case SCHED_PROF_RESET:
+		sched_prof_gen++;
+		break;
+	default:
+		D_ERROR("Invalid ULT profiler control "DF_U64"\n", value);
+		return -DER_INVAL;
+	}
+
+	D_INFO("ULT profiler control "DF_U64", enabled:%d gen:%u\n", value,
+	       sched_prof_enabled, sched_prof_gen);
+	return 0;
+}
+
+static void
+prof_fini(struct dss_xstream *dx)
+{
+	struct sched_prof	*sp = dx->dx_sched_info.si_prof;
+	struct sched_prof_func	*spf, *tmp;
+	int			 i, rc;
+
+	if (sp == NULL)
+		return;
+
+	for (i = 0; i < SCHED_PROF_HASH_SZ; i++) {
+		d_list_for_each_entry_safe(spf, tmp, &sp->sp_hash[i], spf_link) {
+			d_list_del(&spf->spf_link);
+			D_FREE(spf);
+		}
+	}
+
+	rc = d_tm_del_ephemeral_dir(sp->sp_path);
+	if (rc)
+		D_WARN("Failed to delete %s: "DF_RC"\n", sp->sp_path, DP_RC(rc));
+
+	D_FREE(sp);
+	dx->dx_sched_info.si_prof = NULL;
+}
+
+static void
+prof_check_reset(struct dss_xstream *dx)
+{
+	struct sched_prof	*sp = dx->dx_sched_info.si_prof;
+
+	if (sp != NULL && sp->sp_gen != sched_prof_gen)
+		prof_fini(dx);
+}
+
+static struct sched_prof *
+prof_get(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_prof	*sp;
+	int			 i, rc;
+
+	/* Drop all metrics on reset */
+	prof_check_reset(dx);
+	sp = info->si_prof;
+	if (sp != NULL)
+		return sp;
+
+	D_ALLOC_PTR(sp);
+	if (sp == NULL)
+		return NULL;
+
+	for (i = 0; i < SCHED_PROF_HASH_SZ; i++)
+		D_INIT_LIST_HEAD(&sp->sp_hash[i]);
+	sp->sp_gen = sched_prof_gen;
+	snprintf(sp->sp_path, sizeof(sp->sp_path), "sched/prof/xs_%u", dx->dx_xs_id);
+
+	rc = d_tm_add_ephemeral_dir(NULL, SCHED_PROF_FUNC_MAX * SCHED_PROF_FUNC_BYTES,
+				    sp->sp_path);
+	if (rc) {
+		D_ERROR("Failed to create %s: "DF_RC"\n", sp->sp_path, DP_RC(rc));
+		D_FREE(sp);
+		return NULL;
+	}
+
+	info->si_prof = sp;
+	return sp;
+}
+
+/* Get symbol name from the "binary(symbol+offset) [address]" string */
+static void
+prof_func_name(void *func, char *name, size_t len)
+{
+	char	**strings;
+	char	 *start, *end;
+
+	snprintf(name, len, "%p", func);
+
+	strings = backtrace_symbols(&func, 1);
+	if (strings == NULL)
+		return;
+
+	start = strchr(strings[0], '(');
+	if (start != NULL) {
+		start++;
+		end = start + strcspn(start, "+)");
+		if (end > start) {
+			*end = '\0';
+			snprintf(name, len, "%s", start);
+		}
+	}
+	free(strings);
+}
+
+/* Name the RPC ULT after the handler registered by the module for the opcode */
+static void
+prof_rpc_name(uint32_t opc, char *name, size_t len)
+{
+	struct dss_module	*module = dss_module_get(opc_get_mod_id(opc));
+	struct daos_rpc_handler	*hdlr;
+	int			 i;
+
+	snprintf(name, len, "rpc_%#x", opc);
+	if (module == NULL)
+		return;
+
+	for (i = 0; i < module->sm_proto_count; i++) {
+		for (hdlr = module->sm_handlers[i]; hdlr != NULL && hdlr->dr_opc != 0; hdlr++) {
+			if (hdlr->dr_opc == opc && hdlr->dr_hdlr != NULL) {
+				prof_func_name(hdlr->dr_hdlr, name, len);
+				return;
+			}
+		}
+	}
+}
+
+static struct sched_prof_func *
+prof_func_lookup(struct dss_xstream *dx, void *func, uint32_t opc)
+{
+	struct sched_prof	*sp;
+	struct sched_prof_func	*spf;
+	d_list_t		*head;
+	char			 name[128];
+	int			 rc;
+
+	sp = prof_get(dx);
+	if (sp == NULL)
+		return NULL;
+
+	head = &sp->sp_hash[(opc != 0 ? opc : (uintptr_t)func >> 4) % SCHED_PROF_HASH_SZ];
+	d_list_for_each_entry(spf, head, spf_link) {
+		if (spf->spf_func == func && spf->spf_opc == opc)
+			return spf;
+	}
+
+	if (sp->sp_func_cnt >= SCHED_PROF_FUNC_MAX)
+		return NULL;
+
+	D_ALLOC_PTR(spf);
+	if (spf == NULL)
+		return NULL;
+
+	spf->spf_func = func;
+	spf->spf_opc = opc;
+	if (opc != 0)
+		prof_rpc_name(opc, name, sizeof(name));
+	else
+		prof_func_name(func, name, sizeof(name));
+
+	rc = d_tm_add_metric(&spf->spf_exec_time, D_TM_STATS_GAUGE, "ULT execution time per run",
+			     "us", "%s/%s/exec_time", sp->sp_path, name);
+	if (rc == 0) {
+		char	path[D_TM_MAX_NAME_LEN];
+
+		snprintf(path, sizeof(path), "%s/%s/exec_time", sp->sp_path, name);
+		rc = d_tm_init_histogram(spf->spf_exec_time, path, SCHED_PROF_LAT_BUCKETS, 1, 2);
+	}
+	if (rc)
+		D_WARN("Failed to create exec_time telemetry for %s: "DF_RC"\n", name, DP_RC(rc));
+
+	rc = d_tm_add_metric(&spf->spf_yields, D_TM_COUNTER, "ULT resumed from yield or wait",
+			     "yield", "%s/%s/yields", sp->sp_path, name);
+	if (rc)
+		D_WARN("Failed to create yields telemetry for %s: "DF_RC"\n", name, DP_RC(rc));
+
+	/* Keep the entry even if metrics creation failed, don't retry on each run */
+	d_list_add(&spf->spf_link, head);
+	sp->sp_func_cnt++;
+
+	return spf;
+}
+
+static void
+prof_record(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_prof_func	*spf;
+	uint64_t		 cur = daos_get_ntime();
+
+	spf = prof_func_lookup(dx, info->si_ult_func, info->si_ult_opc);
+	if (spf == NULL)
+		return;
+
+	d_tm_set_gauge(spf->spf_exec_time, cur > info->si_prof_start ?
+		       (cur - info->si_prof_start) / NSEC_PER_USEC : 0);
+	if (info->si_prof_resumed)
+		d_tm_inc_counter(spf->spf_yields, 1);
+}
+
 static void
 sched_watchdog_prep(struct dss_xstream *dx, ABT_unit unit)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	ABT_thread		 thread;
+	ABT_xstream		 last_xs;
 	void			 (*thread_func)(void *);
+	void			*thread_arg;
 	int			 rc;
 
-	if (!watchdog_enabled(dx))
+	info->si_prof_start = 0;
+	if (!watchdog_enabled(dx) && !sched_prof_enabled)
 		return;
 
 	info->si_ult_start = daos_getmtime_coarse();
@@ -1915,7 +3178,26 @@ sched_watchdog_prep(struct dss_xstream *dx, ABT_unit unit)
 	D_ASSERT(rc == ABT_SUCCESS);
 	rc = ABT_thread_get_thread_func(thread, &thread_func);
 	D_ASSERT(rc == ABT_SUCCESS);
+	rc = ABT_thread_get_arg(thread, &thread_arg);
+	D_ASSERT(rc == ABT_SUCCESS);
+	/* Report the real function for the ULT on cached stack */
+	if (thread_func == stack_ult_wrapper) {
+		struct sched_stack	*ss = thread_arg;
+
+		thread_func = ss->ss_func;
+		thread_arg = ss->ss_arg;
+	}
 	info->si_ult_func = thread_func;
+	info->si_ult_opc = 0;
+	if (thread_func == info->si_rpc_func && thread_arg != NULL)
+		info->si_ult_opc = ((crt_rpc_t *)thread_arg)->cr_opc;
+
+	if (sched_prof_enabled) {
+		/* The ULT has been executed before, it's resumed */
+		rc = ABT_thread_get_last_xstream(thread, &last_xs);
+		info->si_prof_resumed = (rc == ABT_SUCCESS && last_xs != ABT_XSTREAM_NULL);
+		info->si_prof_start = daos_get_ntime();
+	}
 }
 
 static void
@@ -1929,6 +3211,9 @@ sched_watchdog_post(struct dss_xstream *dx)
 	/* A ULT is just scheduled, increase schedule seq */
 	info->si_cur_seq++;
 
+	if (info->si_prof_start != 0)
+		prof_record(dx);
+
 	if (!watchdog_enabled(dx))
 		return;
 
@@ -1956,8 +3241,9 @@ sched_watchdog_post(struct dss_xstream *dx)
 	info->si_stats.ss_watchdog_ts = cur;
 
 	strings = backtrace_symbols(&info->si_ult_func, 1);
-	D_ERROR("WATCHDOG: Thread %p took %u ms. symbol:%s\n",
-		info->si_ult_func, elapsed, strings != NULL ? strings[0] : NULL);
+	D_ERROR("WATCHDOG: Thread %p took %u ms. symbol:%s opc:%#x\n",
+		info->si_ult_func, elapsed, strings != NULL ? strings[0] : NULL,
+		info->si_ult_opc);
 
 	free(strings);
 }
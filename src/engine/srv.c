@@ -24,6 +24,7 @@
 #include <daos_srv/smd.h>
 #include <daos_srv/vos.h>
 #include <gurt/list.h>
+#include <gurt/telemetry_producer.h>
 #include "drpc_internal.h"
 #include "srv_internal.h"
 
@@ -287,8 +288,20 @@ dss_rpc_hdlr(crt_context_t *ctx, void *hdlr_arg,
 	} else {
 		attr.sra_type = SCHED_REQ_ANONYM;
 	}
+	attr.sra_flags |= SCHED_REQ_FL_RPC;
 
-	return sched_req_enqueue(dx, &attr, real_rpc_hdlr, rpc);
+	rc = sched_req_enqueue(dx, &attr, real_rpc_hdlr, rpc);
+	if (rc == -DER_OVERLOAD_RETRY && module != NULL && module->sm_mod_ops != NULL &&
+	    module->sm_mod_ops->dms_reject_req != NULL) {
+		rc = module->sm_mod_ops->dms_reject_req(rpc, &attr);
+		if (rc != 0)
+			D_ERROR("Failed to reject RPC %#x: "DF_RC"\n", rpc->cr_opc, DP_RC(rc));
+		/* Replied already, drop the reference held for the RPC handler */
+		crt_req_decref(rpc);
+		return 0;
+	}
+
+	return rc;
 }
 
 static void
@@ -621,6 +634,38 @@ dss_xstream_free(struct dss_xstream *dx)
 	D_FREE(dx);
 }
 
+/* Log and export in telemetry the cores and NUMA node an xstream is bound to */
+static void
+dss_xstream_topo_report(struct dss_xstream *dx)
+{
+	struct d_tm_node_t	*cpu = NULL;
+	struct d_tm_node_t	*node = NULL;
+	hwloc_obj_t		 numa = NULL;
+	char			*cpuset = NULL;
+	int			 numa_id = -1;
+
+	while ((numa = hwloc_get_next_obj_by_type(dss_topo, HWLOC_OBJ_NUMANODE, numa)) != NULL) {
+		if (hwloc_bitmap_isincluded(dx->dx_cpuset, numa->cpuset)) {
+			numa_id = numa->os_index;
+			break;
+		}
+	}
+
+	hwloc_bitmap_asprintf(&cpuset, dx->dx_cpuset);
+	D_INFO("xstream %s xs_id(%d)/tgt_id(%d) bound to CPU set %s, NUMA node %d\n",
+	       dx->dx_name, dx->dx_xs_id, dx->dx_tgt_id, cpuset ? cpuset : "?", numa_id);
+	free(cpuset);
+
+	d_tm_add_metric(&cpu, D_TM_GAUGE, "First CPU the xstream is bound to", "",
+			"topo/xs_%u/cpu", dx->dx_xs_id);
+	d_tm_set_gauge(cpu, hwloc_bitmap_first(dx->dx_cpuset));
+	if (numa_id >= 0) {
+		d_tm_add_metric(&node, D_TM_GAUGE, "NUMA node the xstream is bound to", "",
+				"topo/xs_%u/numa_node", dx->dx_xs_id);
+		d_tm_set_gauge(node, numa_id);
+	}
+}
+
 /**
  * Start one xstream.
  *
@@ -758,6 +803,7 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 		"ctx_id(%d)/comm(%d)/is_main_xs(%d).\n",
 		dx->dx_name, dx->dx_xs_id, dx->dx_tgt_id, dx->dx_ctx_id,
 		dx->dx_comm, dx->dx_main_xs);
+	dss_xstream_topo_report(dx);
 
 	return 0;
 out_xstream:
@@ -960,8 +1006,47 @@ dss_xstreams_init(void)
 	D_INFO("CPU relax mode is set to [%s]\n",
 	       sched_relax_mode2str(sched_relax_mode));
 
+	d_getenv_int("DAOS_SCHED_SPIN_WINDOW", &sched_spin_window);
+	if (sched_spin_window > SCHED_RELAX_INTVL_MAX * 1000) {
+		D_WARN("Invalid spin window %u, set to default %u usecs.\n",
+		       sched_spin_window, SCHED_SPIN_WINDOW_DEFAULT);
+		sched_spin_window = SCHED_SPIN_WINDOW_DEFAULT;
+	}
+	if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE)
+		D_INFO("CPU spin window is set to %u usecs\n", sched_spin_window);
+
+	d_getenv_int("DAOS_SCHED_ADMIT_DEPTH", &sched_admit_depth);
+	d_getenv_int("DAOS_SCHED_ADMIT_DELAY", &sched_admit_delay);
+	if (sched_admit_depth != 0 || sched_admit_delay != 0)
+		D_INFO("I/O admission control is enabled, depth:%u, delay:%u msecs\n",
+		       sched_admit_depth, sched_admit_delay);
+
+	env = getenv("DAOS_SCHED_POLICY");
+	if (env) {
+		sched_policy = sched_str2policy(env);
+		if (sched_policy == SCHED_POLICY_MAX) {
+			D_WARN("Invalid sched policy [%s]\n", env);
+			sched_policy = SCHED_POLICY_FIFO;
+		}
+	}
+	D_INFO("IO request sched policy is set to [%s]\n", sched_policy2str(sched_policy));
+
 	d_getenv_int("DAOS_SCHED_UNIT_RUNTIME_MAX", &sched_unit_runtime_max);
 	d_getenv_bool("DAOS_SCHED_WATCHDOG_ALL", &sched_watchdog_all);
+	d_getenv_bool("DAOS_SCHED_WORK_STEAL", &sched_work_steal);
+	d_getenv_bool("DAOS_SCHED_PROF", &sched_prof_enabled);
+	d_getenv_int("DAOS_COLL_BRANCH", &dss_coll_branch);
+	D_INFO("Fan-out branch of collective calls is set to %u\n", dss_coll_branch);
+	d_getenv_int("DAOS_SCHED_DEEP_STACK_CACHE", &sched_stack_cache_max);
+	/* Stacks provided by the caller aren't protected by the Argobots overflow check */
+	env = getenv("ABT_STACK_OVERFLOW_CHECK");
+	if (env != NULL && strcasecmp(env, "none") != 0 && sched_stack_cache_max != 0) {
+		D_INFO("ABT_STACK_OVERFLOW_CHECK=%s, ULT stack cache is disabled\n", env);
+		sched_stack_cache_max = 0;
+	}
+	if (dss_helper_pool)
+		D_INFO("Work stealing among helper xstreams is %s\n",
+		       sched_work_steal ? "enabled" : "disabled");
 
 	/* start the execution streams */
 	D_DEBUG(DB_TRACE,
@@ -1138,6 +1223,25 @@ dss_parameters_set(unsigned int key_id, uint64_t value)
 	case DMG_KEY_FAIL_NUM:
 		daos_fail_num_set(value);
 		break;
+	case DMG_KEY_IO_WEIGHT_FG:
+		rc = bio_io_weight_set(BIO_IO_CLASS_FG, value);
+		break;
+	case DMG_KEY_IO_WEIGHT_REBUILD:
+		rc = bio_io_weight_set(BIO_IO_CLASS_REBUILD, value);
+		break;
+	case DMG_KEY_IO_WEIGHT_BG:
+		rc = bio_io_weight_set(BIO_IO_CLASS_BG, value);
+		break;
+	case DMG_KEY_SCHED_PROF:
+		rc = sched_prof_set(value);
+		break;
+	case DMG_KEY_SCHED_ADMIT_DELAY:
+		sched_admit_delay = value;
+		D_INFO("Admission control max queueing delay %u ms\n", sched_admit_delay);
+		break;
+	case DMG_KEY_COLL_BENCH:
+		rc = dss_coll_bench(value);
+		break;
 	default:
 		D_ERROR("invalid key_id %d\n", key_id);
 		rc = -DER_INVAL;
@@ -24,13 +24,43 @@ enum {
 	DSS_POOL_CNT,
 };
 
+/*
+ * Request classes for the queueing delay stats and the deadline scheduling,
+ * only foreground I/O classes are assigned with deadlines.
+ */
+enum {
+	SCHED_CLASS_READ_SMALL	= 0,
+	SCHED_CLASS_READ,
+	SCHED_CLASS_UPDATE,
+	SCHED_CLASS_IO_MAX,
+	SCHED_CLASS_MIGRATE	= SCHED_CLASS_IO_MAX,
+	SCHED_CLASS_GC,
+	SCHED_CLASS_SCRUB,
+	SCHED_CLASS_MAX,
+};
+
+struct sched_stack;
+
+struct sched_stack_pool {
+	struct sched_stack	*ssp_free;	/* Cached free stacks */
+	uint32_t		 ssp_free_cnt;	/* Number of cached free stacks */
+};
+
 struct sched_stats {
 	struct d_tm_node_t	*ss_total_time;		/* Total CPU time (ms) */
 	struct d_tm_node_t	*ss_relax_time;		/* CPU relax time (ms) */
+	struct d_tm_node_t	*ss_relax_saved;	/* Measured CPU relax time (us) */
+	struct d_tm_node_t	*ss_wakeup_lat;		/* Wakeup latency (us) */
 	struct d_tm_node_t	*ss_wq_len;		/* Wait queue length */
 	struct d_tm_node_t	*ss_sq_len;		/* Sleep queue length */
 	struct d_tm_node_t	*ss_cycle_duration;	/* Cycle duration (ms) */
 	struct d_tm_node_t	*ss_cycle_size;		/* Total ULTs in a cycle */
+	struct d_tm_node_t	*ss_qos_throttled;	/* Requests throttled by QoS */
+	struct d_tm_node_t	*ss_qos_delay;		/* QoS throttled time (ms) */
+	struct d_tm_node_t	*ss_ws_queue;		/* Steal queue length */
+	struct d_tm_node_t	*ss_ws_stolen;		/* ULTs stolen from others */
+	struct d_tm_node_t	*ss_rejected;		/* Requests rejected on overload */
+	struct d_tm_node_t	*ss_queue_delay[SCHED_CLASS_MAX]; /* Queueing delay (ms) */
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
@@ -41,13 +71,29 @@ struct sched_info {
 	uint64_t		 si_cur_seq;	/* Current schedule sequence */
 	uint64_t		 si_ult_start;	/* Start time of last executed unit */
 	void			*si_ult_func;	/* Function addr of last executed unit */
+	void			*si_rpc_func;	/* ULT function of the RPC requests */
+	uint32_t		 si_ult_opc;	/* RPC opcode of last executed unit */
+	uint64_t		 si_arrival_ns;	/* Last arrival (ns), set by any xs */
+	uint64_t		 si_arrival_last; /* Last seen arrival time (ns) */
+	uint64_t		 si_arrival_gap; /* Average inter-arrival time (ns) */
+	uint64_t		 si_relax_start; /* Relax start time (ns), 0 if not */
+	uint64_t		 si_prof_start;	/* Profiling start time (ns) of last unit */
+	struct sched_prof	*si_prof;	/* ULT profiler */
+	bool			 si_prof_resumed; /* Last unit resumed from yield */
 	struct sched_stats	 si_stats;	/* Sched stats */
 	d_list_t		 si_idle_list;	/* All unused requests */
 	d_list_t		 si_sleep_list;	/* All sleeping requests */
 	d_list_t		 si_fifo_list;	/* All IO requests in FIFO */
+	d_list_t		 si_edf_list[SCHED_CLASS_IO_MAX]; /* IO requests per class */
 	d_list_t		 si_purge_list;	/* Stale sched_pool_info */
 	struct d_hash_table	*si_pool_hash;	/* All sched_pool_info */
+	d_list_t		 si_steal_list;	/* Offloaded ULTs to be created */
+	pthread_spinlock_t	 si_steal_lock;	/* Protect si_steal_list */
+	uint32_t		 si_steal_cnt;	/* Item count in si_steal_list */
+	struct sched_stack_pool	 si_stacks;	/* Deep ULT stack cache */
+	ABT_thread_attr		 si_stack_attr;	/* Attr for ULT on cached stack */
 	uint32_t		 si_req_cnt;	/* Total inuse request count */
+	uint32_t		 si_qos_held_cnt; /* Requests held by QoS limits */
 	int			 si_sleep_cnt;	/* Sleeping request count */
 	int			 si_wait_cnt;	/* Long wait request count */
 	unsigned int		 si_stop:1;
@@ -89,6 +135,8 @@ struct engine_metrics {
 	struct d_tm_node_t	*rank_id;
 	struct d_tm_node_t	*dead_rank_events;
 	struct d_tm_node_t	*last_event_time;
+	struct d_tm_node_t	*coll_latency;
+	struct d_tm_node_t	*numa_node;
 };
 
 extern struct engine_metrics dss_engine_metrics;
@@ -153,11 +201,20 @@ int dss_engine_metrics_fini(void);
 /* sched.c */
 #define SCHED_RELAX_INTVL_MAX		100 /* msec */
 #define SCHED_RELAX_INTVL_DEFAULT	1 /* msec */
+#define SCHED_SPIN_WINDOW_DEFAULT	500 /* usec */
+
+/* ult.c */
+#define DSS_COLL_BRANCH_DEFAULT		8
+
+extern unsigned int dss_coll_branch;
+
+int dss_coll_bench(unsigned int iters);
 
 enum sched_cpu_relax_mode {
 	SCHED_RELAX_MODE_NET		= 0,
 	SCHED_RELAX_MODE_SLEEP,
 	SCHED_RELAX_MODE_DISABLED,
+	SCHED_RELAX_MODE_ADAPTIVE,
 	SCHED_RELAX_MODE_INVALID,
 };
 
@@ -171,6 +228,8 @@ sched_relax_mode2str(enum sched_cpu_relax_mode mode)
 		return "sleep";
 	case SCHED_RELAX_MODE_DISABLED:
 		return "disabled";
+	case SCHED_RELAX_MODE_ADAPTIVE:
+		return "adaptive";
 	default:
 		return "invalid";
 	}
@@ -185,23 +244,93 @@ sched_relax_str2mode(char *str)
 		return SCHED_RELAX_MODE_NET;
 	else if (strcasecmp(str, "disabled") == 0)
 		return SCHED_RELAX_MODE_DISABLED;
+	else if (strcasecmp(str, "adaptive") == 0)
+		return SCHED_RELAX_MODE_ADAPTIVE;
 	else
 		return SCHED_RELAX_MODE_INVALID;
 }
 
+enum sched_policy_type {
+	/* All requests for various pools are processed in FIFO */
+	SCHED_POLICY_FIFO	= 0,
+	/*
+	 * All requests are processed in RR based on certain ID (Client ID,
+	 * Pool ID, Container ID, JobID, UID, etc.)
+	 */
+	SCHED_POLICY_ID_RR,
+	/*
+	 * Request priority is based on certain ID (Client ID, Pool ID,
+	 * Container ID, JobID, UID, etc.)
+	 */
+	SCHED_POLICY_ID_PRIO,
+	/* IO requests are processed in earliest deadline first */
+	SCHED_POLICY_EDF,
+	SCHED_POLICY_MAX
+};
+
+static inline char *
+sched_policy2str(enum sched_policy_type policy)
+{
+	switch (policy) {
+	case SCHED_POLICY_FIFO:
+		return "fifo";
+	case SCHED_POLICY_EDF:
+		return "edf";
+	default:
+		return "invalid";
+	}
+}
+
+static inline enum sched_policy_type
+sched_str2policy(char *str)
+{
+	if (strcasecmp(str, "fifo") == 0)
+		return SCHED_POLICY_FIFO;
+	else if (strcasecmp(str, "edf") == 0)
+		return SCHED_POLICY_EDF;
+	else
+		return SCHED_POLICY_MAX;
+}
+
 extern bool sched_prio_disabled;
 extern unsigned int sched_stats_intvl;
 extern unsigned int sched_relax_intvl;
 extern unsigned int sched_relax_mode;
+extern unsigned int sched_spin_window;
+extern unsigned int sched_admit_depth;
+extern unsigned int sched_admit_delay;
+extern unsigned int sched_policy;
 extern unsigned int sched_unit_runtime_max;
 extern bool sched_watchdog_all;
+extern bool sched_work_steal;
+extern bool sched_prof_enabled;
+extern unsigned int sched_stack_cache_max;
 
 void dss_sched_fini(struct dss_xstream *dx);
 int dss_sched_init(struct dss_xstream *dx);
 int sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 		      void (*func)(void *), void *arg);
 void sched_stop(struct dss_xstream *dx);
+int sched_stack_create_thread(struct dss_xstream *dx, void (*func)(void *), void *arg,
+			      ABT_thread_attr t_attr);
+int sched_prof_set(uint64_t value);
+int sched_steal_enqueue(struct dss_xstream *dx, void (*func)(void *), void *arg,
+			size_t stack_size, bool comm);
+
 
+/*
+ * Record an external event (new ULT or offloaded work) for the xstream, it could be
+ * called from any xstream.
+ */
+static inline void
+sched_note_arrival(struct sched_info *info)
+{
+	/* Atomic integer assignment from different xstream */
+	info->si_stats.ss_busy_ts = info->si_cur_ts;
+	/* Precise arrival time is only needed for learning arrivals or measuring wakeup */
+	if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE || info->si_relax_start != 0)
+		info->si_arrival_ns = daos_get_ntime();
+}
 
 static inline bool
 sched_xstream_stopping(void)
@@ -219,6 +348,17 @@ sched_xstream_stopping(void)
 	return state == ABT_TRUE;
 }
 
+/*
+ * Offloaded ULTs for the helper xstreams shared by all targets are queued on
+ * the per-helper steal queue, idle helpers steal from the busy ones.
+ */
+static inline bool
+sched_steal_xs(struct dss_xstream *dx)
+{
+	return sched_work_steal && dss_helper_pool && !dx->dx_main_xs &&
+	       dx->dx_xs_id >= dss_sys_xs_nr;
+}
+
 static inline int
 sched_create_task(struct dss_xstream *dx, void (*func)(void *), void *arg,
 		  ABT_task *task, unsigned int flags)
@@ -232,8 +372,7 @@ sched_create_task(struct dss_xstream *dx, void (*func)(void *), void *arg,
 
 	/* Avoid bumping busy ts for internal periodically created tasks */
 	if (!(flags & DSS_ULT_FL_PERIODIC))
-		/* Atomic integer assignment from different xstream */
-		info->si_stats.ss_busy_ts = info->si_cur_ts;
+		sched_note_arrival(info);
 
 	rc = ABT_task_create(abt_pool, func, arg, task);
 	return dss_abterr2der(rc);
@@ -253,8 +392,20 @@ sched_create_thread(struct dss_xstream *dx, void (*func)(void *), void *arg,
 
 	/* Avoid bumping busy ts for internal periodically created ULTs */
 	if (!(flags & DSS_ULT_FL_PERIODIC))
-		/* Atomic integer assignment from different xstream */
-		info->si_stats.ss_busy_ts = info->si_cur_ts;
+		sched_note_arrival(info);
+
+	/*
+	 * The stack cache is per-xstream and lockless, it's only used for the deep stack ULT
+	 * created on current xstream, and the ULT handle isn't returned since the stack is
+	 * recycled on ULT function returning. Default size stacks are already recycled by
+	 * the per-xstream stack pool of Argobots.
+	 */
+	if (thread == NULL && t_attr != ABT_THREAD_ATTR_NULL && sched_stack_cache_max != 0 &&
+	    dx == dss_current_xstream()) {
+		rc = sched_stack_create_thread(dx, func, arg, t_attr);
+		if (rc != -DER_NOTSUPPORTED)
+			return rc;
+	}
 
 	rc = ABT_thread_create(abt_pool, func, arg, t_attr, thread);
 	return dss_abterr2der(rc);
@@ -67,6 +67,23 @@ dss_engine_metrics_init(void)
 		return rc;
 	}
 
+	rc = d_tm_add_metric(&dss_engine_metrics.numa_node, D_TM_GAUGE,
+			     "NUMA node the xstreams are bound to", "", "topo/numa_node");
+	if (rc != 0) {
+		D_ERROR("unable to add metric for NUMA node: "
+			DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+
+	rc = d_tm_add_metric(&dss_engine_metrics.coll_latency, D_TM_STATS_GAUGE,
+			     "Latency of collective calls on all targets", "us",
+			     "collective/latency");
+	if (rc != 0) {
+		D_ERROR("unable to add metric for collective latency: "
+			DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+
 	return 0;
 }
 
@@ -9,21 +9,11 @@
 #include <abt.h>
 #include <daos/common.h>
 #include <daos_errno.h>
+#include <gurt/atomic.h>
 #include "srv_internal.h"
 
 /* ============== Thread collective functions ============================ */
 
-struct aggregator_arg_type {
-	struct dss_stream_arg_type	at_args;
-	void				(*at_reduce)(void *a_args,
-						     void *s_args);
-	int				at_rc;
-	int				at_xs_nr;
-};
-
-/**
- * Collective operations among all server xstreams
- */
 struct dss_future_arg {
 	ABT_future	dfa_future;
 	int		(*dfa_func)(void *);
@@ -36,67 +26,131 @@ struct dss_future_arg {
 	bool		dfa_async;
 };
 
-struct collective_arg {
-	struct dss_future_arg		ca_future;
+/*
+ * Collective ULTs (or tasklets) are fanned out over a k-ary tree, node 0 is the
+ * caller, node i (i > 0) runs on the i-th involved target. Before calling the
+ * collective function, each node creates ULTs for its children on their own
+ * xstreams, so the fan-out cost is spread over the xstreams instead of being
+ * serialized on the caller.
+ *
+ * A node completes when its own function and all its children have completed,
+ * the last one finishing reduces the partial results of its children (if the
+ * dss_coll_ops::co_reduce_tree is set) then completes the parent. Nothing blocks
+ * in the tree, so it works for tasklets as well.
+ */
+struct coll_tree_node {
+	struct coll_tree		*ctn_tree;
+	struct dss_stream_arg_type	*ctn_stream;	/* NULL for the caller */
+	ATOMIC uint32_t			 ctn_pending;	/* Self + pending children */
+	uint32_t			 ctn_idx;
+	int				 ctn_tgt;
+};
+
+struct coll_tree {
+	struct dss_coll_ops		*ct_ops;
+	void				*ct_func_args;
+	struct coll_tree_node		*ct_nodes;
+	uint32_t			 ct_nr;		/* Including the caller */
+	uint32_t			 ct_branch;
+	ABT_eventual			 ct_eventual;
+	ABT_thread_attr			 ct_attr;
+	unsigned int			 ct_flags;
+	bool				 ct_ult;
 };
 
+unsigned int	dss_coll_branch = DSS_COLL_BRANCH_DEFAULT;
+
+#define coll_for_each_child(tree, idx, c)					\
+	for ((c) = (idx) * (tree)->ct_branch + 1;				\
+	     (c) <= (idx) * (tree)->ct_branch + (tree)->ct_branch && (c) < (tree)->ct_nr; \
+	     (c)++)
+
 static void
-collective_func(void *varg)
+coll_node_done(struct coll_tree *tree, uint32_t idx)
 {
-	struct dss_stream_arg_type	*a_args	= varg;
-	struct collective_arg		*carg	= a_args->st_coll_args;
-	struct dss_future_arg		*f_arg	= &carg->ca_future;
-	int				rc;
+	struct coll_tree_node	*node = &tree->ct_nodes[idx];
+	uint32_t		 c;
 
-	/** Update just the rc value */
-	a_args->st_rc = f_arg->dfa_func(f_arg->dfa_arg);
+	if (atomic_fetch_sub(&node->ctn_pending, 1) > 1)
+		return;
 
-	rc = ABT_future_set(f_arg->dfa_future, (void *)a_args);
-	if (rc != ABT_SUCCESS)
-		D_ERROR("future set failure %d\n", rc);
+	if (idx == 0) {
+		ABT_eventual_set(tree->ct_eventual, NULL, 0);
+		return;
+	}
+
+	/* All children completed, reduce their partial results into this node */
+	if (tree->ct_ops->co_reduce != NULL && tree->ct_ops->co_reduce_tree) {
+		coll_for_each_child(tree, idx, c)
+			tree->ct_ops->co_reduce(node->ctn_stream->st_arg,
+						tree->ct_nodes[c].ctn_stream->st_arg);
+	}
+
+	coll_node_done(tree, (idx - 1) / tree->ct_branch);
 }
 
-/* Reduce the return codes into the first element. */
+static void coll_node_func(void *arg);
+
 static void
-collective_reduce(void **arg)
+coll_dispatch(struct coll_tree *tree, uint32_t idx)
 {
-	struct aggregator_arg_type	*aggregator;
-	struct dss_stream_arg_type	*stream;
-	int				*nfailed;
-	int				 i;
+	struct coll_tree_node	*node;
+	struct dss_xstream	*dx;
+	uint32_t		 c;
+	int			 rc;
+
+	coll_for_each_child(tree, idx, c) {
+		node = &tree->ct_nodes[c];
+		dx = dss_get_xstream(DSS_MAIN_XS_ID(node->ctn_tgt));
+		if (tree->ct_ult)
+			rc = sched_create_thread(dx, coll_node_func, node, tree->ct_attr, NULL,
+						 tree->ct_flags);
+		else
+			rc = sched_create_task(dx, coll_node_func, node, NULL, tree->ct_flags);
+		if (rc == 0)
+			continue;
 
-	aggregator = (struct aggregator_arg_type *)arg[0];
-	nfailed = &aggregator->at_args.st_rc;
+		/* Take over the fan-out of the failed child */
+		node->ctn_stream->st_rc = rc;
+		coll_dispatch(tree, c);
+		coll_node_done(tree, c);
+	}
+}
 
-	for (i = 1; i < aggregator->at_xs_nr + 1; i++) {
-		stream = (struct dss_stream_arg_type *)arg[i];
-		if (stream->st_rc != 0) {
-			if (aggregator->at_rc == 0)
-				aggregator->at_rc = stream->st_rc;
-			(*nfailed)++;
-		}
+static void
+coll_node_func(void *arg)
+{
+	struct coll_tree_node	*node = arg;
+	struct coll_tree	*tree = node->ctn_tree;
 
-		/** optional custom aggregator call provided across streams */
-		if (aggregator->at_reduce)
-			aggregator->at_reduce(aggregator->at_args.st_arg,
-					      stream->st_arg);
-	}
+	coll_dispatch(tree, node->ctn_idx);
+	node->ctn_stream->st_rc = tree->ct_ops->co_func(tree->ct_func_args);
+	coll_node_done(tree, node->ctn_idx);
+}
+
+static bool
+coll_tgt_involved(struct dss_coll_args *args, int tid)
+{
+	if (args->ca_tgt_bitmap == NULL)
+		return true;
+
+	return tid < args->ca_tgt_bitmap_sz * NBBY && isset(args->ca_tgt_bitmap, tid);
 }
 
 static int
 dss_collective_reduce_internal(struct dss_coll_ops *ops,
 			       struct dss_coll_args *args, bool create_ult,
-			       unsigned int flags)
+			       unsigned int flags, unsigned int branch)
 {
-	struct collective_arg		carg;
+	struct coll_tree		tree = { 0 };
+	struct coll_tree_node		*node;
 	struct dss_coll_stream_args	*stream_args;
 	struct dss_stream_arg_type	*stream;
-	struct aggregator_arg_type	aggregator;
-	struct dss_xstream		*dx;
-	ABT_future			future;
+	uint64_t			start;
+	uint32_t			c;
 	int				xs_nr;
-	int				rc;
-	int				tid;
+	int				rc, rc1;
+	int				tid, i;
 
 	if (ops == NULL || args == NULL || ops->co_func == NULL) {
 		D_DEBUG(DB_MD, "mandatory args missing dss_collective_reduce");
@@ -115,106 +169,114 @@ dss_collective_reduce_internal(struct dss_coll_ops *ops,
 		return -DER_CANCELED;
 	}
 
+	start = daos_get_ntime();
 	xs_nr = dss_tgt_nr;
 	stream_args = &args->ca_stream_args;
 	D_ALLOC_ARRAY(stream_args->csa_streams, xs_nr);
 	if (stream_args->csa_streams == NULL)
 		return -DER_NOMEM;
 
-	/*
-	 * Use the first, extra element of the value array to store the number
-	 * of failed tasks.
-	 */
-	rc = ABT_future_create(xs_nr + 1, collective_reduce, &future);
-	if (rc != ABT_SUCCESS)
-		D_GOTO(out_streams, rc = dss_abterr2der(rc));
-
-	carg.ca_future.dfa_future = future;
-	carg.ca_future.dfa_func	= ops->co_func;
-	carg.ca_future.dfa_arg	= args->ca_func_args;
-	carg.ca_future.dfa_status = 0;
-
-	memset(&aggregator, 0, sizeof(aggregator));
-	aggregator.at_xs_nr = xs_nr;
-	if (ops->co_reduce) {
-		aggregator.at_args.st_arg = args->ca_aggregator;
-		aggregator.at_reduce	  = ops->co_reduce;
-	}
+	D_ALLOC_ARRAY(tree.ct_nodes, xs_nr + 1);
+	if (tree.ct_nodes == NULL)
+		D_GOTO(out_streams, rc = -DER_NOMEM);
 
 	if (ops->co_reduce_arg_alloc)
 		for (tid = 0; tid < xs_nr; tid++) {
 			stream = &stream_args->csa_streams[tid];
-			rc = ops->co_reduce_arg_alloc(stream,
-						     aggregator.at_args.st_arg);
+			rc = ops->co_reduce_arg_alloc(stream, args->ca_aggregator);
 			if (rc)
-				D_GOTO(out_future, rc);
+				D_GOTO(out_nodes, rc);
 		}
 
-	rc = ABT_future_set(future, (void *)&aggregator);
-	D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
-	for (tid = 0; tid < xs_nr; tid++) {
-		stream			= &stream_args->csa_streams[tid];
-		stream->st_coll_args	= &carg;
-
-		if (args->ca_exclude_tgts_cnt) {
-			int i;
-
-			for (i = 0; i < args->ca_exclude_tgts_cnt; i++)
-				if (args->ca_exclude_tgts[i] == tid)
-					break;
+	/* Build the tree with involved targets, node 0 is the caller */
+	for (tid = 0; tid < xs_nr; tid++)
+		tree.ct_nodes[tid + 1].ctn_tgt = coll_tgt_involved(args, tid) ? tid : -1;
+	for (i = 0; i < args->ca_exclude_tgts_cnt; i++) {
+		tid = args->ca_exclude_tgts[i];
+		if (tid >= 0 && tid < xs_nr)
+			tree.ct_nodes[tid + 1].ctn_tgt = -1;
+	}
 
-			if (i < args->ca_exclude_tgts_cnt) {
-				D_DEBUG(DB_TRACE, "Skip tgt %d\n", tid);
-				rc = ABT_future_set(future, (void *)stream);
-				D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
-				continue;
-			}
+	tree.ct_nr = 1;
+	for (tid = 0; tid < xs_nr; tid++) {
+		if (tree.ct_nodes[tid + 1].ctn_tgt == -1) {
+			D_DEBUG(DB_TRACE, "Skip tgt %d\n", tid);
+			continue;
 		}
+		/* Compact in place, ct_nr never exceeds tid + 1 */
+		node = &tree.ct_nodes[tree.ct_nr];
+		node->ctn_tgt = tid;
+		node->ctn_idx = tree.ct_nr;
+		node->ctn_stream = &stream_args->csa_streams[tid];
+		tree.ct_nr++;
+	}
 
-		dx = dss_get_xstream(DSS_MAIN_XS_ID(tid));
-		if (create_ult) {
-			ABT_thread_attr		attr;
-			int			rc1;
+	tree.ct_ops = ops;
+	tree.ct_func_args = args->ca_func_args;
+	tree.ct_flags = flags;
+	tree.ct_ult = create_ult;
+	tree.ct_attr = ABT_THREAD_ATTR_NULL;
+	/* Zero branch means flat fan-out, the caller creates all ULTs */
+	tree.ct_branch = branch != 0 ? branch : tree.ct_nr;
+
+	for (i = 0; i < tree.ct_nr; i++) {
+		node = &tree.ct_nodes[i];
+		node->ctn_tree = &tree;
+		node->ctn_pending = 1;
+		coll_for_each_child(&tree, i, c)
+			node->ctn_pending++;
+	}
 
-			if (flags & DSS_ULT_DEEP_STACK) {
-				rc1 = ABT_thread_attr_create(&attr);
-				if (rc1 != ABT_SUCCESS)
-					D_GOTO(next, rc = dss_abterr2der(rc1));
+	rc = ABT_eventual_create(0, &tree.ct_eventual);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(out_nodes, rc = dss_abterr2der(rc));
 
-				rc1 = ABT_thread_attr_set_stacksize(attr, DSS_DEEP_STACK_SZ);
-				D_ASSERT(rc1 == ABT_SUCCESS);
+	if (create_ult && (flags & DSS_ULT_DEEP_STACK)) {
+		rc = ABT_thread_attr_create(&tree.ct_attr);
+		if (rc != ABT_SUCCESS)
+			D_GOTO(out_eventual, rc = dss_abterr2der(rc));
 
-				D_DEBUG(DB_TRACE, "Create collective ult with stacksize %d\n",
-					DSS_DEEP_STACK_SZ);
+		rc = ABT_thread_attr_set_stacksize(tree.ct_attr, DSS_DEEP_STACK_SZ);
+		D_ASSERT(rc == ABT_SUCCESS);
 
-			} else {
-				attr = ABT_THREAD_ATTR_NULL;
-			}
+		D_DEBUG(DB_TRACE, "Create collective ult with stacksize %d\n",
+			DSS_DEEP_STACK_SZ);
+	}
 
-			rc = sched_create_thread(dx, collective_func, stream, attr, NULL, flags);
-			if (attr != ABT_THREAD_ATTR_NULL) {
-				rc1 = ABT_thread_attr_free(&attr);
-				D_ASSERT(rc1 == ABT_SUCCESS);
-			}
-		} else {
-			rc = sched_create_task(dx, collective_func, stream,
-					       NULL, flags);
-		}
+	coll_dispatch(&tree, 0);
+	coll_node_done(&tree, 0);
+	ABT_eventual_wait(tree.ct_eventual, NULL);
 
-		if (rc != 0) {
-next:
-			stream->st_rc = rc;
-			rc = ABT_future_set(future, (void *)stream);
-			D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
+	/* Return the first failure */
+	rc = 0;
+	for (tid = 0; tid < xs_nr; tid++) {
+		stream = &stream_args->csa_streams[tid];
+		if (stream->st_rc != 0) {
+			rc = stream->st_rc;
+			break;
 		}
 	}
 
-	ABT_future_wait(future);
+	/* Optional custom aggregator call provided across streams */
+	if (ops->co_reduce != NULL && ops->co_reduce_tree) {
+		coll_for_each_child(&tree, 0, c)
+			ops->co_reduce(args->ca_aggregator, tree.ct_nodes[c].ctn_stream->st_arg);
+	} else if (ops->co_reduce != NULL) {
+		for (tid = 0; tid < xs_nr; tid++)
+			ops->co_reduce(args->ca_aggregator, stream_args->csa_streams[tid].st_arg);
+	}
 
-	rc = aggregator.at_rc;
+	d_tm_set_gauge(dss_engine_metrics.coll_latency,
+		       (daos_get_ntime() - start) / NSEC_PER_USEC);
 
-out_future:
-	ABT_future_free(&future);
+	if (tree.ct_attr != ABT_THREAD_ATTR_NULL) {
+		rc1 = ABT_thread_attr_free(&tree.ct_attr);
+		D_ASSERT(rc1 == ABT_SUCCESS);
+	}
+out_eventual:
+	ABT_eventual_free(&tree.ct_eventual);
+out_nodes:
+	D_FREE(tree.ct_nodes);
 
 	if (ops->co_reduce_arg_free)
 		for (tid = 0; tid < xs_nr; tid++)
@@ -245,7 +307,7 @@ int
 dss_task_collective_reduce(struct dss_coll_ops *ops,
 			   struct dss_coll_args *args, unsigned int flags)
 {
-	return dss_collective_reduce_internal(ops, args, false, flags);
+	return dss_collective_reduce_internal(ops, args, false, flags, dss_coll_branch);
 }
 
 /**
@@ -267,7 +329,7 @@ int
 dss_thread_collective_reduce(struct dss_coll_ops *ops,
 			     struct dss_coll_args *args, unsigned int flags)
 {
-	return dss_collective_reduce_internal(ops, args, true, flags);
+	return dss_collective_reduce_internal(ops, args, true, flags, dss_coll_branch);
 }
 
 static int
@@ -322,6 +384,71 @@ dss_thread_collective(int (*func)(void *), void *arg, unsigned int flags)
 	return dss_collective_internal(func, arg, true, flags);
 }
 
+static int
+coll_bench_noop(void *arg)
+{
+	return 0;
+}
+
+/**
+ * Measure the latency of collective tasklets running an empty function over
+ * the first 1, 2, 4 ... targets, for a few fan-out branches. The average
+ * latency of each combination is printed, it's triggered by setting the
+ * DMG_KEY_COLL_BENCH parameter.
+ *
+ * \param[in] iters	Number of collective calls for each combination
+ *
+ * \return		0 on success, negative value if error.
+ */
+int
+dss_coll_bench(unsigned int iters)
+{
+	static const unsigned int	 branches[] = { 0, 2, 4, 8, 16 };
+	struct dss_coll_ops		 ops = { 0 };
+	struct dss_coll_args		 args = { 0 };
+	uint8_t				*bitmap;
+	unsigned int			 bitmap_sz;
+	unsigned int			 tgt_nr = 0;
+	uint64_t			 start;
+	int				 i, j, rc = 0;
+
+	if (iters == 0)
+		return -DER_INVAL;
+
+	bitmap_sz = (dss_tgt_nr + NBBY - 1) / NBBY;
+	D_ALLOC(bitmap, bitmap_sz);
+	if (bitmap == NULL)
+		return -DER_NOMEM;
+
+	ops.co_func = coll_bench_noop;
+	args.ca_tgt_bitmap = bitmap;
+	args.ca_tgt_bitmap_sz = bitmap_sz;
+
+	while (tgt_nr < dss_tgt_nr) {
+		tgt_nr = tgt_nr == 0 ? 1 : min(tgt_nr * 2, dss_tgt_nr);
+		for (i = 0; i < tgt_nr; i++)
+			setbit(bitmap, i);
+
+		for (i = 0; i < ARRAY_SIZE(branches); i++) {
+			start = daos_get_ntime();
+			for (j = 0; j < iters; j++) {
+				rc = dss_collective_reduce_internal(&ops, &args, false, 0,
+								    branches[i]);
+				if (rc != 0) {
+					D_ERROR("Collective bench failed: "DF_RC"\n", DP_RC(rc));
+					goto out;
+				}
+			}
+			D_PRINT("Collective bench: targets %u, branch %u, latency "DF_U64" us\n",
+				tgt_nr, branches[i],
+				(daos_get_ntime() - start) / iters / NSEC_PER_USEC);
+		}
+	}
+out:
+	D_FREE(bitmap);
+	return rc;
+}
+
 /* ============== ULT create functions =================================== */
 
 static inline int
@@ -423,6 +550,11 @@ ult_create_internal(void (*func)(void *), void *arg, int xs_type, int tgt_idx,
 	if (dx == NULL)
 		return -DER_NONEXIST;
 
+	/* Leave it to the helper which turns idle first, no handle for queued ULT */
+	if (sched_steal_xs(dx) && ult == NULL && flags == 0 &&
+	    (xs_type == DSS_XS_IOFW || xs_type == DSS_XS_OFFLOAD))
+		return sched_steal_enqueue(dx, func, arg, stack_size, xs_type == DSS_XS_IOFW);
+
 	if (stack_size > 0) {
 		rc = ABT_thread_attr_create(&attr);
 		if (rc != ABT_SUCCESS)
@@ -463,12 +463,18 @@ int dc_obj_list_dkey(tse_task_t *task);
 int dc_obj_list_akey(tse_task_t *task);
 int dc_obj_list_rec(tse_task_t *task);
 int dc_obj_list_obj(tse_task_t *task);
+int dc_obj_fetch_batch_task(tse_task_t *task);
+int dc_obj_update_batch_task(tse_task_t *task);
 int dc_obj_fetch_md(daos_obj_id_t oid, struct daos_obj_md *md);
 int dc_obj_layout_get(daos_handle_t oh, struct daos_obj_layout **p_layout);
 int dc_obj_layout_refresh(daos_handle_t oh);
 int dc_obj_verify(daos_handle_t oh, daos_epoch_t *epochs, unsigned int nr);
 daos_handle_t dc_obj_hdl2cont_hdl(daos_handle_t oh);
 int dc_obj_get_grp_size(daos_handle_t oh, int *grp_size);
+void dc_obj_replica_query(uint32_t rank, uint64_t *least, uint64_t *explored,
+			  uint64_t *picked);
+void dc_obj_hedge_query(uint64_t *issued, uint64_t *won);
+void dc_obj_batch_query(uint64_t *rpcs, uint64_t *reqs, uint64_t *fallbacks);
 
 int dc_tx_open(tse_task_t *task);
 int dc_tx_commit(tse_task_t *task);
@@ -518,6 +524,10 @@ enum daos_io_flags {
 	DIOF_EC_RECOV_FROM_PARITY = 0x200,
 	/* Force fetch/list to do degraded enumeration/fetch */
 	DIOF_FOR_FORCE_DEGRADE = 0x400,
+	/* Part of a batched fetch/update, extra_arg is the batch entry */
+	DIOF_BATCH		= 0x800,
+	/* Part of a hedged fetch, extra_arg is the hedge context */
+	DIOF_HEDGE		= 0x1000,
 };
 
 /**
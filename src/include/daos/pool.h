@@ -44,7 +44,11 @@
 #define DAOS_PO_QUERY_PROP_SCRUB_MODE	(1ULL << (PROP_BIT_START + 15))
 #define DAOS_PO_QUERY_PROP_SCRUB_FREQ	(1ULL << (PROP_BIT_START + 16))
 #define DAOS_PO_QUERY_PROP_SCRUB_THRESH	(1ULL << (PROP_BIT_START + 17))
-#define DAOS_PO_QUERY_PROP_BIT_END	33
+#define DAOS_PO_QUERY_PROP_QOS_IOPS	(1ULL << (PROP_BIT_START + 18))
+#define DAOS_PO_QUERY_PROP_QOS_BW	(1ULL << (PROP_BIT_START + 19))
+#define DAOS_PO_QUERY_PROP_QOS_CONT_IOPS (1ULL << (PROP_BIT_START + 20))
+#define DAOS_PO_QUERY_PROP_QOS_CONT_BW	(1ULL << (PROP_BIT_START + 21))
+#define DAOS_PO_QUERY_PROP_BIT_END	37
 
 #define DAOS_PO_QUERY_PROP_ALL						\
 	(DAOS_PO_QUERY_PROP_LABEL | DAOS_PO_QUERY_PROP_SPACE_RB |	\
@@ -55,7 +59,9 @@
 	 DAOS_PO_QUERY_PROP_RP_PDA | DAOS_PO_QUERY_PROP_REDUN_FAC | \
 	 DAOS_PO_QUERY_PROP_POLICY | DAOS_PO_QUERY_PROP_GLOBAL_VERSION | \
 	 DAOS_PO_QUERY_PROP_UPGRADE_STATUS | DAOS_PO_QUERY_PROP_SCRUB_MODE | \
-	 DAOS_PO_QUERY_PROP_SCRUB_FREQ | DAOS_PO_QUERY_PROP_SCRUB_THRESH)
+	 DAOS_PO_QUERY_PROP_SCRUB_FREQ | DAOS_PO_QUERY_PROP_SCRUB_THRESH | \
+	 DAOS_PO_QUERY_PROP_QOS_IOPS | DAOS_PO_QUERY_PROP_QOS_BW | \
+	 DAOS_PO_QUERY_PROP_QOS_CONT_IOPS | DAOS_PO_QUERY_PROP_QOS_CONT_BW)
 
 int dc_pool_init(void);
 void dc_pool_fini(void);
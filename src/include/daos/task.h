@@ -97,6 +97,9 @@ struct daos_task_args {
 		daos_kv_put_t		kv_put;
 		daos_kv_remove_t	kv_remove;
 		daos_kv_list_t		kv_list;
+
+		/** Object batch */
+		daos_obj_batch_t	obj_batch;
 	}		 ta_u;
 	daos_event_t	*ta_ev;
 };
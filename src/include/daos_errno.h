@@ -284,6 +284,9 @@ extern "C" {
 	/** Re-update again */						\
 	ACTION(DER_UPDATE_AGAIN,	(DER_ERR_DAOS_BASE + 41),	\
 	       update again)						\
+	/** Server is overloaded, retry after the suggested backoff */	\
+	ACTION(DER_OVERLOAD_RETRY,	(DER_ERR_DAOS_BASE + 42),	\
+	       Server is overloaded retry later)			\
 
 /** Defines the gurt error codes */
 #define D_FOREACH_ERR_RANGE(ACTION)	\
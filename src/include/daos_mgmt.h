@@ -59,9 +59,25 @@ enum {
 	DMG_KEY_FAIL_LOC	 = 0,
 	DMG_KEY_FAIL_VALUE,
 	DMG_KEY_FAIL_NUM,
+	DMG_KEY_IO_WEIGHT_FG,
+	DMG_KEY_IO_WEIGHT_REBUILD,
+	DMG_KEY_IO_WEIGHT_BG,
+	DMG_KEY_SCHED_PROF,
+	/** Max queueing delay (ms) of foreground I/O before rejecting, 0 to disable */
+	DMG_KEY_SCHED_ADMIT_DELAY,
+	/** Measure the collective latency on all targets, value is the iteration count */
+	DMG_KEY_COLL_BENCH,
 	DMG_KEY_NUM,
 };
 
+/** Values of DMG_KEY_SCHED_PROF to control the ULT execution time profiler */
+enum {
+	SCHED_PROF_DISABLE	= 0,
+	SCHED_PROF_ENABLE,
+	/** Drop all profiled metrics */
+	SCHED_PROF_RESET,
+};
+
 /**
  * Set parameter on servers.
  *
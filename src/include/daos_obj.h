@@ -298,6 +298,12 @@ enum {
 	DAOS_OO_IO_RAND        = (1 << 4),
 	/** unsupported: sequential I/O */
 	DAOS_OO_IO_SEQ         = (1 << 5),
+	/**
+	 * Hedged fetch: if a fetch hasn't completed after a percentile of the
+	 * recent fetch latencies, fetch again from another replica (or by
+	 * degraded fetch for EC object), the first reply is returned.
+	 */
+	DAOS_OO_HEDGE          = (1 << 6),
 };
 
 /**
@@ -470,6 +476,25 @@ typedef struct {
 	uint32_t	kd_val_type;
 } daos_key_desc_t;
 
+/**
+ * One operation of a batched fetch or update, see daos_obj_fetch_batch() and
+ * daos_obj_update_batch().
+ */
+typedef struct {
+	/** Object open handle */
+	daos_handle_t	 bo_oh;
+	/** Distribution key */
+	daos_key_t	*bo_dkey;
+	/** Number of entries in \a bo_iods and \a bo_sgls */
+	unsigned int	 bo_nr;
+	/** I/O descriptors */
+	daos_iod_t	*bo_iods;
+	/** Scatter/gather lists of the data */
+	d_sg_list_t	*bo_sgls;
+	/** [out]: result of this operation */
+	int		 bo_rc;
+} daos_obj_batch_op_t;
+
 static inline daos_oclass_id_t
 daos_obj_id2class(daos_obj_id_t oid)
 {
@@ -551,7 +576,8 @@ daos_obj_generate_oid(daos_handle_t coh, daos_obj_id_t *oid,
  *
  * \param[in]	coh	Container open handle.
  * \param[in]	oid	Object ID.
- * \param[in]	mode	Open mode: DAOS_OO_RO/RW/EXCL/IO_RAND/IO_SEQ
+ * \param[in]	mode	Open mode: DAOS_OO_RO/RW/EXCL/IO_RAND/IO_SEQ, can be
+ *			combined with DAOS_OO_HEDGE
  * \param[out]	oh	Returned object open handle.
  * \param[in]	ev	Completion event, it is optional and can be NULL.
  *			The function will run in blocking mode if \a ev is NULL.
@@ -808,6 +834,50 @@ daos_obj_update(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 		daos_key_t *dkey, unsigned int nr, daos_iod_t *iods,
 		d_sg_list_t *sgls, daos_event_t *ev);
 
+/**
+ * Fetch a batch of small, independent operations which may target different
+ * objects. Operations whose shards live on the same engine target are packed
+ * into a single RPC and served by one server ULT, which amortizes the per-RPC
+ * cost for tiny objects. Large (bulk), erasure coded or transactional I/O is
+ * issued as regular per-object RPCs.
+ *
+ * \param[in,out]
+ *		ops	Array of \a nr operations. The result of each operation
+ *			is returned in \a ops::bo_rc.
+ *
+ * \param[in]	nr	Number of operations in \a ops.
+ *
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 if all the operations succeeded, otherwise the error
+ *			of the first failed operation.
+ */
+int
+daos_obj_fetch_batch(daos_obj_batch_op_t *ops, unsigned int nr,
+		     daos_event_t *ev);
+
+/**
+ * Update a batch of small, independent operations which may target different
+ * objects, see daos_obj_fetch_batch(). Each operation is an independent
+ * transaction.
+ *
+ * \param[in,out]
+ *		ops	Array of \a nr operations. The result of each operation
+ *			is returned in \a ops::bo_rc.
+ *
+ * \param[in]	nr	Number of operations in \a ops.
+ *
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 if all the operations succeeded, otherwise the error
+ *			of the first failed operation.
+ */
+int
+daos_obj_update_batch(daos_obj_batch_op_t *ops, unsigned int nr,
+		      daos_event_t *ev);
+
 /**
  * Distribution key enumeration.
  *
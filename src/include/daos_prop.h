@@ -117,6 +117,34 @@ enum daos_pool_props {
 	 * default: 0 (disabled)
 	 */
 	DAOS_PROP_PO_SCRUB_THRESH,
+	/**
+	 * QoS limit of foreground I/O operations per second of the pool,
+	 * evenly divided across the pool targets.
+	 *
+	 * default: 0 (unlimited)
+	 */
+	DAOS_PROP_PO_QOS_IOPS,
+	/**
+	 * QoS limit of foreground I/O bandwidth of the pool, in bytes per
+	 * second, evenly divided across the pool targets.
+	 *
+	 * default: 0 (unlimited)
+	 */
+	DAOS_PROP_PO_QOS_BW,
+	/**
+	 * QoS limit of foreground I/O operations per second of each container
+	 * in the pool, evenly divided across the pool targets.
+	 *
+	 * default: 0 (unlimited)
+	 */
+	DAOS_PROP_PO_QOS_CONT_IOPS,
+	/**
+	 * QoS limit of foreground I/O bandwidth of each container in the pool,
+	 * in bytes per second, evenly divided across the pool targets.
+	 *
+	 * default: 0 (unlimited)
+	 */
+	DAOS_PROP_PO_QOS_CONT_BW,
 	DAOS_PROP_PO_MAX,
 };
 
@@ -402,6 +402,19 @@ void bio_register_bulk_ops(int (*bulk_create)(void *ctxt, d_sg_list_t *sgl,
 					      unsigned int perm,
 					      void **bulk_hdl),
 			   int (*bulk_free)(void *bulk_hdl));
+/**
+ * Get the NUMA node that most of the NVMe SSDs in the config file are
+ * attached to, it can be called before bio_nvme_init().
+ *
+ * \param[IN] nvme_conf	NVMe config file
+ * \param[IN] numa_nr		Upper bound (exclusive) of the OS NUMA node
+ *				indexes on the system
+ *
+ * \return			OS index of the NUMA node as reported by sysfs,
+ *				-1 if it can't be determined
+ */
+int bio_nvme_numa_node(const char *nvme_conf, int numa_nr);
+
 /**
  * Global NVMe initialization.
  *
@@ -545,6 +558,15 @@ int bio_blob_unmap(struct bio_io_context *ctxt, uint64_t off, uint64_t len);
  */
 int bio_blob_unmap_sgl(struct bio_io_context *ctxt, d_sg_list_t *unmap_sgl, uint32_t blk_sz);
 
+/*
+ * Invalidate the pages of the extent being freed from the NVMe read cache.
+ *
+ * \param[IN] ctxt	I/O context
+ * \param[IN] off	Offset in bytes
+ * \param[IN] len	Length in bytes
+ */
+void bio_rcache_invalidate(struct bio_io_context *ctxt, uint64_t off, uint64_t len);
+
 /**
  * Write to per VOS instance blob.
  *
@@ -567,6 +589,19 @@ int bio_write(struct bio_io_context *ctxt, bio_addr_t addr, d_iov_t *iov);
  */
 int bio_read(struct bio_io_context *ctxt, bio_addr_t addr, d_iov_t *iov);
 
+/**
+ * Read from per VOS instance blob in the specified I/O class.
+ *
+ * \param[IN] ctxt	VOS instance I/O context
+ * \param[IN] addr	SPDK blob addr info including byte offset
+ * \param[IN] iov	IO vector containing buffer from read
+ * \param[IN] io_class	I/O class, see enum bio_io_class
+ *
+ * \returns		Zero on success, negative value on error
+ */
+int bio_read_class(struct bio_io_context *ctxt, bio_addr_t addr, d_iov_t *iov,
+		   unsigned int io_class);
+
 /**
  * Write SGL to per VOS instance blob.
  *
@@ -636,6 +671,38 @@ enum bio_chunk_type {
 	BIO_CHK_TYPE_MAX,
 };
 
+/* Priority class of the NVMe I/O issued by an io descriptor */
+enum bio_io_class {
+	BIO_IO_CLASS_FG	= 0,	/* Foreground client I/O */
+	BIO_IO_CLASS_REBUILD,	/* Rebuild & migration */
+	BIO_IO_CLASS_BG,	/* Aggregation, scrubbing, etc. */
+	BIO_IO_CLASS_MAX,
+};
+
+/**
+ * Set the priority class of an io descriptor, it must be called before
+ * bio_iod_prep(). The io descriptor is in BIO_IO_CLASS_FG by default, the
+ * one prepared with BIO_CHK_TYPE_REBUILD is always in BIO_IO_CLASS_REBUILD.
+ *
+ * \param biod       [IN]	io descriptor
+ * \param io_class   [IN]	I/O class, see enum bio_io_class
+ *
+ * \return		N/A
+ */
+void bio_iod_set_class(struct bio_desc *biod, unsigned int io_class);
+
+/**
+ * Set the dispatch weight of an I/O class, NVMe I/O from the I/O classes
+ * are dispatched in proportion to their weights when the device queue is
+ * saturated. It can be changed at runtime.
+ *
+ * \param io_class   [IN]	I/O class, see enum bio_io_class
+ * \param weight     [IN]	Dispatch weight, must be non-zero
+ *
+ * \return		Zero on success, negative value on error
+ */
+int bio_io_weight_set(unsigned int io_class, unsigned int weight);
+
 /**
  * Prepare all the SG lists of an io descriptor.
  *
@@ -749,6 +816,40 @@ int bio_get_dev_state(struct nvme_stats *dev_state,
  */
 void bio_get_bs_state(int *blobstore_state, struct bio_xs_context *xs);
 
+/*
+ * Helper function to get the write combining counters of a given xstream.
+ * Used for VOS unit test validation.
+ *
+ * \param xs		[IN]	xstream context
+ * \param writes	[OUT]	Small NVMe writes staged for write combining
+ * \param cmds		[OUT]	NVMe commands issued for the staged writes
+ */
+void bio_wc_query(struct bio_xs_context *xs, uint64_t *writes, uint64_t *cmds);
+
+/*
+ * Helper function to change the max combined write size at runtime, 0 disables
+ * write combining. Used for VOS unit test.
+ *
+ * \param pgs		[IN]	Max combined write in DMA pages
+ *
+ * \return			Previous max combined write in DMA pages
+ */
+unsigned int bio_wc_set(unsigned int pgs);
+
+/*
+ * Helper function to get the read cache counters of a given xstream.
+ * Used for VOS unit test validation.
+ *
+ * \param xs		[IN]	xstream context
+ * \param hits		[OUT]	Extents served from the read cache
+ * \param misses	[OUT]	Eligible extents not found in the read cache
+ * \param invals	[OUT]	Cached pages invalidated by free or overwrite
+ *
+ * \return			False if the read cache is disabled
+ */
+bool bio_rcache_query(struct bio_xs_context *xs, uint64_t *hits, uint64_t *misses,
+		      uint64_t *invals);
+
 
 /*
  * Helper function to set the device health state to FAULTY, and trigger device
@@ -228,12 +228,22 @@ enum {
 enum {
 	SCHED_REQ_FL_NO_DELAY	= (1 << 0),
 	SCHED_REQ_FL_PERIODIC	= (1 << 1),
+	/* Request from client, it could be rejected on overload and retried by client */
+	SCHED_REQ_FL_CLIENT	= (1 << 2),
+	/* Request is an RPC, the ULT argument is the crt_rpc_t */
+	SCHED_REQ_FL_RPC	= (1 << 3),
 };
 
 struct sched_req_attr {
 	uuid_t		sra_pool_id;
+	/* Container of foreground I/O request, for per-container QoS */
+	uuid_t		sra_cont_id;
+	/* Estimated payload size in bytes, for bandwidth QoS */
+	uint64_t	sra_size;
 	uint32_t	sra_type;
 	uint32_t	sra_flags;
+	/* Suggested backoff (ms) for client when the request is rejected on overload */
+	uint32_t	sra_backoff;
 };
 
 static inline void
@@ -242,9 +252,33 @@ sched_req_attr_init(struct sched_req_attr *attr, unsigned int type,
 {
 	attr->sra_type = type;
 	attr->sra_flags = 0;
+	attr->sra_size = 0;
+	attr->sra_backoff = 0;
 	uuid_copy(attr->sra_pool_id, *pool_id);
+	uuid_clear(attr->sra_cont_id);
 }
 
+/* QoS limits of foreground I/O on current target, zero means unlimited */
+struct sched_qos_limits {
+	/* Per pool IOPS and bandwidth (bytes per second) */
+	uint64_t	sql_iops;
+	uint64_t	sql_bw;
+	/* Per container IOPS and bandwidth (bytes per second) */
+	uint64_t	sql_cont_iops;
+	uint64_t	sql_cont_bw;
+};
+
+/**
+ * Set the QoS limits of foreground I/O (update & fetch) for a pool on current
+ * xstream, must be called on VOS xstream.
+ *
+ * \param[in] pool_id	Pool UUID.
+ * \param[in] limits	QoS limits for the pool on current target.
+ *
+ * \retval		Zero on success, negative value on error.
+ */
+int sched_pool_qos_set(uuid_t pool_id, struct sched_qos_limits *limits);
+
 struct sched_request;	/* Opaque schedule request */
 
 /**
@@ -406,6 +440,11 @@ dss_ult_yield(void *arg)
 struct dss_module_ops {
 	/* Get schedule request attributes from RPC */
 	int (*dms_get_req_attr)(crt_rpc_t *rpc, struct sched_req_attr *attr);
+	/*
+	 * Reply the request rejected on overload with -DER_OVERLOAD_RETRY and the
+	 * suggested backoff in \a attr (optional).
+	 */
+	int (*dms_reject_req)(crt_rpc_t *rpc, struct sched_req_attr *attr);
 };
 
 int srv_profile_stop();
@@ -575,6 +614,15 @@ struct dss_coll_ops {
 	 */
 	void				(*co_reduce_arg_free)
 					(struct dss_stream_arg_type *args);
+
+	/**
+	 * co_reduce can merge the reduce arguments of two streams, that requires
+	 * the reduce arguments of streams to be the same type of the aggregator
+	 * arguments, and co_reduce to be associative. If it's set, the partial
+	 * results are reduced along the fan-out tree by the xstreams, otherwise,
+	 * the caller reduces the results of all streams.
+	 */
+	bool				co_reduce_tree;
 };
 
 struct dss_coll_args {
@@ -583,6 +631,13 @@ struct dss_coll_args {
 	void				*ca_aggregator;
 	int				*ca_exclude_tgts;
 	unsigned int			ca_exclude_tgts_cnt;
+	/**
+	 * Bitmap of involved targets (optional), targets not in the bitmap are
+	 * skipped as the excluded ones.
+	 */
+	uint8_t				*ca_tgt_bitmap;
+	/** Size of \a ca_tgt_bitmap in bytes */
+	unsigned int			ca_tgt_bitmap_sz;
 	/** Stream arguments for all streams */
 	struct dss_coll_stream_args	ca_stream_args;
 };
@@ -85,6 +85,11 @@ struct ds_pool {
 	uint64_t		sp_scrub_mode;
 	uint64_t		sp_scrub_freq_sec;
 	uint64_t		sp_scrub_thresh;
+	/** QoS limits of foreground I/O, per target share, 0 means unlimited */
+	uint64_t		sp_qos_iops;
+	uint64_t		sp_qos_bw;
+	uint64_t		sp_qos_cont_iops;
+	uint64_t		sp_qos_cont_bw;
 };
 
 struct ds_pool *ds_pool_lookup(const uuid_t uuid);
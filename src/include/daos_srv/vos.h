@@ -231,6 +231,13 @@ vos_self_init(const char *db_path, bool use_sys_db, int tgt_id);
 void
 vos_self_fini(void);
 
+/**
+ * Get the NVMe context of the current xstream, for a standalone VOS it's
+ * the self polling context created by vos_self_init().
+ */
+struct bio_xs_context *
+vos_xsctxt_get(void);
+
 /**
  * Versioning Object Storage Pool (VOSP)
  * A VOSP creates and manages a versioned object store on a local
@@ -265,6 +265,8 @@ enum {
 	VOS_OF_SKIP_FETCH		= (1 << 18),
 	/** Operation on EC object (currently only applies to update) */
 	VOS_OF_EC			= (1 << 19),
+	/** Background I/O (aggregation, etc.), lower NVMe I/O priority */
+	VOS_OF_BG			= (1 << 20),
 };
 
 enum {
@@ -118,6 +118,10 @@ typedef enum {
 	DAOS_OPC_KV_REMOVE,
 	DAOS_OPC_KV_LIST,
 
+	/** Object batch APIs */
+	DAOS_OPC_OBJ_FETCH_BATCH,
+	DAOS_OPC_OBJ_UPDATE_BATCH,
+
 	DAOS_OPC_MAX
 } daos_opc_t;
 
@@ -681,6 +685,14 @@ typedef daos_obj_rw_t		daos_obj_fetch_t;
 /** update args struct */
 typedef daos_obj_rw_t		daos_obj_update_t;
 
+/** Object batched fetch/update args */
+typedef struct {
+	/** Operations of the batch. */
+	daos_obj_batch_op_t	*ops;
+	/** Number of operations in \a ops. */
+	uint32_t		 nr;
+} daos_obj_batch_t;
+
 /** Object sync args */
 struct daos_obj_sync_args {
 	/** Object open handle */
@@ -0,0 +1,406 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * DAOS client batched fetch/update of small objects.
+ *
+ * Every operation of a batch runs as a regular fetch/update task, so that
+ * placement, retry and reply handling are shared with the per-object path.
+ * The shard requests of these tasks are queued per target instead of being
+ * sent, and each queue is sent as one DAOS_OBJ_RPC_RW_BATCH RPC once all the
+ * operations of the batch reached the shard layer (or the queue is full).
+ *
+ * src/object/cli_batch.c
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/object.h>
+#include <daos/task.h>
+#include <daos_task.h>
+#include <daos_types.h>
+#include <gurt/atomic.h>
+#include "obj_rpc.h"
+#include "obj_internal.h"
+
+/** Max number of requests packed into one batch RPC */
+#define OBJ_BATCH_MAX_OPS	128
+/** Estimated encoded size of one request besides its inline data */
+#define OBJ_BATCH_REQ_HDR_SIZE	256
+/** Max inline payload of one batch RPC, the same as a single request */
+#define OBJ_BATCH_MAX_SIZE	DAOS_BULK_LIMIT
+
+struct obj_batch;
+
+/** Per-operation entry, passed as the extra_arg of the fetch/update task */
+struct obj_batch_ent {
+	struct obj_batch	*be_batch;
+	daos_obj_batch_op_t	*be_op;
+	/** The shard request of the operation is queued or sent individually */
+	bool			 be_settled;
+};
+
+/** Requests queued for the same target, sent as one RPC */
+struct obj_batch_grp {
+	d_list_t		 bg_link;
+	crt_endpoint_t		 bg_ep;
+	crt_context_t		 bg_ctx;
+	crt_opcode_t		 bg_opc;
+	uint32_t		 bg_nr;
+	daos_size_t		 bg_size;
+	/** Input of the batch RPC, shallow copies of the request inputs */
+	struct obj_rw_in	*bg_in;
+	crt_rpc_t		*bg_reqs[OBJ_BATCH_MAX_OPS];
+	tse_task_t		*bg_tasks[OBJ_BATCH_MAX_OPS];
+};
+
+struct obj_batch {
+	/** Groups not sent yet */
+	d_list_t		 ob_grps;
+	/** Number of operations which have not settled their shard request yet */
+	uint32_t		 ob_pending;
+	struct obj_batch_ent	*ob_ents;
+};
+
+/** Set once a server doesn't know DAOS_OBJ_RPC_RW_BATCH, then never batch again */
+static bool obj_batch_unsupported;
+
+/** Batch RPCs sent, requests packed into them, and the batch RPCs sent again individually */
+static ATOMIC uint64_t obj_batch_rpcs;
+static ATOMIC uint64_t obj_batch_reqs;
+static ATOMIC uint64_t obj_batch_fallbacks;
+
+static void
+obj_batch_grp_free(struct obj_batch_grp *grp)
+{
+	D_FREE(grp->bg_in);
+	D_FREE(grp);
+}
+
+/* Send the queued requests individually, as if they were never batched */
+static void
+obj_batch_grp_send_each(struct obj_batch_grp *grp)
+{
+	uint32_t	i;
+
+	for (i = 0; i < grp->bg_nr; i++)
+		daos_rpc_send(grp->bg_reqs[i], grp->bg_tasks[i]);
+	obj_batch_grp_free(grp);
+}
+
+static void
+obj_batch_rpc_cb(const struct crt_cb_info *cb_info)
+{
+	struct obj_batch_grp	*grp = cb_info->cci_arg;
+	struct obj_rw_batch_out	*orbo = crt_reply_get(cb_info->cci_rpc);
+	int			 rc = cb_info->cci_rc;
+	bool			 unreg = rc == -DER_UNREG || rc == -DER_NOSYS;
+	uint32_t		 i;
+
+	if (unreg || DAOS_FAIL_CHECK(DAOS_OBJ_BATCH_UNREG)) {
+		D_DEBUG(DB_IO, "batch RPC unsupported by rank %u, fall back: "DF_RC"\n",
+			grp->bg_ep.ep_rank, DP_RC(rc));
+		/* Keep batching the later requests if it's only injected */
+		if (unreg)
+			obj_batch_unsupported = true;
+		atomic_fetch_add_relaxed(&obj_batch_fallbacks, 1);
+		obj_batch_grp_send_each(grp);
+		return;
+	}
+
+	if (rc == 0 && orbo->orb_ret == 0 && orbo->orb_replies.ca_count != grp->bg_nr) {
+		D_ERROR("batch RPC to rank %u replied %u of %u requests\n", grp->bg_ep.ep_rank,
+			(uint32_t)orbo->orb_replies.ca_count, grp->bg_nr);
+		rc = -DER_PROTO;
+	}
+
+	for (i = 0; i < grp->bg_nr; i++) {
+		crt_rpc_t		*req = grp->bg_reqs[i];
+		struct obj_rw_out	*orwo = crt_reply_get(req);
+
+		if (rc == 0 && orbo->orb_ret == 0) {
+			*orwo = orbo->orb_replies.ca_arrays[i];
+		} else if (rc == 0) {
+			orwo->orw_ret = orbo->orb_ret;
+			orwo->orw_map_version = orbo->orb_map_version;
+			orwo->orw_epoch = orbo->orb_epoch;
+		}
+
+		/* Reply is handled by dc_rw_cb(), as for the individual request */
+		tse_task_complete(grp->bg_tasks[i], rc);
+
+		/* The reply buffers belong to the batch RPC */
+		memset(orwo, 0, sizeof(*orwo));
+		crt_req_decref(req);
+	}
+
+	obj_batch_grp_free(grp);
+}
+
+static void
+obj_batch_grp_flush(struct obj_batch_grp *grp)
+{
+	struct obj_rw_batch_in	*orbi;
+	crt_rpc_t		*req;
+	uint32_t		 i;
+	int			 rc;
+
+	d_list_del_init(&grp->bg_link);
+	if (grp->bg_nr == 1 || obj_batch_unsupported)
+		goto send_each;
+
+	D_ALLOC_ARRAY(grp->bg_in, grp->bg_nr);
+	if (grp->bg_in == NULL)
+		goto send_each;
+
+	rc = obj_req_create(grp->bg_ctx, &grp->bg_ep, DAOS_OBJ_RPC_RW_BATCH, &req);
+	if (rc != 0) {
+		D_DEBUG(DB_IO, "failed to create batch RPC: "DF_RC"\n", DP_RC(rc));
+		goto send_each;
+	}
+
+	for (i = 0; i < grp->bg_nr; i++)
+		grp->bg_in[i] = *(struct obj_rw_in *)crt_req_get(grp->bg_reqs[i]);
+
+	orbi = crt_req_get(req);
+	orbi->orb_opc = grp->bg_opc;
+	orbi->orb_reqs.ca_count = grp->bg_nr;
+	orbi->orb_reqs.ca_arrays = grp->bg_in;
+
+	D_DEBUG(DB_IO, "batch RPC %p of %u %s to rank %u tag %u\n", req, grp->bg_nr,
+		obj_opc_to_str(grp->bg_opc), grp->bg_ep.ep_rank, grp->bg_ep.ep_tag);
+
+	atomic_fetch_add_relaxed(&obj_batch_rpcs, 1);
+	atomic_fetch_add_relaxed(&obj_batch_reqs, grp->bg_nr);
+	/* Failure is reported through obj_batch_rpc_cb() */
+	crt_req_send(req, obj_batch_rpc_cb, grp);
+	return;
+
+send_each:
+	obj_batch_grp_send_each(grp);
+}
+
+static void
+obj_batch_flush_all(struct obj_batch *batch)
+{
+	struct obj_batch_grp	*grp;
+	struct obj_batch_grp	*tmp;
+
+	d_list_for_each_entry_safe(grp, tmp, &batch->ob_grps, bg_link)
+		obj_batch_grp_flush(grp);
+}
+
+static void
+obj_batch_ent_settle(struct obj_batch_ent *ent)
+{
+	struct obj_batch	*batch = ent->be_batch;
+
+	if (ent->be_settled)
+		return;
+
+	ent->be_settled = true;
+	D_ASSERT(batch->ob_pending > 0);
+	if (--batch->ob_pending == 0)
+		obj_batch_flush_all(batch);
+}
+
+/**
+ * Called by dc_obj_shard_rw() for the request \a req of a batched operation,
+ * instead of sending it. \a eligible tells whether the request can be packed
+ * in a batch RPC, i.e. it carries its data inline and has no forwarding target.
+ *
+ * Returns true if the request is queued, it is then sent later and \a task is
+ * completed once the reply is available. Otherwise the caller sends it.
+ */
+bool
+obj_batch_rw_queue(void *batch_ent, crt_rpc_t *req, tse_task_t *task, bool eligible)
+{
+	struct obj_batch_ent	*ent = batch_ent;
+	struct obj_batch	*batch = ent->be_batch;
+	struct obj_batch_grp	*grp;
+	struct obj_rw_in	*orw = crt_req_get(req);
+	daos_size_t		 size;
+	bool			 found = false;
+
+	/* Retried or secondary request of a settled operation */
+	if (ent->be_settled || !eligible || obj_batch_unsupported) {
+		obj_batch_ent_settle(ent);
+		return false;
+	}
+
+	size = OBJ_BATCH_REQ_HDR_SIZE +
+	       daos_sgls_packed_size(orw->orw_sgls.ca_arrays, orw->orw_sgls.ca_count, NULL);
+
+	d_list_for_each_entry(grp, &batch->ob_grps, bg_link) {
+		if (grp->bg_ep.ep_rank == req->cr_ep.ep_rank &&
+		    grp->bg_ep.ep_tag == req->cr_ep.ep_tag) {
+			found = true;
+			break;
+		}
+	}
+
+	if (found && grp->bg_size + size > OBJ_BATCH_MAX_SIZE) {
+		obj_batch_grp_flush(grp);
+		found = false;
+	}
+
+	if (!found) {
+		D_ALLOC_PTR(grp);
+		if (grp == NULL) {
+			obj_batch_ent_settle(ent);
+			return false;
+		}
+		grp->bg_ep = req->cr_ep;
+		grp->bg_ctx = req->cr_ctx;
+		grp->bg_opc = opc_get(req->cr_opc);
+		d_list_add_tail(&grp->bg_link, &batch->ob_grps);
+	}
+
+	/* Keep the creation reference until the batch reply */
+	grp->bg_reqs[grp->bg_nr] = req;
+	grp->bg_tasks[grp->bg_nr] = task;
+	grp->bg_nr++;
+	grp->bg_size += size;
+
+	if (grp->bg_nr == OBJ_BATCH_MAX_OPS)
+		obj_batch_grp_flush(grp);
+
+	obj_batch_ent_settle(ent);
+	return true;
+}
+
+static int
+obj_batch_op_comp_cb(tse_task_t *task, void *data)
+{
+	struct obj_batch_ent	*ent = *((struct obj_batch_ent **)data);
+
+	ent->be_op->bo_rc = task->dt_result;
+	/* Failed before reaching the shard layer */
+	obj_batch_ent_settle(ent);
+	return 0;
+}
+
+static int
+obj_batch_fini_cb(tse_task_t *task, void *data)
+{
+	struct obj_batch	*batch = *((struct obj_batch **)data);
+
+	D_ASSERT(d_list_empty(&batch->ob_grps));
+	D_FREE(batch->ob_ents);
+	D_FREE(batch);
+	return 0;
+}
+
+static int
+obj_batch_task(tse_task_t *task, bool update)
+{
+	daos_obj_batch_t	*args = dc_task_get_args(task);
+	tse_sched_t		*sched = tse_task2sched(task);
+	struct obj_batch	*batch = NULL;
+	struct obj_batch_ent	*ent;
+	daos_obj_batch_op_t	*op;
+	daos_obj_rw_t		*io_args;
+	tse_task_t		*io_task;
+	d_list_t		 io_task_list;
+	uint32_t		 i;
+	int			 rc;
+
+	D_INIT_LIST_HEAD(&io_task_list);
+	if (args->nr == 0)
+		D_GOTO(out_task, rc = 0);
+
+	if (args->ops == NULL)
+		D_GOTO(out_task, rc = -DER_INVAL);
+
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		D_GOTO(out_task, rc = -DER_NOMEM);
+
+	D_INIT_LIST_HEAD(&batch->ob_grps);
+	D_ALLOC_ARRAY(batch->ob_ents, args->nr);
+	if (batch->ob_ents == NULL) {
+		D_FREE(batch);
+		D_GOTO(out_task, rc = -DER_NOMEM);
+	}
+
+	rc = tse_task_register_comp_cb(task, obj_batch_fini_cb, &batch, sizeof(batch));
+	if (rc != 0) {
+		D_FREE(batch->ob_ents);
+		D_FREE(batch);
+		D_GOTO(out_task, rc);
+	}
+
+	for (i = 0; i < args->nr; i++) {
+		op = &args->ops[i];
+		ent = &batch->ob_ents[i];
+		ent->be_batch = batch;
+		ent->be_op = op;
+		op->bo_rc = 0;
+
+		if (update)
+			rc = dc_obj_update_task_create(op->bo_oh, DAOS_TX_NONE, 0, op->bo_dkey,
+						       op->bo_nr, op->bo_iods, op->bo_sgls, NULL,
+						       sched, &io_task);
+		else
+			rc = dc_obj_fetch_task_create(op->bo_oh, DAOS_TX_NONE, 0, op->bo_dkey,
+						      op->bo_nr, 0, op->bo_iods, op->bo_sgls,
+						      NULL, NULL, NULL, NULL, sched, &io_task);
+		if (rc != 0) {
+			op->bo_rc = rc;
+			D_GOTO(out_abort, rc);
+		}
+
+		io_args = dc_task_get_args(io_task);
+		io_args->extra_flags |= DIOF_BATCH;
+		io_args->extra_arg = ent;
+
+		/* Counted as pending once its completion can settle it */
+		rc = tse_task_register_comp_cb(io_task, obj_batch_op_comp_cb, &ent, sizeof(ent));
+		if (rc != 0) {
+			tse_task_complete(io_task, rc);
+			op->bo_rc = rc;
+			D_GOTO(out_abort, rc);
+		}
+		batch->ob_pending++;
+
+		rc = tse_task_register_deps(task, 1, &io_task);
+		if (rc != 0) {
+			tse_task_complete(io_task, rc);
+			D_GOTO(out_abort, rc);
+		}
+		tse_task_list_add(io_task, &io_task_list);
+	}
+
+	tse_task_list_sched(&io_task_list, false);
+	tse_sched_progress(sched);
+	return 0;
+
+out_abort:
+	/* Operations which are not created are not counted as pending */
+	tse_task_list_abort(&io_task_list, rc);
+out_task:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+/** For test, the counters of the batch RPCs sent so far */
+void
+dc_obj_batch_query(uint64_t *rpcs, uint64_t *reqs, uint64_t *fallbacks)
+{
+	*rpcs = atomic_load_relaxed(&obj_batch_rpcs);
+	*reqs = atomic_load_relaxed(&obj_batch_reqs);
+	*fallbacks = atomic_load_relaxed(&obj_batch_fallbacks);
+}
+
+int
+dc_obj_fetch_batch_task(tse_task_t *task)
+{
+	return obj_batch_task(task, false);
+}
+
+int
+dc_obj_update_batch_task(tse_task_t *task)
+{
+	return obj_batch_task(task, true);
+}
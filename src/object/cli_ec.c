@@ -469,7 +469,7 @@ out:
 }
 
 /** Encode one full stripe, the result parity buffer will be filled. */
-static int
+int
 obj_ec_stripe_encode(daos_iod_t *iod, d_sg_list_t *sgl, uint32_t iov_idx,
 		     size_t iov_off, struct obj_ec_codec *codec,
 		     struct daos_oclass_attr *oca, uint64_t cell_bytes,
@@ -585,12 +585,14 @@ codec_get(struct obj_reasb_req *reasb_req, daos_obj_id_t oid)
 
 /**
  * Encode the data in full stripe recx_array, the result parity stored in
- * struct obj_ec_recx_array::oer_pbufs.
+ * struct obj_ec_recx_array::oer_pbufs. With \a encoder the stripes of array
+ * value are added as its jobs instead of being encoded inline.
  */
 static int
 obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 		   daos_iod_t *iod, d_sg_list_t *sgl,
-		   struct obj_ec_recx_array *recx_array)
+		   struct obj_ec_recx_array *recx_array,
+		   struct obj_ec_encoder *encoder)
 {
 	struct obj_ec_recx	*ec_recx;
 	unsigned int		 p = oca->u.ec.e_p;
@@ -599,7 +601,7 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 	uint32_t		 iov_idx = 0;
 	uint64_t		 iov_off = 0, last_off = 0;
 	uint32_t		 encoded_nr = 0;
-	uint32_t		 recx_nr, stripe_nr;
+	uint32_t		 recx_nr, stripe_nr, nr;
 	uint32_t		 i, j, m;
 	bool			 singv;
 	int			 rc = 0;
@@ -631,7 +633,7 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 			last_off = ec_recx->oer_byte_off;
 			stripe_nr = ec_recx->oer_stripe_nr;
 		}
-		for (j = 0; j < stripe_nr; j++) {
+		for (j = 0; j < stripe_nr; j += nr) {
 			for (m = 0; m < p; m++)
 				parity_buf[m] = recx_array->oer_pbufs[m] +
 						encoded_nr * cell_bytes;
@@ -640,18 +642,24 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 				DF_U64".\n", j, iov_off / iod->iod_size,
 				stripe_bytes / iod->iod_size);
 #endif
-			rc = obj_ec_stripe_encode(iod, sgl, iov_idx, iov_off,
-						  codec, oca, cell_bytes,
-						  parity_buf);
-			if (rc) {
-				D_ERROR("stripe encoding failed rc %d.\n", rc);
-				goto out;
+			if (encoder != NULL && !singv) {
+				nr = obj_ec_encoder_add(encoder, iod, sgl, iov_idx, iov_off,
+							cell_bytes, parity_buf, stripe_nr - j);
+			} else {
+				nr = 1;
+				rc = obj_ec_stripe_encode(iod, sgl, iov_idx, iov_off,
+							  codec, oca, cell_bytes,
+							  parity_buf);
+				if (rc) {
+					D_ERROR("stripe encoding failed rc %d.\n", rc);
+					goto out;
+				}
 			}
 			if (singv)
 				break;
-			encoded_nr++;
-			daos_sgl_move(sgl, iov_idx, iov_off, stripe_bytes);
-			last_off += stripe_bytes;
+			encoded_nr += nr;
+			daos_sgl_move(sgl, iov_idx, iov_off, nr * stripe_bytes);
+			last_off += nr * stripe_bytes;
 		}
 	}
 
@@ -1430,7 +1438,7 @@ obj_ec_singv_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 	if (rc)
 		D_GOTO(out, rc);
 
-	rc = obj_ec_recx_encode(codec, oca, iod, sgl, recxs);
+	rc = obj_ec_recx_encode(codec, oca, iod, sgl, recxs, NULL);
 	if (rc) {
 		D_ERROR("obj_ec_recx_encode failed %d.\n", rc);
 		D_GOTO(out, rc);
@@ -1654,9 +1662,10 @@ out:
 int
 obj_ec_encode(struct obj_reasb_req *reasb_req)
 {
-	struct obj_ec_codec *codec;
-	uint32_t	i;
-	int		rc;
+	struct obj_ec_codec	*codec;
+	struct obj_ec_encoder	*encoder = NULL;
+	uint32_t		 i;
+	int			 rc;
 
 	if (reasb_req->orr_usgls == NULL) /* punch case */
 		return 0;
@@ -1668,20 +1677,38 @@ obj_ec_encode(struct obj_reasb_req *reasb_req)
 		return -DER_INVAL;
 	}
 
+	if (reasb_req->orr_encode_async)
+		encoder = obj_ec_encoder_create(reasb_req, codec);
+
 	for (i = 0; i < reasb_req->orr_iod_nr; i++) {
 		rc = obj_ec_recx_encode(codec,
 					reasb_req->orr_oca,
 					&reasb_req->orr_uiods[i],
 					&reasb_req->orr_usgls[i],
-					&reasb_req->orr_recxs[i]);
+					&reasb_req->orr_recxs[i], encoder);
 		if (rc) {
 			D_ERROR(DF_OID" obj_ec_recx_encode failed %d.\n",
 				DP_OID(reasb_req->orr_oid), rc);
+			if (encoder != NULL)
+				obj_ec_encoder_destroy(encoder);
 			return rc;
 		}
 	}
 
-	return 0;
+	if (encoder == NULL)
+		return 0;
+
+	/* the caller waits for the busy encoder before sending the parity */
+	obj_ec_encoder_run(encoder);
+	if (obj_ec_encoder_busy(encoder)) {
+		reasb_req->orr_encoder = encoder;
+		return 0;
+	}
+
+	rc = obj_ec_encoder_destroy(encoder);
+	if (rc)
+		D_ERROR(DF_OID" EC encoding failed %d.\n", DP_OID(reasb_req->orr_oid), rc);
+	return rc;
 }
 
 int
@@ -0,0 +1,354 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * DAOS client EC encoding thread pool.
+ *
+ * The full stripes of a large EC update are split into a few jobs of
+ * contiguous stripes. The calling thread encodes the first job itself and
+ * the others are encoded by a small pool of encoder threads in parallel. The
+ * update task waits for the jobs to be done before sending its RPCs.
+ *
+ * src/object/cli_ec_encode.c
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/common.h>
+#include <daos_task.h>
+#include <daos_types.h>
+#include "obj_rpc.h"
+#include "obj_internal.h"
+
+/** Max number of encoder threads */
+#define OBJ_EC_ENCODE_THREAD_MAX	32
+
+struct obj_ec_encode_job {
+	d_list_t		 ej_link;
+	struct obj_ec_encoder	*ej_encoder;
+	daos_iod_t		*ej_iod;
+	d_sg_list_t		*ej_sgl;
+	/** parity buffers of the first stripe of the job */
+	unsigned char		*ej_pbufs[OBJ_EC_MAX_P];
+	uint64_t		 ej_cell_bytes;
+	uint64_t		 ej_iov_off;
+	uint32_t		 ej_iov_idx;
+	uint32_t		 ej_stripe_nr;
+};
+
+struct obj_ec_encoder {
+	struct obj_ec_codec	*oe_codec;
+	struct daos_oclass_attr	*oe_oca;
+	/** max number of stripes per job */
+	uint32_t		 oe_stripe_max;
+	uint32_t		 oe_job_nr;
+	uint32_t		 oe_job_max;
+	/** jobs not done yet, protected by obj_ec_encode_lock */
+	uint32_t		 oe_pending;
+	int			 oe_rc;
+	struct obj_ec_encode_job oe_jobs[0];
+};
+
+/** Number of encoder threads, 0 to encode inline in the calling thread */
+unsigned int			 obj_ec_encode_thread_nr;
+static pthread_t		*obj_ec_encode_threads;
+static pthread_mutex_t		 obj_ec_encode_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t		 obj_ec_encode_cond = PTHREAD_COND_INITIALIZER;
+static d_list_t			 obj_ec_encode_queue = D_LIST_HEAD_INIT(obj_ec_encode_queue);
+static bool			 obj_ec_encode_stop;
+/** statistics, protected by obj_ec_encode_lock */
+static uint64_t			 obj_ec_encode_reqs;
+static uint64_t			 obj_ec_encode_jobs;
+static uint64_t			 obj_ec_encode_stripes;
+
+static int
+obj_ec_encode_job_run(struct obj_ec_encode_job *job)
+{
+	struct obj_ec_encoder	*encoder = job->ej_encoder;
+	unsigned int		 p = obj_ec_parity_tgt_nr(encoder->oe_oca);
+	uint64_t		 stripe_bytes;
+	uint64_t		 iov_off = job->ej_iov_off;
+	uint32_t		 iov_idx = job->ej_iov_idx;
+	unsigned char		*parity_buf[p];
+	uint32_t		 i, m;
+	int			 rc = 0;
+
+	stripe_bytes = job->ej_cell_bytes * obj_ec_data_tgt_nr(encoder->oe_oca);
+	for (i = 0; i < job->ej_stripe_nr; i++) {
+		for (m = 0; m < p; m++)
+			parity_buf[m] = job->ej_pbufs[m] + i * job->ej_cell_bytes;
+		rc = obj_ec_stripe_encode(job->ej_iod, job->ej_sgl, iov_idx, iov_off,
+					  encoder->oe_codec, encoder->oe_oca,
+					  job->ej_cell_bytes, parity_buf);
+		if (rc) {
+			D_ERROR("stripe encoding failed rc %d.\n", rc);
+			break;
+		}
+		daos_sgl_move(job->ej_sgl, iov_idx, iov_off, stripe_bytes);
+	}
+
+	return rc;
+}
+
+static void
+obj_ec_encode_job_done(struct obj_ec_encode_job *job, int rc)
+{
+	struct obj_ec_encoder	*encoder = job->ej_encoder;
+
+	D_MUTEX_LOCK(&obj_ec_encode_lock);
+	if (encoder->oe_rc == 0)
+		encoder->oe_rc = rc;
+	D_ASSERT(encoder->oe_pending > 0);
+	encoder->oe_pending--;
+	D_MUTEX_UNLOCK(&obj_ec_encode_lock);
+}
+
+static void *
+obj_ec_encode_thread(void *arg)
+{
+	struct obj_ec_encode_job	*job;
+	int				 rc;
+
+	D_MUTEX_LOCK(&obj_ec_encode_lock);
+	while (1) {
+		/* Drain the queued jobs before exiting, their updates are waiting */
+		while (!obj_ec_encode_stop && d_list_empty(&obj_ec_encode_queue))
+			pthread_cond_wait(&obj_ec_encode_cond, &obj_ec_encode_lock);
+		if (d_list_empty(&obj_ec_encode_queue))
+			break;
+
+		job = d_list_pop_entry(&obj_ec_encode_queue, struct obj_ec_encode_job, ej_link);
+		D_MUTEX_UNLOCK(&obj_ec_encode_lock);
+
+		rc = obj_ec_encode_job_run(job);
+		obj_ec_encode_job_done(job, rc);
+
+		D_MUTEX_LOCK(&obj_ec_encode_lock);
+	}
+	D_MUTEX_UNLOCK(&obj_ec_encode_lock);
+
+	return NULL;
+}
+
+/**
+ * Create an encoder for the full stripes of \a reasb_req, return NULL if the
+ * encoding should be done inline, i.e. the pool is disabled or there are too
+ * few stripes to be split.
+ */
+struct obj_ec_encoder *
+obj_ec_encoder_create(struct obj_reasb_req *reasb_req, struct obj_ec_codec *codec)
+{
+	struct obj_ec_encoder	*encoder;
+	uint32_t		 stripe_nr = 0;
+	uint32_t		 recx_nr = 0;
+	uint32_t		 job_max;
+	uint32_t		 i;
+
+	if (obj_ec_encode_threads == NULL || reasb_req->orr_singv_only)
+		return NULL;
+
+	for (i = 0; i < reasb_req->orr_iod_nr; i++) {
+		if (reasb_req->orr_uiods[i].iod_type == DAOS_IOD_SINGLE ||
+		    reasb_req->orr_uiods[i].iod_size == DAOS_REC_ANY)
+			continue;
+		stripe_nr += reasb_req->orr_recxs[i].oer_stripe_total;
+		recx_nr += reasb_req->orr_recxs[i].oer_nr;
+	}
+	if (stripe_nr < 2)
+		return NULL;
+
+	/* one job for the calling thread and one for each encoder thread, plus
+	 * the partial jobs at the end of the recxs.
+	 */
+	job_max = obj_ec_encode_thread_nr + 1 + recx_nr;
+	D_ALLOC(encoder, sizeof(*encoder) + job_max * sizeof(encoder->oe_jobs[0]));
+	if (encoder == NULL)
+		return NULL;
+
+	encoder->oe_codec = codec;
+	encoder->oe_oca = reasb_req->orr_oca;
+	encoder->oe_job_max = job_max;
+	encoder->oe_stripe_max = (stripe_nr + obj_ec_encode_thread_nr) /
+				 (obj_ec_encode_thread_nr + 1);
+	return encoder;
+}
+
+/**
+ * Add a job to encode \a stripe_nr contiguous full stripes starting from
+ * \a iov_idx and \a iov_off of \a sgl, return the number of stripes taken by
+ * the job, at most obj_ec_encoder::oe_stripe_max.
+ */
+uint32_t
+obj_ec_encoder_add(struct obj_ec_encoder *encoder, daos_iod_t *iod, d_sg_list_t *sgl,
+		   uint32_t iov_idx, uint64_t iov_off, uint64_t cell_bytes,
+		   unsigned char *parity_bufs[], uint32_t stripe_nr)
+{
+	struct obj_ec_encode_job	*job;
+	unsigned int			 p = obj_ec_parity_tgt_nr(encoder->oe_oca);
+	unsigned int			 m;
+
+	D_ASSERT(encoder->oe_job_nr < encoder->oe_job_max);
+	job = &encoder->oe_jobs[encoder->oe_job_nr++];
+	job->ej_encoder = encoder;
+	job->ej_iod = iod;
+	job->ej_sgl = sgl;
+	job->ej_iov_idx = iov_idx;
+	job->ej_iov_off = iov_off;
+	job->ej_cell_bytes = cell_bytes;
+	job->ej_stripe_nr = min(stripe_nr, encoder->oe_stripe_max);
+	for (m = 0; m < p; m++)
+		job->ej_pbufs[m] = parity_bufs[m];
+
+	return job->ej_stripe_nr;
+}
+
+/**
+ * Queue the jobs of \a encoder to the encoder threads, except the first one
+ * which is encoded by the calling thread before return. All the jobs are
+ * encoded by the calling thread once the encoder threads are being stopped.
+ */
+void
+obj_ec_encoder_run(struct obj_ec_encoder *encoder)
+{
+	uint32_t	stripe_nr = 0;
+	uint32_t	inline_nr = 1;
+	uint32_t	i;
+	int		rc;
+
+	if (encoder->oe_job_nr == 0)
+		return;
+
+	D_MUTEX_LOCK(&obj_ec_encode_lock);
+	if (obj_ec_encode_stop)
+		inline_nr = encoder->oe_job_nr;
+	encoder->oe_pending = encoder->oe_job_nr;
+	for (i = 0; i < encoder->oe_job_nr; i++) {
+		stripe_nr += encoder->oe_jobs[i].ej_stripe_nr;
+		if (i >= inline_nr)
+			d_list_add_tail(&encoder->oe_jobs[i].ej_link, &obj_ec_encode_queue);
+	}
+	obj_ec_encode_reqs++;
+	obj_ec_encode_jobs += encoder->oe_job_nr;
+	obj_ec_encode_stripes += stripe_nr;
+	if (encoder->oe_job_nr > inline_nr)
+		pthread_cond_broadcast(&obj_ec_encode_cond);
+	D_MUTEX_UNLOCK(&obj_ec_encode_lock);
+
+	for (i = 0; i < inline_nr; i++) {
+		rc = obj_ec_encode_job_run(&encoder->oe_jobs[i]);
+		obj_ec_encode_job_done(&encoder->oe_jobs[i], rc);
+	}
+}
+
+/** Check if \a encoder still has jobs in the encoder threads */
+bool
+obj_ec_encoder_busy(struct obj_ec_encoder *encoder)
+{
+	bool	busy;
+
+	D_MUTEX_LOCK(&obj_ec_encode_lock);
+	busy = encoder->oe_pending > 0;
+	D_MUTEX_UNLOCK(&obj_ec_encode_lock);
+
+	return busy;
+}
+
+/**
+ * Free \a encoder, wait for its jobs if it is still busy.
+ * Return the first error of the jobs.
+ */
+int
+obj_ec_encoder_destroy(struct obj_ec_encoder *encoder)
+{
+	int	rc;
+
+	while (obj_ec_encoder_busy(encoder))
+		sched_yield();
+
+	rc = encoder->oe_rc;
+	D_FREE(encoder);
+	return rc;
+}
+
+static void
+obj_ec_encode_start(void)
+{
+	unsigned int	i;
+	int		rc;
+
+	if (obj_ec_encode_thread_nr == 0)
+		return;
+	if (obj_ec_encode_thread_nr > OBJ_EC_ENCODE_THREAD_MAX)
+		obj_ec_encode_thread_nr = OBJ_EC_ENCODE_THREAD_MAX;
+
+	D_ALLOC_ARRAY(obj_ec_encode_threads, obj_ec_encode_thread_nr);
+	if (obj_ec_encode_threads == NULL)
+		goto inline_encode;
+
+	obj_ec_encode_stop = false;
+	for (i = 0; i < obj_ec_encode_thread_nr; i++) {
+		rc = pthread_create(&obj_ec_encode_threads[i], NULL, obj_ec_encode_thread, NULL);
+		if (rc != 0) {
+			D_ERROR("failed to create EC encoder thread: %d\n", rc);
+			obj_ec_encode_thread_nr = i;
+			obj_ec_encode_fini();
+			goto inline_encode;
+		}
+	}
+	D_DEBUG(DB_IO, "%u EC encoder threads\n", obj_ec_encode_thread_nr);
+	return;
+
+inline_encode:
+	D_WARN("EC encoder threads disabled, encode inline\n");
+	obj_ec_encode_thread_nr = 0;
+}
+
+void
+obj_ec_encode_init(void)
+{
+	d_getenv_int("DAOS_EC_ENCODE_THREADS", &obj_ec_encode_thread_nr);
+	obj_ec_encode_start();
+}
+
+/**
+ * For test, restart the encoder threads with \a thread_nr threads, 0 to encode
+ * inline. Return the previous number of threads.
+ */
+unsigned int
+obj_ec_encode_threads_reset(unsigned int thread_nr)
+{
+	unsigned int	old = obj_ec_encode_thread_nr;
+
+	obj_ec_encode_fini();
+	obj_ec_encode_thread_nr = thread_nr;
+	obj_ec_encode_start();
+	return old;
+}
+
+void
+obj_ec_encode_fini(void)
+{
+	unsigned int	i;
+
+	if (obj_ec_encode_threads == NULL)
+		return;
+
+	D_MUTEX_LOCK(&obj_ec_encode_lock);
+	obj_ec_encode_stop = true;
+	pthread_cond_broadcast(&obj_ec_encode_cond);
+	D_MUTEX_UNLOCK(&obj_ec_encode_lock);
+
+	for (i = 0; i < obj_ec_encode_thread_nr; i++)
+		pthread_join(obj_ec_encode_threads[i], NULL);
+	D_FREE(obj_ec_encode_threads);
+	D_ASSERT(d_list_empty(&obj_ec_encode_queue));
+
+	if (obj_ec_encode_reqs != 0)
+		D_INFO("EC encoder threads: "DF_U64" requests, "DF_U64" jobs, "DF_U64
+		       " stripes\n", obj_ec_encode_reqs, obj_ec_encode_jobs,
+		       obj_ec_encode_stripes);
+	obj_ec_encode_reqs = 0;
+	obj_ec_encode_jobs = 0;
+	obj_ec_encode_stripes = 0;
+}
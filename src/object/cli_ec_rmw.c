@@ -0,0 +1,676 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * DAOS client read-modify-write of EC partial stripe.
+ *
+ * A partial stripe update of EC object is written as replicated data on the
+ * data and parity targets, the parity is calculated later by EC aggregation
+ * on the servers. With DAOS_EC_PARTIAL_RMW, the client instead fetches the
+ * stripes partially covered by the update, merges the new data into them and
+ * writes them as full stripes, so the parity is encoded by the client and
+ * written together with the data. The fetch and the update are done in one
+ * internal TX, which is restarted if there is a conflicting write.
+ *
+ * A stripe is only rewritten if all of it has been written before or is
+ * covered by the update, so no hole of the array is filled. The other stripes
+ * are updated as partial stripes as before.
+ *
+ * src/object/cli_ec_rmw.c
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/object.h>
+#include <daos/task.h>
+#include <daos_task.h>
+#include <daos_types.h>
+#include <gurt/atomic.h>
+#include "obj_rpc.h"
+#include "obj_internal.h"
+
+/** Per iod state, only used for the array iod with partial stripes */
+struct ec_rmw_iod {
+	/** Sorted indices of the stripes partially covered by the update */
+	uint64_t		*ri_stripes;
+	/** Whether each of ri_stripes is rewritten as full stripe */
+	bool			*ri_full;
+	uint32_t		 ri_stripe_nr;
+	/** Index of the iod in the fetch */
+	uint32_t		 ri_fetch_idx;
+	/** The fetched stripes, then merged with the new data */
+	char			*ri_buf;
+	/** The new data out of the rewritten stripes */
+	char			*ri_rest_buf;
+	daos_recx_t		*ri_recxs;
+	uint32_t		 ri_recx_nr;
+	uint32_t		 ri_recx_max;
+	d_iov_t			*ri_iovs;
+};
+
+struct obj_ec_rmw {
+	/** The API update task */
+	tse_task_t		*er_parent;
+	daos_handle_t		 er_th;
+	uint64_t		 er_stripe_rec_nr;
+	/** Stripes rewritten and skipped for holes, by the last attempt */
+	uint64_t		 er_stripes;
+	uint64_t		 er_skipped;
+	bool			 er_restarted;
+	/** Fetch of the partial stripes */
+	uint32_t		 er_fetch_nr;
+	daos_iod_t		*er_fetch_iods;
+	d_sg_list_t		*er_fetch_sgls;
+	d_iov_t			*er_fetch_iovs;
+	daos_iom_t		*er_fetch_ioms;
+	/** Update in the TX, one iod for each iod of the API task */
+	daos_iod_t		*er_iods;
+	d_sg_list_t		*er_sgls;
+	struct ec_rmw_iod	*er_rmw_iods;
+};
+
+/** Write the partial stripe of EC object by read-modify-write */
+unsigned int			 obj_ec_rmw;
+static ATOMIC uint64_t		 obj_ec_rmw_updates;
+static ATOMIC uint64_t		 obj_ec_rmw_stripes;
+static ATOMIC uint64_t		 obj_ec_rmw_skipped;
+static ATOMIC uint64_t		 obj_ec_rmw_restarts;
+
+static bool
+ec_rmw_iod_partial(daos_iod_t *iod, uint64_t stripe_rec_nr)
+{
+	daos_recx_t	*recx;
+	uint32_t	 i;
+
+	if (iod->iod_type != DAOS_IOD_ARRAY || iod->iod_size == DAOS_REC_ANY)
+		return false;
+
+	for (i = 0; i < iod->iod_nr; i++) {
+		recx = &iod->iod_recxs[i];
+		if (recx->rx_nr == 0)
+			continue;
+		if (recx->rx_idx % stripe_rec_nr != 0 ||
+		    (recx->rx_idx + recx->rx_nr) % stripe_rec_nr != 0)
+			return true;
+	}
+	return false;
+}
+
+/** Check if the update of \a obj has partial stripe to be written by read-modify-write */
+bool
+obj_ec_rmw_enabled(struct dc_object *obj, daos_obj_update_t *args)
+{
+	uint64_t	stripe_rec_nr;
+	uint32_t	i;
+
+	if (!obj_is_ec(obj) || daos_handle_is_valid(args->th) ||
+	    args->flags & DAOS_COND_MASK || args->sgls == NULL)
+		return false;
+
+	/* The fail locs enable it for test */
+	if (!obj_ec_rmw && !DAOS_FAIL_CHECK(DAOS_OBJ_EC_RMW) &&
+	    !DAOS_FAIL_CHECK(DAOS_OBJ_EC_RMW_RESTART))
+		return false;
+
+	stripe_rec_nr = obj_ec_stripe_rec_nr(obj_get_oca(obj));
+	for (i = 0; i < args->nr; i++) {
+		if (ec_rmw_iod_partial(&args->iods[i], stripe_rec_nr))
+			return true;
+	}
+	return false;
+}
+
+static int
+ec_rmw_stripe_cmp(const void *p1, const void *p2)
+{
+	uint64_t	s1 = *(uint64_t *)p1;
+	uint64_t	s2 = *(uint64_t *)p2;
+
+	return s1 < s2 ? -1 : (s1 > s2 ? 1 : 0);
+}
+
+/** Return the position of the first partial stripe not before \a stripe */
+static uint32_t
+ec_rmw_stripe_lower(struct ec_rmw_iod *rmw_iod, uint64_t stripe)
+{
+	uint32_t	lo = 0;
+	uint32_t	hi = rmw_iod->ri_stripe_nr;
+	uint32_t	mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (rmw_iod->ri_stripes[mid] < stripe)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/** Collect the partial stripes of \a iod and prepare the fetch of them */
+static int
+ec_rmw_iod_init(struct obj_ec_rmw *rmw, daos_iod_t *iod, struct ec_rmw_iod *rmw_iod)
+{
+	uint64_t	 stripe_rec_nr = rmw->er_stripe_rec_nr;
+	uint32_t	 f = rmw->er_fetch_nr;
+	daos_recx_t	*fetch_recxs;
+	daos_recx_t	*recx;
+	uint64_t	 first, last;
+	daos_size_t	 buf_size;
+	uint32_t	 nr = 0;
+	uint32_t	 i;
+
+	D_ALLOC_ARRAY(rmw_iod->ri_stripes, iod->iod_nr * 2);
+	if (rmw_iod->ri_stripes == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < iod->iod_nr; i++) {
+		recx = &iod->iod_recxs[i];
+		if (recx->rx_nr == 0)
+			continue;
+		first = recx->rx_idx / stripe_rec_nr;
+		last = (recx->rx_idx + recx->rx_nr - 1) / stripe_rec_nr;
+		if (recx->rx_idx % stripe_rec_nr != 0 ||
+		    (first == last && recx->rx_nr != stripe_rec_nr))
+			rmw_iod->ri_stripes[nr++] = first;
+		if (last != first && (recx->rx_idx + recx->rx_nr) % stripe_rec_nr != 0)
+			rmw_iod->ri_stripes[nr++] = last;
+	}
+	D_ASSERT(nr > 0);
+
+	qsort(rmw_iod->ri_stripes, nr, sizeof(*rmw_iod->ri_stripes), ec_rmw_stripe_cmp);
+	rmw_iod->ri_stripe_nr = 1;
+	for (i = 1; i < nr; i++) {
+		if (rmw_iod->ri_stripes[i] != rmw_iod->ri_stripes[rmw_iod->ri_stripe_nr - 1])
+			rmw_iod->ri_stripes[rmw_iod->ri_stripe_nr++] = rmw_iod->ri_stripes[i];
+	}
+
+	D_ALLOC_ARRAY(rmw_iod->ri_full, rmw_iod->ri_stripe_nr);
+	if (rmw_iod->ri_full == NULL)
+		return -DER_NOMEM;
+
+	buf_size = rmw_iod->ri_stripe_nr * stripe_rec_nr * iod->iod_size;
+	D_ALLOC(rmw_iod->ri_buf, buf_size);
+	if (rmw_iod->ri_buf == NULL)
+		return -DER_NOMEM;
+
+	D_ALLOC_ARRAY(fetch_recxs, rmw_iod->ri_stripe_nr);
+	if (fetch_recxs == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < rmw_iod->ri_stripe_nr; i++) {
+		fetch_recxs[i].rx_idx = rmw_iod->ri_stripes[i] * stripe_rec_nr;
+		fetch_recxs[i].rx_nr = stripe_rec_nr;
+	}
+
+	rmw->er_fetch_iods[f] = *iod;
+	rmw->er_fetch_iods[f].iod_nr = rmw_iod->ri_stripe_nr;
+	rmw->er_fetch_iods[f].iod_recxs = fetch_recxs;
+	d_iov_set(&rmw->er_fetch_iovs[f], rmw_iod->ri_buf, buf_size);
+	rmw->er_fetch_sgls[f].sg_nr = 1;
+	rmw->er_fetch_sgls[f].sg_iovs = &rmw->er_fetch_iovs[f];
+	/* the existing extents tell which partial stripes have no hole */
+	rmw->er_fetch_ioms[f].iom_type = DAOS_IOD_ARRAY;
+	rmw->er_fetch_ioms[f].iom_flags = DAOS_IOMF_DETAIL;
+	rmw_iod->ri_fetch_idx = f;
+	rmw->er_fetch_nr++;
+
+	return 0;
+}
+
+/** Check if [lo, hi) is covered by the extents of \a iom and the recxs of \a iod */
+static bool
+ec_rmw_covered(uint64_t lo, uint64_t hi, daos_iom_t *iom, daos_iod_t *iod)
+{
+	uint32_t	 iom_nr = min(iom->iom_nr_out, iom->iom_nr);
+	daos_recx_t	*recx;
+	bool		 moved = true;
+	uint32_t	 i;
+
+	while (lo < hi && moved) {
+		moved = false;
+		for (i = 0; i < iom_nr + iod->iod_nr; i++) {
+			recx = i < iom_nr ? &iom->iom_recxs[i] : &iod->iod_recxs[i - iom_nr];
+			if (recx->rx_idx <= lo && lo < recx->rx_idx + recx->rx_nr) {
+				lo = recx->rx_idx + recx->rx_nr;
+				moved = true;
+			}
+		}
+	}
+	return lo >= hi;
+}
+
+/** Copy \a len bytes from offset \a off of \a sgl */
+static void
+ec_rmw_sgl_copy(d_sg_list_t *sgl, uint64_t off, char *buf, uint64_t len)
+{
+	uint64_t	copied = 0;
+	uint64_t	cp_len;
+	uint32_t	i;
+
+	for (i = 0; i < sgl->sg_nr && copied < len; i++) {
+		if (off >= sgl->sg_iovs[i].iov_len) {
+			off -= sgl->sg_iovs[i].iov_len;
+			continue;
+		}
+		cp_len = min(sgl->sg_iovs[i].iov_len - off, len - copied);
+		memcpy(buf + copied, (char *)sgl->sg_iovs[i].iov_buf + off, cp_len);
+		copied += cp_len;
+		off = 0;
+	}
+	D_ASSERT(copied == len);
+}
+
+static int
+ec_rmw_recx_add(struct ec_rmw_iod *rmw_iod, uint64_t idx, uint64_t nr, bool merge)
+{
+	daos_recx_t	*recxs;
+	daos_recx_t	*last;
+
+	if (merge && rmw_iod->ri_recx_nr > 0) {
+		last = &rmw_iod->ri_recxs[rmw_iod->ri_recx_nr - 1];
+		if (last->rx_idx + last->rx_nr == idx) {
+			last->rx_nr += nr;
+			return 0;
+		}
+	}
+
+	if (rmw_iod->ri_recx_nr == rmw_iod->ri_recx_max) {
+		D_REALLOC_ARRAY(recxs, rmw_iod->ri_recxs, rmw_iod->ri_recx_max,
+				rmw_iod->ri_recx_max + 8);
+		if (recxs == NULL)
+			return -DER_NOMEM;
+		rmw_iod->ri_recxs = recxs;
+		rmw_iod->ri_recx_max += 8;
+	}
+	rmw_iod->ri_recxs[rmw_iod->ri_recx_nr].rx_idx = idx;
+	rmw_iod->ri_recxs[rmw_iod->ri_recx_nr].rx_nr = nr;
+	rmw_iod->ri_recx_nr++;
+	return 0;
+}
+
+/**
+ * Merge the new data of \a iod and \a sgl into the fetched stripes, set the
+ * update of the full stripes and the rest of the new data to \a new_iod and
+ * \a new_sgl.
+ */
+static int
+ec_rmw_iod_merge(struct obj_ec_rmw *rmw, daos_iod_t *iod, d_sg_list_t *sgl,
+		 struct ec_rmw_iod *rmw_iod, daos_iod_t *new_iod, d_sg_list_t *new_sgl)
+{
+	daos_iom_t	*iom = &rmw->er_fetch_ioms[rmw_iod->ri_fetch_idx];
+	uint64_t	 stripe_rec_nr = rmw->er_stripe_rec_nr;
+	daos_size_t	 size = iod->iod_size;
+	uint64_t	 stripe_bytes = stripe_rec_nr * size;
+	uint64_t	 sgl_off = 0;
+	uint64_t	 rest_off = 0;
+	uint64_t	 rest_bytes = 0;
+	uint64_t	 idx, end, start, stripe;
+	uint32_t	 full_nr = 0;
+	uint32_t	 pos, i;
+	int		 rc;
+
+	for (i = 0; i < rmw_iod->ri_stripe_nr; i++) {
+		stripe = rmw_iod->ri_stripes[i];
+		rmw_iod->ri_full[i] = ec_rmw_covered(stripe * stripe_rec_nr,
+						     (stripe + 1) * stripe_rec_nr, iom, iod);
+		if (rmw_iod->ri_full[i])
+			full_nr++;
+	}
+	rmw->er_stripes += full_nr;
+	rmw->er_skipped += rmw_iod->ri_stripe_nr - full_nr;
+
+	*new_iod = *iod;
+	*new_sgl = *sgl;
+	if (full_nr == 0)
+		return 0;
+
+	for (i = 0; i < iod->iod_nr; i++)
+		rest_bytes += iod->iod_recxs[i].rx_nr * size;
+	D_ALLOC(rmw_iod->ri_rest_buf, rest_bytes);
+	if (rmw_iod->ri_rest_buf == NULL)
+		return -DER_NOMEM;
+
+	D_ALLOC_ARRAY(rmw_iod->ri_iovs, full_nr + 1);
+	if (rmw_iod->ri_iovs == NULL)
+		return -DER_NOMEM;
+
+	/* the full stripes first, then the rest of the new data */
+	new_sgl->sg_nr = 0;
+	new_sgl->sg_nr_out = 0;
+	new_sgl->sg_iovs = rmw_iod->ri_iovs;
+	for (i = 0; i < rmw_iod->ri_stripe_nr; i++) {
+		if (!rmw_iod->ri_full[i])
+			continue;
+		rc = ec_rmw_recx_add(rmw_iod, rmw_iod->ri_stripes[i] * stripe_rec_nr,
+				     stripe_rec_nr, false);
+		if (rc)
+			return rc;
+		d_iov_set(&new_sgl->sg_iovs[new_sgl->sg_nr++],
+			  rmw_iod->ri_buf + i * stripe_bytes, stripe_bytes);
+	}
+
+	for (i = 0; i < iod->iod_nr; i++) {
+		idx = iod->iod_recxs[i].rx_idx;
+		end = idx + iod->iod_recxs[i].rx_nr;
+		pos = ec_rmw_stripe_lower(rmw_iod, idx / stripe_rec_nr);
+		while (idx < end) {
+			while (pos < rmw_iod->ri_stripe_nr && !rmw_iod->ri_full[pos])
+				pos++;
+			start = end;
+			if (pos < rmw_iod->ri_stripe_nr &&
+			    rmw_iod->ri_stripes[pos] * stripe_rec_nr < end)
+				start = max(idx, rmw_iod->ri_stripes[pos] * stripe_rec_nr);
+
+			/* out of the full stripes */
+			if (idx < start) {
+				rc = ec_rmw_recx_add(rmw_iod, idx, start - idx, true);
+				if (rc)
+					return rc;
+				ec_rmw_sgl_copy(sgl, sgl_off, rmw_iod->ri_rest_buf + rest_off,
+						(start - idx) * size);
+				rest_off += (start - idx) * size;
+				sgl_off += (start - idx) * size;
+				idx = start;
+			}
+			if (idx == end)
+				break;
+
+			/* merged into the full stripe */
+			stripe = rmw_iod->ri_stripes[pos];
+			start = min(end, (stripe + 1) * stripe_rec_nr);
+			ec_rmw_sgl_copy(sgl, sgl_off, rmw_iod->ri_buf + pos * stripe_bytes +
+					(idx - stripe * stripe_rec_nr) * size,
+					(start - idx) * size);
+			sgl_off += (start - idx) * size;
+			idx = start;
+			pos++;
+		}
+	}
+
+	if (rest_off > 0)
+		d_iov_set(&new_sgl->sg_iovs[new_sgl->sg_nr++], rmw_iod->ri_rest_buf, rest_off);
+	new_iod->iod_nr = rmw_iod->ri_recx_nr;
+	new_iod->iod_recxs = rmw_iod->ri_recxs;
+
+	return 0;
+}
+
+/** Release the state of the last attempt, for the TX restart */
+static void
+ec_rmw_reset(struct obj_ec_rmw *rmw)
+{
+	daos_obj_update_t	*args = dc_task_get_args(rmw->er_parent);
+	struct ec_rmw_iod	*rmw_iod;
+	uint32_t		 i;
+
+	for (i = 0; i < rmw->er_fetch_nr; i++) {
+		D_FREE(rmw->er_fetch_ioms[i].iom_recxs);
+		rmw->er_fetch_ioms[i].iom_nr = 0;
+		rmw->er_fetch_ioms[i].iom_nr_out = 0;
+	}
+
+	for (i = 0; i < args->nr; i++) {
+		rmw_iod = &rmw->er_rmw_iods[i];
+		D_FREE(rmw_iod->ri_rest_buf);
+		D_FREE(rmw_iod->ri_recxs);
+		D_FREE(rmw_iod->ri_iovs);
+		rmw_iod->ri_recx_nr = 0;
+		rmw_iod->ri_recx_max = 0;
+	}
+	rmw->er_stripes = 0;
+	rmw->er_skipped = 0;
+}
+
+static void
+ec_rmw_free(struct obj_ec_rmw *rmw)
+{
+	daos_obj_update_t	*args = dc_task_get_args(rmw->er_parent);
+	struct ec_rmw_iod	*rmw_iod;
+	uint32_t		 i;
+
+	if (rmw->er_rmw_iods != NULL) {
+		ec_rmw_reset(rmw);
+		for (i = 0; i < args->nr; i++) {
+			rmw_iod = &rmw->er_rmw_iods[i];
+			D_FREE(rmw_iod->ri_stripes);
+			D_FREE(rmw_iod->ri_full);
+			D_FREE(rmw_iod->ri_buf);
+		}
+	}
+	for (i = 0; i < rmw->er_fetch_nr; i++)
+		D_FREE(rmw->er_fetch_iods[i].iod_recxs);
+
+	D_FREE(rmw->er_rmw_iods);
+	D_FREE(rmw->er_iods);
+	D_FREE(rmw->er_sgls);
+	D_FREE(rmw->er_fetch_iods);
+	D_FREE(rmw->er_fetch_sgls);
+	D_FREE(rmw->er_fetch_iovs);
+	D_FREE(rmw->er_fetch_ioms);
+	D_FREE(rmw);
+}
+
+static int ec_rmw_fetch(struct obj_ec_rmw *rmw, uint32_t delay);
+
+static void
+ec_rmw_done(struct obj_ec_rmw *rmw, int rc)
+{
+	uint32_t	backoff;
+
+	if (rc == -DER_TX_RESTART) {
+		rc = dc_tx_internal_restart(rmw->er_th, &backoff);
+		if (rc == 0) {
+			atomic_fetch_add_relaxed(&obj_ec_rmw_restarts, 1);
+			rmw->er_restarted = true;
+			ec_rmw_reset(rmw);
+			rc = ec_rmw_fetch(rmw, backoff);
+			if (rc == 0)
+				return;
+		}
+	}
+
+	if (rc == 0) {
+		atomic_fetch_add_relaxed(&obj_ec_rmw_updates, 1);
+		atomic_fetch_add_relaxed(&obj_ec_rmw_stripes, rmw->er_stripes);
+		atomic_fetch_add_relaxed(&obj_ec_rmw_skipped, rmw->er_skipped);
+	}
+
+	dc_tx_internal_close(rmw->er_th);
+	tse_task_complete(rmw->er_parent, rc);
+	ec_rmw_free(rmw);
+}
+
+static int
+ec_rmw_commit_cb(tse_task_t *task, void *data)
+{
+	ec_rmw_done(*((struct obj_ec_rmw **)data), task->dt_result);
+	return 0;
+}
+
+/** Merge the fetched stripes with the new data, then update and commit them in the TX */
+static int
+ec_rmw_update(struct obj_ec_rmw *rmw)
+{
+	daos_obj_update_t	*args = dc_task_get_args(rmw->er_parent);
+	tse_sched_t		*sched = tse_task2sched(rmw->er_parent);
+	struct ec_rmw_iod	*rmw_iod;
+	daos_tx_commit_t	*commit_args;
+	tse_task_t		*update = NULL;
+	tse_task_t		*commit = NULL;
+	uint32_t		 i;
+	int			 rc;
+
+	for (i = 0; i < args->nr; i++) {
+		rmw_iod = &rmw->er_rmw_iods[i];
+		if (rmw_iod->ri_stripes == NULL) {
+			rmw->er_iods[i] = args->iods[i];
+			rmw->er_sgls[i] = args->sgls[i];
+			continue;
+		}
+		rc = ec_rmw_iod_merge(rmw, &args->iods[i], &args->sgls[i], rmw_iod,
+				      &rmw->er_iods[i], &rmw->er_sgls[i]);
+		if (rc)
+			return rc;
+	}
+
+	rc = dc_obj_update_task_create(args->oh, rmw->er_th, args->flags, args->dkey, args->nr,
+				       rmw->er_iods, rmw->er_sgls, NULL, sched, &update);
+	if (rc)
+		return rc;
+
+	rc = dc_task_create(dc_tx_commit, sched, NULL, &commit);
+	if (rc)
+		goto out;
+
+	commit_args = dc_task_get_args(commit);
+	commit_args->th = rmw->er_th;
+	commit_args->flags = 0;
+
+	rc = tse_task_register_deps(commit, 1, &update);
+	if (rc)
+		goto out;
+
+	rc = tse_task_register_comp_cb(commit, ec_rmw_commit_cb, &rmw, sizeof(rmw));
+	if (rc)
+		goto out;
+
+	/* the commit runs once the update is attached to the TX */
+	tse_task_schedule(commit, false);
+	tse_task_schedule(update, true);
+	return 0;
+
+out:
+	if (commit != NULL)
+		tse_task_complete(commit, rc);
+	tse_task_complete(update, rc);
+	return rc;
+}
+
+static int
+ec_rmw_fetch_cb(tse_task_t *task, void *data)
+{
+	struct obj_ec_rmw	*rmw = *((struct obj_ec_rmw **)data);
+	int			 rc = task->dt_result;
+
+	/* A conflicting write for test, only once */
+	if (rc == 0 && !rmw->er_restarted && DAOS_FAIL_CHECK(DAOS_OBJ_EC_RMW_RESTART))
+		rc = -DER_TX_RESTART;
+
+	if (rc == 0)
+		rc = ec_rmw_update(rmw);
+	if (rc != 0)
+		ec_rmw_done(rmw, rc);
+	return 0;
+}
+
+static int
+ec_rmw_fetch(struct obj_ec_rmw *rmw, uint32_t delay)
+{
+	daos_obj_update_t	*args = dc_task_get_args(rmw->er_parent);
+	tse_task_t		*task;
+	int			 rc;
+
+	rc = dc_obj_fetch_task_create(args->oh, rmw->er_th, 0, args->dkey, rmw->er_fetch_nr, 0,
+				      rmw->er_fetch_iods, rmw->er_fetch_sgls, rmw->er_fetch_ioms,
+				      NULL, NULL, NULL, tse_task2sched(rmw->er_parent), &task);
+	if (rc != 0)
+		return rc;
+
+	rc = tse_task_register_comp_cb(task, ec_rmw_fetch_cb, &rmw, sizeof(rmw));
+	if (rc != 0) {
+		tse_task_complete(task, rc);
+		return rc;
+	}
+
+	return tse_task_schedule_with_delay(task, false, delay);
+}
+
+/**
+ * Write the update task \a task of EC object \a obj by read-modify-write of
+ * its partial stripes. \a task is completed once the TX is committed.
+ */
+int
+obj_ec_rmw_update(tse_task_t *task, struct dc_object *obj)
+{
+	daos_obj_update_t	*args = dc_task_get_args(task);
+	struct obj_ec_rmw	*rmw;
+	uint32_t		 i;
+	int			 rc;
+
+	D_ALLOC_PTR(rmw);
+	if (rmw == NULL)
+		D_GOTO(out_task, rc = -DER_NOMEM);
+
+	rmw->er_parent = task;
+	rmw->er_th = DAOS_HDL_INVAL;
+	rmw->er_stripe_rec_nr = obj_ec_stripe_rec_nr(obj_get_oca(obj));
+
+	D_ALLOC_ARRAY(rmw->er_rmw_iods, args->nr);
+	D_ALLOC_ARRAY(rmw->er_iods, args->nr);
+	D_ALLOC_ARRAY(rmw->er_sgls, args->nr);
+	D_ALLOC_ARRAY(rmw->er_fetch_iods, args->nr);
+	D_ALLOC_ARRAY(rmw->er_fetch_sgls, args->nr);
+	D_ALLOC_ARRAY(rmw->er_fetch_iovs, args->nr);
+	D_ALLOC_ARRAY(rmw->er_fetch_ioms, args->nr);
+	if (rmw->er_rmw_iods == NULL || rmw->er_iods == NULL || rmw->er_sgls == NULL ||
+	    rmw->er_fetch_iods == NULL || rmw->er_fetch_sgls == NULL ||
+	    rmw->er_fetch_iovs == NULL || rmw->er_fetch_ioms == NULL)
+		D_GOTO(out_free, rc = -DER_NOMEM);
+
+	for (i = 0; i < args->nr; i++) {
+		if (!ec_rmw_iod_partial(&args->iods[i], rmw->er_stripe_rec_nr))
+			continue;
+		rc = ec_rmw_iod_init(rmw, &args->iods[i], &rmw->er_rmw_iods[i]);
+		if (rc)
+			D_GOTO(out_free, rc);
+	}
+
+	rc = dc_tx_internal_open(obj->cob_coh, &rmw->er_th);
+	if (rc)
+		D_GOTO(out_free, rc);
+
+	rc = ec_rmw_fetch(rmw, 0);
+	if (rc)
+		D_GOTO(out_tx, rc);
+
+	D_DEBUG(DB_IO, DF_OID" partial stripe update %p by read-modify-write\n",
+		DP_OID(obj->cob_md.omd_id), task);
+	return 0;
+
+out_tx:
+	dc_tx_internal_close(rmw->er_th);
+out_free:
+	ec_rmw_free(rmw);
+out_task:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+/** For test, the counters of the read-modify-write updates done so far */
+void
+obj_ec_rmw_query(uint64_t *stripes, uint64_t *skipped, uint64_t *restarts)
+{
+	*stripes = atomic_load_relaxed(&obj_ec_rmw_stripes);
+	*skipped = atomic_load_relaxed(&obj_ec_rmw_skipped);
+	*restarts = atomic_load_relaxed(&obj_ec_rmw_restarts);
+}
+
+void
+obj_ec_rmw_init(void)
+{
+	d_getenv_int("DAOS_EC_PARTIAL_RMW", &obj_ec_rmw);
+}
+
+void
+obj_ec_rmw_fini(void)
+{
+	if (atomic_load_relaxed(&obj_ec_rmw_updates) == 0)
+		return;
+
+	D_INFO("EC partial stripe read-modify-write: "DF_U64" updates, "DF_U64
+	       " stripes rewritten, "DF_U64" skipped for holes, "DF_U64" TX restarts\n",
+	       atomic_load_relaxed(&obj_ec_rmw_updates), atomic_load_relaxed(&obj_ec_rmw_stripes),
+	       atomic_load_relaxed(&obj_ec_rmw_skipped), atomic_load_relaxed(&obj_ec_rmw_restarts));
+}
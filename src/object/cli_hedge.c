@@ -0,0 +1,522 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * DAOS client hedged fetch.
+ *
+ * A fetch from an object opened with DAOS_OO_HEDGE runs as a primary fetch
+ * task. If it has not completed after a delay taken from the recent fetch
+ * latencies, a second fetch task is issued to another replica, or as a
+ * degraded fetch for EC object. The first successful one completes the API
+ * task, the in-flight RPCs of the other one are aborted.
+ *
+ * Each fetch task picks its own epoch, and a reply or bulk transfer of the
+ * aborted one may still land. So the second fetch task reads into private
+ * iods and sgls, which are copied out to the caller's ones only if it wins,
+ * after both fetch tasks completed.
+ *
+ * src/object/cli_hedge.c
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/object.h>
+#include <daos/task.h>
+#include <daos_task.h>
+#include <daos_types.h>
+#include <gurt/atomic.h>
+#include "obj_rpc.h"
+#include "obj_internal.h"
+
+/** Fetch latency histogram, bucket i counts the latencies in [2^i, 2^(i+1)) us */
+#define OBJ_HEDGE_BUCKETS	32
+/** No hedge until there are enough latency samples */
+#define OBJ_HEDGE_MIN_SAMPLES	64
+/** The histogram is halved once it has so many samples, to follow the recent latencies */
+#define OBJ_HEDGE_WINDOW	4096
+/** Max in-flight RPCs of a hedged fetch can be aborted */
+#define OBJ_HEDGE_RPC_MAX	32
+
+enum {
+	OBJ_HEDGE_PRIMARY,
+	OBJ_HEDGE_SECOND,
+	OBJ_HEDGE_NR,
+};
+
+struct obj_hedge_rpc {
+	crt_rpc_t		*hr_rpc;
+	tse_task_t		*hr_task;
+};
+
+struct obj_hedge {
+	/** The API task, NULL once completed */
+	tse_task_t		*oh_parent;
+	/** The fetch tasks, NULL once completed */
+	tse_task_t		*oh_tasks[OBJ_HEDGE_NR];
+	struct obj_hedge_rpc	 oh_rpcs[OBJ_HEDGE_RPC_MAX];
+	uint64_t		 oh_start;
+	/** Target of the primary fetch, avoided by the hedge of replicated object */
+	int32_t			 oh_primary_tgt;
+	/** Index of the first successful fetch, -1 if none yet */
+	int			 oh_winner;
+	int			 oh_result;
+	/** Fetch tasks not completed yet */
+	int			 oh_pending;
+	/** Held by the API task and the hedge timer */
+	int			 oh_ref;
+	bool			 oh_ec;
+	/** Private iods and sgls of the second fetch task */
+	unsigned int		 oh_nr;
+	daos_iod_t		*oh_iods;
+	d_sg_list_t		*oh_sgls;
+};
+
+struct obj_hedge_cb_arg {
+	struct obj_hedge	*oh;
+	int			 idx;
+};
+
+/** Fetch latency percentile to issue the hedge at, 0 disables hedging */
+unsigned int			 obj_hedge_pct = 95;
+static ATOMIC uint32_t		 obj_hedge_lat[OBJ_HEDGE_BUCKETS];
+static ATOMIC uint32_t		 obj_hedge_samples;
+static ATOMIC uint64_t		 obj_hedge_issued;
+static ATOMIC uint64_t		 obj_hedge_won;
+
+static void
+obj_hedge_lat_add(uint64_t nsec)
+{
+	uint64_t	usec = nsec / NSEC_PER_USEC;
+	int		bucket = 0;
+	int		i;
+
+	if (usec != 0)
+		bucket = min(63 - __builtin_clzll(usec), OBJ_HEDGE_BUCKETS - 1);
+	atomic_fetch_add_relaxed(&obj_hedge_lat[bucket], 1);
+
+	if (atomic_fetch_add_relaxed(&obj_hedge_samples, 1) + 1 < OBJ_HEDGE_WINDOW)
+		return;
+
+	/* Racy, but it's only for the hedge delay */
+	for (i = 0; i < OBJ_HEDGE_BUCKETS; i++)
+		atomic_store_relaxed(&obj_hedge_lat[i], atomic_load_relaxed(&obj_hedge_lat[i]) / 2);
+	atomic_store_relaxed(&obj_hedge_samples, OBJ_HEDGE_WINDOW / 2);
+}
+
+/** The obj_hedge_pct percentile of the fetch latency in us, 0 if not known yet */
+static uint64_t
+obj_hedge_delay(void)
+{
+	uint32_t	cnt[OBJ_HEDGE_BUCKETS];
+	uint64_t	total = 0;
+	uint64_t	target;
+	uint64_t	sum = 0;
+	uint64_t	low;
+	int		i;
+
+	for (i = 0; i < OBJ_HEDGE_BUCKETS; i++) {
+		cnt[i] = atomic_load_relaxed(&obj_hedge_lat[i]);
+		total += cnt[i];
+	}
+	if (total < OBJ_HEDGE_MIN_SAMPLES)
+		return 0;
+
+	target = max(total * obj_hedge_pct / 100, 1);
+	for (i = 0; i < OBJ_HEDGE_BUCKETS; i++) {
+		if (cnt[i] != 0 && sum + cnt[i] >= target)
+			break;
+		sum += cnt[i];
+	}
+	D_ASSERT(i < OBJ_HEDGE_BUCKETS);
+
+	/* Linear interpolation within the bucket */
+	low = 1ULL << i;
+	return low + low * (target - sum) / cnt[i];
+}
+
+bool
+obj_hedge_enabled(struct dc_object *obj, daos_obj_fetch_t *args)
+{
+	if (!(obj->cob_mode & DAOS_OO_HEDGE) || obj_hedge_pct == 0)
+		return false;
+
+	/* Plain fetch only, the output of the hedge is copied out from private buffers */
+	if (args->extra_flags != 0 || args->extra_arg != NULL || args->ioms != NULL ||
+	    args->csum_iov != NULL || daos_handle_is_valid(args->th))
+		return false;
+
+	return obj_is_ec(obj) || obj_get_replicas(obj) > 1;
+}
+
+static void
+obj_hedge_priv_free(struct obj_hedge *oh)
+{
+	int	i;
+
+	if (oh->oh_sgls != NULL) {
+		for (i = 0; i < oh->oh_nr; i++)
+			d_sgl_fini(&oh->oh_sgls[i], true);
+		D_FREE(oh->oh_sgls);
+	}
+	D_FREE(oh->oh_iods);
+}
+
+/** Private iods and sgls of the second fetch task, with the caller's buffer sizes */
+static int
+obj_hedge_priv_alloc(struct obj_hedge *oh, daos_obj_fetch_t *args)
+{
+	int	rc;
+
+	oh->oh_nr = args->nr;
+	D_ALLOC_ARRAY(oh->oh_iods, args->nr);
+	if (oh->oh_iods == NULL)
+		return -DER_NOMEM;
+	memcpy(oh->oh_iods, args->iods, sizeof(*args->iods) * args->nr);
+
+	if (args->sgls == NULL)
+		return 0;
+
+	D_ALLOC_ARRAY(oh->oh_sgls, args->nr);
+	if (oh->oh_sgls == NULL)
+		return -DER_NOMEM;
+
+	rc = daos_sgls_alloc(oh->oh_sgls, args->sgls, args->nr);
+	if (rc != 0)
+		return rc;
+
+	/* Allocation failure isn't returned by daos_sgls_alloc() */
+	if (daos_sgls_buf_size(oh->oh_sgls, args->nr) !=
+	    daos_sgls_buf_size(args->sgls, args->nr))
+		return -DER_NOMEM;
+	return 0;
+}
+
+/** The second fetch task won, copy its output to the caller's iods and sgls */
+static void
+obj_hedge_priv_copy_out(struct obj_hedge *oh)
+{
+	daos_obj_fetch_t	*args = dc_task_get_args(oh->oh_parent);
+	d_sg_list_t		*src;
+	d_sg_list_t		*dst;
+	int			 i, j;
+
+	for (i = 0; i < oh->oh_nr; i++) {
+		args->iods[i].iod_size = oh->oh_iods[i].iod_size;
+		if (oh->oh_sgls == NULL)
+			continue;
+
+		/* The losing primary fetch may have set any of them */
+		src = &oh->oh_sgls[i];
+		dst = &args->sgls[i];
+		dst->sg_nr_out = src->sg_nr_out;
+		for (j = 0; j < src->sg_nr; j++) {
+			dst->sg_iovs[j].iov_len = src->sg_iovs[j].iov_len;
+			if (src->sg_iovs[j].iov_len != 0)
+				memcpy(dst->sg_iovs[j].iov_buf, src->sg_iovs[j].iov_buf,
+				       src->sg_iovs[j].iov_len);
+		}
+	}
+}
+
+static void
+obj_hedge_decref(struct obj_hedge *oh)
+{
+	D_ASSERT(oh->oh_ref > 0);
+	if (--oh->oh_ref == 0) {
+		obj_hedge_priv_free(oh);
+		D_FREE(oh);
+	}
+}
+
+/** Release the tracked RPCs of \a task, or abort them if \a abort */
+static void
+obj_hedge_rpc_release(struct obj_hedge *oh, tse_task_t *task, bool abort)
+{
+	struct obj_hedge_rpc	*hr;
+	int			 i;
+
+	for (i = 0; i < OBJ_HEDGE_RPC_MAX; i++) {
+		hr = &oh->oh_rpcs[i];
+		if (hr->hr_rpc == NULL || hr->hr_task != task)
+			continue;
+
+		if (abort) {
+			/* The RPC completes with -DER_CANCELED, then it's untracked */
+			crt_req_abort(hr->hr_rpc);
+			continue;
+		}
+		crt_req_decref(hr->hr_rpc);
+		hr->hr_rpc = NULL;
+		hr->hr_task = NULL;
+	}
+}
+
+bool
+obj_hedge_rpc_track(void *hedge, tse_task_t *task, crt_rpc_t *rpc, int32_t tgt)
+{
+	struct obj_hedge	*oh = hedge;
+	int			 i;
+
+	/* Lost before sending the RPC */
+	if (oh->oh_winner >= 0)
+		return false;
+
+	if (task == oh->oh_tasks[OBJ_HEDGE_PRIMARY] && oh->oh_primary_tgt == -1)
+		oh->oh_primary_tgt = tgt;
+
+	for (i = 0; i < OBJ_HEDGE_RPC_MAX; i++) {
+		if (oh->oh_rpcs[i].hr_rpc == NULL) {
+			crt_req_addref(rpc);
+			oh->oh_rpcs[i].hr_rpc = rpc;
+			oh->oh_rpcs[i].hr_task = task;
+			break;
+		}
+	}
+	/* Not tracked if it's full, then it cannot be aborted, but it's still correct */
+	return true;
+}
+
+void
+obj_hedge_rpc_untrack(void *hedge, crt_rpc_t *rpc)
+{
+	struct obj_hedge	*oh = hedge;
+	int			 i;
+
+	for (i = 0; i < OBJ_HEDGE_RPC_MAX; i++) {
+		if (oh->oh_rpcs[i].hr_rpc == rpc) {
+			crt_req_decref(rpc);
+			oh->oh_rpcs[i].hr_rpc = NULL;
+			oh->oh_rpcs[i].hr_task = NULL;
+			break;
+		}
+	}
+}
+
+bool
+obj_hedge_lost(tse_task_t *task)
+{
+	daos_obj_fetch_t	*args = dc_task_get_args(task);
+	struct obj_hedge	*oh = args->extra_arg;
+
+	if (!(args->extra_flags & DIOF_HEDGE))
+		return false;
+
+	/* The winner is settled after all the other completion callbacks of itself */
+	return oh->oh_winner >= 0;
+}
+
+int
+obj_hedge_fetch_prep(void *hedge, tse_task_t *task, int32_t *avoid_tgt)
+{
+	struct obj_hedge	*oh = hedge;
+
+	if (oh->oh_winner >= 0)
+		return -DER_CANCELED;
+
+	*avoid_tgt = -1;
+	if (task == oh->oh_tasks[OBJ_HEDGE_SECOND] && !oh->oh_ec)
+		*avoid_tgt = oh->oh_primary_tgt;
+	return 0;
+}
+
+static int
+obj_hedge_comp_cb(tse_task_t *task, void *data)
+{
+	struct obj_hedge_cb_arg	*arg = data;
+	struct obj_hedge	*oh = arg->oh;
+	tse_task_t		*parent;
+	int			 rc;
+	int			 i;
+
+	obj_hedge_rpc_release(oh, task, false);
+	oh->oh_tasks[arg->idx] = NULL;
+	D_ASSERT(oh->oh_pending > 0);
+	oh->oh_pending--;
+
+	if (task->dt_result == 0 && oh->oh_winner < 0) {
+		oh->oh_winner = arg->idx;
+		/* The primary fetch took at least this long if the hedge won */
+		obj_hedge_lat_add(daos_get_ntime() - oh->oh_start);
+		if (arg->idx == OBJ_HEDGE_SECOND)
+			atomic_fetch_add_relaxed(&obj_hedge_won, 1);
+
+		for (i = 0; i < OBJ_HEDGE_NR; i++) {
+			if (oh->oh_tasks[i] != NULL)
+				obj_hedge_rpc_release(oh, oh->oh_tasks[i], true);
+		}
+	} else if (task->dt_result != 0 && oh->oh_result == 0) {
+		oh->oh_result = task->dt_result;
+	}
+
+	if (oh->oh_pending > 0)
+		return 0;
+
+	/* Nothing else writes the caller's buffers once both fetch tasks completed */
+	if (oh->oh_winner == OBJ_HEDGE_SECOND)
+		obj_hedge_priv_copy_out(oh);
+	rc = oh->oh_winner >= 0 ? 0 : oh->oh_result;
+
+	parent = oh->oh_parent;
+	oh->oh_parent = NULL;
+	tse_task_complete(parent, rc);
+	obj_hedge_decref(oh);
+	return 0;
+}
+
+static int
+obj_hedge_task_create(struct obj_hedge *oh, int idx)
+{
+	daos_obj_fetch_t	*args = dc_task_get_args(oh->oh_parent);
+	struct obj_hedge_cb_arg	 cb_arg;
+	uint32_t		 extra_flags = DIOF_HEDGE;
+	daos_iod_t		*iods = args->iods;
+	d_sg_list_t		*sgls = args->sgls;
+	tse_task_t		*task;
+	int			 rc;
+
+	if (idx == OBJ_HEDGE_SECOND) {
+		if (oh->oh_ec)
+			extra_flags |= DIOF_FOR_FORCE_DEGRADE;
+
+		/* Freed with the hedge context */
+		rc = obj_hedge_priv_alloc(oh, args);
+		if (rc != 0)
+			return rc;
+		iods = oh->oh_iods;
+		sgls = oh->oh_sgls;
+	}
+
+	rc = dc_obj_fetch_task_create(args->oh, DAOS_TX_NONE, args->flags, args->dkey, args->nr,
+				      extra_flags, iods, sgls, NULL, oh, NULL, NULL,
+				      tse_task2sched(oh->oh_parent), &task);
+	if (rc != 0)
+		return rc;
+
+	cb_arg.oh = oh;
+	cb_arg.idx = idx;
+	rc = tse_task_register_comp_cb(task, obj_hedge_comp_cb, &cb_arg, sizeof(cb_arg));
+	if (rc != 0) {
+		tse_task_complete(task, rc);
+		return rc;
+	}
+
+	oh->oh_tasks[idx] = task;
+	oh->oh_pending++;
+	tse_task_schedule(task, true);
+	return 0;
+}
+
+static int
+obj_hedge_timer(tse_task_t *task)
+{
+	struct obj_hedge	*oh = tse_task_get_priv(task);
+	int			 rc;
+
+	/* The replicated object needs to know the replica to avoid */
+	if (oh->oh_parent != NULL && oh->oh_winner < 0 &&
+	    oh->oh_tasks[OBJ_HEDGE_PRIMARY] != NULL &&
+	    (oh->oh_ec || oh->oh_primary_tgt != -1)) {
+		rc = obj_hedge_task_create(oh, OBJ_HEDGE_SECOND);
+		if (rc == 0) {
+			atomic_fetch_add_relaxed(&obj_hedge_issued, 1);
+			D_DEBUG(DB_IO, "hedged fetch %p after "DF_U64" us\n", oh->oh_parent,
+				(daos_get_ntime() - oh->oh_start) / NSEC_PER_USEC);
+		} else {
+			D_DEBUG(DB_IO, "failed to issue hedged fetch: "DF_RC"\n", DP_RC(rc));
+		}
+	}
+
+	tse_task_complete(task, 0);
+	return 0;
+}
+
+static int
+obj_hedge_timer_comp_cb(tse_task_t *task, void *data)
+{
+	obj_hedge_decref(*((struct obj_hedge **)data));
+	return 0;
+}
+
+/* Without the timer, it's a regular fetch */
+static void
+obj_hedge_timer_start(struct obj_hedge *oh, uint64_t delay)
+{
+	tse_task_t	*timer;
+	int		 rc;
+
+	rc = tse_task_create(obj_hedge_timer, tse_task2sched(oh->oh_parent), oh, &timer);
+	if (rc != 0)
+		return;
+
+	rc = tse_task_register_comp_cb(timer, obj_hedge_timer_comp_cb, &oh, sizeof(oh));
+	if (rc != 0) {
+		tse_task_complete(timer, rc);
+		return;
+	}
+
+	oh->oh_ref++;
+	tse_task_schedule_with_delay(timer, false, delay);
+}
+
+int
+obj_hedge_fetch(tse_task_t *task, struct dc_object *obj)
+{
+	struct obj_hedge	*oh;
+	uint64_t		 delay = obj_hedge_delay();
+	int			 rc;
+
+	D_ALLOC_PTR(oh);
+	if (oh == NULL)
+		D_GOTO(out_task, rc = -DER_NOMEM);
+
+	oh->oh_parent = task;
+	oh->oh_start = daos_get_ntime();
+	oh->oh_primary_tgt = -1;
+	oh->oh_winner = -1;
+	oh->oh_ec = obj_is_ec(obj);
+	oh->oh_ref = 1;
+
+	/* Without enough latency samples yet, the fetch is only sampled */
+	if (delay != 0)
+		obj_hedge_timer_start(oh, delay);
+
+	rc = obj_hedge_task_create(oh, OBJ_HEDGE_PRIMARY);
+	if (rc != 0) {
+		/* The timer does nothing without the primary fetch */
+		oh->oh_parent = NULL;
+		obj_hedge_decref(oh);
+		D_GOTO(out_task, rc);
+	}
+	return 0;
+
+out_task:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+/** For test, the counters of the hedged fetches done so far */
+void
+dc_obj_hedge_query(uint64_t *issued, uint64_t *won)
+{
+	*issued = atomic_load_relaxed(&obj_hedge_issued);
+	*won = atomic_load_relaxed(&obj_hedge_won);
+}
+
+void
+obj_hedge_init(void)
+{
+	d_getenv_int("DAOS_OBJ_HEDGE_PCT", &obj_hedge_pct);
+	if (obj_hedge_pct > 99)
+		obj_hedge_pct = 99;
+}
+
+void
+obj_hedge_fini(void)
+{
+	if (atomic_load_relaxed(&obj_hedge_issued) == 0)
+		return;
+
+	D_INFO("Hedged fetch: issued "DF_U64", won "DF_U64"\n",
+	       atomic_load_relaxed(&obj_hedge_issued), atomic_load_relaxed(&obj_hedge_won));
+}
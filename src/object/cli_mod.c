@@ -79,6 +79,9 @@ dc_obj_init(void)
 		srv_io_mode = DIM_DTX_FULL_ENABLED;
 		D_DEBUG(DB_IO, "Full dtx mode by default\n");
 	}
+	obj_tgt_load_init();
+	obj_hedge_init();
+	obj_ec_rmw_init();
 
 	rc = obj_utils_init();
 	if (rc)
@@ -166,6 +169,7 @@ dc_obj_init(void)
 			daos_rpc_unregister(&obj_proto_fmt_1);
 		D_GOTO(out_rsvc, rc);
 	}
+	obj_ec_encode_init();
 
 out_rsvc:
 	rsvc_client_fini(&oproto->cli);
@@ -192,7 +196,11 @@ dc_obj_fini(void)
 		daos_rpc_unregister(&obj_proto_fmt_0);
 	else
 		daos_rpc_unregister(&obj_proto_fmt_1);
+	obj_ec_encode_fini();
 	obj_ec_codec_fini();
+	obj_ec_rmw_fini();
+	obj_hedge_fini();
+	obj_tgt_load_fini();
 	obj_class_fini();
 	obj_utils_fini();
 }
@@ -432,16 +432,26 @@ obj_get_grp_nr(struct dc_object *obj)
 	return obj->cob_grp_nr;
 }
 
-/* Get a valid shard from an object group */
+/*
+ * Get a valid shard from an object group, the one on the target with the lowest expected
+ * latency is preferred, or a random one for obj_replica_explore percent of the calls.
+ */
 static int
 obj_grp_valid_shard_get(struct dc_object *obj, int grp_idx,
 			unsigned int map_ver,
 			struct obj_auxi_tgt_list *failed_list)
 {
-	int grp_start;
-	int idx;
-	int grp_size;
-	int i = 0;
+	struct dc_obj_shard	*shard;
+	uint64_t		 best_cost = 0;
+	uint64_t		 cost;
+	uint32_t		 rank = 0;
+	uint32_t		 tag = 0;
+	bool			 explore;
+	int			 best = -1;
+	int			 grp_start;
+	int			 idx;
+	int			 grp_size;
+	int			 i = 0;
 
 	grp_size = obj_get_grp_size(obj);
 	D_ASSERT(grp_size > 0);
@@ -471,19 +481,21 @@ obj_grp_valid_shard_get(struct dc_object *obj, int grp_idx,
 	D_ASSERT(grp_size >= obj_get_replicas(obj));
 	grp_start = grp_idx * grp_size;
 	idx = grp_start + d_rand() % grp_size;
+	explore = grp_size == 1 || d_rand() % 100 < obj_replica_explore;
 	for (i = 0; i < grp_size; i++, idx++) {
 		uint32_t tgt_id;
 		int index;
 
 		index = idx % grp_size + grp_start;
+		shard = &obj->cob_shards->do_shards[index];
 		/* let's skip the rebuild shard */
-		if (obj->cob_shards->do_shards[index].do_rebuilding)
+		if (shard->do_rebuilding)
 			continue;
 
 		/* Skip the target which is already in the failed list, i.e.
 		 * they have been tried.
 		 */
-		tgt_id = obj->cob_shards->do_shards[index].do_target_id;
+		tgt_id = shard->do_target_id;
 		if (failed_list && tgt_in_failed_tgts_list(tgt_id, failed_list))
 			continue;
 
@@ -492,19 +504,35 @@ obj_grp_valid_shard_get(struct dc_object *obj, int grp_idx,
 			continue;
 
 		/* Skip the invalid shards and targets */
-		if (obj->cob_shards->do_shards[index].do_target_id != -1 ||
-		    obj->cob_shards->do_shards[index].do_shard != -1) {
-			idx = index;
-			break;
+		if (shard->do_target_id == -1 && shard->do_shard == -1)
+			continue;
+
+		/* Ties are broken by the random start */
+		cost = explore ? 0 : obj_tgt_load_cost(shard->do_target_rank,
+						       shard->do_target_idx);
+		if (best == -1 || cost < best_cost) {
+			best = index;
+			best_cost = cost;
+			rank = shard->do_target_rank;
+			tag = shard->do_target_idx;
 		}
+		if (explore)
+			break;
 	}
 
 	D_RWLOCK_UNLOCK(&obj->cob_lock);
 
-	if (i == grp_size)
+	if (best == -1)
 		return -DER_NONEXIST;
 
-	return idx;
+	if (grp_size > 1) {
+		obj_tgt_load_picked(rank, tag, explore);
+		D_DEBUG(DB_IO, DF_OID" grp %d picked shard %d on rank %u tag %u, cost "DF_U64
+			"%s\n", DP_OID(obj->cob_md.omd_id), grp_idx, best, rank, tag, best_cost,
+			explore ? " (explored)" : "");
+	}
+
+	return best;
 }
 
 static int
@@ -886,6 +914,11 @@ obj_reasb_req_fini(struct obj_reasb_req *reasb_req, uint32_t iod_nr)
 	if (reasb_req->orr_iods == NULL)
 		return;
 
+	if (reasb_req->orr_encoder != NULL) {
+		obj_ec_encoder_destroy(reasb_req->orr_encoder);
+		reasb_req->orr_encoder = NULL;
+	}
+
 	for (i = 0; i < iod_nr; i++) {
 		iod = &reasb_req->orr_iods[i];
 		D_FREE(iod->iod_recxs);
@@ -1587,6 +1620,22 @@ dc_obj_layout_refresh(daos_handle_t oh)
 	return rc;
 }
 
+/*
+ * Delay (us) for retrying the I/O rejected by overloaded server. Back off
+ * exponentially on consecutive retries from the suggested backoff, and add
+ * jitter to avoid the clients retrying in lockstep.
+ */
+static uint64_t
+obj_retry_backoff(struct obj_auxi_args *obj_auxi)
+{
+	uint64_t	delay;
+
+	delay = (uint64_t)obj_auxi->retry_backoff << min(obj_auxi->retry_cnt, 3);
+	delay = min(delay, OBJ_RETRY_BACKOFF_MAX) * 1000;
+
+	return delay / 2 + d_rand() % (delay / 2 + 1);
+}
+
 static int
 obj_retry_cb(tse_task_t *task, struct dc_object *obj,
 	     struct obj_auxi_args *obj_auxi, bool pmap_stale,
@@ -1614,7 +1663,12 @@ obj_retry_cb(tse_task_t *task, struct dc_object *obj,
 			}
 		}
 
-		rc = dc_task_resched(task);
+		if (obj_auxi->retry_backoff != 0) {
+			rc = tse_task_reinit_with_delay(task, obj_retry_backoff(obj_auxi));
+			obj_auxi->retry_backoff = 0;
+		} else {
+			rc = dc_task_resched(task);
+		}
 		if (rc != 0) {
 			D_ERROR("Failed to re-init task (%p)\n", task);
 			D_GOTO(err, rc);
@@ -4301,6 +4355,10 @@ obj_comp_cb(tse_task_t *task, void *data)
 		pm_stale = true;
 	}
 
+	/* The other fetch of the hedged fetch has won, see cli_hedge.c */
+	if (obj_auxi->opc == DAOS_OBJ_RPC_FETCH && obj_hedge_lost(task))
+		obj_auxi->no_retry = 1;
+
 	obj_auxi->to_leader = 0;
 	if (obj_retry_error(task->dt_result)) {
 		/* If the RPC sponsor specify shard/group, then means it wants
@@ -5159,6 +5217,13 @@ dc_obj_fetch_task(tse_task_t *task)
 	if (rc != 0)
 		D_GOTO(out_task, rc);
 
+	if (!obj_req_with_cond_flags(args->flags) && obj_hedge_enabled(obj, args)) {
+		/* Sub fetch tasks will do the fetch, see cli_hedge.c */
+		rc = obj_hedge_fetch(task, obj);
+		obj_decref(obj);
+		return rc;
+	}
+
 	rc = obj_task_init(task, DAOS_OBJ_RPC_FETCH, map_ver, args->th,
 			   &obj_auxi, obj);
 	if (rc != 0) {
@@ -5207,6 +5272,21 @@ dc_obj_fetch_task(tse_task_t *task)
 	obj_auxi->spec_group = (args->extra_flags & DIOF_TO_SPEC_GROUP) != 0;
 	obj_auxi->to_leader = (args->extra_flags & DIOF_TO_LEADER) != 0;
 
+	if (args->extra_flags & DIOF_HEDGE) {
+		int32_t	avoid_tgt;
+
+		rc = obj_hedge_fetch_prep(args->extra_arg, task, &avoid_tgt);
+		if (rc != 0)
+			D_GOTO(out_task, rc);
+
+		/* The hedge of replicated object reads from another replica */
+		if (avoid_tgt != -1) {
+			rc = obj_auxi_add_failed_tgt(obj_auxi, avoid_tgt);
+			if (rc != 0)
+				D_GOTO(out_task, rc);
+		}
+	}
+
 	obj_auxi->dkey_hash = obj_dkey2hash(obj->cob_md.omd_id, args->dkey);
 	obj_auxi->iod_nr = args->nr;
 
@@ -5307,49 +5387,16 @@ out:
 }
 
 static int
-dc_obj_update(tse_task_t *task, struct dtx_epoch *epoch, uint32_t map_ver,
-	      daos_obj_update_t *args, struct dc_object *obj)
+obj_update_dispatch(tse_task_t *task, struct dc_object *obj, struct obj_auxi_args *obj_auxi,
+		    daos_obj_update_t *args, uint32_t map_ver, struct dtx_epoch *epoch)
 {
-	struct obj_auxi_args	*obj_auxi;
 	uint8_t			*tgt_bitmap = NIL_BITMAP;
-	uint32_t		shard;
-	uint32_t		shard_cnt;
-	int			rc;
-
-	rc = obj_task_init(task, DAOS_OBJ_RPC_UPDATE, map_ver, args->th,
-			   &obj_auxi, obj);
-	if (rc != 0) {
-		obj_decref(obj);
-		D_GOTO(out_task, rc);
-	}
-
-	rc = obj_update_sgls_dup(obj_auxi, args);
-	if (rc) {
-		D_ERROR(DF_OID" obj_update_sgls_dup failed %d.\n", DP_OID(obj->cob_md.omd_id), rc);
-		D_GOTO(out_task, rc);
-	}
-
-	if (obj_auxi->tx_convert) {
-		if (obj_auxi->is_ec_obj && obj_auxi->req_reasbed) {
-			args->iods = obj_auxi->reasb_req.orr_uiods;
-			args->sgls = obj_auxi->reasb_req.orr_usgls;
-		}
-
-		obj_auxi->tx_convert = 0;
-		return dc_tx_convert(obj, DAOS_OBJ_RPC_UPDATE, task);
-	}
+	uint32_t		 shard;
+	uint32_t		 shard_cnt;
+	int			 rc;
 
-	obj_auxi->dkey_hash = obj_dkey2hash(obj->cob_md.omd_id, args->dkey);
-	obj_auxi->iod_nr = args->nr;
-	if (obj_is_ec(obj)) {
-		rc = obj_rw_req_reassemb(obj, args, NULL, obj_auxi);
-		if (rc) {
-			D_ERROR(DF_OID" obj_req_reassemb failed %d.\n",
-				DP_OID(obj->cob_md.omd_id), rc);
-			D_GOTO(out_task, rc);
-		}
+	if (obj_is_ec(obj))
 		tgt_bitmap = obj_auxi->reasb_req.tgt_bitmap;
-	}
 
 	rc = obj_update_shards_get(obj, args, map_ver, obj_auxi, &shard, &shard_cnt);
 	if (rc != 0)
@@ -5400,6 +5447,138 @@ out_task:
 	return rc;
 }
 
+struct obj_encode_wait_args {
+	tse_task_t		*ewa_task;
+	struct dc_object	*ewa_obj;
+	struct obj_auxi_args	*ewa_auxi;
+	struct dtx_epoch	 ewa_epoch;
+	uint32_t		 ewa_map_ver;
+};
+
+/** Interval to check if the encoder threads are done with an update */
+#define OBJ_ENCODE_WAIT_US	20
+
+static int
+obj_update_encode_wait_task(tse_task_t *task)
+{
+	struct obj_encode_wait_args	*ewa = tse_task_buf_embedded(task, sizeof(*ewa));
+	struct obj_auxi_args		*obj_auxi = ewa->ewa_auxi;
+	struct obj_reasb_req		*reasb_req = &obj_auxi->reasb_req;
+	int				 rc;
+
+	if (obj_ec_encoder_busy(reasb_req->orr_encoder) &&
+	    tse_task_reinit_with_delay(task, OBJ_ENCODE_WAIT_US) == 0)
+		return 0;
+
+	/* waits inline if the task cannot be re-inserted */
+	rc = obj_ec_encoder_destroy(reasb_req->orr_encoder);
+	reasb_req->orr_encoder = NULL;
+	if (rc) {
+		D_ERROR(DF_OID" EC encoding failed: "DF_RC"\n",
+			DP_OID(ewa->ewa_obj->cob_md.omd_id), DP_RC(rc));
+		tse_task_complete(ewa->ewa_task, rc);
+	} else {
+		obj_update_dispatch(ewa->ewa_task, ewa->ewa_obj, obj_auxi,
+				    dc_task_get_args(ewa->ewa_task), ewa->ewa_map_ver,
+				    &ewa->ewa_epoch);
+	}
+
+	tse_task_decref(ewa->ewa_task);
+	tse_task_complete(task, 0);
+	return 0;
+}
+
+/**
+ * The EC parity of the update is still being encoded by the encoder threads,
+ * dispatch the update from a task polling the encoder, so the calling thread
+ * does not block on it. The update task stays running until then.
+ */
+static int
+obj_update_encode_wait(tse_task_t *task, struct dc_object *obj, struct obj_auxi_args *obj_auxi,
+		       uint32_t map_ver, struct dtx_epoch *epoch)
+{
+	struct obj_encode_wait_args	*ewa;
+	tse_task_t			*wait_task;
+	int				 rc;
+
+	rc = tse_task_create(obj_update_encode_wait_task, tse_task2sched(task), NULL,
+			     &wait_task);
+	if (rc != 0) {
+		/* wait for the encoder inline */
+		rc = obj_ec_encoder_destroy(obj_auxi->reasb_req.orr_encoder);
+		obj_auxi->reasb_req.orr_encoder = NULL;
+		if (rc) {
+			tse_task_complete(task, rc);
+			return rc;
+		}
+		return obj_update_dispatch(task, obj, obj_auxi, dc_task_get_args(task),
+					   map_ver, epoch);
+	}
+
+	ewa = tse_task_buf_embedded(wait_task, sizeof(*ewa));
+	ewa->ewa_task = task;
+	ewa->ewa_obj = obj;
+	ewa->ewa_auxi = obj_auxi;
+	ewa->ewa_epoch = *epoch;
+	ewa->ewa_map_ver = map_ver;
+	/* released by the wait task */
+	tse_task_addref(task);
+
+	return tse_task_schedule_with_delay(wait_task, false, OBJ_ENCODE_WAIT_US);
+}
+
+static int
+dc_obj_update(tse_task_t *task, struct dtx_epoch *epoch, uint32_t map_ver,
+	      daos_obj_update_t *args, struct dc_object *obj)
+{
+	struct obj_auxi_args	*obj_auxi;
+	int			rc;
+
+	rc = obj_task_init(task, DAOS_OBJ_RPC_UPDATE, map_ver, args->th,
+			   &obj_auxi, obj);
+	if (rc != 0) {
+		obj_decref(obj);
+		D_GOTO(out_task, rc);
+	}
+
+	rc = obj_update_sgls_dup(obj_auxi, args);
+	if (rc) {
+		D_ERROR(DF_OID" obj_update_sgls_dup failed %d.\n", DP_OID(obj->cob_md.omd_id), rc);
+		D_GOTO(out_task, rc);
+	}
+
+	if (obj_auxi->tx_convert) {
+		if (obj_auxi->is_ec_obj && obj_auxi->req_reasbed) {
+			args->iods = obj_auxi->reasb_req.orr_uiods;
+			args->sgls = obj_auxi->reasb_req.orr_usgls;
+		}
+
+		obj_auxi->tx_convert = 0;
+		return dc_tx_convert(obj, DAOS_OBJ_RPC_UPDATE, task);
+	}
+
+	obj_auxi->dkey_hash = obj_dkey2hash(obj->cob_md.omd_id, args->dkey);
+	obj_auxi->iod_nr = args->nr;
+	if (obj_is_ec(obj)) {
+		obj_auxi->reasb_req.orr_encode_async = 1;
+		rc = obj_rw_req_reassemb(obj, args, NULL, obj_auxi);
+		if (rc) {
+			D_ERROR(DF_OID" obj_req_reassemb failed %d.\n",
+				DP_OID(obj->cob_md.omd_id), rc);
+			D_GOTO(out_task, rc);
+		}
+		/* parity is still being encoded by the encoder threads */
+		if (obj_auxi->reasb_req.orr_encoder != NULL)
+			return obj_update_encode_wait(task, obj, obj_auxi, map_ver, epoch);
+	}
+
+	return obj_update_dispatch(task, obj, obj_auxi, args, map_ver, epoch);
+
+out_task:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
 int
 dc_obj_update_task(tse_task_t *task)
 {
@@ -5420,6 +5599,12 @@ dc_obj_update_task(tse_task_t *task)
 		goto comp;
 	}
 
+	if (obj_ec_rmw_enabled(obj, args)) {
+		rc = obj_ec_rmw_update(task, obj);
+		obj_decref(obj);
+		return rc;
+	}
+
 	/* submit the update */
 	return dc_obj_update(task, &epoch, map_ver, args, obj);
 comp:
@@ -14,6 +14,7 @@
 #include <daos/pool_map.h>
 #include <daos/rpc.h>
 #include <daos/checksum.h>
+#include <gurt/atomic.h>
 #include "obj_rpc.h"
 #include "obj_internal.h"
 
@@ -95,6 +96,186 @@ dc_obj_shard_close(struct dc_obj_shard *shard)
 	obj_shard_decref(shard);
 }
 
+/**
+ * Load statistics of the engine targets seen by this client, they are used to pick the
+ * replica with the lowest expected latency for the replicated fetch. The table is direct
+ * mapped by the (rank, tag) of the target, the slot is taken over by the new target on
+ * collision, so the statistics are only hints.
+ */
+#define OBJ_TGT_LOAD_BITS	12
+#define OBJ_TGT_LOAD_NR		(1U << OBJ_TGT_LOAD_BITS)
+/** Weight of the new sample in the smoothed RTT is 1/8, as TCP does */
+#define OBJ_TGT_LOAD_SHIFT	3
+
+struct obj_tgt_load {
+	/** (rank << 8 | tag) + 1, 0 for the unused slot */
+	ATOMIC uint64_t		tl_key;
+	/** smoothed RTT of the fetch RPCs in nanoseconds */
+	ATOMIC uint64_t		tl_srtt;
+	/** number of times being picked as the replica to fetch from */
+	ATOMIC uint64_t		tl_picked;
+	/** in-flight fetch and update RPCs */
+	ATOMIC uint32_t		tl_inflight;
+};
+
+static struct obj_tgt_load	obj_tgt_loads[OBJ_TGT_LOAD_NR];
+static ATOMIC uint64_t		obj_replica_least;
+static ATOMIC uint64_t		obj_replica_explored;
+/** Percentage of the replicated fetches which pick a random replica */
+unsigned int			obj_replica_explore = 10;
+
+static inline uint64_t
+obj_tgt_load_key(uint32_t rank, uint32_t tag)
+{
+	return (((uint64_t)rank << 8) | (tag & 0xff)) + 1;
+}
+
+static inline struct obj_tgt_load *
+obj_tgt_load_slot(uint64_t key)
+{
+	return &obj_tgt_loads[(key * 0x9E3779B97F4A7C15ULL) >> (64 - OBJ_TGT_LOAD_BITS)];
+}
+
+/** Lookup the statistics of the target, NULL if the target isn't tracked */
+static struct obj_tgt_load *
+obj_tgt_load_find(uint32_t rank, uint32_t tag)
+{
+	uint64_t		 key = obj_tgt_load_key(rank, tag);
+	struct obj_tgt_load	*tl = obj_tgt_load_slot(key);
+
+	return atomic_load_relaxed(&tl->tl_key) == key ? tl : NULL;
+}
+
+static void
+obj_tgt_load_send(crt_endpoint_t *tgt_ep)
+{
+	uint64_t		 key = obj_tgt_load_key(tgt_ep->ep_rank, tgt_ep->ep_tag);
+	struct obj_tgt_load	*tl = obj_tgt_load_slot(key);
+
+	if (atomic_load_relaxed(&tl->tl_key) != key) {
+		atomic_store_relaxed(&tl->tl_key, key);
+		atomic_store_relaxed(&tl->tl_srtt, 0);
+		atomic_store_relaxed(&tl->tl_inflight, 0);
+		atomic_store_relaxed(&tl->tl_picked, 0);
+	}
+	atomic_fetch_add_relaxed(&tl->tl_inflight, 1);
+}
+
+static void
+obj_tgt_load_complete(crt_endpoint_t *tgt_ep, uint64_t send_time, bool sample)
+{
+	struct obj_tgt_load	*tl = obj_tgt_load_find(tgt_ep->ep_rank, tgt_ep->ep_tag);
+	uint64_t		 srtt;
+	uint64_t		 rtt;
+
+	if (tl == NULL)
+		return;
+
+	if (atomic_load_relaxed(&tl->tl_inflight) > 0)
+		atomic_fetch_sub_relaxed(&tl->tl_inflight, 1);
+	if (!sample)
+		return;
+
+	rtt = daos_get_ntime() - send_time;
+	srtt = atomic_load_relaxed(&tl->tl_srtt);
+	if (srtt == 0)
+		srtt = rtt;
+	else if (rtt > srtt)
+		srtt += (rtt - srtt) >> OBJ_TGT_LOAD_SHIFT;
+	else
+		srtt -= (srtt - rtt) >> OBJ_TGT_LOAD_SHIFT;
+	atomic_store_relaxed(&tl->tl_srtt, srtt);
+}
+
+/**
+ * Expected latency of a new fetch from the target, the one never been measured costs
+ * nothing, so that it will be tried soon.
+ */
+uint64_t
+obj_tgt_load_cost(uint32_t rank, uint32_t tag)
+{
+	struct obj_tgt_load	*tl = obj_tgt_load_find(rank, tag);
+	uint64_t		 srtt;
+
+	if (tl == NULL)
+		return 0;
+
+	srtt = atomic_load_relaxed(&tl->tl_srtt);
+	return max(srtt, 1) * (atomic_load_relaxed(&tl->tl_inflight) + 1);
+}
+
+void
+obj_tgt_load_picked(uint32_t rank, uint32_t tag, bool explored)
+{
+	struct obj_tgt_load	*tl = obj_tgt_load_find(rank, tag);
+
+	if (tl != NULL)
+		atomic_fetch_add_relaxed(&tl->tl_picked, 1);
+	if (explored)
+		atomic_fetch_add_relaxed(&obj_replica_explored, 1);
+	else
+		atomic_fetch_add_relaxed(&obj_replica_least, 1);
+}
+
+/**
+ * For test, the counters of the replica selection done so far, \a picked is the number of
+ * times the targets on \a rank being picked.
+ */
+void
+dc_obj_replica_query(uint32_t rank, uint64_t *least, uint64_t *explored, uint64_t *picked)
+{
+	struct obj_tgt_load	*tl;
+	uint64_t		 key;
+	int			 i;
+
+	*least = atomic_load_relaxed(&obj_replica_least);
+	*explored = atomic_load_relaxed(&obj_replica_explored);
+	*picked = 0;
+	for (i = 0; i < OBJ_TGT_LOAD_NR; i++) {
+		tl = &obj_tgt_loads[i];
+		key = atomic_load_relaxed(&tl->tl_key);
+		if (key != 0 && (uint32_t)((key - 1) >> 8) == rank)
+			*picked += atomic_load_relaxed(&tl->tl_picked);
+	}
+}
+
+void
+obj_tgt_load_init(void)
+{
+	d_getenv_int("DAOS_OBJ_REPLICA_EXPLORE", &obj_replica_explore);
+	if (obj_replica_explore > 100)
+		obj_replica_explore = 100;
+	D_DEBUG(DB_IO, "Replica exploration rate %u%%\n", obj_replica_explore);
+}
+
+/** Log the distribution of the replica selection */
+void
+obj_tgt_load_fini(void)
+{
+	struct obj_tgt_load	*tl;
+	uint64_t		 key;
+	int			 i;
+
+	if (atomic_load_relaxed(&obj_replica_least) == 0 &&
+	    atomic_load_relaxed(&obj_replica_explored) == 0)
+		return;
+
+	D_INFO("Replica selection: least loaded "DF_U64", explored "DF_U64"\n",
+	       atomic_load_relaxed(&obj_replica_least),
+	       atomic_load_relaxed(&obj_replica_explored));
+	for (i = 0; i < OBJ_TGT_LOAD_NR; i++) {
+		tl = &obj_tgt_loads[i];
+		key = atomic_load_relaxed(&tl->tl_key);
+		if (key == 0 || atomic_load_relaxed(&tl->tl_picked) == 0)
+			continue;
+
+		D_INFO("Replica selection: rank %u tag %u picked "DF_U64", srtt "DF_U64" us\n",
+		       (uint32_t)((key - 1) >> 8), (uint32_t)((key - 1) & 0xff),
+		       atomic_load_relaxed(&tl->tl_picked),
+		       atomic_load_relaxed(&tl->tl_srtt) / NSEC_PER_USEC);
+	}
+}
+
 struct rw_cb_args {
 	crt_rpc_t		*rpc;
 	daos_handle_t		*hdlp;
@@ -104,6 +285,8 @@ struct rw_cb_args {
 	daos_iom_t		*maps;
 	crt_endpoint_t		tgt_ep;
 	struct shard_rw_args	*shard_args;
+	/** for the RTT of the target */
+	uint64_t		send_time;
 };
 
 static struct dcs_layout *
@@ -878,6 +1061,11 @@ dc_rw_cb(tse_task_t *task, void *arg)
 	opc = opc_get(rw_args->rpc->cr_opc);
 	D_DEBUG(DB_IO, "rpc %p opc:%d completed, task %p dt_result %d.\n",
 		rw_args->rpc, opc, task, ret);
+	obj_tgt_load_complete(&rw_args->tgt_ep, rw_args->send_time,
+			      opc == DAOS_OBJ_RPC_FETCH && (ret == 0 || ret == -DER_TIMEDOUT));
+	api_args = dc_task_get_args(rw_args->shard_args->auxi.obj_auxi->obj_task);
+	if (api_args->extra_flags & DIOF_HEDGE)
+		obj_hedge_rpc_untrack(api_args->extra_arg, rw_args->rpc);
 	if (opc == DAOS_OBJ_RPC_FETCH &&
 	    DAOS_FAIL_CHECK(DAOS_SHARD_OBJ_FETCH_TIMEOUT)) {
 		D_ERROR("Inducing -DER_TIMEDOUT error on shard I/O fetch\n");
@@ -912,11 +1100,22 @@ dc_rw_cb(tse_task_t *task, void *arg)
 	}
 
 	rc = obj_reply_get_status(rw_args->rpc);
+	if (rc == -DER_OVERLOAD_RETRY) {
+		struct obj_auxi_args	*obj_auxi = rw_args->shard_args->auxi.obj_auxi;
+
+		/* orwo->orw_epoch is the backoff suggested by server, see obj_reject_req() */
+		obj_auxi->retry_backoff = max(obj_auxi->retry_backoff,
+					      min(orwo->orw_epoch, OBJ_RETRY_BACKOFF_MAX));
+		D_DEBUG(DB_IO, "rpc %p opc %d to rank %d tag %d rejected on overload, backoff "
+			DF_U64" ms\n", rw_args->rpc, opc, rw_args->rpc->cr_ep.ep_rank,
+			rw_args->rpc->cr_ep.ep_tag, orwo->orw_epoch);
+		D_GOTO(out, rc);
+	}
+
 	/*
 	 * orwo->orw_epoch may be set even when the status is nonzero (e.g.,
 	 * -DER_TX_RESTART and -DER_INPROGRESS).
 	 */
-	api_args = dc_task_get_args(rw_args->shard_args->auxi.obj_auxi->obj_task);
 	th = api_args->th;
 	if (daos_handle_is_valid(th)) {
 		int rc_tmp;
@@ -1369,13 +1568,26 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	if (DAOS_FAIL_CHECK(DAOS_SHARD_OBJ_RW_CRT_ERROR))
 		D_GOTO(out_args, rc = -DER_HG);
 
+	if ((api_args->extra_flags & DIOF_HEDGE) &&
+	    !obj_hedge_rpc_track(api_args->extra_arg, auxi->obj_auxi->obj_task, req,
+				 shard->do_target_id))
+		D_GOTO(out_args, rc = -DER_CANCELED);
+
+	rw_args.send_time = daos_get_ntime();
 	rc = tse_task_register_comp_cb(task, dc_rw_cb, &rw_args,
 				       sizeof(rw_args));
 	if (rc != 0)
 		D_GOTO(out_args, rc);
 
+	obj_tgt_load_send(&tgt_ep);
 	if (daos_io_bypass & IOBP_CLI_RPC) {
 		rc = daos_rpc_complete(req, task);
+	} else if ((api_args->extra_flags & DIOF_BATCH) &&
+		   obj_batch_rw_queue(api_args->extra_arg, req, task,
+				      args->bulks == NULL && fw_shard_tgts == NULL &&
+				      args->reasb_req == NULL)) {
+		/* Sent by the batch RPC to the target, see cli_batch.c */
+		rc = 0;
 	} else {
 		if (opc == DAOS_OBJ_RPC_UPDATE && args->bulks != NULL &&
 		    !(orw->orw_flags & ORF_RESEND) &&
@@ -728,6 +728,9 @@ obj_ec_parity_lists_match(struct daos_recx_ep_list *lists_1,
 int obj_ec_req_reasb(daos_iod_t *iods, uint64_t dkey_hash, d_sg_list_t *sgls,
 		     daos_obj_id_t oid, struct daos_oclass_attr *oca,
 		     struct obj_reasb_req *reasb_req, uint32_t iod_nr, bool update);
+int obj_ec_stripe_encode(daos_iod_t *iod, d_sg_list_t *sgl, uint32_t iov_idx, size_t iov_off,
+			 struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
+			 uint64_t cell_bytes, unsigned char *parity_bufs[]);
 void obj_ec_recxs_fini(struct obj_ec_recx_array *recxs);
 void obj_ec_seg_sorter_fini(struct obj_ec_seg_sorter *sorter);
 void obj_ec_tgt_oiod_fini(struct obj_tgt_oiod *tgt_oiods);
@@ -759,6 +762,12 @@ void obj_ec_recov_data(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 int obj_ec_get_degrade(struct obj_reasb_req *reasb_req, uint16_t fail_tgt_idx,
 		       uint32_t *parity_tgt_idx, bool ignore_fail_tgt_idx);
 
+/* cli_ec_encode.c */
+unsigned int obj_ec_encode_threads_reset(unsigned int thread_nr);
+
+/* cli_ec_rmw.c */
+void obj_ec_rmw_query(uint64_t *stripes, uint64_t *skipped, uint64_t *restarts);
+
 /* srv_ec.c */
 struct obj_rw_in;
 int obj_ec_rw_req_split(daos_unit_oid_t oid, uint64_t dkey_hash,
@@ -158,6 +158,8 @@ struct obj_reasb_req {
 	uint32_t			 orr_iod_nr;
 	struct daos_oclass_attr		*orr_oca;
 	struct obj_ec_codec		*orr_codec;
+	/* encoder with stripes still being encoded by the encoder threads */
+	struct obj_ec_encoder		*orr_encoder;
 	pthread_mutex_t			 orr_mutex;
 	/* target bitmap, one bit for each target (from first data cell to last parity cell. */
 	uint8_t				*tgt_bitmap;
@@ -184,7 +186,9 @@ struct obj_reasb_req {
 	/* the flag of IOM re-allocable (used for EC IOM merge) */
 					 orr_iom_realloc:1,
 	/* orr_fail allocated flag, recovery task's orr_fail is inherited */
-					 orr_fail_alloc:1;
+					 orr_fail_alloc:1,
+	/* the caller can wait for orr_encoder, stripes can be encoded by encoder threads */
+					 orr_encode_async:1;
 };
 
 static inline void
@@ -380,6 +384,8 @@ struct obj_auxi_args {
 	uint32_t			 flags;
 	uint32_t			 specified_shard;
 	uint32_t			 retry_cnt;
+	/* Backoff (ms) suggested by overloaded server for next retry */
+	uint32_t			 retry_backoff;
 	struct obj_req_tgts		 req_tgts;
 	d_sg_list_t			*sgls_dup;
 	crt_bulk_t			*bulks;
@@ -504,6 +510,47 @@ int dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 		    void *shard_args, struct daos_shard_tgt *fw_shard_tgts,
 		    uint32_t fw_cnt, tse_task_t *task);
 
+extern unsigned int obj_replica_explore;
+uint64_t obj_tgt_load_cost(uint32_t rank, uint32_t tag);
+void obj_tgt_load_picked(uint32_t rank, uint32_t tag, bool explored);
+void obj_tgt_load_init(void);
+void obj_tgt_load_fini(void);
+
+/* cli_batch.c */
+bool obj_batch_rw_queue(void *batch_ent, crt_rpc_t *req, tse_task_t *task, bool eligible);
+
+/* cli_hedge.c */
+extern unsigned int obj_hedge_pct;
+bool obj_hedge_enabled(struct dc_object *obj, daos_obj_fetch_t *args);
+int obj_hedge_fetch(tse_task_t *task, struct dc_object *obj);
+int obj_hedge_fetch_prep(void *hedge, tse_task_t *task, int32_t *avoid_tgt);
+bool obj_hedge_lost(tse_task_t *task);
+bool obj_hedge_rpc_track(void *hedge, tse_task_t *task, crt_rpc_t *rpc, int32_t tgt);
+void obj_hedge_rpc_untrack(void *hedge, crt_rpc_t *rpc);
+void obj_hedge_init(void);
+void obj_hedge_fini(void);
+
+/* cli_ec_encode.c */
+struct obj_ec_encoder;
+extern unsigned int obj_ec_encode_thread_nr;
+struct obj_ec_encoder *obj_ec_encoder_create(struct obj_reasb_req *reasb_req,
+					     struct obj_ec_codec *codec);
+uint32_t obj_ec_encoder_add(struct obj_ec_encoder *encoder, daos_iod_t *iod, d_sg_list_t *sgl,
+			    uint32_t iov_idx, uint64_t iov_off, uint64_t cell_bytes,
+			    unsigned char *parity_bufs[], uint32_t stripe_nr);
+void obj_ec_encoder_run(struct obj_ec_encoder *encoder);
+bool obj_ec_encoder_busy(struct obj_ec_encoder *encoder);
+int obj_ec_encoder_destroy(struct obj_ec_encoder *encoder);
+void obj_ec_encode_init(void);
+void obj_ec_encode_fini(void);
+
+/* cli_ec_rmw.c */
+extern unsigned int obj_ec_rmw;
+bool obj_ec_rmw_enabled(struct dc_object *obj, daos_obj_update_t *args);
+int obj_ec_rmw_update(tse_task_t *task, struct dc_object *obj);
+void obj_ec_rmw_init(void);
+void obj_ec_rmw_fini(void);
+
 int
 ec_obj_update_encode(tse_task_t *task, daos_obj_id_t oid,
 		     struct daos_oclass_attr *oca, uint64_t *tgt_set);
@@ -585,6 +632,9 @@ obj_get_shard(void *data, int idx)
 	return &obj->cob_shards->do_shards[idx].do_pl_shard;
 }
 
+/* Max backoff (ms) for retrying the I/O rejected by overloaded server */
+#define OBJ_RETRY_BACKOFF_MAX	2000
+
 static inline bool
 obj_retry_error(int err)
 {
@@ -593,7 +643,8 @@ obj_retry_error(int err)
 	       err == -DER_EXCLUDED || err == -DER_CSUM ||
 	       err == -DER_TX_BUSY || err == -DER_TX_UNCERTAIN ||
 	       err == -DER_NEED_TX || err == -DER_NOTLEADER ||
-	       err == -DER_UPDATE_AGAIN || daos_crt_network_error(err);
+	       err == -DER_UPDATE_AGAIN || err == -DER_OVERLOAD_RETRY ||
+	       daos_crt_network_error(err);
 }
 
 static inline daos_handle_t
@@ -681,7 +732,9 @@ struct obj_io_context {
 				 ioc_free_sgls:1,
 				 ioc_lost_reply:1,
 				 ioc_fetch_snap:1,
-				 ioc_ec_rotate_parity:1;
+				 ioc_ec_rotate_parity:1,
+				 /* sub-request of DAOS_OBJ_RPC_RW_BATCH */
+				 ioc_batched:1;
 };
 
 static inline uint64_t
@@ -825,6 +878,15 @@ dc_tx_attach(daos_handle_t th, struct dc_object *obj, enum obj_rpc_opc opc,
 int
 dc_tx_convert(struct dc_object *obj, enum obj_rpc_opc opc, tse_task_t *task);
 
+int
+dc_tx_internal_open(daos_handle_t coh, daos_handle_t *th);
+
+int
+dc_tx_internal_restart(daos_handle_t th, uint32_t *backoff);
+
+void
+dc_tx_internal_close(daos_handle_t th);
+
 int
 iov_alloc_for_csum_info(d_iov_t *iov, struct dcs_csum_info *csum_info);
 #endif /* __DAOS_OBJ_INTENRAL_H__ */
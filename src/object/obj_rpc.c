@@ -1014,6 +1014,23 @@ out:
 }
 
 CRT_RPC_DEFINE(obj_rw, DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW)
+
+/* Element procs of obj_rw_batch, the requests and replies are the obj_rw ones */
+static int
+crt_proc_struct_obj_rw_in(crt_proc_t proc, crt_proc_op_t proc_op,
+			  struct obj_rw_in *orw)
+{
+	return crt_proc_obj_rw_in(proc, orw);
+}
+
+static int
+crt_proc_struct_obj_rw_out(crt_proc_t proc, crt_proc_op_t proc_op,
+			   struct obj_rw_out *orwo)
+{
+	return crt_proc_obj_rw_out(proc, orwo);
+}
+
+CRT_RPC_DEFINE(obj_rw_batch, DAOS_ISEQ_OBJ_RW_BATCH, DAOS_OSEQ_OBJ_RW_BATCH)
 CRT_RPC_DEFINE(obj_key_enum, DAOS_ISEQ_OBJ_KEY_ENUM, DAOS_OSEQ_OBJ_KEY_ENUM)
 CRT_RPC_DEFINE(obj_punch, DAOS_ISEQ_OBJ_PUNCH, DAOS_OSEQ_OBJ_PUNCH)
 CRT_RPC_DEFINE(obj_query_key_0, DAOS_ISEQ_OBJ_QUERY_KEY, DAOS_OSEQ_OBJ_QUERY_KEY_0)
@@ -1101,6 +1118,9 @@ obj_reply_set_status(crt_rpc_t *rpc, int status)
 	case DAOS_OBJ_RPC_EC_REPLICATE:
 		((struct obj_ec_rep_out *)reply)->er_status = status;
 		break;
+	case DAOS_OBJ_RPC_RW_BATCH:
+		((struct obj_rw_batch_out *)reply)->orb_ret = status;
+		break;
 	default:
 		D_ASSERT(0);
 	}
@@ -1138,6 +1158,8 @@ obj_reply_get_status(crt_rpc_t *rpc)
 		return ((struct obj_cpd_out *)reply)->oco_ret;
 	case DAOS_OBJ_RPC_EC_REPLICATE:
 		return ((struct obj_ec_rep_out *)reply)->er_status;
+	case DAOS_OBJ_RPC_RW_BATCH:
+		return ((struct obj_rw_batch_out *)reply)->orb_ret;
 	default:
 		D_ASSERT(0);
 	}
@@ -1186,6 +1208,9 @@ obj_reply_map_version_set(crt_rpc_t *rpc, uint32_t map_version)
 	case DAOS_OBJ_RPC_EC_REPLICATE:
 		((struct obj_ec_rep_out *)reply)->er_map_ver = map_version;
 		break;
+	case DAOS_OBJ_RPC_RW_BATCH:
+		((struct obj_rw_batch_out *)reply)->orb_map_version = map_version;
+		break;
 	default:
 		D_ASSERT(0);
 	}
@@ -1219,6 +1244,8 @@ obj_reply_map_version_get(crt_rpc_t *rpc)
 		return ((struct obj_sync_out *)reply)->oso_map_version;
 	case DAOS_OBJ_RPC_CPD:
 		return ((struct obj_cpd_out *)reply)->oco_map_version;
+	case DAOS_OBJ_RPC_RW_BATCH:
+		return ((struct obj_rw_batch_out *)reply)->orb_map_version;
 	default:
 		D_ASSERT(0);
 	}
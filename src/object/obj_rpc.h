@@ -103,7 +103,10 @@
 		ds_obj_ec_rep_handler, NULL, "ec_rep")			\
 	X(DAOS_OBJ_RPC_CPD,						\
 		0, &CQF_obj_cpd,					\
-		ds_obj_cpd_handler, NULL, "compound")
+		ds_obj_cpd_handler, NULL, "compound")			\
+	X(DAOS_OBJ_RPC_RW_BATCH,					\
+		0, &CQF_obj_rw_batch,					\
+		ds_obj_rw_batch_handler, NULL, "rw_batch")
 
 /* Define for RPC enum population below */
 #define X(a, b, c, d, e, f) a,
@@ -224,6 +227,25 @@ enum obj_rpc_flags {
 
 CRT_RPC_DECLARE(obj_rw,		DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW)
 
+/*
+ * Batch of independent fetch or update requests sent to the same target, each
+ * element is handled as a standalone DAOS_OBJ_RPC_FETCH/UPDATE. Only the
+ * requests with inline data and without forwarding targets can be batched.
+ */
+#define DAOS_ISEQ_OBJ_RW_BATCH	/* input fields */		 \
+	((uint32_t)		(orb_opc)		CRT_VAR) \
+	((uint32_t)		(orb_padding)		CRT_VAR) \
+	((struct obj_rw_in)	(orb_reqs)		CRT_ARRAY)
+
+/* orb_ret is only for the failure of the whole batch */
+#define DAOS_OSEQ_OBJ_RW_BATCH	/* output fields */		 \
+	((int32_t)		(orb_ret)		CRT_VAR) \
+	((uint32_t)		(orb_map_version)	CRT_VAR) \
+	((uint64_t)		(orb_epoch)		CRT_VAR) \
+	((struct obj_rw_out)	(orb_replies)		CRT_ARRAY)
+
+CRT_RPC_DECLARE(obj_rw_batch,	DAOS_ISEQ_OBJ_RW_BATCH, DAOS_OSEQ_OBJ_RW_BATCH)
+
 /* object Enumerate in/out */
 #define DAOS_ISEQ_OBJ_KEY_ENUM	/* input fields */		 \
 	((struct dtx_id)	(oei_dti)		CRT_RAW) \
@@ -3246,3 +3246,66 @@ out:
 
 	return rc;
 }
+
+/**
+ * Open an internal TX for the IO issued by the client library itself, such as
+ * the read-modify-write of EC partial stripe. The IO buffers are not copied.
+ */
+int
+dc_tx_internal_open(daos_handle_t coh, daos_handle_t *th)
+{
+	struct dc_tx	*tx;
+	int		 rc;
+
+	rc = dc_tx_alloc(coh, 0, DAOS_TF_ZERO_COPY, &tx);
+	if (rc == 0)
+		*th = dc_tx_ptr2hdl(tx);
+
+	return rc;
+}
+
+/**
+ * Restart the internal TX failed with -DER_TX_RESTART, the caller redoes its
+ * IO after \a backoff.
+ */
+int
+dc_tx_internal_restart(daos_handle_t th, uint32_t *backoff)
+{
+	struct dc_tx	*tx;
+	int		 rc;
+
+	tx = dc_tx_hdl2ptr(th);
+	if (tx == NULL)
+		return -DER_NO_HDL;
+
+	D_MUTEX_LOCK(&tx->tx_lock);
+	rc = dc_tx_restart_begin(tx, backoff);
+	if (rc == 0) {
+		/* Since tx is internal, it is okay to end the restart before the backoff. */
+		dc_tx_restart_end(tx);
+		tx->tx_pm_ver = dc_pool_get_version(tx->tx_pool);
+	}
+	D_MUTEX_UNLOCK(&tx->tx_lock);
+
+	/* -1 for hdl2ptr */
+	dc_tx_decref(tx);
+
+	return rc;
+}
+
+void
+dc_tx_internal_close(daos_handle_t th)
+{
+	struct dc_tx	*tx;
+
+	tx = dc_tx_hdl2ptr(th);
+	if (tx == NULL)
+		return;
+
+	D_MUTEX_LOCK(&tx->tx_lock);
+	dc_tx_close_internal(tx);
+	D_MUTEX_UNLOCK(&tx->tx_lock);
+
+	/* -1 for hdl2ptr */
+	dc_tx_decref(tx);
+}
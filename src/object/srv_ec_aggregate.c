@@ -626,7 +626,7 @@ agg_fetch_data_stripe(struct ec_agg_entry *entry)
 
 	agg_param = container_of(entry, struct ec_agg_param, ap_agg_entry);
 	rc = vos_obj_fetch(agg_param->ap_cont_handle, entry->ae_oid,
-			   entry->ae_cur_stripe.as_hi_epoch, 0, &entry->ae_dkey,
+			   entry->ae_cur_stripe.as_hi_epoch, VOS_OF_BG, &entry->ae_dkey,
 			   1, &iod, &entry->ae_sgl);
 	if (rc)
 		D_ERROR(DF_UOID" vos_obj_fetch "DF_RECX" failed: "DF_RC"\n",
@@ -801,7 +801,7 @@ agg_update_vos(struct ec_agg_param *agg_param, struct ec_agg_entry *entry,
 			D_ASSERT(iod_csums != NULL);
 		}
 		rc = vos_obj_update(ap->ap_cont_handle, entry->ae_oid,
-				    entry->ae_cur_stripe.as_hi_epoch, 0, 0,
+				    entry->ae_cur_stripe.as_hi_epoch, 0, VOS_OF_BG,
 				    &entry->ae_dkey, 1, &iod, iod_csums, &sgl);
 		if (csummer != NULL && iod_csums != NULL)
 			daos_csummer_free_ic(csummer, &iod_csums);
@@ -899,7 +899,7 @@ agg_fetch_local_extents(struct ec_agg_entry *entry, uint8_t *bit_map,
 	iod.iod_recxs = recxs;
 	agg_param = container_of(entry, struct ec_agg_param, ap_agg_entry);
 	rc = vos_obj_fetch(agg_param->ap_cont_handle, entry->ae_oid,
-			   entry->ae_cur_stripe.as_hi_epoch, 0,
+			   entry->ae_cur_stripe.as_hi_epoch, VOS_OF_BG,
 			   &entry->ae_dkey, 1, &iod, &sgl);
 	if (rc)
 		D_ERROR("vos_obj_fetch failed: "DF_RC"\n", DP_RC(rc));
@@ -1721,7 +1721,7 @@ agg_process_holes(struct ec_agg_entry *entry)
 	if (iod->iod_nr) {
 		/* write the reps to vos */
 		rc = vos_obj_update(agg_param->ap_cont_handle, entry->ae_oid,
-				    entry->ae_cur_stripe.as_hi_epoch, 0, 0,
+				    entry->ae_cur_stripe.as_hi_epoch, 0, VOS_OF_BG,
 				    &entry->ae_dkey, 1, iod,
 				    stripe_ud.asu_iod_csums,
 				    &entry->ae_sgl);
@@ -188,6 +188,18 @@ struct dss_module_key obj_module_key = {
 	.dmk_fini = obj_tls_fini,
 };
 
+/* Container and estimated payload size of object I/O for the QoS limits */
+static void
+obj_rw_req_attr(struct obj_rw_in *orw, struct sched_req_attr *attr)
+{
+	daos_size_t	size;
+
+	uuid_copy(attr->sra_cont_id, orw->orw_co_uuid);
+	size = daos_iods_len(orw->orw_iod_array.oia_iods, orw->orw_iod_array.oia_iod_nr);
+	/* Unknown size for fetch */
+	attr->sra_size = size == (daos_size_t)-1 ? 0 : size;
+}
+
 static int
 obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 {
@@ -196,11 +208,35 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 
 		sched_req_attr_init(attr, SCHED_REQ_UPDATE,
 				    &orw->orw_pool_uuid);
+		obj_rw_req_attr(orw, attr);
+		/* Forwarded update from leader can't be rejected */
+		if (opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_UPDATE)
+			attr->sra_flags |= SCHED_REQ_FL_CLIENT;
 	} else if (obj_rpc_is_fetch(rpc)) {
 		struct obj_rw_in	*orw = crt_req_get(rpc);
 
 		sched_req_attr_init(attr, SCHED_REQ_FETCH,
 				    &orw->orw_pool_uuid);
+		obj_rw_req_attr(orw, attr);
+		attr->sra_flags |= SCHED_REQ_FL_CLIENT;
+	} else if (opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_RW_BATCH) {
+		struct obj_rw_batch_in	*orbi = crt_req_get(rpc);
+		struct obj_rw_in	*orw = orbi->orb_reqs.ca_arrays;
+		daos_size_t		 size = 0;
+		uint32_t		 i;
+
+		if (orbi->orb_reqs.ca_count == 0)
+			return -DER_NOSYS;
+
+		/* All sub-requests of the batch are charged to the pool of the first one */
+		sched_req_attr_init(attr, orbi->orb_opc == DAOS_OBJ_RPC_UPDATE ?
+				    SCHED_REQ_UPDATE : SCHED_REQ_FETCH, &orw[0].orw_pool_uuid);
+		for (i = 0; i < orbi->orb_reqs.ca_count; i++) {
+			obj_rw_req_attr(&orw[i], attr);
+			size += attr->sra_size;
+		}
+		attr->sra_size = size;
+		attr->sra_flags |= SCHED_REQ_FL_CLIENT;
 	} else if (obj_rpc_is_migrate(rpc)) {
 		struct obj_migrate_in	*omi = crt_req_get(rpc);
 
@@ -214,8 +250,28 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 	return 0;
 }
 
+static int
+obj_reject_req(crt_rpc_t *rpc, struct sched_req_attr *attr)
+{
+	obj_reply_set_status(rpc, -DER_OVERLOAD_RETRY);
+	/* The reply epoch carries the suggested backoff (ms) on overload, see dc_rw_cb() */
+	if (opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_RW_BATCH) {
+		struct obj_rw_batch_out	*orbo = crt_reply_get(rpc);
+
+		orbo->orb_epoch = attr->sra_backoff;
+	} else {
+		struct obj_rw_out	*orwo = crt_reply_get(rpc);
+
+		D_ASSERT(obj_rpc_is_update(rpc) || obj_rpc_is_fetch(rpc));
+		orwo->orw_epoch = attr->sra_backoff;
+	}
+
+	return crt_reply_send(rpc);
+}
+
 static struct dss_module_ops ds_obj_mod_ops = {
 	.dms_get_req_attr = obj_get_req_attr,
+	.dms_reject_req	  = obj_reject_req,
 };
 
 static void *
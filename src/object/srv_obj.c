@@ -149,38 +149,11 @@ obj_rw_complete(crt_rpc_t *rpc, struct obj_io_context *ioc,
 }
 
 static void
-obj_rw_reply(crt_rpc_t *rpc, int status, uint64_t epoch,
-	     struct obj_io_context *ioc)
+obj_rw_reply_free(crt_rpc_t *rpc, bool free_sgls)
 {
 	struct obj_rw_out	*orwo = crt_reply_get(rpc);
-	int			 rc;
 	int			 i;
 
-	obj_reply_set_status(rpc, status);
-	obj_reply_map_version_set(rpc, ioc->ioc_map_ver);
-	if (DAOS_FAIL_CHECK(DAOS_DTX_START_EPOCH)) {
-		/* Return an stale epoch for test. */
-		orwo->orw_epoch = dss_get_start_epoch() -
-				  crt_hlc_epsilon_get() * 3;
-	} else {
-		/* orwo->orw_epoch possibly updated in obj_ec_recov_need_try_again(), reply
-		 * the max so client can fetch from that epoch.
-		 */
-		orwo->orw_epoch = max(epoch, orwo->orw_epoch);
-	}
-
-	D_DEBUG(DB_IO, "rpc %p opc %d send reply, pmv %d, epoch "DF_X64
-		", status %d\n", rpc, opc_get(rpc->cr_opc),
-		ioc->ioc_map_ver, orwo->orw_epoch, status);
-
-	if (!ioc->ioc_lost_reply) {
-		rc = crt_reply_send(rpc);
-		if (rc != 0)
-			D_ERROR("send reply failed: "DF_RC"\n", DP_RC(rc));
-	} else {
-		D_WARN("lost reply rpc %p\n", rpc);
-	}
-
 	if (obj_rpc_is_fetch(rpc)) {
 		if (orwo->orw_iod_sizes.ca_arrays != NULL) {
 			D_FREE(orwo->orw_iod_sizes.ca_arrays);
@@ -205,7 +178,7 @@ obj_rw_reply(crt_rpc_t *rpc, int status, uint64_t epoch,
 		daos_recx_ep_list_free(orwo->orw_rels.ca_arrays,
 				       orwo->orw_rels.ca_count);
 
-		if (ioc->ioc_free_sgls) {
+		if (free_sgls) {
 			struct obj_rw_in *orw = crt_req_get(rpc);
 			d_sg_list_t *sgls = orwo->orw_sgls.ca_arrays;
 			int j;
@@ -217,6 +190,45 @@ obj_rw_reply(crt_rpc_t *rpc, int status, uint64_t epoch,
 	}
 }
 
+static void
+obj_rw_reply(crt_rpc_t *rpc, int status, uint64_t epoch,
+	     struct obj_io_context *ioc)
+{
+	struct obj_rw_out	*orwo = crt_reply_get(rpc);
+	int			 rc;
+
+	obj_reply_set_status(rpc, status);
+	obj_reply_map_version_set(rpc, ioc->ioc_map_ver);
+	if (DAOS_FAIL_CHECK(DAOS_DTX_START_EPOCH)) {
+		/* Return an stale epoch for test. */
+		orwo->orw_epoch = dss_get_start_epoch() -
+				  crt_hlc_epsilon_get() * 3;
+	} else {
+		/* orwo->orw_epoch possibly updated in obj_ec_recov_need_try_again(), reply
+		 * the max so client can fetch from that epoch.
+		 */
+		orwo->orw_epoch = max(epoch, orwo->orw_epoch);
+	}
+
+	/* Replied and released by ds_obj_rw_batch_handler() */
+	if (ioc->ioc_batched)
+		return;
+
+	D_DEBUG(DB_IO, "rpc %p opc %d send reply, pmv %d, epoch "DF_X64
+		", status %d\n", rpc, opc_get(rpc->cr_opc),
+		ioc->ioc_map_ver, orwo->orw_epoch, status);
+
+	if (!ioc->ioc_lost_reply) {
+		rc = crt_reply_send(rpc);
+		if (rc != 0)
+			D_ERROR("send reply failed: "DF_RC"\n", DP_RC(rc));
+	} else {
+		D_WARN("lost reply rpc %p\n", rpc);
+	}
+
+	obj_rw_reply_free(rpc, ioc->ioc_free_sgls);
+}
+
 struct obj_bulk_args {
 	int		bulks_inflight;
 	int		result;
@@ -2468,8 +2480,12 @@ process_epoch(uint64_t *epoch, uint64_t *epoch_first, uint32_t *flags)
 	return PE_OK_LOCAL;
 }
 
-void
-ds_obj_rw_handler(crt_rpc_t *rpc)
+/*
+ * \a free_sgls is non-NULL for a sub-request of DAOS_OBJ_RPC_RW_BATCH, the reply
+ * is then left to the caller, which is told whether the fetch sgls need to be freed.
+ */
+static void
+obj_rw_handler_internal(crt_rpc_t *rpc, bool *free_sgls)
 {
 	struct obj_rw_in		*orw = crt_req_get(rpc);
 	struct obj_rw_out		*orwo = crt_reply_get(rpc);
@@ -2498,6 +2514,7 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 			   orw->orw_pool_uuid, orw->orw_co_hdl,
 			   orw->orw_co_uuid, opc_get(rpc->cr_opc),
 			   orw->orw_flags, &ioc);
+	ioc.ioc_batched = (free_sgls != NULL);
 	if (rc != 0) {
 		D_ASSERTF(rc < 0, "unexpected error# "DF_RC"\n", DP_RC(rc));
 		goto out;
@@ -2531,6 +2548,10 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 		if (DAOS_FAIL_CHECK(DAOS_OBJ_FETCH_DATA_LOST))
 			D_GOTO(out, rc = -DER_DATA_LOSS);
 
+		/* Slow replica for the hedged fetch test */
+		if (DAOS_FAIL_CHECK(DAOS_OBJ_FETCH_DELAY))
+			dss_sleep(2 * 1000);
+
 		epoch.oe_value = orw->orw_epoch;
 		epoch.oe_first = orw->orw_epoch_first;
 		epoch.oe_flags = orf_to_dtx_epoch_flags(orw->orw_flags);
@@ -2722,9 +2743,87 @@ out:
 	obj_ec_split_req_fini(split_req);
 	D_FREE(mbs);
 	D_FREE(dti_cos);
+	if (free_sgls != NULL)
+		*free_sgls = ioc.ioc_free_sgls;
 	obj_ioc_end(&ioc, rc);
 }
 
+void
+ds_obj_rw_handler(crt_rpc_t *rpc)
+{
+	obj_rw_handler_internal(rpc, NULL);
+}
+
+/*
+ * Handle the batched standalone fetch/update requests one by one in this ULT, against a
+ * shadow of the batch RPC carrying the sub-request input and output, then send a single
+ * reply for all of them.
+ */
+void
+ds_obj_rw_batch_handler(crt_rpc_t *rpc)
+{
+	struct obj_rw_batch_in	*orbi = crt_req_get(rpc);
+	struct obj_rw_batch_out	*orbo = crt_reply_get(rpc);
+	struct obj_rw_in	*reqs = orbi->orb_reqs.ca_arrays;
+	struct obj_rw_out	*replies = NULL;
+	bool			*free_sgls = NULL;
+	uint32_t		 nr = orbi->orb_reqs.ca_count;
+	crt_rpc_t		 sub;
+	uint32_t		 i;
+	int			 rc = 0;
+
+	if (orbi->orb_opc != DAOS_OBJ_RPC_FETCH && orbi->orb_opc != DAOS_OBJ_RPC_UPDATE) {
+		D_ERROR("invalid batched opc %u\n", orbi->orb_opc);
+		D_GOTO(out, rc = -DER_PROTO);
+	}
+
+	sub = *rpc;
+	sub.cr_opc = (rpc->cr_opc & ~OPCODE_MASK) | orbi->orb_opc;
+
+	if (nr == 0)
+		goto out;
+
+	D_ALLOC_ARRAY(replies, nr);
+	if (replies == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	D_ALLOC_ARRAY(free_sgls, nr);
+	if (free_sgls == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	D_DEBUG(DB_IO, "rpc %p batch of %u %s\n", rpc, nr, obj_opc_to_str(orbi->orb_opc));
+
+	for (i = 0; i < nr; i++) {
+		sub.cr_input = &reqs[i];
+		sub.cr_output = &replies[i];
+		/* The client only batches inline data without forwarding */
+		if (reqs[i].orw_bulks.ca_count != 0 || reqs[i].orw_shard_tgts.ca_count != 0) {
+			replies[i].orw_ret = -DER_PROTO;
+			continue;
+		}
+		obj_rw_handler_internal(&sub, &free_sgls[i]);
+	}
+	orbo->orb_replies.ca_count = nr;
+	orbo->orb_replies.ca_arrays = replies;
+out:
+	orbo->orb_ret = rc;
+	rc = crt_reply_send(rpc);
+	if (rc != 0)
+		D_ERROR("send reply failed: "DF_RC"\n", DP_RC(rc));
+
+	orbo->orb_replies.ca_count = 0;
+	orbo->orb_replies.ca_arrays = NULL;
+	if (replies != NULL && free_sgls != NULL) {
+		for (i = 0; i < nr; i++) {
+			sub.cr_input = &reqs[i];
+			sub.cr_output = &replies[i];
+			obj_rw_reply_free(&sub, free_sgls[i]);
+		}
+	}
+	D_FREE(free_sgls);
+	D_FREE(replies);
+}
+
 static void
 obj_enum_complete(crt_rpc_t *rpc, int status, int map_version,
 		  daos_epoch_t epoch)
@@ -235,6 +235,18 @@ pool_query_bits(daos_pool_info_t *po_info, daos_prop_t *prop)
 		case DAOS_PROP_PO_SCRUB_THRESH:
 			bits |= DAOS_PO_QUERY_PROP_SCRUB_THRESH;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			bits |= DAOS_PO_QUERY_PROP_QOS_IOPS;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			bits |= DAOS_PO_QUERY_PROP_QOS_BW;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_IOPS:
+			bits |= DAOS_PO_QUERY_PROP_QOS_CONT_IOPS;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_BW:
+			bits |= DAOS_PO_QUERY_PROP_QOS_CONT_BW;
+			break;
 		default:
 			D_ERROR("ignore bad dpt_type %d.\n", entry->dpe_type);
 			break;
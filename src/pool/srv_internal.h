@@ -24,11 +24,30 @@ struct pool_metrics {
 	struct d_tm_node_t	*query_total;
 	struct d_tm_node_t	*query_space_total;
 	struct d_tm_node_t	*evict_total;
+	struct d_tm_node_t	*qos_iops;
+	struct d_tm_node_t	*qos_bw;
+	struct d_tm_node_t	*qos_cont_iops;
+	struct d_tm_node_t	*qos_cont_bw;
 };
 
+/**
+ * Engine startup metrics, recorded while pools are started at engine setup
+ */
+struct pool_startup_metrics {
+	struct d_tm_node_t	*psm_pool_start;	/* per pool start on all targets */
+	struct d_tm_node_t	*psm_rsvc_start;	/* per pool service start */
+	struct d_tm_node_t	*psm_total;		/* start of all pools */
+	bool			 psm_active;		/* startup in progress */
+};
+
+extern struct pool_startup_metrics ds_pool_startup_metrics;
+
 /* Pool thread-local storage */
 struct pool_tls {
 	struct d_list_head	dt_pool_list;	/* of ds_pool_child objects */
+	/* Startup metrics of this target, updated only from its own xstream */
+	struct d_tm_node_t	*dt_startup_vos_open;	/* VOS pool open */
+	struct d_tm_node_t	*dt_startup_cont_start;	/* containers start */
 };
 
 extern struct dss_module_key pool_module_key;
@@ -61,6 +80,10 @@ struct pool_iv_prop {
 	uint64_t	pip_scrub_mode;
 	uint64_t	pip_scrub_freq;
 	uint64_t	pip_scrub_thresh;
+	uint64_t	pip_qos_iops;
+	uint64_t	pip_qos_bw;
+	uint64_t	pip_qos_cont_iops;
+	uint64_t	pip_qos_cont_bw;
 	uint64_t	pip_reclaim;
 	uint64_t	pip_ec_cell_sz;
 	uint32_t	pip_redun_fac;
@@ -207,5 +230,8 @@ void ds_pool_metrics_free(void *data);
 int ds_pool_metrics_count(void);
 int ds_pool_metrics_start(struct ds_pool *pool);
 void ds_pool_metrics_stop(struct ds_pool *pool);
+void ds_pool_metrics_qos_update(struct ds_pool *pool);
+void ds_pool_startup_metrics_init(void);
+void ds_pool_startup_tgt_metrics_init(struct pool_tls *tls, int tgt_id);
 
 #endif /* __POOL_SRV_INTERNAL_H__ */
@@ -197,6 +197,18 @@ pool_iv_prop_l2g(daos_prop_t *prop, struct pool_iv_prop *iv_prop)
 		case DAOS_PROP_PO_SCRUB_THRESH:
 			iv_prop->pip_scrub_thresh = prop_entry->dpe_val;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			iv_prop->pip_qos_iops = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			iv_prop->pip_qos_bw = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_IOPS:
+			iv_prop->pip_qos_cont_iops = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_BW:
+			iv_prop->pip_qos_cont_bw = prop_entry->dpe_val;
+			break;
 		default:
 			D_ASSERTF(0, "bad dpe_type %d\n", prop_entry->dpe_type);
 			break;
@@ -265,6 +277,18 @@ pool_iv_prop_g2l(struct pool_iv_prop *iv_prop, daos_prop_t *prop)
 		case DAOS_PROP_PO_SCRUB_THRESH:
 			prop_entry->dpe_val = iv_prop->pip_scrub_thresh;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			prop_entry->dpe_val = iv_prop->pip_qos_iops;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			prop_entry->dpe_val = iv_prop->pip_qos_bw;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_IOPS:
+			prop_entry->dpe_val = iv_prop->pip_qos_cont_iops;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_BW:
+			prop_entry->dpe_val = iv_prop->pip_qos_cont_bw;
+			break;
 		case DAOS_PROP_PO_RECLAIM:
 			prop_entry->dpe_val = iv_prop->pip_reclaim;
 			break;
@@ -43,6 +43,10 @@ RDB_STRING_KEY(ds_pool_prop_, scrub_sched);
 RDB_STRING_KEY(ds_pool_prop_, scrub_freq);
 RDB_STRING_KEY(ds_pool_prop_, scrub_cred);
 RDB_STRING_KEY(ds_pool_prop_, scrub_thresh);
+RDB_STRING_KEY(ds_pool_prop_, qos_iops);
+RDB_STRING_KEY(ds_pool_prop_, qos_bw);
+RDB_STRING_KEY(ds_pool_prop_, qos_cont_iops);
+RDB_STRING_KEY(ds_pool_prop_, qos_cont_bw);
 
 /** default properties, should cover all optional pool properties */
 struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
@@ -102,6 +106,18 @@ struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
 	}, {
 		.dpe_type	= DAOS_PROP_PO_SCRUB_THRESH,
 		.dpe_val	= 0,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_QOS_IOPS,
+		.dpe_val	= 0,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_QOS_BW,
+		.dpe_val	= 0,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_QOS_CONT_IOPS,
+		.dpe_val	= 0,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_QOS_CONT_BW,
+		.dpe_val	= 0,
 	}
 };
 
@@ -71,6 +71,10 @@ extern d_iov_t ds_pool_prop_upgrade_global_version;/* uint32_t */
 extern d_iov_t ds_pool_prop_scrub_sched;	/* uint64_t */
 extern d_iov_t ds_pool_prop_scrub_freq;		/* uint64_t */
 extern d_iov_t ds_pool_prop_scrub_thresh;	/* uint64_t */
+extern d_iov_t ds_pool_prop_qos_iops;		/* uint64_t */
+extern d_iov_t ds_pool_prop_qos_bw;		/* uint64_t */
+extern d_iov_t ds_pool_prop_qos_cont_iops;	/* uint64_t */
+extern d_iov_t ds_pool_prop_qos_cont_bw;	/* uint64_t */
 /* Please read the IMPORTANT notes above before adding new keys. */
 
 /*
@@ -80,6 +80,34 @@ ds_pool_metrics_alloc(const char *path, int tgt_id)
 	if (rc != 0)
 		D_WARN("Failed to create pool query space counter: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&metrics->qos_iops, D_TM_GAUGE,
+			     "Per target foreground I/O operations limit (0 means unlimited)",
+			     "ops/s", "%s/qos/iops_limit", path);
+	if (rc != 0)
+		D_WARN("Failed to create QoS IOPS limit gauge: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->qos_bw, D_TM_GAUGE,
+			     "Per target foreground I/O bandwidth limit (0 means unlimited)",
+			     "bytes/s", "%s/qos/bw_limit", path);
+	if (rc != 0)
+		D_WARN("Failed to create QoS bandwidth limit gauge: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->qos_cont_iops, D_TM_GAUGE,
+			     "Per target and container foreground I/O operations limit "
+			     "(0 means unlimited)",
+			     "ops/s", "%s/qos/cont_iops_limit", path);
+	if (rc != 0)
+		D_WARN("Failed to create QoS container IOPS limit gauge: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->qos_cont_bw, D_TM_GAUGE,
+			     "Per target and container foreground I/O bandwidth limit "
+			     "(0 means unlimited)",
+			     "bytes/s", "%s/qos/cont_bw_limit", path);
+	if (rc != 0)
+		D_WARN("Failed to create QoS container bandwidth limit gauge: "DF_RC"\n",
+		       DP_RC(rc));
+
 	return metrics;
 }
 
@@ -98,6 +126,25 @@ ds_pool_metrics_free(void *data)
 	D_FREE(data);
 }
 
+/**
+ * Publish the per-target share of the QoS limits
+ *
+ * \param[in]	pool	pointer to ds_pool structure
+ */
+void
+ds_pool_metrics_qos_update(struct ds_pool *pool)
+{
+	struct pool_metrics	*metrics = pool->sp_metrics[DAOS_POOL_MODULE];
+
+	if (metrics == NULL)
+		return;
+
+	d_tm_set_gauge(metrics->qos_iops, pool->sp_qos_iops);
+	d_tm_set_gauge(metrics->qos_bw, pool->sp_qos_bw);
+	d_tm_set_gauge(metrics->qos_cont_iops, pool->sp_qos_cont_iops);
+	d_tm_set_gauge(metrics->qos_cont_bw, pool->sp_qos_cont_bw);
+}
+
 /**
  * Generate the metrics path for a specific pool UUID.
  *
@@ -175,3 +222,64 @@ ds_pool_metrics_stop(struct ds_pool *pool)
 
 	D_INFO(DF_UUID ": destroyed ds_pool metrics\n", DP_UUID(pool->sp_uuid));
 }
+
+struct pool_startup_metrics ds_pool_startup_metrics;
+
+/**
+ * Initializes the engine startup metrics. Failures are not fatal, the
+ * corresponding timing is simply not reported.
+ */
+void
+ds_pool_startup_metrics_init(void)
+{
+	struct pool_startup_metrics	*psm = &ds_pool_startup_metrics;
+	int				 rc;
+
+	if (psm->psm_total != NULL)
+		return;
+
+	rc = d_tm_add_metric(&psm->psm_pool_start, D_TM_STATS_GAUGE,
+			     "Time to start a pool on all targets at startup", "us",
+			     "startup/pool_start");
+	if (rc != 0)
+		D_WARN("Failed to create pool_start metric: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&psm->psm_rsvc_start, D_TM_STATS_GAUGE,
+			     "Time to start a pool service replica at startup", "us",
+			     "startup/rsvc_start");
+	if (rc != 0)
+		D_WARN("Failed to create rsvc_start metric: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&psm->psm_total, D_TM_GAUGE,
+			     "Time to start all pools at startup", "us",
+			     "startup/total");
+	if (rc != 0)
+		D_WARN("Failed to create startup total metric: "DF_RC"\n", DP_RC(rc));
+}
+
+/**
+ * Initializes the startup metrics of one target. They are kept per target
+ * since the targets start their pool children concurrently, and the stats
+ * gauges must only be updated from a single xstream.
+ */
+void
+ds_pool_startup_tgt_metrics_init(struct pool_tls *tls, int tgt_id)
+{
+	int	rc;
+
+	if (tls->dt_startup_vos_open == NULL) {
+		rc = d_tm_add_metric(&tls->dt_startup_vos_open, D_TM_STATS_GAUGE,
+				     "Time to open the VOS pool on a target at startup", "us",
+				     "startup/vos_open/tgt_%d", tgt_id);
+		if (rc != 0)
+			D_WARN("Failed to create vos_open metric: "DF_RC"\n", DP_RC(rc));
+	}
+
+	if (tls->dt_startup_cont_start == NULL) {
+		rc = d_tm_add_metric(&tls->dt_startup_cont_start, D_TM_STATS_GAUGE,
+				     "Time to start all containers of a pool on a target at startup",
+				     "us", "startup/cont_start/tgt_%d", tgt_id);
+		if (rc != 0)
+			D_WARN("Failed to create cont_start metric: "DF_RC"\n", DP_RC(rc));
+	}
+}
@@ -294,6 +294,12 @@ pool_prop_default_copy(daos_prop_t *prop_def, daos_prop_t *prop)
 		case DAOS_PROP_PO_SCRUB_THRESH:
 			entry_def->dpe_val = entry->dpe_val;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+		case DAOS_PROP_PO_QOS_BW:
+		case DAOS_PROP_PO_QOS_CONT_IOPS:
+		case DAOS_PROP_PO_QOS_CONT_BW:
+			entry_def->dpe_val = entry->dpe_val;
+			break;
 		case DAOS_PROP_PO_GLOBAL_VERSION:
 			D_ERROR("pool global version property could be not set\n");
 			return -DER_INVAL;
@@ -464,6 +470,30 @@ pool_prop_write(struct rdb_tx *tx, const rdb_path_t *kvs, daos_prop_t *prop,
 			if (rc)
 				return rc;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_iops, &value);
+			if (rc)
+				return rc;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_bw, &value);
+			if (rc)
+				return rc;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_IOPS:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_cont_iops, &value);
+			if (rc)
+				return rc;
+			break;
+		case DAOS_PROP_PO_QOS_CONT_BW:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_cont_bw, &value);
+			if (rc)
+				return rc;
+			break;
 		case DAOS_PROP_PO_GLOBAL_VERSION:
 			if (entry->dpe_val > DS_POOL_GLOBAL_VERSION) {
 				rc = -DER_INVAL;
@@ -1691,13 +1721,16 @@ int ds_pool_failed_lookup(uuid_t uuid)
 static int
 start_one(uuid_t uuid, void *varg)
 {
-	char	       *path;
-	d_iov_t		id;
-	struct stat	st;
-	int		rc;
+	struct pool_startup_metrics	*psm = &ds_pool_startup_metrics;
+	char			       *path;
+	d_iov_t				id;
+	struct stat			st;
+	uint64_t			start;
+	int				rc;
 
 	D_DEBUG(DB_MD, DF_UUID": starting pool\n", DP_UUID(uuid));
 
+	start = daos_get_ntime();
 	rc = ds_pool_start(uuid);
 	if (rc != 0) {
 		D_ERROR(DF_UUID": failed to start pool: %d\n", DP_UUID(uuid),
@@ -1705,6 +1738,7 @@ start_one(uuid_t uuid, void *varg)
 		ds_pool_failed_add(uuid, rc);
 		return 0;
 	}
+	d_tm_set_gauge(psm->psm_pool_start, (daos_get_ntime() - start) / NSEC_PER_USEC);
 
 	/*
 	 * Check if an RDB file exists, to avoid unnecessary error messages
@@ -1726,21 +1760,132 @@ start_one(uuid_t uuid, void *varg)
 	}
 
 	d_iov_set(&id, uuid, sizeof(uuid_t));
-	ds_rsvc_start(DS_RSVC_CLASS_POOL, &id, uuid, false /* create */, 0 /* size */,
-		      NULL /* replicas */, NULL /* arg */);
+	start = daos_get_ntime();
+	rc = ds_rsvc_start(DS_RSVC_CLASS_POOL, &id, uuid, false /* create */, 0 /* size */,
+			   NULL /* replicas */, NULL /* arg */);
+	if (rc == 0)
+		d_tm_set_gauge(psm->psm_rsvc_start, (daos_get_ntime() - start) / NSEC_PER_USEC);
+	return 0;
+}
+
+/* Default number of pools started concurrently at engine setup */
+#define POOL_START_CONCURRENCY_DEFAULT	4
+
+struct pool_start_all_arg {
+	ABT_mutex	psa_lock;
+	ABT_cond	psa_cond;
+	unsigned int	psa_inflight;
+	unsigned int	psa_max;
+};
+
+struct pool_start_one_arg {
+	uuid_t				 pso_uuid;
+	struct pool_start_all_arg	*pso_all;
+};
+
+static void
+start_one_ult(void *varg)
+{
+	struct pool_start_one_arg	*arg = varg;
+	struct pool_start_all_arg	*all = arg->pso_all;
+
+	start_one(arg->pso_uuid, NULL);
+	D_FREE(arg);
+
+	ABT_mutex_lock(all->psa_lock);
+	D_ASSERT(all->psa_inflight > 0);
+	all->psa_inflight--;
+	ABT_cond_broadcast(all->psa_cond);
+	ABT_mutex_unlock(all->psa_lock);
+}
+
+/*
+ * Start the pool in a separate ULT, so that the VOS pool open, container
+ * start and pool service start of different pools can overlap. Wait for a
+ * slot when psa_max pools are being started already.
+ */
+static int
+start_one_async(uuid_t uuid, void *varg)
+{
+	struct pool_start_all_arg	*all = varg;
+	struct pool_start_one_arg	*arg;
+	int				 rc;
+
+	D_ALLOC_PTR(arg);
+	if (arg == NULL)
+		return start_one(uuid, NULL);
+	uuid_copy(arg->pso_uuid, uuid);
+	arg->pso_all = all;
+
+	ABT_mutex_lock(all->psa_lock);
+	while (all->psa_inflight >= all->psa_max)
+		ABT_cond_wait(all->psa_cond, all->psa_lock);
+	all->psa_inflight++;
+	ABT_mutex_unlock(all->psa_lock);
+
+	rc = dss_ult_create(start_one_ult, arg, DSS_XS_SYS, 0 /* tgt_idx */,
+			    0 /* stack_size */, NULL);
+	if (rc != 0) {
+		D_WARN(DF_UUID": failed to create pool start ULT, start inline: "DF_RC"\n",
+		       DP_UUID(uuid), DP_RC(rc));
+		/* start_one_ult() releases the slot and frees the arg */
+		start_one_ult(arg);
+	}
 	return 0;
 }
 
 static void
 pool_start_all(void *arg)
 {
-	int rc;
+	struct pool_startup_metrics	*psm = &ds_pool_startup_metrics;
+	struct pool_start_all_arg	 all = { 0 };
+	unsigned int			 concurrency = POOL_START_CONCURRENCY_DEFAULT;
+	uint64_t			 start;
+	int				 rc;
+
+	d_getenv_int("DAOS_POOL_START_CONCURRENCY", &concurrency);
+	if (concurrency == 0)
+		concurrency = 1;
+	all.psa_max = concurrency;
+
+	ds_pool_startup_metrics_init();
+	psm->psm_active = true;
+	start = daos_get_ntime();
+
+	if (concurrency > 1) {
+		rc = ABT_mutex_create(&all.psa_lock);
+		if (rc != ABT_SUCCESS) {
+			concurrency = 1;
+		} else {
+			rc = ABT_cond_create(&all.psa_cond);
+			if (rc != ABT_SUCCESS) {
+				ABT_mutex_free(&all.psa_lock);
+				concurrency = 1;
+			}
+		}
+	}
+	D_INFO("starting pools with concurrency %u\n", concurrency);
 
 	/* Scan the storage and start all pool services. */
-	rc = ds_mgmt_tgt_pool_iterate(start_one, NULL /* arg */);
+	if (concurrency > 1)
+		rc = ds_mgmt_tgt_pool_iterate(start_one_async, &all);
+	else
+		rc = ds_mgmt_tgt_pool_iterate(start_one, NULL /* arg */);
 	if (rc != 0)
 		D_ERROR("failed to scan all pool services: "DF_RC"\n",
 			DP_RC(rc));
+
+	if (concurrency > 1) {
+		ABT_mutex_lock(all.psa_lock);
+		while (all.psa_inflight > 0)
+			ABT_cond_wait(all.psa_cond, all.psa_lock);
+		ABT_mutex_unlock(all.psa_lock);
+		ABT_cond_free(&all.psa_cond);
+		ABT_mutex_free(&all.psa_lock);
+	}
+
+	psm->psm_active = false;
+	d_tm_set_gauge(psm->psm_total, (daos_get_ntime() - start) / NSEC_PER_USEC);
 }
 
 /* Note that this function is currently called from the main xstream. */
@@ -1835,6 +1980,29 @@ ds_pool_set_hint(struct rdb *db, struct rsvc_hint *hint)
 	hint->sh_flags |= RSVC_HINT_VALID;
 }
 
+/* QoS properties are absent on pools created before they were introduced */
+static int
+pool_prop_read_qos(struct rdb_tx *tx, const struct pool_svc *svc, d_iov_t *key,
+		   uint32_t type, struct daos_prop_entry *entry)
+{
+	d_iov_t		value;
+	uint64_t	val;
+	int		rc;
+
+	d_iov_set(&value, &val, sizeof(val));
+	rc = rdb_tx_lookup(tx, &svc->ps_root, key, &value);
+	if (rc == -DER_NONEXIST) {
+		val = 0;
+		entry->dpe_flags |= DAOS_PROP_ENTRY_NOT_SET;
+	} else if (rc != 0) {
+		return rc;
+	}
+
+	entry->dpe_type = type;
+	entry->dpe_val = val;
+	return 0;
+}
+
 static int
 pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 	       daos_prop_t **prop_out)
@@ -2142,6 +2310,38 @@ pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 		prop->dpp_entries[idx].dpe_val = val;
 		idx++;
 	}
+	if (bits & DAOS_PO_QUERY_PROP_QOS_IOPS) {
+		D_ASSERT(idx < nr);
+		rc = pool_prop_read_qos(tx, svc, &ds_pool_prop_qos_iops,
+					DAOS_PROP_PO_QOS_IOPS, &prop->dpp_entries[idx]);
+		if (rc != 0)
+			return rc;
+		idx++;
+	}
+	if (bits & DAOS_PO_QUERY_PROP_QOS_BW) {
+		D_ASSERT(idx < nr);
+		rc = pool_prop_read_qos(tx, svc, &ds_pool_prop_qos_bw,
+					DAOS_PROP_PO_QOS_BW, &prop->dpp_entries[idx]);
+		if (rc != 0)
+			return rc;
+		idx++;
+	}
+	if (bits & DAOS_PO_QUERY_PROP_QOS_CONT_IOPS) {
+		D_ASSERT(idx < nr);
+		rc = pool_prop_read_qos(tx, svc, &ds_pool_prop_qos_cont_iops,
+					DAOS_PROP_PO_QOS_CONT_IOPS, &prop->dpp_entries[idx]);
+		if (rc != 0)
+			return rc;
+		idx++;
+	}
+	if (bits & DAOS_PO_QUERY_PROP_QOS_CONT_BW) {
+		D_ASSERT(idx < nr);
+		rc = pool_prop_read_qos(tx, svc, &ds_pool_prop_qos_cont_bw,
+					DAOS_PROP_PO_QOS_CONT_BW, &prop->dpp_entries[idx]);
+		if (rc != 0)
+			return rc;
+		idx++;
+	}
 
 	return 0;
 }
@@ -3192,6 +3392,10 @@ ds_pool_query_handler(crt_rpc_t *rpc, bool return_pool_ver)
 			case DAOS_PROP_PO_SCRUB_MODE:
 			case DAOS_PROP_PO_SCRUB_FREQ:
 			case DAOS_PROP_PO_SCRUB_THRESH:
+			case DAOS_PROP_PO_QOS_IOPS:
+			case DAOS_PROP_PO_QOS_BW:
+			case DAOS_PROP_PO_QOS_CONT_IOPS:
+			case DAOS_PROP_PO_QOS_CONT_BW:
 				if (entry->dpe_val != iv_entry->dpe_val) {
 					D_ERROR("type %d mismatch "DF_U64" - "
 						DF_U64".\n", entry->dpe_type,
@@ -287,7 +287,9 @@ pool_child_add_one(void *varg)
 	struct pool_tls		       *tls = pool_tls_get();
 	struct ds_pool_child	       *child;
 	struct dss_module_info	       *info = dss_get_module_info();
+	struct pool_startup_metrics    *psm = &ds_pool_startup_metrics;
 	char			       *path;
+	uint64_t			start;
 	int				rc;
 
 	child = ds_pool_child_lookup(arg->pla_uuid);
@@ -317,6 +319,9 @@ pool_child_add_one(void *varg)
 		goto out_metrics;
 
 	D_ASSERT(child->spc_metrics[DAOS_VOS_MODULE] != NULL);
+	if (psm->psm_active)
+		ds_pool_startup_tgt_metrics_init(tls, info->dmi_tgt_id);
+	start = daos_get_ntime();
 	rc = vos_pool_open_metrics(path, arg->pla_uuid, VOS_POF_EXCL | VOS_POF_EXTERNAL_FLUSH,
 				   child->spc_metrics[DAOS_VOS_MODULE], &child->spc_hdl);
 
@@ -325,6 +330,9 @@ pool_child_add_one(void *varg)
 	if (rc != 0)
 		goto out_metrics;
 
+	if (psm->psm_active)
+		d_tm_set_gauge(tls->dt_startup_vos_open, (daos_get_ntime() - start) / NSEC_PER_USEC);
+
 	uuid_copy(child->spc_uuid, arg->pla_uuid);
 	child->spc_map_version = arg->pla_map_version;
 	child->spc_ref = 1; /* 1 for the list */
@@ -355,10 +363,14 @@ pool_child_add_one(void *varg)
 	d_list_add(&child->spc_list, &tls->dt_pool_list);
 
 	/* Load all containers */
+	start = daos_get_ntime();
 	rc = ds_cont_child_start_all(child);
 	if (rc)
 		goto out_list;
 
+	if (psm->psm_active)
+		d_tm_set_gauge(tls->dt_startup_cont_start, (daos_get_ntime() - start) / NSEC_PER_USEC);
+
 	return 0;
 
 out_list:
@@ -1556,7 +1568,8 @@ update_vos_prop_on_targets(void *in)
 	struct ds_pool			*pool = (struct ds_pool *)in;
 	struct ds_pool_child		*child = NULL;
 	struct policy_desc_t		policy_desc = {0};
-	int				ret = 0;
+	struct sched_qos_limits		qos;
+	int				ret = 0, rc;
 	uint64_t			features = 0;
 
 	child = ds_pool_child_lookup(pool->sp_uuid);
@@ -1571,7 +1584,43 @@ update_vos_prop_on_targets(void *in)
 	vos_pool_features_set(child->spc_hdl, features);
 	ds_pool_child_put(child);
 
-	return ret;
+	qos.sql_iops = pool->sp_qos_iops;
+	qos.sql_bw = pool->sp_qos_bw;
+	qos.sql_cont_iops = pool->sp_qos_cont_iops;
+	qos.sql_cont_bw = pool->sp_qos_cont_bw;
+	rc = sched_pool_qos_set(pool->sp_uuid, &qos);
+	if (rc)
+		D_ERROR(DF_UUID": failed to set QoS limits. "DF_RC"\n",
+			DP_UUID(pool->sp_uuid), DP_RC(rc));
+
+	return ret ? ret : rc;
+}
+
+/* Pool-wide QoS limit is evenly divided across the pool targets */
+static inline uint64_t
+qos_tgt_share(uint64_t limit, unsigned int tgt_nr)
+{
+	if (limit == 0 || tgt_nr <= 1)
+		return limit;
+	return max(limit / tgt_nr, 1);
+}
+
+static void
+pool_qos_update(struct ds_pool *pool, struct pool_iv_prop *iv_prop)
+{
+	unsigned int	tgt_nr = 0;
+
+	ABT_rwlock_rdlock(pool->sp_lock);
+	if (pool->sp_map != NULL)
+		tgt_nr = pool_map_target_nr(pool->sp_map);
+	ABT_rwlock_unlock(pool->sp_lock);
+
+	pool->sp_qos_iops = qos_tgt_share(iv_prop->pip_qos_iops, tgt_nr);
+	pool->sp_qos_bw = qos_tgt_share(iv_prop->pip_qos_bw, tgt_nr);
+	pool->sp_qos_cont_iops = qos_tgt_share(iv_prop->pip_qos_cont_iops, tgt_nr);
+	pool->sp_qos_cont_bw = qos_tgt_share(iv_prop->pip_qos_cont_bw, tgt_nr);
+
+	ds_pool_metrics_qos_update(pool);
 }
 
 int
@@ -1586,6 +1635,7 @@ ds_pool_tgt_prop_update(struct ds_pool *pool, struct pool_iv_prop *iv_prop)
 	pool->sp_redun_fac = iv_prop->pip_redun_fac;
 	pool->sp_ec_pda = iv_prop->pip_ec_pda;
 	pool->sp_rp_pda = iv_prop->pip_rp_pda;
+	pool_qos_update(pool, iv_prop);
 
 	if (!daos_policy_try_parse(iv_prop->pip_policy_str,
 				   &pool->sp_policy_desc)) {
@@ -1869,26 +1919,34 @@ ds_pool_tgt_discard_ult(void *data)
 	coll_ops.co_func = pool_child_discard;
 	coll_args.ca_func_args	= arg;
 	if (pool->sp_map != NULL) {
-		unsigned int status;
+		int		*tgts = NULL;
+		unsigned int	 tgts_cnt;
+		int		 i;
 
-		/* It should only discard the target in DOWNOUT state, and skip
-		 * targets in other state.
+		/* It should only discard the target in DOWNOUT state, usually a
+		 * few of them, so the others aren't involved in the collective.
 		 */
-		status = PO_COMP_ST_UP | PO_COMP_ST_UPIN | PO_COMP_ST_DRAIN |
-			 PO_COMP_ST_DOWN | PO_COMP_ST_NEW;
-		rc = ds_pool_get_tgt_idx_by_state(arg->pool_uuid, status,
-						  &coll_args.ca_exclude_tgts,
-						  &coll_args.ca_exclude_tgts_cnt);
+		rc = ds_pool_get_tgt_idx_by_state(arg->pool_uuid, PO_COMP_ST_DOWNOUT,
+						  &tgts, &tgts_cnt);
 		if (rc) {
 			D_ERROR(DF_UUID "failed to get index : rc "DF_RC"\n",
 				DP_UUID(arg->pool_uuid), DP_RC(rc));
 			D_GOTO(put, rc);
 		}
+
+		coll_args.ca_tgt_bitmap_sz = (dss_tgt_nr + NBBY - 1) / NBBY;
+		D_ALLOC(coll_args.ca_tgt_bitmap, coll_args.ca_tgt_bitmap_sz);
+		if (coll_args.ca_tgt_bitmap == NULL) {
+			D_FREE(tgts);
+			D_GOTO(put, rc = -DER_NOMEM);
+		}
+		for (i = 0; i < tgts_cnt; i++)
+			setbit(coll_args.ca_tgt_bitmap, tgts[i]);
+		D_FREE(tgts);
 	}
 
 	rc = dss_thread_collective_reduce(&coll_ops, &coll_args, 0);
-	if (coll_args.ca_exclude_tgts)
-		D_FREE(coll_args.ca_exclude_tgts);
+	D_FREE(coll_args.ca_tgt_bitmap);
 	D_CDEBUG(rc == 0, DB_MD, DLOG_ERR, DF_UUID" tgt discard:" DF_RC"\n",
 		 DP_UUID(arg->pool_uuid), DP_RC(rc));
 put:
@@ -0,0 +1,731 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/*
+ * bio_perf: standalone benchmark for the BIO layer (DMA buffer mapping, bulk
+ * cache, bio_readv/bio_writev and bio_copy) against SPDK malloc or AIO bdev.
+ */
+#define D_LOGFAC       DD_FAC(tests)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <abt.h>
+#include <gurt/atomic.h>
+#include <daos/common.h>
+#include <daos/mem.h>
+#include <daos_srv/bio.h>
+#include <daos_srv/vos.h>
+
+#define BP_BLOB_SZ		(1ULL << 30)	/* One blobstore cluster */
+#define BP_LAT_MAX		(1U << 20)	/* Max latency samples per xstream */
+#define BP_XS_MAX		32
+#define BP_PAGE_SZ		4096
+
+enum {
+	BP_OP_RW,
+	BP_OP_COPY,
+};
+
+struct bp_xstream {
+	ABT_xstream		 bx_xstream;
+	ABT_thread		 bx_thread;
+	int			 bx_id;
+	struct bio_xs_context	*bx_xs_ctxt;
+	struct bio_io_context	*bx_io_ctxt;
+	struct umem_instance	 bx_umm;
+	uuid_t			 bx_uuid;
+	bool			 bx_stop_poll;
+	int			 bx_rc;
+	/* Stats */
+	uint64_t		 bx_reads;
+	uint64_t		 bx_writes;
+	uint64_t		 bx_copies;
+	uint64_t		 bx_errs;
+	uint64_t		*bx_lats;	/* in ns */
+	unsigned int		 bx_lat_cnt;
+};
+
+struct bp_worker {
+	struct bp_xstream	*bw_xs;
+	void			*bw_buf;
+	unsigned int		 bw_seed;
+};
+
+static char		 bp_dir[PATH_MAX - 64] = "/tmp/bio_perf";
+static char		 bp_aio_file[PATH_MAX] = "/tmp/bio_perf_aio";
+static bool		 bp_aio;
+/* Drive the file through io_uring instead of Linux AIO */
+static bool		 bp_uring;
+static bool		 bp_bulk;
+static int		 bp_op = BP_OP_RW;
+static unsigned int	 bp_io_size = BP_PAGE_SZ;
+static unsigned int	 bp_depth = 1;
+static unsigned int	 bp_xs_nr = 1;
+static unsigned int	 bp_read_pct = 50;
+static unsigned int	 bp_secs = 10;
+static uint64_t		 bp_ops;	/* ops per worker, overrides bp_secs */
+static uint64_t		 bp_bdev_mb;
+static unsigned int	 bp_mem_mb;
+static uint64_t		 bp_end_ns;
+
+static struct bp_xstream bp_xstreams[BP_XS_MAX];
+static ATOMIC unsigned int bp_xs_done;
+
+static uint64_t
+bp_parse_size(const char *str)
+{
+	char		*end;
+	uint64_t	 val;
+
+	val = strtoull(str, &end, 0);
+	switch (*end) {
+	case 'k':
+	case 'K':
+		val <<= 10;
+		break;
+	case 'm':
+	case 'M':
+		val <<= 20;
+		break;
+	case 'g':
+	case 'G':
+		val <<= 30;
+		break;
+	default:
+		break;
+	}
+	return val;
+}
+
+static int
+bp_write_conf(void)
+{
+	char	 path[PATH_MAX];
+	char	 mem[16];
+	FILE	*fp;
+	int	 fd, rc;
+
+	rc = mkdir(bp_dir, 0755);
+	if (rc != 0 && errno != EEXIST) {
+		fprintf(stderr, "failed to create %s: %s\n", bp_dir, strerror(errno));
+		return -1;
+	}
+
+	if (bp_aio) {
+		fd = open(bp_aio_file, O_CREAT | O_RDWR, 0600);
+		if (fd < 0) {
+			fprintf(stderr, "failed to open %s: %s\n", bp_aio_file, strerror(errno));
+			return -1;
+		}
+		rc = ftruncate(fd, bp_bdev_mb << 20);
+		close(fd);
+		if (rc != 0) {
+			fprintf(stderr, "failed to truncate %s: %s\n", bp_aio_file,
+				strerror(errno));
+			return -1;
+		}
+	}
+
+	snprintf(path, sizeof(path), "%s/daos_nvme.conf", bp_dir);
+	fp = fopen(path, "w");
+	if (fp == NULL) {
+		fprintf(stderr, "failed to create %s: %s\n", path, strerror(errno));
+		return -1;
+	}
+
+	fprintf(fp, "{\n"
+		"  \"daos_data\": {\n"
+		"    \"config\": []\n"
+		"  },\n"
+		"  \"subsystems\": [\n"
+		"    {\n"
+		"      \"subsystem\": \"bdev\",\n"
+		"      \"config\": [\n"
+		"        {\n"
+		"          \"params\": {\n"
+		"            \"bdev_io_pool_size\": 65536,\n"
+		"            \"bdev_io_cache_size\": 256\n"
+		"          },\n"
+		"          \"method\": \"bdev_set_options\"\n"
+		"        },\n"
+		"        {\n");
+	if (bp_aio)
+		fprintf(fp, "          \"params\": {\n"
+			"            \"block_size\": %d,\n"
+			"            \"name\": \"%s_1\",\n"
+			"            \"filename\": \"%s\"\n"
+			"          },\n"
+			"          \"method\": \"%s\"\n",
+			BP_PAGE_SZ, bp_uring ? "URING" : "AIO", bp_aio_file,
+			bp_uring ? "bdev_uring_create" : "bdev_aio_create");
+	else
+		fprintf(fp, "          \"params\": {\n"
+			"            \"block_size\": %d,\n"
+			"            \"num_blocks\": "DF_U64",\n"
+			"            \"name\": \"Malloc0\"\n"
+			"          },\n"
+			"          \"method\": \"bdev_malloc_create\"\n",
+			BP_PAGE_SZ, (bp_bdev_mb << 20) / BP_PAGE_SZ);
+	fprintf(fp, "        }\n"
+		"      ]\n"
+		"    }\n"
+		"  ]\n"
+		"}\n");
+	fclose(fp);
+
+	/* Tell BIO which bdev class to use, and the hugepage memory for SPDK */
+	setenv("VOS_BDEV_CLASS", bp_aio ? (bp_uring ? "URING" : "AIO") : "MALLOC", 1);
+	snprintf(mem, sizeof(mem), "%u", bp_mem_mb);
+	setenv("VOS_NVME_MEM_SIZE", mem, 1);
+	return 0;
+}
+
+/* No real RDMA in the benchmark, the bulk handle is only used as cache key */
+static int
+bp_bulk_create(void *ctxt, d_sg_list_t *sgl, unsigned int perm, void **bulk_hdl)
+{
+	*bulk_hdl = sgl->sg_iovs[0].iov_buf;
+	return 0;
+}
+
+static int
+bp_bulk_free(void *bulk_hdl)
+{
+	return 0;
+}
+
+static inline uint64_t
+bp_rand_off(struct bp_worker *bw, uint64_t start, uint64_t end)
+{
+	uint64_t	size = D_ALIGNUP(bp_io_size, BP_PAGE_SZ);
+	uint64_t	slots = (end - start) / size;
+
+	return start + ((uint64_t)rand_r(&bw->bw_seed) % slots) * size;
+}
+
+static int
+bp_iod_rw(struct bp_worker *bw, bio_addr_t addr, bool update)
+{
+	struct bio_io_context	*ioctxt = bw->bw_xs->bx_io_ctxt;
+	struct bio_desc		*biod;
+	struct bio_sglist	*bsgl;
+	int			 rc;
+
+	biod = bio_iod_alloc(ioctxt, 1, update ? BIO_IOD_TYPE_UPDATE : BIO_IOD_TYPE_FETCH);
+	if (biod == NULL)
+		return -DER_NOMEM;
+
+	bsgl = bio_iod_sgl(biod, 0);
+	rc = bio_sgl_init(bsgl, 1);
+	if (rc)
+		goto out;
+
+	bio_iov_set(&bsgl->bs_iovs[0], addr, bp_io_size);
+	bsgl->bs_nr_out = 1;
+
+	/* Data is left in the bulk cached DMA buffer, no transfer is done */
+	rc = bio_iod_prep(biod, BIO_CHK_TYPE_IO, bw, CRT_BULK_RW);
+	if (rc)
+		goto out;
+
+	rc = bio_iod_post(biod, 0);
+out:
+	bio_iod_free(biod);
+	return rc;
+}
+
+static int
+bp_rw(struct bp_worker *bw, bool update)
+{
+	struct bio_io_context	*ioctxt = bw->bw_xs->bx_io_ctxt;
+	struct bio_sglist	 bsgl;
+	struct bio_iov		 biov;
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	bio_addr_t		 addr = { 0 };
+
+	bio_addr_set(&addr, DAOS_MEDIA_NVME, bp_rand_off(bw, 0, BP_BLOB_SZ));
+	if (bp_bulk)
+		return bp_iod_rw(bw, addr, update);
+
+	bio_iov_set(&biov, addr, bp_io_size);
+	bsgl.bs_iovs = &biov;
+	bsgl.bs_nr = bsgl.bs_nr_out = 1;
+
+	d_iov_set(&iov, bw->bw_buf, bp_io_size);
+	sgl.sg_iovs = &iov;
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+
+	return update ? bio_writev(ioctxt, &bsgl, &sgl) : bio_readv(ioctxt, &bsgl, &sgl);
+}
+
+static int
+bp_copy(struct bp_worker *bw)
+{
+	struct bio_sglist	 bsgl_src, bsgl_dst;
+	struct bio_iov		 biov_src, biov_dst;
+	bio_addr_t		 addr = { 0 };
+
+	/* Copy from the lower half of the blob to the upper half */
+	bio_addr_set(&addr, DAOS_MEDIA_NVME, bp_rand_off(bw, 0, BP_BLOB_SZ / 2));
+	bio_iov_set(&biov_src, addr, bp_io_size);
+	bio_addr_set(&addr, DAOS_MEDIA_NVME, bp_rand_off(bw, BP_BLOB_SZ / 2, BP_BLOB_SZ));
+	bio_iov_set(&biov_dst, addr, bp_io_size);
+
+	bsgl_src.bs_iovs = &biov_src;
+	bsgl_src.bs_nr = bsgl_src.bs_nr_out = 1;
+	bsgl_dst.bs_iovs = &biov_dst;
+	bsgl_dst.bs_nr = bsgl_dst.bs_nr_out = 1;
+
+	return bio_copy(bw->bw_xs->bx_io_ctxt, &bsgl_src, &bsgl_dst, 0, NULL);
+}
+
+static void
+bp_worker_ult(void *arg)
+{
+	struct bp_worker	*bw = arg;
+	struct bp_xstream	*bx = bw->bw_xs;
+	uint64_t		 start, i;
+	bool			 update = false;
+	int			 rc;
+
+	for (i = 0; bp_ops == 0 || i < bp_ops; i++) {
+		start = daos_get_ntime();
+		if (bp_ops == 0 && start >= bp_end_ns)
+			break;
+
+		if (bp_op == BP_OP_COPY) {
+			rc = bp_copy(bw);
+		} else {
+			update = (rand_r(&bw->bw_seed) % 100) >= bp_read_pct;
+			rc = bp_rw(bw, update);
+		}
+
+		if (rc) {
+			bx->bx_errs++;
+			continue;
+		}
+
+		if (bp_op == BP_OP_COPY)
+			bx->bx_copies++;
+		else if (update)
+			bx->bx_writes++;
+		else
+			bx->bx_reads++;
+
+		if (bx->bx_lat_cnt < BP_LAT_MAX)
+			bx->bx_lats[bx->bx_lat_cnt++] = daos_get_ntime() - start;
+	}
+}
+
+static void
+bp_poll_ult(void *arg)
+{
+	struct bp_xstream	*bx = arg;
+
+	while (!bx->bx_stop_poll) {
+		bio_nvme_poll(bx->bx_xs_ctxt);
+		ABT_thread_yield();
+	}
+}
+
+static void
+bp_xstream_ult(void *arg)
+{
+	struct bp_xstream	*bx = arg;
+	struct bp_worker	*workers = NULL;
+	ABT_thread		*threads = NULL;
+	ABT_thread		 poller = ABT_THREAD_NULL;
+	ABT_pool		 pool;
+	struct umem_attr	 uma = { 0 };
+	bool			 blob_created = false;
+	int			 i, rc;
+
+	ABT_xstream_get_main_pools(bx->bx_xstream, 1, &pool);
+
+	/* Target 0 is used by the standalone VOS context of main thread */
+	rc = bio_xsctxt_alloc(&bx->bx_xs_ctxt, bx->bx_id + 1, false);
+	if (rc) {
+		fprintf(stderr, "xs %d: failed to alloc xs context: "DF_RC"\n", bx->bx_id,
+			DP_RC(rc));
+		goto out;
+	}
+
+	rc = ABT_thread_create(pool, bp_poll_ult, bx, ABT_THREAD_ATTR_NULL, &poller);
+	if (rc != ABT_SUCCESS) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
+
+	uma.uma_id = UMEM_CLASS_VMEM;
+	rc = umem_class_init(&uma, &bx->bx_umm);
+	if (rc)
+		goto out;
+
+	uuid_generate(bx->bx_uuid);
+	rc = bio_blob_create(bx->bx_uuid, bx->bx_xs_ctxt, BP_BLOB_SZ);
+	if (rc) {
+		fprintf(stderr, "xs %d: failed to create blob: "DF_RC"\n", bx->bx_id, DP_RC(rc));
+		goto out;
+	}
+	blob_created = true;
+
+	rc = bio_ioctxt_open(&bx->bx_io_ctxt, bx->bx_xs_ctxt, &bx->bx_umm, bx->bx_uuid, false);
+	if (rc) {
+		fprintf(stderr, "xs %d: failed to open io context: "DF_RC"\n", bx->bx_id,
+			DP_RC(rc));
+		goto out;
+	}
+
+	D_ALLOC_ARRAY(bx->bx_lats, BP_LAT_MAX);
+	D_ALLOC_ARRAY(workers, bp_depth);
+	D_ALLOC_ARRAY(threads, bp_depth);
+	if (bx->bx_lats == NULL || workers == NULL || threads == NULL) {
+		rc = -DER_NOMEM;
+		goto close;
+	}
+
+	for (i = 0; i < bp_depth; i++) {
+		workers[i].bw_xs = bx;
+		workers[i].bw_seed = (bx->bx_id << 16) + i;
+		rc = posix_memalign(&workers[i].bw_buf, BP_PAGE_SZ, bp_io_size);
+		if (rc) {
+			rc = -DER_NOMEM;
+			break;
+		}
+		memset(workers[i].bw_buf, 'a' + (i % 26), bp_io_size);
+
+		rc = ABT_thread_create(pool, bp_worker_ult, &workers[i], ABT_THREAD_ATTR_NULL,
+				       &threads[i]);
+		if (rc != ABT_SUCCESS) {
+			rc = -DER_NOMEM;
+			free(workers[i].bw_buf);
+			break;
+		}
+	}
+
+	while (--i >= 0) {
+		ABT_thread_free(&threads[i]);
+		free(workers[i].bw_buf);
+	}
+close:
+	bio_ioctxt_close(bx->bx_io_ctxt, false);
+out:
+	if (blob_created)
+		bio_blob_delete(bx->bx_uuid, bx->bx_xs_ctxt);
+	if (poller != ABT_THREAD_NULL) {
+		bx->bx_stop_poll = true;
+		ABT_thread_free(&poller);
+	}
+	if (bx->bx_xs_ctxt != NULL)
+		bio_xsctxt_free(bx->bx_xs_ctxt);
+	D_FREE(workers);
+	D_FREE(threads);
+	bx->bx_rc = rc;
+	atomic_fetch_add_relaxed(&bp_xs_done, 1);
+}
+
+static int
+bp_lat_cmp(const void *a, const void *b)
+{
+	uint64_t	la = *(const uint64_t *)a;
+	uint64_t	lb = *(const uint64_t *)b;
+
+	return la < lb ? -1 : (la > lb ? 1 : 0);
+}
+
+static void
+bp_report(uint64_t elapsed_ns)
+{
+	struct bp_xstream	*bx;
+	uint64_t		*lats;
+	uint64_t		 reads = 0, writes = 0, copies = 0, errs = 0, ops, lat_sum = 0;
+	unsigned int		 lat_cnt = 0;
+	double			 secs = (double)elapsed_ns / NSEC_PER_SEC;
+	int			 i;
+
+	for (i = 0; i < bp_xs_nr; i++) {
+		bx = &bp_xstreams[i];
+		reads += bx->bx_reads;
+		writes += bx->bx_writes;
+		copies += bx->bx_copies;
+		errs += bx->bx_errs;
+		lat_cnt += bx->bx_lat_cnt;
+	}
+	ops = reads + writes + copies;
+
+	fprintf(stdout, "Results:\n"
+		"\tops           : "DF_U64" (read "DF_U64", write "DF_U64", copy "DF_U64
+		", error "DF_U64")\n"
+		"\telapsed       : %.2f sec\n"
+		"\tIOPS          : %.0f\n"
+		"\tbandwidth     : %.2f MB/s\n",
+		ops, reads, writes, copies, errs, secs, ops / secs,
+		(double)ops * bp_io_size / secs / (1 << 20));
+
+	if (lat_cnt == 0)
+		return;
+
+	D_ALLOC_ARRAY(lats, lat_cnt);
+	if (lats == NULL)
+		return;
+
+	lat_cnt = 0;
+	for (i = 0; i < bp_xs_nr; i++) {
+		bx = &bp_xstreams[i];
+		memcpy(&lats[lat_cnt], bx->bx_lats, bx->bx_lat_cnt * sizeof(*lats));
+		lat_cnt += bx->bx_lat_cnt;
+	}
+	qsort(lats, lat_cnt, sizeof(*lats), bp_lat_cmp);
+	for (i = 0; i < lat_cnt; i++)
+		lat_sum += lats[i];
+
+#define BP_LAT_PCT(pct)	((double)lats[(uint64_t)((lat_cnt - 1) * (pct) / 100)] / 1000)
+	fprintf(stdout, "Latency (us, %u samples):\n"
+		"\tavg           : %.2f\n"
+		"\tp50           : %.2f\n"
+		"\tp90           : %.2f\n"
+		"\tp99           : %.2f\n"
+		"\tp99.9         : %.2f\n"
+		"\tmax           : %.2f\n",
+		lat_cnt, (double)lat_sum / lat_cnt / 1000, BP_LAT_PCT(50), BP_LAT_PCT(90),
+		BP_LAT_PCT(99), BP_LAT_PCT(99.9), (double)lats[lat_cnt - 1] / 1000);
+#undef BP_LAT_PCT
+	D_FREE(lats);
+}
+
+static void
+bp_print_usage(void)
+{
+	printf("bio_perf -- performance benchmark tool for BIO\n\n"
+	       "Usage: bio_perf [options]\n\n"
+	       "-D pathname\n"
+	       "	Directory for the generated NVMe config and SMD, default %s.\n\n"
+	       "-a [filename]\n"
+	       "	Use AIO bdev backed by the file (default %s), otherwise\n"
+	       "	malloc bdev (hugepages required) is used.\n\n"
+	       "-U	Use io_uring instead of Linux AIO for the file of -a, implies -a\n"
+	       "	(SPDK built with io_uring support required).\n\n"
+	       "-S size\n"
+	       "	Size of the bdev, default (xstreams + 1) GiB.\n\n"
+	       "-M size\n"
+	       "	SPDK hugepage memory size, default 1 GiB plus the malloc bdev size,\n"
+	       "	it must be larger than the malloc bdev.\n\n"
+	       "-o rw|copy\n"
+	       "	Operation, bio_readv/bio_writev or bio_copy, default rw.\n\n"
+	       "-s size\n"
+	       "	I/O size, default 4k.\n\n"
+	       "-r pct\n"
+	       "	Read percentage of rw operation, default 50.\n\n"
+	       "-d depth\n"
+	       "	Concurrent I/O ULTs per xstream, default 1.\n\n"
+	       "-x xstreams\n"
+	       "	Number of xstreams (max %d), default 1.\n\n"
+	       "-t seconds\n"
+	       "	Test duration, default 10.\n\n"
+	       "-n ops\n"
+	       "	Number of operations per ULT, overrides -t.\n\n"
+	       "-B	Map I/O through the bulk cache (rw operation only).\n\n"
+	       "-P depth\n"
+	       "	In-flight segments of pipelined bio_copy, 1 disables pipelining,\n"
+	       "	default 4.\n\n"
+	       "Examples:\n"
+	       "	$ bio_perf -a -x 4 -d 16 -s 16k -r 70 -t 30\n"
+	       "	$ bio_perf -a -o copy -s 8m -P 1 -t 30\n",
+	       bp_dir, bp_aio_file, BP_XS_MAX);
+}
+
+static struct option bp_opts[] = {
+	{ "dir",	required_argument,	NULL,	'D' },
+	{ "aio",	optional_argument,	NULL,	'a' },
+	{ "uring",	no_argument,		NULL,	'U' },
+	{ "bdev_size",	required_argument,	NULL,	'S' },
+	{ "mem_size",	required_argument,	NULL,	'M' },
+	{ "op",		required_argument,	NULL,	'o' },
+	{ "size",	required_argument,	NULL,	's' },
+	{ "read",	required_argument,	NULL,	'r' },
+	{ "depth",	required_argument,	NULL,	'd' },
+	{ "xstreams",	required_argument,	NULL,	'x' },
+	{ "time",	required_argument,	NULL,	't' },
+	{ "num",	required_argument,	NULL,	'n' },
+	{ "bulk",	no_argument,		NULL,	'B' },
+	{ "copy_depth",	required_argument,	NULL,	'P' },
+	{ "help",	no_argument,		NULL,	'h' },
+	{ NULL,		0,			NULL,	0   },
+};
+
+int
+main(int argc, char **argv)
+{
+	struct bp_xstream	*bx;
+	struct bio_xs_context	*self_ctxt;
+	uint64_t		 start;
+	int			 i, rc;
+
+	while ((rc = getopt_long(argc, argv, "D:a::US:M:o:s:r:d:x:t:n:BP:h", bp_opts,
+				 NULL)) != -1) {
+		switch (rc) {
+		case 'D':
+			strncpy(bp_dir, optarg, sizeof(bp_dir) - 1);
+			break;
+		case 'a':
+			bp_aio = true;
+			if (optarg != NULL)
+				strncpy(bp_aio_file, optarg, sizeof(bp_aio_file) - 1);
+			break;
+		case 'U':
+			bp_aio = bp_uring = true;
+			break;
+		case 'S':
+			bp_bdev_mb = bp_parse_size(optarg) >> 20;
+			break;
+		case 'M':
+			bp_mem_mb = bp_parse_size(optarg) >> 20;
+			break;
+		case 'o':
+			if (strcasecmp(optarg, "copy") == 0) {
+				bp_op = BP_OP_COPY;
+			} else if (strcasecmp(optarg, "rw") != 0) {
+				fprintf(stderr, "invalid operation %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 's':
+			bp_io_size = bp_parse_size(optarg);
+			break;
+		case 'r':
+			bp_read_pct = atoi(optarg);
+			break;
+		case 'd':
+			bp_depth = atoi(optarg);
+			break;
+		case 'x':
+			bp_xs_nr = atoi(optarg);
+			break;
+		case 't':
+			bp_secs = atoi(optarg);
+			break;
+		case 'n':
+			bp_ops = strtoull(optarg, NULL, 0);
+			break;
+		case 'B':
+			bp_bulk = true;
+			break;
+		case 'P':
+			setenv("DAOS_NVME_COPY_DEPTH", optarg, 1);
+			break;
+		case 'h':
+			bp_print_usage();
+			return 0;
+		default:
+			bp_print_usage();
+			return -1;
+		}
+	}
+
+	if (bp_io_size == 0 || bp_io_size > BP_BLOB_SZ / 4 || bp_read_pct > 100 ||
+	    bp_depth == 0 || bp_xs_nr == 0 || bp_xs_nr > BP_XS_MAX ||
+	    (bp_ops == 0 && bp_secs == 0) || (bp_bulk && bp_op == BP_OP_COPY)) {
+		fprintf(stderr, "invalid arguments\n");
+		bp_print_usage();
+		return -1;
+	}
+
+	if (bp_bdev_mb == 0)
+		bp_bdev_mb = (uint64_t)(bp_xs_nr + 1) * (BP_BLOB_SZ >> 20);
+	if (bp_mem_mb == 0)
+		bp_mem_mb = 1024 + (bp_aio ? 0 : bp_bdev_mb);
+	/* The malloc bdev is allocated from the SPDK memory */
+	if (!bp_aio && bp_bdev_mb >= bp_mem_mb) {
+		fprintf(stderr, "SPDK memory "DF_U64" MB can't hold the malloc bdev\n",
+			(uint64_t)bp_mem_mb);
+		return -1;
+	}
+
+	rc = bp_write_conf();
+	if (rc)
+		return rc;
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc) {
+		fprintf(stderr, "failed to init debug: "DF_RC"\n", DP_RC(rc));
+		return rc;
+	}
+
+	/*
+	 * Standalone VOS initializes the SPDK env with the generated config,
+	 * and creates a self polling NVMe context (target 0) for main thread,
+	 * which owns the blobstore and must keep polling during the test.
+	 */
+	rc = vos_self_init(bp_dir, false, 0);
+	if (rc) {
+		fprintf(stderr, "failed to init standalone VOS: "DF_RC"\n", DP_RC(rc));
+		goto out_debug;
+	}
+	self_ctxt = vos_xsctxt_get();
+	bio_register_bulk_ops(bp_bulk_create, bp_bulk_free);
+
+	fprintf(stdout, "Test :\n\tBIO %s%s\n"
+		"Parameters :\n"
+		"\tbdev          : %s (%s), "DF_U64" MB\n"
+		"\tI/O size      : %u\n"
+		"\tread          : %u%%\n"
+		"\txstreams      : %u\n"
+		"\tdepth         : %u\n",
+		bp_op == BP_OP_COPY ? "copy" : "readv/writev", bp_bulk ? " (bulk cache)" : "",
+		bp_aio ? (bp_uring ? "io_uring" : "AIO") : "malloc",
+		bp_aio ? bp_aio_file : "hugepages", bp_bdev_mb,
+		bp_io_size, bp_op == BP_OP_COPY ? 0 : bp_read_pct, bp_xs_nr, bp_depth);
+
+	start = daos_get_ntime();
+	bp_end_ns = start + (uint64_t)bp_secs * NSEC_PER_SEC;
+
+	for (i = 0; i < bp_xs_nr; i++) {
+		bx = &bp_xstreams[i];
+		bx->bx_id = i;
+		bx->bx_xstream = ABT_XSTREAM_NULL;
+
+		rc = ABT_xstream_create(ABT_SCHED_NULL, &bx->bx_xstream);
+		if (rc == ABT_SUCCESS)
+			rc = ABT_thread_create_on_xstream(bx->bx_xstream, bp_xstream_ult, bx,
+							  ABT_THREAD_ATTR_NULL, &bx->bx_thread);
+		if (rc != ABT_SUCCESS) {
+			fprintf(stderr, "failed to start xstream %d: %d\n", i, rc);
+			bx->bx_rc = -DER_NOMEM;
+			atomic_fetch_add_relaxed(&bp_xs_done, 1);
+		}
+	}
+
+	/* Poll the blobstore owner context until all xstreams are done */
+	while (atomic_load_relaxed(&bp_xs_done) < bp_xs_nr)
+		bio_nvme_poll(self_ctxt);
+
+	bp_report(daos_get_ntime() - start);
+
+	rc = 0;
+	for (i = 0; i < bp_xs_nr; i++) {
+		bx = &bp_xstreams[i];
+		if (bx->bx_xstream != ABT_XSTREAM_NULL) {
+			ABT_thread_free(&bx->bx_thread);
+			ABT_xstream_join(bx->bx_xstream);
+			ABT_xstream_free(&bx->bx_xstream);
+		}
+		D_FREE(bx->bx_lats);
+		if (bx->bx_rc != 0 && rc == 0)
+			rc = bx->bx_rc;
+	}
+
+	vos_self_fini();
+out_debug:
+	daos_debug_fini();
+	return rc;
+}
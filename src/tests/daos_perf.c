@@ -31,6 +31,8 @@ enum {
 
 int	ts_mode = TS_MODE_DAOS;
 int	ts_class = OC_SX;
+/* Number of objects updated or fetched by one batched call, 0 for per-object I/O */
+static unsigned int ts_batch;
 
 static int
 daos_update_or_fetch(int obj_idx, enum ts_op_type op_type,
@@ -59,6 +61,133 @@ daos_update_or_fetch(int obj_idx, enum ts_op_type op_type,
 	return rc;
 }
 
+/* I/O descriptors of one operation of a batch */
+struct batch_io {
+	daos_iod_t	bi_iod;
+	daos_recx_t	bi_recx;
+	d_sg_list_t	bi_sgl;
+	d_iov_t		bi_iov;
+};
+
+static void
+batch_io_setup(struct batch_io *bio, enum ts_op_type op_type, daos_key_t *akey,
+	       int idx, char *buf, struct pf_param *param)
+{
+	daos_iod_t	*iod = &bio->bi_iod;
+	daos_recx_t	*recx = &bio->bi_recx;
+
+	d_iov_set(&iod->iod_name, akey->iov_buf, akey->iov_len);
+	if (ts_single) {
+		iod->iod_type = DAOS_IOD_SINGLE;
+		iod->iod_size = param->pa_rw.size;
+		recx->rx_nr   = 1;
+		recx->rx_idx  = 0;
+	} else {
+		iod->iod_type = DAOS_IOD_ARRAY;
+		iod->iod_size = 1;
+		recx->rx_nr   = param->pa_rw.size;
+		recx->rx_idx  = ts_indices[idx] * ts_stride + param->pa_rw.offset;
+	}
+	iod->iod_nr    = 1;
+	iod->iod_recxs = recx;
+	iod->iod_flags = 0;
+
+	if (op_type == TS_DO_UPDATE)
+		stride_buf_load(buf, param->pa_rw.offset, param->pa_rw.size);
+	d_iov_set(&bio->bi_iov, buf, param->pa_rw.size);
+	bio->bi_sgl.sg_iovs = &bio->bi_iov;
+	bio->bi_sgl.sg_nr = 1;
+	bio->bi_sgl.sg_nr_out = 0;
+}
+
+/* Issue the I/O of the same dkey/akey/recx for all objects, ts_batch objects per call */
+static int
+objects_rw_batch_one(enum ts_op_type op_type, daos_key_t *dkey, daos_key_t *akey, int idx,
+		     daos_obj_batch_op_t *ops, struct batch_io *bios, char *bufs,
+		     struct pf_param *param)
+{
+	uint64_t	start = 0;
+	int		obj_idx;
+	int		nr;
+	int		i;
+	int		rc;
+
+	for (obj_idx = 0; obj_idx < param->pa_obj_nr; obj_idx += nr) {
+		nr = min(ts_batch, (unsigned int)(param->pa_obj_nr - obj_idx));
+		for (i = 0; i < nr; i++) {
+			batch_io_setup(&bios[i], op_type, akey, idx,
+				       &bufs[i * param->pa_rw.size], param);
+			ops[i].bo_oh   = ts_ohs[obj_idx + i];
+			ops[i].bo_dkey = dkey;
+			ops[i].bo_nr   = 1;
+			ops[i].bo_iods = &bios[i].bi_iod;
+			ops[i].bo_sgls = &bios[i].bi_sgl;
+		}
+
+		TS_TIME_START(&param->pa_duration, start);
+		if (op_type == TS_DO_UPDATE)
+			rc = daos_obj_update_batch(ops, nr, NULL);
+		else
+			rc = daos_obj_fetch_batch(ops, nr, NULL);
+		TS_TIME_END(&param->pa_duration, start);
+		if (rc != 0) {
+			fprintf(stderr, "Batched %s failed. rc=%d\n",
+				op_type == TS_DO_FETCH ? "fetch" : "update", rc);
+			return rc;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Same I/O pattern as objects_update()/objects_fetch(), but the I/O of up to ts_batch
+ * objects is submitted by one daos_obj_update_batch()/daos_obj_fetch_batch() call.
+ */
+static int
+objects_rw_batch(enum ts_op_type op_type, struct pf_param *param)
+{
+	daos_obj_batch_op_t	*ops;
+	struct batch_io		*bios;
+	char			*bufs;
+	int			 akey_idx;
+	int			 i, j, k;
+	int			 rc = 0;
+
+	ops = calloc(ts_batch, sizeof(*ops));
+	bios = calloc(ts_batch, sizeof(*bios));
+	bufs = calloc(ts_batch, param->pa_rw.size);
+	if (!ops || !bios || !bufs) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
+
+	if (op_type == TS_DO_UPDATE)
+		stride_buf_set(param->pa_rw.offset, param->pa_rw.size);
+
+	if (!ts_indices) {
+		ts_indices = dts_rand_iarr_alloc_set(ts_recx_p_akey, 0, ts_random);
+		D_ASSERT(ts_indices != NULL);
+	}
+
+	for (i = 0; i < param->pa_dkey_nr; i++) {
+		for (j = 0; j < param->pa_akey_nr; j++) {
+			akey_idx = ts_const_akey ? 0 : j;
+			for (k = 0; k < param->pa_recx_nr; k++) {
+				rc = objects_rw_batch_one(op_type, &ts_dkeys[i],
+							  &ts_akeys[akey_idx], k, ops,
+							  bios, bufs, param);
+				if (rc)
+					goto out;
+			}
+		}
+	}
+out:
+	free(ops);
+	free(bios);
+	free(bufs);
+	return rc;
+}
+
 static int
 objects_open(void)
 {
@@ -113,7 +242,10 @@ pf_update(struct pf_test *ts, struct pf_param *param)
 	if (rc)
 		return rc;
 
-	rc = objects_update(param);
+	if (ts_batch > 0 && ts_mode == TS_MODE_DAOS)
+		rc = objects_rw_batch(TS_DO_UPDATE, param);
+	else
+		rc = objects_update(param);
 	if (rc)
 		return rc;
 
@@ -131,7 +263,10 @@ pf_fetch(struct pf_test *ts, struct pf_param *param)
 		return rc;
 
 	param->pa_rw.verify = false;
-	rc = objects_fetch(param);
+	if (ts_batch > 0 && ts_mode == TS_MODE_DAOS)
+		rc = objects_rw_batch(TS_DO_FETCH, param);
+	else
+		rc = objects_fetch(param);
 	if (rc)
 		return rc;
 
@@ -290,6 +425,11 @@ const char perf_daos_usage[] = "\n"
 "	Object class for DAOS full stack test.\n\n"
 "-g dmg_conf\n"
 "	dmg configuration file.\n\n"
+"-B number\n"
+"	Batch size. Update and fetch tests issue the I/O of up to this number\n"
+"	of objects with one daos_obj_update_batch()/daos_obj_fetch_batch()\n"
+"	call, which suits the ops/sec test of tiny objects (e.g. -c TINY\n"
+"	-s 64). The calls are synchronous and credits are ignored.\n\n"
 "Examples:\n"
 "	$ daos_perf -C 16 -A -R 'U;p F;i=5;p V'\n";
 
@@ -309,10 +449,11 @@ const struct option perf_daos_opts[] = {
 	{ "credits",	required_argument,	NULL,	'C' },
 	{ "class",	required_argument,	NULL,	'c' },
 	{ "dmg_conf",	required_argument,	NULL,	'g' },
+	{ "batch",	required_argument,	NULL,	'B' },
 	{ NULL,		0,			NULL,	0   },
 };
 
-const char perf_daos_optstr[] = "T:C:c:g:";
+const char perf_daos_optstr[] = "T:C:c:g:B:";
 
 int
 main(int argc, char **argv)
@@ -381,6 +522,9 @@ main(int argc, char **argv)
 		case 'g':
 			dmg_conf = optarg;
 			break;
+		case 'B':
+			ts_batch = strtoul(optarg, &endp, 0);
+			break;
 		}
 	}
 
@@ -471,6 +615,7 @@ main(int argc, char **argv)
 			"Parameters :\n"
 			"\tpool size     : SCM: %u MB, NVMe: %u MB\n"
 			"\tcredits       : %d (sync I/O for -ve)\n"
+			"\tbatch         : %u\n"
 			"\tobj_per_cont  : %u x %d (procs)\n"
 			"\tdkey_per_obj  : %u (%s)\n"
 			"\takey_per_dkey : %u\n"
@@ -481,6 +626,7 @@ main(int argc, char **argv)
 			(unsigned int)(ts_scm_size >> 20),
 			(unsigned int)(ts_nvme_size >> 20),
 			credits,
+			ts_batch,
 			ts_obj_p_cont,
 			ts_ctx.tsc_mpi_size,
 			ts_dkey_p_obj, ts_dkey_prefix == NULL ? "int" : "buf",
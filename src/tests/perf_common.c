@@ -152,13 +152,13 @@ stride_buf_op(int opc, char *buf, unsigned offset, int size)
 	return 0;
 }
 
-static void
+void
 stride_buf_set(unsigned offset, int size)
 {
 	stride_buf_op(STRIDE_BUF_SET, NULL, offset, size);
 }
 
-static void
+void
 stride_buf_load(char *buf, unsigned offset, int size)
 {
 	stride_buf_op(STRIDE_BUF_LOAD, buf, offset, size);
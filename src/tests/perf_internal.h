@@ -104,6 +104,7 @@ extern bool		ts_oid_init;
 extern daos_handle_t	*ts_ohs;
 extern daos_obj_id_t	*ts_oids;
 extern daos_key_t	*ts_dkeys;
+extern daos_key_t	*ts_akeys;
 extern uint64_t		*ts_indices;
 
 extern struct credit_context	ts_ctx;
@@ -195,6 +196,10 @@ void
 stride_buf_init(int size);
 void
 stride_buf_fini(void);
+void
+stride_buf_set(unsigned offset, int size);
+void
+stride_buf_load(char *buf, unsigned offset, int size);
 int
 objects_update(struct pf_param *param);
 int
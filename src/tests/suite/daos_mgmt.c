@@ -396,6 +396,22 @@ pool_create_and_destroy_retry(void **state)
 	print_message("success\n");
 }
 
+static void
+coll_bench(void **state)
+{
+	test_arg_t	*arg = *state;
+	int		 rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	/* The latencies are printed by the engines */
+	print_message("measuring collective latency on all engines ... ");
+	rc = daos_debug_set_params(arg->group, -1, DMG_KEY_COLL_BENCH, 1000, 0, NULL);
+	assert_rc_equal(rc, 0);
+	print_message("success\n");
+}
+
 static const struct CMUnitTest tests[] = {
 	{ "MGMT1: create/destroy pool on all tgts",
 	  pool_create_all, async_disable, test_case_teardown},
@@ -406,7 +422,9 @@ static const struct CMUnitTest tests[] = {
 	{ "MGMT4: list-pools with multiple pools in sys",
 	  list_pools_test, setup_manypools, teardown_pools},
 	{ "MGMT5: retry MGMT_POOL_{CREATE,DESETROY} upon errors",
-	  pool_create_and_destroy_retry, async_disable, test_case_teardown}
+	  pool_create_and_destroy_retry, async_disable, test_case_teardown},
+	{ "MGMT6: collective latency against target count and fan-out branch",
+	  coll_bench, async_disable, test_case_teardown}
 };
 
 static int
@@ -4753,6 +4753,567 @@ io_tx_convert(void **state)
 	ioreq_fini(&req);
 }
 
+#define HEDGE_PRIME_NR	100
+
+static void
+io_hedge_slow_replica(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	uint64_t	 start;
+	uint64_t	 elapsed;
+	uint64_t	 issued[2];
+	uint64_t	 won[2];
+	char		 fetch_buf[32];
+	char		 update_buf[32];
+	int		 i;
+	int		 rc;
+
+	FAULT_INJECTION_REQUIRED();
+
+	/* needs at lest 2 targets */
+	if (!test_runable(arg, 2))
+		skip();
+
+	oid = daos_test_oid_gen(arg->coh, DAOS_OC_R2S_SPEC_RANK, 0, 0,
+				arg->myrank);
+	oid = dts_oid_set_rank(oid, 0);
+
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+	rc = daos_obj_close(req.oh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW | DAOS_OO_HEDGE, &req.oh,
+			   NULL);
+	assert_rc_equal(rc, 0);
+
+	/** Insert */
+	dts_buf_render(update_buf, 32);
+	insert_single("d_key_hedge", "a_key_hedge", 0, update_buf,
+		      32, DAOS_TX_NONE, &req);
+
+	/* Enough fetch latency samples to set the hedge delay */
+	print_message("Prime the hedge delay with %d fetches\n", HEDGE_PRIME_NR);
+	for (i = 0; i < HEDGE_PRIME_NR; i++) {
+		memset(fetch_buf, 0, 32);
+		lookup_single("d_key_hedge", "a_key_hedge", 0, fetch_buf,
+			      32, DAOS_TX_NONE, &req);
+		assert_memory_equal(update_buf, fetch_buf, 32);
+	}
+
+	/* Slow down the replica on rank 0, the primary fetch reads from it */
+	if (arg->myrank == 0)
+		daos_debug_set_params(arg->group, 0, DMG_KEY_FAIL_LOC,
+				      DAOS_OBJ_FETCH_DELAY | DAOS_FAIL_ONCE,
+				      0, NULL);
+	sleep(3);
+	daos_fail_loc_set(DAOS_OBJ_TRY_SPECIAL_SHARD | DAOS_FAIL_ONCE);
+	daos_fail_value_set(0);
+
+	print_message("Fetch with the slow replica\n");
+	dc_obj_hedge_query(&issued[0], &won[0]);
+	memset(fetch_buf, 0, 32);
+	start = daos_get_ntime();
+	lookup_single("d_key_hedge", "a_key_hedge", 0, fetch_buf,
+		      32, DAOS_TX_NONE, &req);
+	elapsed = daos_get_ntime() - start;
+	assert_memory_equal(update_buf, fetch_buf, 32);
+	dc_obj_hedge_query(&issued[1], &won[1]);
+
+	/* The hedge read the other replica without waiting for the slow one */
+	print_message("Fetch took "DF_U64" ms, hedge issued "DF_U64", won "
+		      DF_U64"\n", elapsed / NSEC_PER_MSEC, issued[1] - issued[0],
+		      won[1] - won[0]);
+	assert_true(elapsed < 2 * NSEC_PER_SEC);
+	assert_true(issued[1] > issued[0]);
+	assert_true(won[1] > won[0]);
+
+	if (arg->myrank == 0)
+		daos_debug_set_params(arg->group, 0, DMG_KEY_FAIL_LOC, 0, 0,
+				      NULL);
+	ioreq_fini(&req);
+}
+
+#define BATCH_OBJ_NR	8
+#define BATCH_OP_NR	256
+/* More than the 128 requests of one batch RPC go to the same target */
+#define BATCH_SAME_NR	160
+#define BATCH_VAL_SIZE	32
+#define BATCH_FAIL_IDX	200
+
+struct batch_ctx {
+	daos_handle_t		ohs[BATCH_OBJ_NR];
+	daos_obj_batch_op_t	ops[BATCH_OP_NR];
+	daos_key_t		dkeys[BATCH_OP_NR];
+	daos_iod_t		iods[BATCH_OP_NR];
+	d_sg_list_t		sgls[BATCH_OP_NR];
+	d_iov_t			iovs[BATCH_OP_NR];
+	char			dkey_bufs[BATCH_OP_NR][32];
+	char			bufs[BATCH_OP_NR][BATCH_VAL_SIZE];
+	char			fetch_bufs[BATCH_OP_NR][BATCH_VAL_SIZE];
+};
+
+static void
+batch_ops_init(struct batch_ctx *ctx, bool update)
+{
+	int	i;
+
+	for (i = 0; i < BATCH_OP_NR; i++) {
+		ctx->iods[i].iod_type = DAOS_IOD_SINGLE;
+		ctx->iods[i].iod_size = update ? BATCH_VAL_SIZE : DAOS_REC_ANY;
+		ctx->iods[i].iod_nr = 1;
+		ctx->iods[i].iod_recxs = NULL;
+		d_iov_set(&ctx->iods[i].iod_name, "akey", strlen("akey"));
+
+		if (update) {
+			d_iov_set(&ctx->iovs[i], ctx->bufs[i], BATCH_VAL_SIZE);
+		} else {
+			memset(ctx->fetch_bufs[i], 0, BATCH_VAL_SIZE);
+			d_iov_set(&ctx->iovs[i], ctx->fetch_bufs[i], BATCH_VAL_SIZE);
+		}
+		ctx->sgls[i].sg_nr = 1;
+		ctx->sgls[i].sg_nr_out = 0;
+		ctx->sgls[i].sg_iovs = &ctx->iovs[i];
+
+		ctx->ops[i].bo_oh = ctx->ohs[i < BATCH_SAME_NR ? 0 : i % BATCH_OBJ_NR];
+		ctx->ops[i].bo_dkey = &ctx->dkeys[i];
+		ctx->ops[i].bo_nr = 1;
+		ctx->ops[i].bo_iods = &ctx->iods[i];
+		ctx->ops[i].bo_sgls = &ctx->sgls[i];
+		ctx->ops[i].bo_rc = -DER_INVAL;
+	}
+}
+
+static void
+batch_fetch_verify(struct batch_ctx *ctx, int fail_idx)
+{
+	int	i;
+
+	for (i = 0; i < BATCH_OP_NR; i++) {
+		if (i == fail_idx) {
+			assert_rc_equal(ctx->ops[i].bo_rc, -DER_REC2BIG);
+			continue;
+		}
+		assert_rc_equal(ctx->ops[i].bo_rc, 0);
+		assert_int_equal(ctx->iods[i].iod_size, BATCH_VAL_SIZE);
+		assert_memory_equal(ctx->bufs[i], ctx->fetch_bufs[i], BATCH_VAL_SIZE);
+	}
+}
+
+static struct batch_ctx *
+batch_ctx_open(test_arg_t *arg)
+{
+	struct batch_ctx	*ctx;
+	daos_obj_id_t		 oid;
+	int			 i;
+	int			 rc;
+
+	D_ALLOC_PTR(ctx);
+	assert_non_null(ctx);
+
+	/* Objects on different targets, so a batch is split per target */
+	for (i = 0; i < BATCH_OBJ_NR; i++) {
+		oid = daos_test_oid_gen(arg->coh, dts_obj_class, 0, 0, arg->myrank);
+		rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &ctx->ohs[i], NULL);
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < BATCH_OP_NR; i++) {
+		snprintf(ctx->dkey_bufs[i], sizeof(ctx->dkey_bufs[i]), "batch_dkey_%d", i);
+		d_iov_set(&ctx->dkeys[i], ctx->dkey_bufs[i], strlen(ctx->dkey_bufs[i]));
+		dts_buf_render(ctx->bufs[i], BATCH_VAL_SIZE);
+	}
+	return ctx;
+}
+
+static void
+batch_ctx_close(struct batch_ctx *ctx)
+{
+	int	i;
+	int	rc;
+
+	for (i = 0; i < BATCH_OBJ_NR; i++) {
+		rc = daos_obj_close(ctx->ohs[i], NULL);
+		assert_rc_equal(rc, 0);
+	}
+	D_FREE(ctx);
+}
+
+static void
+batch_update(struct batch_ctx *ctx)
+{
+	int	i;
+	int	rc;
+
+	print_message("Batched update of %d values\n", BATCH_OP_NR);
+	batch_ops_init(ctx, true);
+	rc = daos_obj_update_batch(ctx->ops, BATCH_OP_NR, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < BATCH_OP_NR; i++)
+		assert_rc_equal(ctx->ops[i].bo_rc, 0);
+}
+
+static void
+io_batch(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct batch_ctx	*ctx;
+	uint64_t		 rpcs[2];
+	uint64_t		 reqs[2];
+	uint64_t		 fallbacks[2];
+	int			 rc;
+
+	ctx = batch_ctx_open(arg);
+
+	dc_obj_batch_query(&rpcs[0], &reqs[0], &fallbacks[0]);
+	batch_update(ctx);
+	dc_obj_batch_query(&rpcs[1], &reqs[1], &fallbacks[1]);
+
+	/* The requests are packed, a single request is never sent as batch RPC */
+	print_message("batch RPCs "DF_U64", requests "DF_U64"\n", rpcs[1] - rpcs[0],
+		      reqs[1] - reqs[0]);
+	assert_true(rpcs[1] > rpcs[0]);
+	assert_true(reqs[1] - reqs[0] >= 2 * (rpcs[1] - rpcs[0]));
+	assert_true(reqs[1] - reqs[0] <= BATCH_OP_NR);
+	assert_int_equal(fallbacks[1], fallbacks[0]);
+
+	print_message("Batched fetch and verify\n");
+	batch_ops_init(ctx, false);
+	rc = daos_obj_fetch_batch(ctx->ops, BATCH_OP_NR, NULL);
+	assert_rc_equal(rc, 0);
+	batch_fetch_verify(ctx, -1);
+
+	/* The failure of one operation doesn't fail the others of the batch */
+	print_message("Batched fetch with one too small buffer\n");
+	batch_ops_init(ctx, false);
+	d_iov_set(&ctx->iovs[BATCH_FAIL_IDX], ctx->fetch_bufs[BATCH_FAIL_IDX],
+		  BATCH_VAL_SIZE - 1);
+	rc = daos_obj_fetch_batch(ctx->ops, BATCH_OP_NR, NULL);
+	assert_rc_equal(rc, -DER_REC2BIG);
+	batch_fetch_verify(ctx, BATCH_FAIL_IDX);
+
+	batch_ctx_close(ctx);
+}
+
+static void
+io_batch_unreg(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct batch_ctx	*ctx;
+	uint64_t		 rpcs[2];
+	uint64_t		 reqs[2];
+	uint64_t		 fallbacks[2];
+	int			 rc;
+
+	FAULT_INJECTION_REQUIRED();
+
+	ctx = batch_ctx_open(arg);
+	batch_update(ctx);
+
+	/* The requests of a batch RPC are sent individually once it's unknown */
+	print_message("Batched fetch with the batch RPC unsupported\n");
+	batch_ops_init(ctx, false);
+	dc_obj_batch_query(&rpcs[0], &reqs[0], &fallbacks[0]);
+	daos_fail_loc_set(DAOS_OBJ_BATCH_UNREG | DAOS_FAIL_ONCE);
+	rc = daos_obj_fetch_batch(ctx->ops, BATCH_OP_NR, NULL);
+	daos_fail_loc_set(0);
+	assert_rc_equal(rc, 0);
+	batch_fetch_verify(ctx, -1);
+	dc_obj_batch_query(&rpcs[1], &reqs[1], &fallbacks[1]);
+	assert_int_equal(fallbacks[1] - fallbacks[0], 1);
+
+	batch_ctx_close(ctx);
+}
+
+#define QOS_HELD_NR	8
+#define QOS_VAL_SIZE	16
+
+/* Set the per-container QoS IOPS limit to \a tgt_iops on each target of the pool */
+static void
+qos_cont_iops_set(test_arg_t *arg, uint64_t tgt_iops)
+{
+	daos_pool_info_t	info = {0};
+	char			limit[32];
+	int			rc;
+
+	rc = daos_pool_query(arg->pool.poh, NULL, &info, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	snprintf(limit, sizeof(limit), DF_U64, tgt_iops * info.pi_ntargets);
+	rc = daos_pool_set_prop(arg->pool.pool_uuid, "qos_cont_iops", limit);
+	assert_rc_equal(rc, 0);
+	/* The property is propagated to the targets lazily */
+	sleep(3);
+}
+
+static void
+qos_update(daos_handle_t oh, char *buf, daos_event_t *ev)
+{
+	daos_key_t	dkey;
+	daos_iod_t	iod = {0};
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	int		rc;
+
+	d_iov_set(&dkey, "qos_dkey", strlen("qos_dkey"));
+	d_iov_set(&iod.iod_name, "qos_akey", strlen("qos_akey"));
+	iod.iod_type = DAOS_IOD_SINGLE;
+	iod.iod_size = QOS_VAL_SIZE;
+	iod.iod_nr = 1;
+	d_iov_set(&iov, buf, QOS_VAL_SIZE);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+
+	rc = daos_obj_update(oh, DAOS_TX_NONE, 0, &dkey, 1, &iod, &sgl, ev);
+	assert_rc_equal(rc, 0);
+}
+
+/* Wait for the \a nr updates issued with \a evs, they must all succeed */
+static void
+qos_update_wait(test_arg_t *arg, daos_event_t *evs, int nr)
+{
+	daos_event_t	*evp;
+	int		 i;
+	int		 rc;
+
+	for (i = 0; i < nr; i++) {
+		rc = daos_eq_poll(arg->eq, 1, DAOS_EQ_WAIT, 1, &evp);
+		assert_int_equal(rc, 1);
+		assert_rc_equal(evp->ev_error, 0);
+	}
+
+	for (i = 0; i < nr; i++) {
+		rc = daos_event_fini(&evs[i]);
+		assert_rc_equal(rc, 0);
+	}
+}
+
+#define QOS_RATE_NR	6
+
+/* The requests exceeding the QoS limit are held, then released as tokens refill */
+static void
+io_qos_hold(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_event_t	 evs[QOS_RATE_NR];
+	daos_handle_t	 oh;
+	daos_obj_id_t	 oid;
+	char		 buf[QOS_VAL_SIZE];
+	uint64_t	 start;
+	uint64_t	 elapsed;
+	int		 i;
+	int		 rc;
+
+	par_barrier(PAR_COMM_WORLD);
+	if (arg->myrank != 0)
+		goto out;
+
+	oid = daos_test_oid_gen(arg->coh, OC_S1, 0, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+	dts_buf_render(buf, QOS_VAL_SIZE);
+
+	print_message("Limit the container to 2 op/s per target\n");
+	qos_cont_iops_set(arg, 2);
+
+	print_message("Issue %d updates at once\n", QOS_RATE_NR);
+	start = daos_get_ntime();
+	for (i = 0; i < QOS_RATE_NR; i++) {
+		rc = daos_event_init(&evs[i], arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+		qos_update(oh, buf, &evs[i]);
+	}
+	qos_update_wait(arg, evs, QOS_RATE_NR);
+	elapsed = daos_get_ntime() - start;
+
+	/* One token for the burst, then a token per 500ms */
+	print_message("Updates took "DF_U64" ms\n", elapsed / NSEC_PER_MSEC);
+	assert_true(elapsed >= 2 * NSEC_PER_SEC);
+	assert_true(elapsed < 10 * NSEC_PER_SEC);
+
+	qos_cont_iops_set(arg, 0);
+
+	print_message("Issue %d updates without limit\n", QOS_RATE_NR);
+	start = daos_get_ntime();
+	for (i = 0; i < QOS_RATE_NR; i++) {
+		rc = daos_event_init(&evs[i], arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+		qos_update(oh, buf, &evs[i]);
+	}
+	qos_update_wait(arg, evs, QOS_RATE_NR);
+	elapsed = daos_get_ntime() - start;
+	print_message("Updates took "DF_U64" ms\n", elapsed / NSEC_PER_MSEC);
+	assert_true(elapsed < 2 * NSEC_PER_SEC);
+
+	rc = daos_obj_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+out:
+	par_barrier(PAR_COMM_WORLD);
+}
+
+/*
+ * The requests held by the QoS limits of one container are delayed on purpose,
+ * they must not get the I/O of another container on the same target rejected by
+ * the admission control.
+ */
+static void
+io_qos_admit(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_event_t	 evs[QOS_HELD_NR];
+	daos_handle_t	 coh;
+	daos_handle_t	 oh_held;
+	daos_handle_t	 oh;
+	daos_obj_id_t	 oid;
+	uuid_t		 uuid;
+	char		 str[37];
+	char		 buf[QOS_VAL_SIZE];
+	uint64_t	 start;
+	uint64_t	 elapsed;
+	int		 i;
+	int		 rc;
+
+	par_barrier(PAR_COMM_WORLD);
+	if (arg->myrank != 0)
+		goto out;
+
+	rc = daos_cont_create(arg->pool.poh, &uuid, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	uuid_unparse(uuid, str);
+	rc = daos_cont_open(arg->pool.poh, str, DAOS_COO_RW, &coh, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	/* Same single shard object in both containers, so on the same target */
+	oid = daos_test_oid_gen(arg->coh, OC_S1, 0, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &oh_held, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_obj_open(coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+	dts_buf_render(buf, QOS_VAL_SIZE);
+
+	print_message("Limit each container to 1 op/s per target, admit delay 100ms\n");
+	qos_cont_iops_set(arg, 1);
+	rc = daos_debug_set_params(arg->group, -1, DMG_KEY_SCHED_ADMIT_DELAY, 100, 0, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("Issue %d updates to the throttled container\n", QOS_HELD_NR);
+	for (i = 0; i < QOS_HELD_NR; i++) {
+		rc = daos_event_init(&evs[i], arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+		qos_update(oh_held, buf, &evs[i]);
+	}
+	/* The held requests have been queued for much longer than the admit delay */
+	sleep(1);
+
+	print_message("Update the other container\n");
+	start = daos_get_ntime();
+	qos_update(oh, buf, NULL);
+	elapsed = daos_get_ntime() - start;
+	print_message("Update took "DF_U64" ms\n", elapsed / NSEC_PER_MSEC);
+	assert_true(elapsed < NSEC_PER_SEC);
+
+	/* The held requests are all released eventually */
+	qos_update_wait(arg, evs, QOS_HELD_NR);
+
+	rc = daos_debug_set_params(arg->group, -1, DMG_KEY_SCHED_ADMIT_DELAY, 0, 0, NULL);
+	assert_rc_equal(rc, 0);
+	qos_cont_iops_set(arg, 0);
+
+	rc = daos_obj_close(oh_held, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_obj_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_close(coh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_destroy(arg->pool.poh, str, 0, NULL);
+	assert_rc_equal(rc, 0);
+out:
+	par_barrier(PAR_COMM_WORLD);
+}
+
+#define REPLICA_PRIME_NR	32
+#define REPLICA_FETCH_NR	64
+
+static void
+io_replica_slow(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	uint64_t	 least[2];
+	uint64_t	 explored[2];
+	uint64_t	 picked[2];
+	char		 fetch_buf[32];
+	char		 update_buf[32];
+	int		 i;
+
+	FAULT_INJECTION_REQUIRED();
+
+	/* needs at least 2 targets */
+	if (!test_runable(arg, 2))
+		skip();
+
+	/* The fail_loc on the engine is shared by all clients */
+	if (arg->myrank != 0)
+		goto out;
+
+	oid = daos_test_oid_gen(arg->coh, DAOS_OC_R2S_SPEC_RANK, 0, 0,
+				arg->myrank);
+	oid = dts_oid_set_rank(oid, 0);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+
+	dts_buf_render(update_buf, 32);
+	insert_single("d_key_replica", "a_key_replica", 0, update_buf,
+		      32, DAOS_TX_NONE, &req);
+
+	/* Both replicas are measured */
+	print_message("Prime the replica latency with %d fetches\n",
+		      REPLICA_PRIME_NR);
+	for (i = 0; i < REPLICA_PRIME_NR; i++) {
+		memset(fetch_buf, 0, 32);
+		lookup_single("d_key_replica", "a_key_replica", 0, fetch_buf,
+			      32, DAOS_TX_NONE, &req);
+		assert_memory_equal(update_buf, fetch_buf, 32);
+	}
+
+	/* One slow fetch from the replica on rank 0 */
+	daos_debug_set_params(arg->group, 0, DMG_KEY_FAIL_LOC,
+			      DAOS_OBJ_FETCH_DELAY | DAOS_FAIL_ONCE, 0, NULL);
+	sleep(3);
+	daos_fail_loc_set(DAOS_OBJ_TRY_SPECIAL_SHARD | DAOS_FAIL_ONCE);
+	daos_fail_value_set(0);
+	print_message("Fetch from the slow replica\n");
+	memset(fetch_buf, 0, 32);
+	lookup_single("d_key_replica", "a_key_replica", 0, fetch_buf,
+		      32, DAOS_TX_NONE, &req);
+	assert_memory_equal(update_buf, fetch_buf, 32);
+	daos_debug_set_params(arg->group, 0, DMG_KEY_FAIL_LOC, 0, 0, NULL);
+
+	dc_obj_replica_query(0, &least[0], &explored[0], &picked[0]);
+	print_message("Fetch %d times after the slow one\n", REPLICA_FETCH_NR);
+	for (i = 0; i < REPLICA_FETCH_NR; i++) {
+		memset(fetch_buf, 0, 32);
+		lookup_single("d_key_replica", "a_key_replica", 0, fetch_buf,
+			      32, DAOS_TX_NONE, &req);
+		assert_memory_equal(update_buf, fetch_buf, 32);
+	}
+	dc_obj_replica_query(0, &least[1], &explored[1], &picked[1]);
+
+	print_message("least loaded "DF_U64", explored "DF_U64", rank 0 "
+		      DF_U64"\n", least[1] - least[0], explored[1] - explored[0],
+		      picked[1] - picked[0]);
+	assert_int_equal(least[1] - least[0] + explored[1] - explored[0],
+			 REPLICA_FETCH_NR);
+	assert_true(least[1] > least[0]);
+	/* Only the random exploration goes to the slow replica */
+	assert_true(picked[1] - picked[0] <= explored[1] - explored[0]);
+
+	ioreq_fini(&req);
+out:
+	par_barrier(PAR_COMM_WORLD);
+}
+
 static const struct CMUnitTest io_tests[] = {
 	{ "IO1: simple update/fetch/verify",
 	  io_simple, async_disable, test_case_teardown},
@@ -4848,6 +5409,18 @@ static const struct CMUnitTest io_tests[] = {
 	  enum_recxs_with_aggregation, async_disable, test_case_teardown},
 	{ "IO46: tx convert",
 	  io_tx_convert, async_disable, test_case_teardown},
+	{ "IO47: hedged fetch with a slow replica",
+	  io_hedge_slow_replica, async_disable, test_case_teardown},
+	{ "IO48: batched fetch/update of small values",
+	  io_batch, async_disable, test_case_teardown},
+	{ "IO49: QoS held requests don't trigger admission control",
+	  io_qos_admit, async_disable, test_case_teardown},
+	{ "IO50: QoS held requests are released as tokens refill",
+	  io_qos_hold, async_disable, test_case_teardown},
+	{ "IO51: fetch prefers the replica not being slow",
+	  io_replica_slow, async_disable, test_case_teardown},
+	{ "IO52: batched fetch with the batch RPC unsupported",
+	  io_batch_unreg, async_disable, test_case_teardown},
 };
 
 int
@@ -1677,6 +1677,306 @@ ec_cond_fetch(void **state)
 	}
 }
 
+static void
+ec_rmw_update(daos_handle_t oh, uint64_t idx, uint64_t nr, char *buf)
+{
+	d_iov_t		dkey;
+	d_sg_list_t	sgl;
+	d_iov_t		sg_iov;
+	daos_iod_t	iod;
+	daos_recx_t	recx;
+	int		rc;
+
+	d_iov_set(&dkey, "dkey", strlen("dkey"));
+	d_iov_set(&sg_iov, buf, nr);
+	sgl.sg_nr	= 1;
+	sgl.sg_nr_out	= 0;
+	sgl.sg_iovs	= &sg_iov;
+	d_iov_set(&iod.iod_name, "akey", strlen("akey"));
+	iod.iod_nr	= 1;
+	iod.iod_size	= 1;
+	iod.iod_recxs	= &recx;
+	iod.iod_type	= DAOS_IOD_ARRAY;
+	recx.rx_idx	= idx;
+	recx.rx_nr	= nr;
+
+	rc = daos_obj_update(oh, DAOS_TX_NONE, 0, &dkey, 1, &iod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+}
+
+static void
+ec_rmw_verify(daos_handle_t oh, uint64_t idx, uint64_t nr, char *expected)
+{
+	d_iov_t		dkey;
+	d_sg_list_t	sgl;
+	d_iov_t		sg_iov;
+	daos_iod_t	iod;
+	daos_recx_t	recx;
+	char		*buf;
+	int		rc;
+
+	D_ALLOC(buf, nr);
+	assert_non_null(buf);
+
+	d_iov_set(&dkey, "dkey", strlen("dkey"));
+	d_iov_set(&sg_iov, buf, nr);
+	sgl.sg_nr	= 1;
+	sgl.sg_nr_out	= 0;
+	sgl.sg_iovs	= &sg_iov;
+	d_iov_set(&iod.iod_name, "akey", strlen("akey"));
+	iod.iod_nr	= 1;
+	iod.iod_size	= 1;
+	iod.iod_recxs	= &recx;
+	iod.iod_type	= DAOS_IOD_ARRAY;
+	recx.rx_idx	= idx;
+	recx.rx_nr	= nr;
+
+	rc = daos_obj_fetch(oh, DAOS_TX_NONE, 0, &dkey, 1, &iod, &sgl, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	assert_memory_equal(buf, expected, nr);
+	D_FREE(buf);
+}
+
+static void
+ec_parity_fetch(daos_handle_t oh, uint64_t stripe, uint32_t shard, char *buf)
+{
+	tse_task_t	*task = NULL;
+	d_iov_t		 dkey;
+	d_sg_list_t	 sgl;
+	d_iov_t		 sg_iov;
+	daos_iod_t	 iod;
+	daos_recx_t	 recx;
+	int		 rc;
+
+	d_iov_set(&dkey, "dkey", strlen("dkey"));
+	d_iov_set(&sg_iov, buf, ec_cell_size);
+	sgl.sg_nr	= 1;
+	sgl.sg_nr_out	= 0;
+	sgl.sg_iovs	= &sg_iov;
+	d_iov_set(&iod.iod_name, "akey", strlen("akey"));
+	iod.iod_nr	= 1;
+	iod.iod_size	= 1;
+	iod.iod_recxs	= &recx;
+	iod.iod_type	= DAOS_IOD_ARRAY;
+	recx.rx_idx	= (stripe * ec_cell_size) | PARITY_INDICATOR;
+	recx.rx_nr	= ec_cell_size;
+
+	rc = dc_obj_fetch_task_create(oh, DAOS_TX_NONE, 0, &dkey, 1, DIOF_TO_SPEC_SHARD,
+				      &iod, &sgl, NULL, &shard, NULL, NULL, NULL, &task);
+	assert_rc_equal(rc, 0);
+	rc = dc_task_schedule(task, true);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(iod.iod_size, 1);
+}
+
+/* Parity of the stripe is the same as the one of a full stripe update of the same data */
+static void
+ec_rmw_parity_verify(test_arg_t *arg, daos_handle_t oh, uint64_t stripe, char *stripe_buf)
+{
+	struct daos_oclass_attr	*oca;
+	daos_obj_id_t		 oid;
+	daos_handle_t		 ref_oh;
+	d_iov_t			 dkey;
+	uint64_t		 stripe_size = ec_cell_size * 4;
+	uint32_t		 shard, grp_size;
+	char			*parity[2];
+	int			 i, m, rc;
+
+	for (i = 0; i < 2; i++) {
+		D_ALLOC(parity[i], ec_cell_size);
+		assert_non_null(parity[i]);
+	}
+
+	oid = daos_test_oid_gen(arg->coh, OC_EC_4P2G1, 0, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &ref_oh, NULL);
+	assert_rc_equal(rc, 0);
+	ec_rmw_update(ref_oh, stripe * stripe_size, stripe_size, stripe_buf);
+
+	assert_true(oid_is_ec(oid, &oca));
+	grp_size = oca->u.ec.e_p + oca->u.ec.e_k;
+	d_iov_set(&dkey, "dkey", strlen("dkey"));
+	shard = test_ec_get_parity_off(&dkey, oca);
+	for (m = 0; m < oca->u.ec.e_p; m++, shard = (shard + 1) % grp_size) {
+		ec_parity_fetch(oh, stripe, shard, parity[0]);
+		ec_parity_fetch(ref_oh, stripe, shard, parity[1]);
+		assert_memory_equal(parity[0], parity[1], ec_cell_size);
+	}
+
+	rc = daos_obj_close(ref_oh, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < 2; i++)
+		D_FREE(parity[i]);
+}
+
+static void
+ec_partial_rmw(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	 oid;
+	daos_handle_t	 oh;
+	uint64_t	 stripe_size = ec_cell_size * 4;
+	uint64_t	 hole_stripe = 2 * stripe_size;
+	uint64_t	 stripes[2], skipped[2], restarts[2];
+	char		*stripe_buf;
+	char		*buf;
+	int		 rc;
+
+	FAULT_INJECTION_REQUIRED();
+
+	if (!test_runable(arg, 6))
+		return;
+
+	oid = daos_test_oid_gen(arg->coh, OC_EC_4P2G1, 0, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	D_ALLOC(stripe_buf, stripe_size);
+	assert_non_null(stripe_buf);
+	D_ALLOC(buf, stripe_size);
+	assert_non_null(buf);
+
+	/* As with DAOS_EC_PARTIAL_RMW=1 */
+	daos_fail_loc_set(DAOS_OBJ_EC_RMW | DAOS_FAIL_ALWAYS);
+
+	print_message("full stripe, then partial update of it\n");
+	dts_buf_render(stripe_buf, stripe_size);
+	ec_rmw_update(oh, 0, stripe_size, stripe_buf);
+
+	obj_ec_rmw_query(&stripes[0], &skipped[0], &restarts[0]);
+	dts_buf_render(buf, 5000);
+	ec_rmw_update(oh, 1000, 5000, buf);
+	memcpy(stripe_buf + 1000, buf, 5000);
+	obj_ec_rmw_query(&stripes[1], &skipped[1], &restarts[1]);
+	/* No hole in the stripe, rewritten as full stripe */
+	assert_int_equal(stripes[1] - stripes[0], 1);
+	assert_int_equal(skipped[1] - skipped[0], 0);
+	ec_rmw_verify(oh, 0, stripe_size, stripe_buf);
+	ec_rmw_parity_verify(arg, oh, 0, stripe_buf);
+
+	print_message("partial updates of a stripe with holes\n");
+	obj_ec_rmw_query(&stripes[0], &skipped[0], &restarts[0]);
+	dts_buf_render(buf, 2000);
+	ec_rmw_update(oh, hole_stripe, 1000, buf);
+	ec_rmw_update(oh, hole_stripe + 5000, 1000, buf + 1000);
+	obj_ec_rmw_query(&stripes[1], &skipped[1], &restarts[1]);
+	/* Rewriting the stripe would fill the holes, it stays partial */
+	assert_int_equal(stripes[1] - stripes[0], 0);
+	assert_int_equal(skipped[1] - skipped[0], 2);
+	ec_rmw_verify(oh, hole_stripe, 1000, buf);
+	ec_rmw_verify(oh, hole_stripe + 5000, 1000, buf + 1000);
+
+	print_message("partial update restarted by a conflict\n");
+	daos_fail_loc_set(DAOS_OBJ_EC_RMW_RESTART | DAOS_FAIL_ALWAYS);
+	obj_ec_rmw_query(&stripes[0], &skipped[0], &restarts[0]);
+	dts_buf_render(buf, 3000);
+	ec_rmw_update(oh, 70000, 3000, buf);
+	memcpy(stripe_buf + 70000, buf, 3000);
+	obj_ec_rmw_query(&stripes[1], &skipped[1], &restarts[1]);
+	assert_int_equal(restarts[1] - restarts[0], 1);
+	assert_int_equal(stripes[1] - stripes[0], 1);
+	daos_fail_loc_set(0);
+	ec_rmw_verify(oh, 0, stripe_size, stripe_buf);
+	ec_rmw_parity_verify(arg, oh, 0, stripe_buf);
+
+	rc = daos_obj_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+	D_FREE(stripe_buf);
+	D_FREE(buf);
+}
+
+#define ENC_STRIPE_NR	8
+
+static void
+ec_encode_threads(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct daos_oclass_attr	*oca;
+	daos_obj_id_t		 oid;
+	daos_handle_t		 oh;
+	d_iov_t			 dkey;
+	d_sg_list_t		 sgl;
+	d_iov_t			 sg_iovs[3];
+	daos_iod_t		 iod;
+	daos_recx_t		 recxs[2];
+	uint64_t		 stripe_size = ec_cell_size * 4;
+	uint64_t		 data_size = ENC_STRIPE_NR * stripe_size;
+	uint64_t		 parity_size = ENC_STRIPE_NR * 2 * ec_cell_size;
+	uint64_t		 stripes[ENC_STRIPE_NR] = { 0, 1, 2, 3, 4, 8, 9, 10 };
+	unsigned int		 thread_nrs[2] = { 0, 3 };
+	unsigned int		 old_nr;
+	uint32_t		 p_shard, shard, grp_size;
+	char			*parity[2];
+	char			*data;
+	int			 i, j, m, rc;
+
+	if (!test_runable(arg, 6))
+		return;
+
+	D_ALLOC(data, data_size);
+	assert_non_null(data);
+	dts_buf_render(data, data_size);
+	for (i = 0; i < 2; i++) {
+		D_ALLOC(parity[i], parity_size);
+		assert_non_null(parity[i]);
+	}
+
+	/* Two recxs, so the stripes of a job can be split across them */
+	recxs[0].rx_idx	= 0;
+	recxs[0].rx_nr	= 5 * stripe_size;
+	recxs[1].rx_idx	= 8 * stripe_size;
+	recxs[1].rx_nr	= 3 * stripe_size;
+
+	/* The iovs don't line up with the stripe boundaries */
+	d_iov_set(&sg_iovs[0], data, 100000);
+	d_iov_set(&sg_iovs[1], data + 100000, 300001);
+	d_iov_set(&sg_iovs[2], data + 400001, data_size - 400001);
+	sgl.sg_nr	= 3;
+	sgl.sg_nr_out	= 0;
+	sgl.sg_iovs	= sg_iovs;
+
+	d_iov_set(&dkey, "dkey", strlen("dkey"));
+	d_iov_set(&iod.iod_name, "akey", strlen("akey"));
+	iod.iod_nr	= 2;
+	iod.iod_size	= 1;
+	iod.iod_recxs	= recxs;
+	iod.iod_type	= DAOS_IOD_ARRAY;
+
+	old_nr = obj_ec_encode_threads_reset(0);
+	for (i = 0; i < 2; i++) {
+		print_message("update with %u encoder threads\n", thread_nrs[i]);
+		obj_ec_encode_threads_reset(thread_nrs[i]);
+
+		oid = daos_test_oid_gen(arg->coh, OC_EC_4P2G1, 0, 0, arg->myrank);
+		rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+		assert_rc_equal(rc, 0);
+		rc = daos_obj_update(oh, DAOS_TX_NONE, 0, &dkey, 1, &iod, &sgl, NULL);
+		assert_rc_equal(rc, 0);
+
+		ec_rmw_verify(oh, recxs[0].rx_idx, recxs[0].rx_nr, data);
+		ec_rmw_verify(oh, recxs[1].rx_idx, recxs[1].rx_nr, data + recxs[0].rx_nr);
+
+		assert_true(oid_is_ec(oid, &oca));
+		grp_size = oca->u.ec.e_p + oca->u.ec.e_k;
+		p_shard = test_ec_get_parity_off(&dkey, oca);
+		for (j = 0; j < ENC_STRIPE_NR; j++) {
+			for (m = 0, shard = p_shard; m < 2; m++, shard = (shard + 1) % grp_size)
+				ec_parity_fetch(oh, stripes[j], shard,
+						parity[i] + (j * 2 + m) * ec_cell_size);
+		}
+
+		rc = daos_obj_close(oh, NULL);
+		assert_rc_equal(rc, 0);
+	}
+	obj_ec_encode_threads_reset(old_nr);
+
+	/* The parity encoded by the encoder threads is the same as the inline one */
+	assert_memory_equal(parity[0], parity[1], parity_size);
+
+	for (i = 0; i < 2; i++)
+		D_FREE(parity[i]);
+	D_FREE(data);
+}
+
 static int
 ec_setup(void  **state)
 {
@@ -1742,6 +2042,10 @@ static const struct CMUnitTest ec_tests[] = {
 	{"EC17: ec single-value different size fetch", ec_singv_diff_size_fetch, async_disable,
 	 test_case_teardown},
 	{"EC18: ec conditional fetch", ec_cond_fetch, async_disable, test_case_teardown},
+	{"EC19: ec partial stripe read-modify-write", ec_partial_rmw, async_disable,
+	 test_case_teardown},
+	{"EC20: ec parity of the encoder threads", ec_encode_threads, async_disable,
+	 test_case_teardown},
 };
 
 int
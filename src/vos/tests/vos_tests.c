@@ -24,6 +24,7 @@
 
 #define		FORCE_CSUM 0x1001
 #define		FORCE_NO_ZERO_COPY 0x1002
+#define		NVME_RCACHE 0x1003
 
 static void
 print_usage()
@@ -50,6 +51,7 @@ print_usage()
 	print_message("  -e|--exclude <filter>\n");
 	print_message("  --force_checksum\n");
 	print_message("  --force_no_zero_copy\n");
+	print_message("  --nvme_rcache\n");
 }
 
 static int type_list[] = {
@@ -134,6 +136,7 @@ main(int argc, char **argv)
 		{"storage",		required_argument, 0, 'S'},
 		{"force_csum",		no_argument, 0, FORCE_CSUM},
 		{"force_no_zero_copy",	no_argument, 0, FORCE_NO_ZERO_COPY},
+		{"nvme_rcache",		no_argument, 0, NVME_RCACHE},
 		{NULL},
 	};
 
@@ -190,6 +193,10 @@ main(int argc, char **argv)
 		case FORCE_NO_ZERO_COPY:
 			g_force_no_zero_copy = true;
 			break;
+		case NVME_RCACHE:
+			/* Enable the NVMe read cache unless configured explicitly */
+			setenv("DAOS_NVME_RCACHE_MB", "16", 0);
+			break;
 		default:
 			break;
 		}
@@ -276,6 +283,7 @@ main(int argc, char **argv)
 		case 'e':
 		case FORCE_CSUM:
 		case FORCE_NO_ZERO_COPY:
+		case NVME_RCACHE:
 			/** already handled */
 			break;
 		default:
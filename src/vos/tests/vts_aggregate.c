@@ -2859,6 +2859,93 @@ aggregate_35(void **state)
 	assert_int_equal(feats & INIT_FEATS, INIT_FEATS);
 }
 
+#define AGG_COPY_EXT_NR	4
+
+static void
+agg_copy_verify(struct io_test_args *arg, daos_unit_oid_t oid, char *dkey, char *akey,
+		daos_recx_t *recx, char *expected, char *buf)
+{
+	fetch_value(arg, oid, AGG_COPY_EXT_NR + 1, 0, dkey, akey, DAOS_IOD_ARRAY, 1, recx, buf);
+	assert_memory_equal(expected, buf, recx->rx_nr);
+}
+
+/*
+ * Aggregate NVMe records larger than the pipelined copy segment, the source
+ * extents aren't aligned with the copy segments. Copy failure and copy retry
+ * on DMA buffer shortage are injected.
+ */
+static void
+aggregate_36(void **state)
+{
+	struct io_test_args	*arg = *state;
+	vos_pool_info_t		 pool_info;
+	struct vos_pool_space	*vps = &pool_info.pif_space;
+	daos_size_t		 ext_sz[AGG_COPY_EXT_NR] = { 3 << 19, 1 << 19, 5 << 18, 3 << 18 };
+	daos_epoch_range_t	 epr = { 0, AGG_COPY_EXT_NR + 1 };
+	daos_epoch_range_t	 epr_all = { 0, DAOS_EPOCH_MAX };
+	daos_unit_oid_t		 oid;
+	daos_recx_t		 recx, recx_tot = { 0 };
+	char			 dkey[UPDATE_DKEY_SIZE] = { 0 };
+	char			 akey[UPDATE_AKEY_SIZE] = { 0 };
+	char			*expected, *buf;
+	int			 rc, i;
+
+	rc = vos_pool_query(arg->ctx.tc_po_hdl, &pool_info);
+	assert_rc_equal(rc, 0);
+
+	/* NVMe isn't enabled */
+	if (NVME_TOTAL(vps) == 0) {
+		print_message("NVMe isn't enabled, skip test\n");
+		skip();
+	}
+
+	for (i = 0; i < AGG_COPY_EXT_NR; i++)
+		recx_tot.rx_nr += ext_sz[i];
+
+	D_ALLOC(expected, recx_tot.rx_nr);
+	assert_non_null(expected);
+	D_ALLOC(buf, recx_tot.rx_nr);
+	assert_non_null(buf);
+
+	oid = dts_unit_oid_gen(0, 0);
+	dts_key_gen(dkey, UPDATE_DKEY_SIZE, UPDATE_DKEY);
+	dts_key_gen(akey, UPDATE_AKEY_SIZE, UPDATE_AKEY);
+
+	recx.rx_idx = 0;
+	for (i = 0; i < AGG_COPY_EXT_NR; i++) {
+		recx.rx_nr = ext_sz[i];
+		update_value(arg, oid, i + 1, 0, dkey, akey, DAOS_IOD_ARRAY, 1, &recx,
+			     expected + recx.rx_idx);
+		recx.rx_idx += recx.rx_nr;
+	}
+	assert_int_equal(phy_recs_nr(arg, oid, &epr_all, dkey, akey, DAOS_IOD_ARRAY),
+			 AGG_COPY_EXT_NR);
+
+	VERBOSE_MSG("Aggregate with NVMe read failure\n");
+	daos_fail_loc_set(DAOS_NVME_READ_ERR | DAOS_FAIL_ALWAYS);
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, VOS_AGG_FL_FORCE_MERGE);
+	daos_fail_loc_set(0);
+	assert_true(rc != 0);
+
+	/* The failed copy must leave the original records intact */
+	assert_int_equal(phy_recs_nr(arg, oid, &epr_all, dkey, akey, DAOS_IOD_ARRAY),
+			 AGG_COPY_EXT_NR);
+	agg_copy_verify(arg, oid, dkey, akey, &recx_tot, expected, buf);
+
+	VERBOSE_MSG("Aggregate with DMA buffer shortage\n");
+	daos_fail_loc_set(DAOS_NVME_COPY_NOBUF | DAOS_FAIL_ALWAYS);
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, VOS_AGG_FL_FORCE_MERGE);
+	daos_fail_loc_set(0);
+	assert_rc_equal(rc, 0);
+
+	assert_int_equal(phy_recs_nr(arg, oid, &epr_all, dkey, akey, DAOS_IOD_ARRAY), 1);
+	agg_copy_verify(arg, oid, dkey, akey, &recx_tot, expected, buf);
+
+	D_FREE(expected);
+	D_FREE(buf);
+	cleanup();
+}
+
 static int
 agg_tst_teardown(void **state)
 {
@@ -2975,6 +3062,8 @@ static const struct CMUnitTest aggregate_tests[] = {
 	  aggregate_34, NULL, agg_tst_teardown },
 	{ "VOS435: Test aggregation timestamp functions",
 	  aggregate_35, NULL, NULL },
+	{ "VOS436: Aggregate NVMe records with pipelined copy",
+	  aggregate_36, NULL, agg_tst_teardown },
 };
 
 int
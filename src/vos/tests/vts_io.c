@@ -2353,6 +2353,511 @@ io_fetch_hole(void **state)
 	assert_memory_equal(ground_truth, fetch_buf, 3 * 1024);
 }
 
+#define COALESCE_AKEY_NR	4
+#define COALESCE_EXT_SIZE	(8 * 1024)
+
+/*
+ * Update several akeys with extents landing on adjacent NVMe blocks (with a
+ * filler extent making a small hole in between), then fetch them all in one
+ * call to exercise the cross-iod NVMe request coalescing.
+ */
+static void
+io_fetch_coalesce(void **state)
+{
+	struct io_test_args	*arg = *state;
+	daos_key_t		 dkey;
+	daos_key_t		 akeys[COALESCE_AKEY_NR + 1];
+	daos_recx_t		 recxs[COALESCE_AKEY_NR + 1];
+	daos_iod_t		 iods[COALESCE_AKEY_NR + 1];
+	d_sg_list_t		 sgls[COALESCE_AKEY_NR + 1];
+	d_iov_t			 iovs[COALESCE_AKEY_NR + 1];
+	char			 dkey_buf[UPDATE_DKEY_SIZE];
+	char			 akey_bufs[COALESCE_AKEY_NR + 1][UPDATE_AKEY_SIZE];
+	char			*update_bufs[COALESCE_AKEY_NR];
+	char			*fetch_bufs[COALESCE_AKEY_NR];
+	char			 filler[4 * 1024];
+	int			 i, j, rc;
+
+	memset(iods, 0, sizeof(iods));
+	memset(sgls, 0, sizeof(sgls));
+
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	set_iov(&dkey, &dkey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_DKEY_UINT64));
+
+	for (i = 0; i <= COALESCE_AKEY_NR; i++) {
+		vts_key_gen(&akey_bufs[i][0], arg->akey_size, false, arg);
+		set_iov(&akeys[i], &akey_bufs[i][0],
+			is_daos_obj_type_set(arg->otype, DAOS_OT_AKEY_UINT64));
+
+		recxs[i].rx_idx = 0;
+		recxs[i].rx_nr = COALESCE_EXT_SIZE;
+		iods[i].iod_type = DAOS_IOD_ARRAY;
+		iods[i].iod_size = 1;
+		iods[i].iod_name = akeys[i];
+		iods[i].iod_recxs = &recxs[i];
+		iods[i].iod_nr = 1;
+		sgls[i].sg_iovs = &iovs[i];
+		sgls[i].sg_nr = 1;
+	}
+	/* The last akey is the small filler */
+	recxs[COALESCE_AKEY_NR].rx_nr = sizeof(filler);
+
+	for (i = 0; i < COALESCE_AKEY_NR; i++) {
+		D_ALLOC(update_bufs[i], COALESCE_EXT_SIZE);
+		assert_non_null(update_bufs[i]);
+		D_ALLOC(fetch_bufs[i], COALESCE_EXT_SIZE);
+		assert_non_null(fetch_bufs[i]);
+		dts_buf_render(update_bufs[i], COALESCE_EXT_SIZE);
+	}
+	dts_buf_render(filler, sizeof(filler));
+
+	/* Update one by one, so the extents are allocated in sequence */
+	for (i = 0; i < COALESCE_AKEY_NR; i++) {
+		d_iov_set(&iovs[i], update_bufs[i], COALESCE_EXT_SIZE);
+		rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, 1, 0, 0, &dkey, 1,
+				    &iods[i], NULL, &sgls[i]);
+		assert_rc_equal(rc, 0);
+		inc_cntr(arg->ta_flags);
+
+		if (i != 1)
+			continue;
+
+		d_iov_set(&iovs[COALESCE_AKEY_NR], filler, sizeof(filler));
+		rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, 1, 0, 0, &dkey, 1,
+				    &iods[COALESCE_AKEY_NR], NULL, &sgls[COALESCE_AKEY_NR]);
+		assert_rc_equal(rc, 0);
+	}
+
+	/* Fetch all in one call, in forward and reverse iod order */
+	for (j = 0; j < 2; j++) {
+		for (i = 0; i < COALESCE_AKEY_NR; i++) {
+			memset(fetch_bufs[i], 0, COALESCE_EXT_SIZE);
+			d_iov_set(&iovs[i], fetch_bufs[i], COALESCE_EXT_SIZE);
+		}
+
+		rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, 1, 0, &dkey,
+				   COALESCE_AKEY_NR, iods, sgls);
+		assert_rc_equal(rc, 0);
+
+		for (i = 0; i < COALESCE_AKEY_NR; i++)
+			assert_memory_equal(update_bufs[i], fetch_bufs[i], COALESCE_EXT_SIZE);
+
+		for (i = 0; i < COALESCE_AKEY_NR / 2; i++) {
+			daos_iod_t	iod_tmp = iods[i];
+			char		*buf_tmp = update_bufs[i];
+			int		 k = COALESCE_AKEY_NR - 1 - i;
+
+			iods[i] = iods[k];
+			iods[k] = iod_tmp;
+			update_bufs[i] = update_bufs[k];
+			update_bufs[k] = buf_tmp;
+		}
+	}
+
+	for (i = 0; i < COALESCE_AKEY_NR; i++) {
+		D_FREE(update_bufs[i]);
+		D_FREE(fetch_bufs[i]);
+	}
+}
+
+#define RCACHE_EXT_SIZE	(8 * 1024)
+#define RCACHE_EXT_PGS	(RCACHE_EXT_SIZE / 4096)
+
+/* Get the address of the extent fetched by a single recx iod, return true if it's on NVMe */
+static bool
+rcache_ext_addr(struct io_test_args *arg, daos_epoch_t epoch, daos_key_t *dkey,
+		daos_iod_t *iod, bio_addr_t *addr)
+{
+	struct bio_sglist	*bsgl;
+	daos_handle_t		 ioh;
+	int			 rc;
+
+	rc = vos_fetch_begin(arg->ctx.tc_co_hdl, arg->oid, epoch, dkey, 1, iod, 0, NULL, &ioh,
+			     NULL);
+	assert_rc_equal(rc, 0);
+	bsgl = bio_iod_sgl(vos_ioh2desc(ioh), 0);
+	assert_int_equal(bsgl->bs_nr_out, 1);
+	*addr = bsgl->bs_iovs[0].bi_addr;
+	rc = vos_fetch_end(ioh, NULL, 0);
+	assert_rc_equal(rc, 0);
+
+	return addr->ba_type == DAOS_MEDIA_NVME;
+}
+
+static void
+rcache_fetch_verify(struct io_test_args *arg, daos_epoch_t epoch, daos_key_t *dkey,
+		    daos_iod_t *iod, char *expected)
+{
+	char		fetch_buf[RCACHE_EXT_SIZE];
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	bio_addr_t	addr;
+	uint64_t	hits[2], misses, invals;
+	bool		cached;
+	int		i, rc;
+
+	cached = rcache_ext_addr(arg, epoch, dkey, iod, &addr) &&
+		 bio_rcache_query(vos_xsctxt_get(), &hits[0], &misses, &invals);
+	sgl.sg_iovs = &iov;
+	sgl.sg_nr = 1;
+
+	/* The second fetch must be served by the NVMe read cache */
+	for (i = 0; i < 2; i++) {
+		if (i == 1)
+			bio_rcache_query(vos_xsctxt_get(), &hits[0], &misses, &invals);
+		memset(fetch_buf, 0, sizeof(fetch_buf));
+		d_iov_set(&iov, fetch_buf, sizeof(fetch_buf));
+		rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, epoch, 0, dkey, 1, iod, &sgl);
+		assert_rc_equal(rc, 0);
+		assert_memory_equal(expected, fetch_buf, sizeof(fetch_buf));
+	}
+
+	if (cached) {
+		bio_rcache_query(vos_xsctxt_get(), &hits[1], &misses, &invals);
+		assert_int_equal(hits[1] - hits[0], 1);
+	}
+}
+
+/*
+ * Free a cached extent with VOS discard, its pages must be dropped from the
+ * read cache, then write new data to the freed extent as VEA would hand it out
+ * again and read it back.
+ */
+static void
+rcache_free_reuse(struct io_test_args *arg, daos_epoch_t epoch, daos_key_t *dkey,
+		  daos_iod_t *iod)
+{
+	struct bio_io_context	*ioctxt = vos_hdl2pool(arg->ctx.tc_po_hdl)->vp_io_ctxt;
+	char			 update_buf[RCACHE_EXT_SIZE];
+	char			 fetch_buf[RCACHE_EXT_SIZE];
+	daos_epoch_range_t	 epr;
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	bio_addr_t		 addr;
+	uint64_t		 hits[2], misses[2], invals[2];
+	int			 i, rc;
+
+	dts_buf_render(update_buf, RCACHE_EXT_SIZE);
+	d_iov_set(&iov, update_buf, RCACHE_EXT_SIZE);
+	sgl.sg_iovs = &iov;
+	sgl.sg_nr = 1;
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, epoch, 0, 0, dkey, 1, iod, NULL, &sgl);
+	assert_rc_equal(rc, 0);
+	inc_cntr(arg->ta_flags);
+	rcache_fetch_verify(arg, epoch, dkey, iod, update_buf);
+
+	if (!rcache_ext_addr(arg, epoch, dkey, iod, &addr) ||
+	    !bio_rcache_query(vos_xsctxt_get(), &hits[0], &misses[0], &invals[0])) {
+		print_message("NVMe read cache isn't enabled, skip extent reuse\n");
+		return;
+	}
+
+	epr.epr_lo = epr.epr_hi = epoch;
+	rc = vos_discard(arg->ctx.tc_co_hdl, &arg->oid, &epr, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	bio_rcache_query(vos_xsctxt_get(), &hits[1], &misses[1], &invals[1]);
+	assert_true(invals[1] - invals[0] >= RCACHE_EXT_PGS);
+
+	/* The freed extent still holds the old data, but it's not cached anymore */
+	d_iov_set(&iov, fetch_buf, RCACHE_EXT_SIZE);
+	rc = bio_read(ioctxt, addr, &iov);
+	assert_rc_equal(rc, 0);
+	bio_rcache_query(vos_xsctxt_get(), &hits[0], &misses[0], &invals[0]);
+	assert_int_equal(hits[0], hits[1]);
+	assert_int_equal(misses[0] - misses[1], 1);
+
+	dts_buf_render(update_buf, RCACHE_EXT_SIZE);
+	d_iov_set(&iov, update_buf, RCACHE_EXT_SIZE);
+	rc = bio_write(ioctxt, addr, &iov);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < 2; i++) {
+		memset(fetch_buf, 0, sizeof(fetch_buf));
+		d_iov_set(&iov, fetch_buf, RCACHE_EXT_SIZE);
+		rc = bio_read(ioctxt, addr, &iov);
+		assert_rc_equal(rc, 0);
+		assert_memory_equal(update_buf, fetch_buf, RCACHE_EXT_SIZE);
+	}
+	bio_rcache_query(vos_xsctxt_get(), &hits[1], &misses[1], &invals[1]);
+	assert_int_equal(hits[1] - hits[0], 1);
+}
+
+static void
+io_fetch_rcache(void **state)
+{
+	struct io_test_args	*arg = *state;
+	daos_key_t		 dkey, akey;
+	daos_recx_t		 recx;
+	daos_iod_t		 iod;
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	char			 dkey_buf[UPDATE_DKEY_SIZE];
+	char			 akey_buf[UPDATE_AKEY_SIZE];
+	char			 update_bufs[2][RCACHE_EXT_SIZE];
+	int			 i, rc;
+
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	set_iov(&dkey, &dkey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_DKEY_UINT64));
+	vts_key_gen(&akey_buf[0], arg->akey_size, false, arg);
+	set_iov(&akey, &akey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_AKEY_UINT64));
+
+	memset(&iod, 0, sizeof(iod));
+	recx.rx_idx = 0;
+	recx.rx_nr = RCACHE_EXT_SIZE;
+	iod.iod_type = DAOS_IOD_ARRAY;
+	iod.iod_size = 1;
+	iod.iod_name = akey;
+	iod.iod_recxs = &recx;
+	iod.iod_nr = 1;
+	sgl.sg_iovs = &iov;
+	sgl.sg_nr = 1;
+
+	/* Overwrite the same recx at a higher epoch, then re-fetch both epochs */
+	for (i = 0; i < 2; i++) {
+		dts_buf_render(update_bufs[i], RCACHE_EXT_SIZE);
+		d_iov_set(&iov, update_bufs[i], RCACHE_EXT_SIZE);
+		rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, i + 1, 0, 0, &dkey, 1, &iod,
+				    NULL, &sgl);
+		assert_rc_equal(rc, 0);
+		inc_cntr(arg->ta_flags);
+
+		rcache_fetch_verify(arg, i + 1, &dkey, &iod, update_bufs[i]);
+	}
+	rcache_fetch_verify(arg, 1, &dkey, &iod, update_bufs[0]);
+
+	/* Punch and re-update, stale data must not be served from cache */
+	rc = vos_obj_punch(arg->ctx.tc_co_hdl, arg->oid, 3, 0, 0, &dkey, 0, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	dts_buf_render(update_bufs[0], RCACHE_EXT_SIZE);
+	d_iov_set(&iov, update_bufs[0], RCACHE_EXT_SIZE);
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, 4, 0, 0, &dkey, 1, &iod, NULL, &sgl);
+	assert_rc_equal(rc, 0);
+	rcache_fetch_verify(arg, 4, &dkey, &iod, update_bufs[0]);
+
+	/* Another dkey, so the discard doesn't touch the extents above */
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	set_iov(&dkey, &dkey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_DKEY_UINT64));
+	rcache_free_reuse(arg, 5, &dkey, &iod);
+}
+
+#define WC_AKEY_NR	4
+#define WC_EXT_SIZE	(8 * 1024)
+#define WC_PGS		64
+
+static unsigned int wc_saved_pgs;
+
+/* Enable the NVMe write combining for the test, restore it on teardown */
+static int
+io_wc_setup(void **state)
+{
+	wc_saved_pgs = bio_wc_set(WC_PGS);
+	return 0;
+}
+
+static int
+io_wc_teardown(void **state)
+{
+	bio_wc_set(wc_saved_pgs);
+	return 0;
+}
+
+static int
+wc_update(struct io_test_args *arg, daos_epoch_t epoch, daos_key_t *dkey, daos_iod_t *iods,
+	  char bufs[WC_AKEY_NR][WC_EXT_SIZE])
+{
+	d_sg_list_t	sgls[WC_AKEY_NR];
+	d_iov_t		iovs[WC_AKEY_NR];
+	int		i;
+
+	for (i = 0; i < WC_AKEY_NR; i++) {
+		dts_buf_render(bufs[i], WC_EXT_SIZE);
+		d_iov_set(&iovs[i], bufs[i], WC_EXT_SIZE);
+		sgls[i].sg_iovs = &iovs[i];
+		sgls[i].sg_nr = 1;
+	}
+
+	return vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, epoch, 0, 0, dkey, WC_AKEY_NR, iods,
+			      NULL, sgls);
+}
+
+static void
+wc_fetch_verify(struct io_test_args *arg, daos_epoch_t epoch, daos_key_t *dkey,
+		daos_iod_t *iods, char bufs[WC_AKEY_NR][WC_EXT_SIZE])
+{
+	char		fetch_bufs[WC_AKEY_NR][WC_EXT_SIZE];
+	d_sg_list_t	sgls[WC_AKEY_NR];
+	d_iov_t		iovs[WC_AKEY_NR];
+	int		i, rc;
+
+	memset(fetch_bufs, 0, sizeof(fetch_bufs));
+	for (i = 0; i < WC_AKEY_NR; i++) {
+		d_iov_set(&iovs[i], fetch_bufs[i], WC_EXT_SIZE);
+		sgls[i].sg_iovs = &iovs[i];
+		sgls[i].sg_nr = 1;
+	}
+
+	rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, epoch, 0, dkey, WC_AKEY_NR, iods, sgls);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < WC_AKEY_NR; i++)
+		assert_memory_equal(bufs[i], fetch_bufs[i], WC_EXT_SIZE);
+}
+
+/*
+ * Small NVMe writes are combined into one NVMe write when write combining is
+ * enabled, inject write failure to the combined write and verify none of the
+ * writes is acknowledged or becomes visible.
+ */
+static void
+io_update_wc_failure(void **state)
+{
+	struct io_test_args	*arg = *state;
+	daos_key_t		 dkey;
+	daos_key_t		 akeys[WC_AKEY_NR];
+	daos_recx_t		 recxs[WC_AKEY_NR];
+	daos_iod_t		 iods[WC_AKEY_NR];
+	char			 dkey_buf[UPDATE_DKEY_SIZE];
+	char			 akey_bufs[WC_AKEY_NR][UPDATE_AKEY_SIZE];
+	char			 bufs[WC_AKEY_NR][WC_EXT_SIZE];
+	char			 failed_bufs[WC_AKEY_NR][WC_EXT_SIZE];
+	char			 epoch1_bufs[WC_AKEY_NR][WC_EXT_SIZE];
+	int			 i, rc;
+
+	memset(iods, 0, sizeof(iods));
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	set_iov(&dkey, &dkey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_DKEY_UINT64));
+
+	for (i = 0; i < WC_AKEY_NR; i++) {
+		vts_key_gen(&akey_bufs[i][0], arg->akey_size, false, arg);
+		set_iov(&akeys[i], &akey_bufs[i][0],
+			is_daos_obj_type_set(arg->otype, DAOS_OT_AKEY_UINT64));
+
+		recxs[i].rx_idx = 0;
+		recxs[i].rx_nr = WC_EXT_SIZE;
+		iods[i].iod_type = DAOS_IOD_ARRAY;
+		iods[i].iod_size = 1;
+		iods[i].iod_name = akeys[i];
+		iods[i].iod_recxs = &recxs[i];
+		iods[i].iod_nr = 1;
+	}
+
+	rc = wc_update(arg, 1, &dkey, iods, bufs);
+	assert_rc_equal(rc, 0);
+	inc_cntr(arg->ta_flags);
+	wc_fetch_verify(arg, 1, &dkey, iods, bufs);
+
+	/* Data on SCM only when NVMe isn't configured, no failure to inject */
+	if (!bio_nvme_configured()) {
+		print_message("NVMe isn't configured, skip failure injection\n");
+		return;
+	}
+
+	daos_fail_loc_set(DAOS_NVME_WRITE_ERR | DAOS_FAIL_ONCE);
+	rc = wc_update(arg, 2, &dkey, iods, failed_bufs);
+	daos_fail_loc_set(0);
+	assert_rc_equal(rc, -DER_IO);
+
+	/* The failed update must not be visible */
+	wc_fetch_verify(arg, 2, &dkey, iods, bufs);
+
+	/* The space reserved by the failed update is released, update again */
+	memcpy(epoch1_bufs, bufs, sizeof(bufs));
+	rc = wc_update(arg, 3, &dkey, iods, bufs);
+	assert_rc_equal(rc, 0);
+	wc_fetch_verify(arg, 3, &dkey, iods, bufs);
+	wc_fetch_verify(arg, 2, &dkey, iods, epoch1_bufs);
+}
+
+/* Small NVMe extents interleaved with SCM extents, so each gets its own DMA region */
+#define WC_IOD_NR	(WC_AKEY_NR * 2 - 1)
+#define WC_SCM_SIZE	64
+
+/*
+ * Adjacent small NVMe writes from different IODs are combined into one NVMe
+ * write when write combining is enabled, verify the combined data.
+ */
+static void
+io_update_wc_combine(void **state)
+{
+	struct io_test_args	*arg = *state;
+	daos_key_t		 dkey;
+	daos_key_t		 akeys[WC_IOD_NR];
+	daos_recx_t		 recxs[WC_IOD_NR];
+	daos_iod_t		 iods[WC_IOD_NR];
+	d_sg_list_t		 sgls[WC_IOD_NR];
+	d_iov_t			 iovs[WC_IOD_NR];
+	char			 dkey_buf[UPDATE_DKEY_SIZE];
+	char			 akey_bufs[WC_IOD_NR][UPDATE_AKEY_SIZE];
+	char			 bufs[WC_IOD_NR][WC_EXT_SIZE];
+	char			 fetch_bufs[WC_IOD_NR][WC_EXT_SIZE];
+	bio_addr_t		 addrs[WC_AKEY_NR];
+	uint64_t		 writes[2], cmds[2];
+	int			 i, rc;
+
+	if (!bio_nvme_configured()) {
+		print_message("NVMe isn't configured, skip test\n");
+		skip();
+	}
+
+	memset(iods, 0, sizeof(iods));
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	set_iov(&dkey, &dkey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_DKEY_UINT64));
+
+	for (i = 0; i < WC_IOD_NR; i++) {
+		vts_key_gen(&akey_bufs[i][0], arg->akey_size, false, arg);
+		set_iov(&akeys[i], &akey_bufs[i][0],
+			is_daos_obj_type_set(arg->otype, DAOS_OT_AKEY_UINT64));
+
+		recxs[i].rx_idx = 0;
+		recxs[i].rx_nr = (i % 2) ? WC_SCM_SIZE : WC_EXT_SIZE;
+		iods[i].iod_type = DAOS_IOD_ARRAY;
+		iods[i].iod_size = 1;
+		iods[i].iod_name = akeys[i];
+		iods[i].iod_recxs = &recxs[i];
+		iods[i].iod_nr = 1;
+
+		dts_buf_render(bufs[i], recxs[i].rx_nr);
+		d_iov_set(&iovs[i], bufs[i], recxs[i].rx_nr);
+		sgls[i].sg_iovs = &iovs[i];
+		sgls[i].sg_nr = 1;
+	}
+
+	bio_wc_query(vos_xsctxt_get(), &writes[0], &cmds[0]);
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, 1, 0, 0, &dkey, WC_IOD_NR, iods,
+			    NULL, sgls);
+	assert_rc_equal(rc, 0);
+	inc_cntr(arg->ta_flags);
+	bio_wc_query(vos_xsctxt_get(), &writes[1], &cmds[1]);
+
+	if (writes[1] == writes[0]) {
+		print_message("Write combining is disabled, skip test\n");
+		skip();
+	}
+
+	/* The NVMe extents of one update are allocated in sequence */
+	assert_int_equal(writes[1] - writes[0], WC_AKEY_NR);
+	assert_true(cmds[1] - cmds[0] < WC_AKEY_NR);
+
+	/* Each NVMe extent is adjacent to the one of the previous NVMe IOD */
+	for (i = 0; i < WC_IOD_NR; i += 2) {
+		assert_true(rcache_ext_addr(arg, 1, &dkey, &iods[i], &addrs[i / 2]));
+		if (i > 0)
+			assert_int_equal(addrs[i / 2].ba_off,
+					 addrs[i / 2 - 1].ba_off + WC_EXT_SIZE);
+	}
+
+	memset(fetch_bufs, 0, sizeof(fetch_bufs));
+	for (i = 0; i < WC_IOD_NR; i++)
+		d_iov_set(&iovs[i], fetch_bufs[i], recxs[i].rx_nr);
+
+	rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, 1, 0, &dkey, WC_IOD_NR, iods, sgls);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < WC_IOD_NR; i++)
+		assert_memory_equal(bufs[i], fetch_bufs[i], recxs[i].rx_nr);
+}
+
 static void
 io_pool_overflow_test(void **state)
 {
@@ -2884,6 +3389,14 @@ static const struct CMUnitTest io_tests[] = {
 		io_sgl_fetch, NULL, NULL},
 	{ "VOS208: Extent hole test",
 		io_fetch_hole, NULL, NULL},
+	{ "VOS209: Fetch adjacent NVMe extents across iods",
+		io_fetch_coalesce, NULL, NULL},
+	{ "VOS210: Re-fetch small NVMe extent after overwrite",
+		io_fetch_rcache, NULL, NULL},
+	{ "VOS211: Combined small NVMe writes with injected write failure",
+		io_update_wc_failure, io_wc_setup, io_wc_teardown},
+	{ "VOS212: Combine adjacent small NVMe writes of different IODs",
+		io_update_wc_combine, io_wc_setup, io_wc_teardown},
 	{ "VOS220: 100K update/fetch/verify test",
 		io_multiple_dkey, NULL, NULL},
 	{ "VOS222: overwrite test",
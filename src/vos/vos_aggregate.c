@@ -1199,20 +1199,24 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 	D_ASSERT(!bio_addr_is_hole(&ent_in->ei_addr));
 	bio_iov_set(&bsgl_dst.bs_iovs[0], ent_in->ei_addr, seg_size);
 
+	/* Large segment without csum can be copied in pipelined sub-segments */
+	if (!mw->mw_csum_type) {
+		rc = bio_copy(bio_ctxt, &bsgl, &bsgl_dst, seg_size, NULL);
+		goto done;
+	}
+
 	copy_desc = bio_copy_prep(bio_ctxt, &bsgl, &bsgl_dst);
 	if (copy_desc == NULL) {
 		D_ERROR("Failed to Prepare source & target SGLs for copy.\n");
 		goto out;
 	}
 
-	if (mw->mw_csum_type) {
-		/* Verify prior data, calculate csums for output range. */
-		rc = verify_and_recalc(bio_copy_get_sgl(copy_desc, true), ent_in,
-				       io->ic_csum_recalcs, seg_count);
-		if (rc) {
-			D_ERROR("CSUM verify error: "DF_RC"\n", DP_RC(rc));
-			goto post;
-		}
+	/* Verify prior data, calculate csums for output range. */
+	rc = verify_and_recalc(bio_copy_get_sgl(copy_desc, true), ent_in,
+			       io->ic_csum_recalcs, seg_count);
+	if (rc) {
+		D_ERROR("CSUM verify error: "DF_RC"\n", DP_RC(rc));
+		goto post;
 	}
 
 	rc = bio_copy_run(copy_desc, seg_size, NULL);
@@ -1221,6 +1225,7 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 			DP_RECT(&ent_in->ei_rect), DP_RC(rc));
 post:
 	rc = bio_copy_post(copy_desc, rc);
+done:
 	if (rc) {
 		D_ERROR("Write to "DF_RECT" error "DF_RC"\n",
 			DP_RECT(&ent_in->ei_rect), DP_RC(rc));
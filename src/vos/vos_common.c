@@ -163,6 +163,8 @@ vos_bio_addr_free(struct vos_pool *pool, bio_addr_t *addr, daos_size_t nob)
 		blk_off = vos_byte2blkoff(addr->ba_off);
 		blk_cnt = vos_byte2blkcnt(nob);
 
+		/* The freed extent could be reallocated, drop it from read cache */
+		bio_rcache_invalidate(pool->vp_io_ctxt, addr->ba_off, nob);
 		rc = vea_free(pool->vp_vea_info, blk_off, blk_cnt);
 		if (rc)
 			D_ERROR("Error on block ["DF_U64", %u] free. "DF_RC"\n",
@@ -680,8 +682,9 @@ vos_self_nvme_fini(void)
 static int
 vos_self_nvme_init(const char *vos_path, uint32_t tgt_id)
 {
-	char	*nvme_conf;
-	int	 rc, fd;
+	char		*nvme_conf;
+	unsigned int	 mem_size = VOS_NVME_MEM_SIZE;
+	int		 rc, fd;
 
 	D_ASSERT(vos_path != NULL);
 	D_ASPRINTF(nvme_conf, "%s/%s", vos_path, VOS_NVME_CONF);
@@ -701,8 +704,10 @@ vos_self_nvme_init(const char *vos_path, uint32_t tgt_id)
 		rc = bio_nvme_init(NULL, VOS_NVME_NUMA_NODE, 0, 0,
 				   VOS_NVME_NR_TARGET, vos_db_get(), true);
 	} else {
+		/* Hugepage memory (MB) for SPDK, e.g. malloc bdev needs more */
+		d_getenv_int("VOS_NVME_MEM_SIZE", &mem_size);
 		rc = bio_nvme_init(nvme_conf, VOS_NVME_NUMA_NODE,
-				   VOS_NVME_MEM_SIZE, VOS_NVME_HUGEPAGE_SIZE,
+				   mem_size, VOS_NVME_HUGEPAGE_SIZE,
 				   VOS_NVME_NR_TARGET, vos_db_get(), true);
 		close(fd);
 	}
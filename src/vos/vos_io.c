@@ -695,6 +695,8 @@ vos_ioc_create(daos_handle_t coh, daos_unit_oid_t oid, bool read_only,
 		rc = -DER_NOMEM;
 		goto error;
 	}
+	if (vos_flags & VOS_OF_BG)
+		bio_iod_set_class(ioc->ic_biod, BIO_IO_CLASS_BG);
 
 	rc = dcs_csum_info_list_init(&ioc->ic_csum_list, iod_nr);
 	if (rc != 0)
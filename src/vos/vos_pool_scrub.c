@@ -468,7 +468,7 @@ sc_verify_obj_value(struct scrub_ctx *ctx, struct bio_iov *biov, daos_handle_t i
 	iter = vos_hdl2iter(ih);
 	oiter = vos_iter2oiter(iter);
 	bio_ctx = oiter->it_obj->obj_cont->vc_pool->vp_io_ctxt;
-	rc = bio_read(bio_ctx, biov->bi_addr, &data);
+	rc = bio_read_class(bio_ctx, biov->bi_addr, &data, BIO_IO_CLASS_BG);
 
 	/* if bio_read of NVME then it might have yielded */
 	if (bio_iov2media(biov) == DAOS_MEDIA_NVME)
@@ -113,6 +113,7 @@ if [ -d "/mnt/daos" ]; then
 
         export VOS_BDEV_CLASS="AIO"
         run_test "sudo -E ${SL_PREFIX}/bin/vos_tests" -a
+        run_test "sudo -E ${SL_PREFIX}/bin/vos_tests" --nvme_rcache -i 0 -f VOS210
 
         rm -f "${AIO_DEV}"
         rm -f "${NVME_CONF}"
@@ -156,6 +157,7 @@ if [ -d "/mnt/daos" ]; then
 
     COMP="UTEST_bio"
     run_test "${SL_BUILD_DIR}/src/bio/smd/tests/smd_ut"
+    run_test "${SL_BUILD_DIR}/src/bio/tests/bio_bulk_tests"
 
     COMP="UTEST_common"
     run_test "${SL_BUILD_DIR}/src/common/tests/umem_test"
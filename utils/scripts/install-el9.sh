@@ -38,6 +38,7 @@ dnf --nodocs install \
     libtool \
     libtool-ltdl-devel \
     libunwind-devel \
+    liburing-devel \
     libuuid-devel \
     libyaml-devel \
     lz4-devel \
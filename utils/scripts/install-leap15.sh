@@ -38,6 +38,7 @@ dnf --nodocs install \
     libopenssl-devel \
     libtool \
     libunwind-devel \
+    liburing-devel \
     libuuid-devel \
     libyaml-devel \
     lua-lmod \
@@ -37,6 +37,7 @@ apt-get install \
     libssl-dev \
     libtool-bin \
     libunwind-dev \
+    liburing-dev \
     libyaml-dev \
     locales \
     maven \